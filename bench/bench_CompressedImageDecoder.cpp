@@ -0,0 +1,85 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// Measures the decoding throughput of the CompressedImageDecoder for all supported formats.
+// The unpacking of an uncompressed RGBA8888 image with the ImageConverter is measured as reference.
+
+#include "CompressedImageDecoder.hpp"
+#include "ImageConverter.hpp"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace rr;
+
+namespace
+{
+
+static constexpr std::size_t TEXTURE_SIZE { 256 };
+static constexpr std::size_t ITERATIONS { 500 };
+
+template <typename Function>
+void measure(const char* name, const std::size_t inputSize, const Function& decode)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < ITERATIONS; i++)
+    {
+        decode();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    const double pixels = static_cast<double>(TEXTURE_SIZE * TEXTURE_SIZE * ITERATIONS);
+    const double bytes = static_cast<double>(inputSize * ITERATIONS);
+    std::printf("%-10s %10.1f Mpixel/s %10.1f MB/s input\n", name, pixels / seconds / 1e6, bytes / seconds / 1e6);
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937 rng { 42 };
+    std::vector<uint8_t> data(TEXTURE_SIZE * TEXTURE_SIZE * 4);
+    for (uint8_t& d : data)
+    {
+        d = static_cast<uint8_t>(rng());
+    }
+
+    std::shared_ptr<uint16_t> texture { new uint16_t[TEXTURE_SIZE * TEXTURE_SIZE], std::default_delete<uint16_t[]>() };
+    volatile uint16_t sink = 0;
+
+    const std::array<const char*, 5> names { "DXT1 RGB", "DXT1 RGBA", "DXT3", "DXT5", "ETC1" };
+    for (std::size_t i = 0; i < CompressedImageDecoder::SUPPORTED_FORMATS.size(); i++)
+    {
+        const GLenum format = CompressedImageDecoder::SUPPORTED_FORMATS[i];
+        InternalPixelFormat ipf {};
+        CompressedImageDecoder::convertInternalPixelFormat(ipf, format);
+        measure(names[i], CompressedImageDecoder::getImageSize(format, TEXTURE_SIZE, TEXTURE_SIZE), [&]()
+            {
+                CompressedImageDecoder::decode(texture, ipf, TEXTURE_SIZE, 0, 0, TEXTURE_SIZE, TEXTURE_SIZE, format, data.data());
+                sink = sink + texture.get()[0]; });
+    }
+
+    ImageConverter imageConverter {};
+    measure("RGBA8888", data.size(), [&]()
+        {
+            imageConverter.convertUnpack(texture, InternalPixelFormat::RGBA, TEXTURE_SIZE, 0, 0, TEXTURE_SIZE, TEXTURE_SIZE, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+            sink = sink + texture.get()[0]; });
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// Measures the decoding throughput of the DisplayListDisassembler.
+// Compares the CommandVariant based decoding (getNextCommand() + std::visit) with the
+// op code indexed dispatch table (visitNextCommand()).
+
+#include "renderer/commands/CommandVariant.hpp"
+#include "renderer/displaylist/DisplayList.hpp"
+#include "renderer/displaylist/DisplayListDisassembler.hpp"
+#include "renderer/displaylist/RIXDisplayListAssembler.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace rr;
+using namespace rr::displaylist;
+
+namespace
+{
+
+// Typical mix of commands of a frame: mostly vertices and triangles with a few state changes
+std::size_t fillDisplayList(DisplayList& displayList)
+{
+    RIXDisplayListAssembler<DisplayList> assembler { displayList };
+    const std::array<std::size_t, 4> pages { 1, 2, 3, 4 };
+    TriangleStreamCmd::TrDesc triangle {};
+    std::size_t commands = 0;
+    for (;;)
+    {
+        bool ret = true;
+        ret = ret && assembler.addCommand(WriteRegisterCmd { ColorBufferAddrReg { 0x1000 } });
+        ret = ret && assembler.addCommand(TextureStreamCmd { 0, pages });
+        ret = ret && assembler.addCommand(DrawNewElementCmd {});
+        commands += 3;
+        for (std::size_t i = 0; ret && (i < 16); i++)
+        {
+            ret = ret && assembler.addCommand(PushVertexCmd { VertexParameter {} });
+            ret = ret && assembler.addCommand(TriangleStreamCmd { TriangleStreamCmd::command(), { &triangle, 1 }, true });
+            ret = ret && assembler.addCommand(NopCmd {});
+            commands += 3;
+        }
+        if (!ret)
+        {
+            return commands;
+        }
+    }
+}
+
+// Touches the op and the first word of the payload like a real command handler would do
+template <typename TCmd>
+uint32_t sinkCommand(const TCmd& cmd)
+{
+    uint32_t val = static_cast<uint32_t>(cmd.command());
+    if (!cmd.payload().empty())
+    {
+        uint32_t word;
+        std::memcpy(&word, cmd.payload().data(), sizeof(word));
+        val ^= word;
+    }
+    return val;
+}
+
+template <typename Function>
+double measure(const char* name, DisplayList& displayList, const std::size_t iterations, const Function& decode)
+{
+    std::size_t commands = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; i++)
+    {
+        displayList.resetGet();
+        commands += decode(displayList);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    const double commandsPerSecond = static_cast<double>(commands) / seconds;
+    std::printf("%-24s %12.0f commands/s (%zu commands in %.3f s)\n", name, commandsPerSecond, commands, seconds);
+    return commandsPerSecond;
+}
+
+} // namespace
+
+int main()
+{
+    static constexpr std::size_t BUFFER_SIZE { 1024 * 1024 };
+    static constexpr std::size_t ITERATIONS { 2000 };
+    std::vector<uint8_t> buffer(BUFFER_SIZE);
+    DisplayList displayList {};
+    displayList.setBuffer({ buffer.data(), buffer.size() });
+    fillDisplayList(displayList);
+
+    volatile uint32_t sink = 0;
+
+    const double variant = measure("getNextCommand", displayList, ITERATIONS, [&sink](DisplayList& dl)
+        {
+            DisplayListDisassembler disassembler { dl };
+            std::size_t commands = 0;
+            while (disassembler.hasNextCommand())
+            {
+                sink = sink + std::visit([](const auto& cmd)
+                    { return sinkCommand(cmd); },
+                    disassembler.getNextCommand());
+                commands++;
+            }
+            return commands; });
+
+    const double table = measure("visitNextCommand", displayList, ITERATIONS, [&sink](DisplayList& dl)
+        {
+            DisplayListDisassembler disassembler { dl };
+            std::size_t commands = 0;
+            while (disassembler.hasNextCommand())
+            {
+                disassembler.visitNextCommand([&sink](const auto& cmd)
+                    {
+                        sink = sink + sinkCommand(cmd);
+                        return true; });
+                commands++;
+            }
+            return commands; });
+
+    std::printf("speedup                  %12.2fx\n", table / variant);
+    return 0;
+}
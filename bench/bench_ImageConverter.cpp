@@ -0,0 +1,85 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// Measures the throughput of ImageConverter::convertUnpack() for the common client format and internal pixel
+// format combinations with a 256x256 image like it is used by glTexImage2D.
+
+#include "ImageConverter.hpp"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace rr;
+
+namespace
+{
+
+struct UnpackCase
+{
+    const char* name;
+    GLenum format;
+    GLenum type;
+    InternalPixelFormat ipf;
+    std::size_t pixelSize;
+};
+
+} // namespace
+
+int main()
+{
+    static constexpr std::size_t TEXTURE_SIZE { 256 };
+    static constexpr std::size_t ITERATIONS { 1000 };
+
+    const std::array<UnpackCase, 9> cases { {
+        { "RGBA/UNSIGNED_BYTE -> RGBA4444", GL_RGBA, GL_UNSIGNED_BYTE, InternalPixelFormat::RGBA, 4 },
+        { "RGBA/UNSIGNED_BYTE -> RGBA5551", GL_RGBA, GL_UNSIGNED_BYTE, InternalPixelFormat::RGBA1, 4 },
+        { "RGBA/UNSIGNED_BYTE -> RGB565", GL_RGBA, GL_UNSIGNED_BYTE, InternalPixelFormat::RGB, 4 },
+        { "BGRA/UNSIGNED_BYTE -> RGBA4444", GL_BGRA, GL_UNSIGNED_BYTE, InternalPixelFormat::RGBA, 4 },
+        { "RGB/UNSIGNED_BYTE -> RGB565", GL_RGB, GL_UNSIGNED_BYTE, InternalPixelFormat::RGB, 3 },
+        { "RGB/UNSIGNED_BYTE -> RGBA4444", GL_RGB, GL_UNSIGNED_BYTE, InternalPixelFormat::RGBA, 3 },
+        { "RGB/UNSIGNED_SHORT_5_6_5 -> RGB565", GL_RGB, GL_UNSIGNED_SHORT_5_6_5, InternalPixelFormat::RGB, 2 },
+        { "RGBA/UNSIGNED_SHORT_4_4_4_4 -> RGBA4444", GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4, InternalPixelFormat::RGBA, 2 },
+        { "LUMINANCE/UNSIGNED_BYTE -> RGB565", GL_LUMINANCE, GL_UNSIGNED_BYTE, InternalPixelFormat::LUMINANCE, 1 },
+    } };
+
+    std::mt19937 rng { 42 };
+    std::vector<uint8_t> client(TEXTURE_SIZE * TEXTURE_SIZE * 4);
+    for (uint8_t& c : client)
+    {
+        c = static_cast<uint8_t>(rng());
+    }
+    std::shared_ptr<uint16_t> texture { new uint16_t[TEXTURE_SIZE * TEXTURE_SIZE], std::default_delete<uint16_t[]>() };
+    ImageConverter imageConverter {};
+    volatile uint16_t sink = 0;
+
+    for (const UnpackCase& c : cases)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < ITERATIONS; i++)
+        {
+            imageConverter.convertUnpack(texture, c.ipf, TEXTURE_SIZE, 0, 0, TEXTURE_SIZE, TEXTURE_SIZE, c.format, c.type, client.data());
+            sink = sink + texture.get()[i % (TEXTURE_SIZE * TEXTURE_SIZE)];
+        }
+        const auto end = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        const double bytes = static_cast<double>(TEXTURE_SIZE * TEXTURE_SIZE * c.pixelSize * ITERATIONS);
+        std::printf("%-40s %10.1f MB/s\n", c.name, bytes / seconds / 1e6);
+    }
+    return 0;
+}
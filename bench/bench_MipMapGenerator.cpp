@@ -0,0 +1,87 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// Measures the generation of all mip map levels of a texture for the internal pixel formats.
+
+#include "MipMapGenerator.hpp"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+
+using namespace rr;
+
+namespace
+{
+
+static constexpr std::size_t TEXTURE_SIZE { 256 };
+static constexpr std::size_t ITERATIONS { 2000 };
+
+void measure(const char* name, const InternalPixelFormat ipf)
+{
+    std::mt19937 rng { 42 };
+    // The allocator must outlive the texture, which holds the generated levels
+    TexturePixelAllocator allocator {};
+    TextureObject textureObject {};
+    textureObject.setWidth(0, TEXTURE_SIZE);
+    textureObject.setHeight(0, TEXTURE_SIZE);
+    textureObject.setInternalPixelFormat(0, ipf);
+    textureObject.setPixels(0, TextureObject::PixelsType { new uint16_t[TEXTURE_SIZE * TEXTURE_SIZE], std::default_delete<uint16_t[]>() });
+    for (std::size_t i = 0; i < TEXTURE_SIZE * TEXTURE_SIZE; i++)
+    {
+        textureObject.getPixels(0).get()[i] = static_cast<uint16_t>(rng());
+    }
+
+    MipMapGenerator generator { allocator };
+    generator.setEnableMipMapGeneration(true);
+
+    volatile uint16_t sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < ITERATIONS; i++)
+    {
+        generator.generateMipMap(textureObject, 0);
+        sink = sink + textureObject.getPixels(1).get()[0];
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    const double basePixels = static_cast<double>(TEXTURE_SIZE * TEXTURE_SIZE * ITERATIONS);
+    std::printf("%-16s %10.1f Mpixel/s base level %8.2f us/texture\n",
+        name,
+        basePixels / seconds / 1e6,
+        seconds / ITERATIONS * 1e6);
+}
+
+} // namespace
+
+int main()
+{
+    const std::array<std::pair<const char*, InternalPixelFormat>, 7> formats { {
+        { "ALPHA", InternalPixelFormat::ALPHA },
+        { "LUMINANCE", InternalPixelFormat::LUMINANCE },
+        { "INTENSITY", InternalPixelFormat::INTENSITY },
+        { "LUMINANCE_ALPHA", InternalPixelFormat::LUMINANCE_ALPHA },
+        { "RGB", InternalPixelFormat::RGB },
+        { "RGBA", InternalPixelFormat::RGBA },
+        { "RGBA1", InternalPixelFormat::RGBA1 },
+    } };
+
+    for (const auto& [name, ipf] : formats)
+    {
+        measure(name, ipf);
+    }
+    return 0;
+}
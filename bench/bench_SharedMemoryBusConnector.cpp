@@ -0,0 +1,173 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// Compares the transport of the DeviceDataUploader over the SharedMemoryBusConnector to a server in another process
+// with the transport to an in-process bus connector. Measures the time to stream a 128 kB display list and the
+// round trip time of a small read of the device memory.
+
+#include "GenericMemoryBusConnector.hpp"
+#include "SharedMemoryBusConnector.hpp"
+#include "SharedMemoryBusServer.hpp"
+#include "renderer/devicedatauploader/DeviceDataReceiver.hpp"
+#include "renderer/devicedatauploader/DeviceDataUploader.hpp"
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace rr;
+using namespace rr::devicedatauploader;
+
+namespace
+{
+
+static constexpr std::size_t DISPLAY_LIST_SIZE { 128 * 1024 };
+static constexpr std::size_t DISPLAY_LIST_COUNT { 4 };
+static constexpr std::size_t STREAM_ITERATIONS { 20000 };
+static constexpr std::size_t READ_ITERATIONS { 20000 };
+static constexpr std::size_t READ_SIZE { 64 };
+
+/// Discards the display lists. The memory reads return zeros.
+class NullDevice : public IDevice
+{
+public:
+    void streamDisplayList(const uint8_t, const uint32_t) override { }
+    bool writeToDeviceMemory(tcb::span<const uint8_t>, const uint32_t) override { return true; }
+    bool readFromDeviceMemory(tcb::span<uint8_t> data, const uint32_t) override
+    {
+        std::fill(data.begin(), data.end(), 0);
+        return true;
+    }
+    void blockUntilDeviceIsIdle() override { }
+    tcb::span<uint8_t> requestDisplayListBuffer(const uint8_t index) override { return { m_displayLists[index] }; }
+    uint8_t getDisplayListBufferCount() const override { return m_displayLists.size(); }
+
+private:
+    std::array<std::array<uint8_t, DISPLAY_LIST_SIZE>, DISPLAY_LIST_COUNT> m_displayLists {};
+};
+
+/// Discards all data. Reads return the content of the read buffer.
+class NullBusConnector : public GenericMemoryBusConnector<DISPLAY_LIST_COUNT + 1, DISPLAY_LIST_SIZE + sizeof(Command)>
+{
+public:
+    void writeData(const uint8_t, const uint32_t, const uint32_t) override { }
+    void readData(const uint8_t, const uint32_t) override { }
+    void blockUntilTransferIsComplete() override { }
+};
+
+void measure(const char* name, IBusConnector& busConnector)
+{
+    DeviceDataUploader uploader { busConnector };
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < STREAM_ITERATIONS; i++)
+    {
+        const uint8_t index = i % uploader.getDisplayListBufferCount();
+        uploader.requestDisplayListBuffer(index)[0] = static_cast<uint8_t>(i);
+        uploader.streamDisplayList(index, DISPLAY_LIST_SIZE);
+    }
+    uploader.blockUntilDeviceIsIdle();
+    const double streamSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::array<uint8_t, READ_SIZE> data {};
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < READ_ITERATIONS; i++)
+    {
+        uploader.readFromDeviceMemory(data, 0);
+    }
+    const double readSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%-40s %10.2f us/display list %10.2f us/read\n",
+        name,
+        streamSeconds * 1e6 / STREAM_ITERATIONS,
+        readSeconds * 1e6 / READ_ITERATIONS);
+}
+
+SharedMemoryBusServer* server { nullptr };
+
+void stopServer(int)
+{
+    server->stop();
+}
+
+int runServer(const std::string& name)
+{
+    static NullDevice device {};
+    static DeviceDataReceiver receiver { device };
+    static SharedMemoryBusServer sharedMemoryServer { receiver };
+    server = &sharedMemoryServer;
+    std::signal(SIGTERM, stopServer);
+    if (!sharedMemoryServer.open(name.c_str()))
+    {
+        return 1;
+    }
+    sharedMemoryServer.serve();
+    return 0;
+}
+
+} // namespace
+
+int main()
+{
+    const std::string name { "/rixbus_bench_" + std::to_string(getpid()) };
+    const pid_t serverPid = fork();
+    if (serverPid == 0)
+    {
+        return runServer(name);
+    }
+
+    {
+        static NullBusConnector busConnector {};
+        measure("in-process GenericMemoryBusConnector", busConnector);
+    }
+    {
+        static NullDevice device {};
+        static DeviceDataReceiver receiver { device };
+        measure("in-process DeviceDataReceiver", receiver);
+    }
+    {
+        SharedMemoryBusConnector busConnector {};
+        bool connected = false;
+        for (std::size_t i = 0; (i < 500) && !connected; i++)
+        {
+            connected = busConnector.connect(name.c_str());
+            if (!connected)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+        if (connected)
+        {
+            measure("SharedMemoryBusConnector (other process)", busConnector);
+        }
+        else
+        {
+            std::fprintf(stderr, "Cannot connect to the server\n");
+        }
+    }
+
+    kill(serverPid, SIGTERM);
+    waitpid(serverPid, nullptr, 0);
+    shm_unlink(name.c_str());
+    return 0;
+}
@@ -0,0 +1,74 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// Measures the time of SoftwareRasterizerBusConnector::writeData(), which presents the color buffer of the software
+// rasterizer, for a 1024x600 frame in the supported framebuffer formats.
+
+#include "SoftwareRasterizerBusConnector.hpp"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace rr;
+
+namespace
+{
+
+static constexpr std::size_t WIDTH { 1024 };
+static constexpr std::size_t HEIGHT { 600 };
+static constexpr std::size_t ITERATIONS { 500 };
+static constexpr uint32_t GRAM_SIZE { 4 * 1024 * 1024 };
+
+template <SoftwareRasterizerBusConnectorColorFormat Format>
+void measure(const char* name, const std::size_t bytesPerPixel, const bool dirtyBandsOnly)
+{
+    std::vector<uint8_t> framebuffer(WIDTH * HEIGHT * bytesPerPixel);
+    auto busConnector = std::make_unique<SoftwareRasterizerBusConnector<GRAM_SIZE, Format>>(framebuffer);
+    busConnector->setConvertDirtyBandsOnly(dirtyBandsOnly);
+
+    std::mt19937 rng { 42 };
+    tcb::span<uint8_t> gram = busConnector->requestWriteBuffer(0);
+    for (std::size_t i = 0; i < WIDTH * HEIGHT * 2; i++)
+    {
+        gram[i] = static_cast<uint8_t>(rng());
+    }
+
+    volatile uint8_t sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < ITERATIONS; i++)
+    {
+        busConnector->writeData(0, WIDTH * HEIGHT * 2, 0);
+        sink = sink + framebuffer[i % framebuffer.size()];
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    std::printf("%-40s %10.3f ms/frame\n", name, seconds * 1e3 / ITERATIONS);
+}
+
+} // namespace
+
+int main()
+{
+    measure<SoftwareRasterizerBusConnectorColorFormat::RGB565>("RGB565", 2, false);
+    measure<SoftwareRasterizerBusConnectorColorFormat::BGR888>("BGR888", 3, false);
+    measure<SoftwareRasterizerBusConnectorColorFormat::RGBA8888>("RGBA8888", 4, false);
+    measure<SoftwareRasterizerBusConnectorColorFormat::BGR888>("BGR888 dirty bands (static frame)", 3, true);
+    measure<SoftwareRasterizerBusConnectorColorFormat::RGBA8888>("RGBA8888 dirty bands (static frame)", 4, true);
+    return 0;
+}
@@ -0,0 +1,115 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// Stress test of the TextureMemoryManager. Textures are created, updated and deleted like an application which
+// streams its textures every frame. Reports the number of texture updates per second and the memory statistics.
+
+#include "RenderConfigs.hpp"
+#include "renderer/TextureMemoryManager.hpp"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace rr;
+
+namespace
+{
+
+TextureObject createTextureObject(const std::size_t width, const std::size_t height)
+{
+    TextureObject obj {};
+    obj.setWidth(0, width);
+    obj.setHeight(0, height);
+    obj.setInternalPixelFormat(0, InternalPixelFormat::RGB);
+    obj.setPixels(0, TextureObject::PixelsType { new uint16_t[width * height](), std::default_delete<uint16_t[]>() });
+    return obj;
+}
+
+} // namespace
+
+int main()
+{
+    using TextureManager = TextureMemoryManager<RenderConfig>;
+    static constexpr std::size_t FRAMES { 2000 };
+    static constexpr std::size_t LIVE_TEXTURES { 2048 };
+    static constexpr std::size_t UPDATES_PER_FRAME { 32 };
+    static constexpr std::size_t RECREATES_PER_FRAME { 8 };
+
+    // The texture objects are prepared upfront to only measure the memory manager
+    std::vector<TextureObject> textureObjects;
+    for (std::size_t size = 8; size <= 128; size *= 2)
+    {
+        textureObjects.push_back(createTextureObject(size, size));
+        textureObjects.push_back(createTextureObject(size, size / 2));
+    }
+
+    std::unique_ptr<TextureManager> manager = std::make_unique<TextureManager>();
+    std::vector<uint16_t> textures;
+    for (std::size_t i = 0; i < LIVE_TEXTURES; i++)
+    {
+        textures.push_back(manager->createTexture().second);
+    }
+
+    std::mt19937 rng { 42 };
+    std::uniform_int_distribution<std::size_t> textureDist { 0, LIVE_TEXTURES - 1 };
+    std::uniform_int_distribution<std::size_t> objectDist { 0, textureObjects.size() - 1 };
+    std::size_t operations = 0;
+    std::size_t failures = 0;
+    std::size_t uploadedPages = 0;
+    const auto uploader = [&uploadedPages](uint32_t, const tcb::span<const uint8_t>)
+    {
+        uploadedPages++;
+        return true;
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t frame = 0; frame < FRAMES; frame++)
+    {
+        for (std::size_t i = 0; i < UPDATES_PER_FRAME; i++)
+        {
+            const uint16_t texId = textures[textureDist(rng)];
+            failures += manager->updateTexture(texId, textureObjects[objectDist(rng)]) ? 0 : 1;
+            operations++;
+        }
+        for (std::size_t i = 0; i < RECREATES_PER_FRAME; i++)
+        {
+            uint16_t& texId = textures[textureDist(rng)];
+            manager->deleteTexture(texId);
+            const std::pair<bool, uint16_t> ret = manager->createTexture();
+            failures += ret.first ? 0 : 1;
+            texId = ret.second;
+            failures += manager->updateTexture(texId, textureObjects[objectDist(rng)]) ? 0 : 1;
+            operations += 3;
+        }
+        manager->uploadTextures(uploader);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+
+    const TextureManager::Statistics stats = manager->getStatistics();
+    std::printf("%-24s %12.0f operations/s (%zu operations, %zu frames in %.3f s)\n", "texture churn", static_cast<double>(operations) / seconds, operations, FRAMES, seconds);
+    std::printf("%-24s %12.0f frames/s\n", "", static_cast<double>(FRAMES) / seconds);
+    std::printf("%-24s %12zu\n", "failed operations", failures);
+    std::printf("%-24s %12zu\n", "uploaded pages", uploadedPages);
+    std::printf("%-24s %12zu / %zu (peak %zu)\n", "used pages", stats.usedPages, stats.usedPages + stats.freePages, stats.peakUsedPages);
+    std::printf("%-24s %12zu bytes\n", "unused bytes in pages", stats.unusedBytesInPages);
+    std::printf("%-24s %12zu (largest %zu pages)\n", "free page runs", stats.freePageRuns, stats.largestFreePageRun);
+    std::printf("%-24s %12zu (%zu bytes uploaded again)\n", "evictions", stats.evictions, stats.reuploadedBytes);
+    return 0;
+}
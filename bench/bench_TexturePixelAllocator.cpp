@@ -0,0 +1,68 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+// Measures the allocation of texture pixel buffers like a loading screen does it. A texture update allocates the
+// new buffer before the old one is released. The TexturePixelAllocator is compared with a heap allocation per buffer.
+
+#include "TexturePixelAllocator.hpp"
+#include <array>
+#include <chrono>
+#include <cstdio>
+
+using namespace rr;
+
+namespace
+{
+
+static constexpr std::size_t ITERATIONS { 20000 };
+static constexpr std::size_t LIVE_TEXTURES { 16 };
+static constexpr std::array<std::size_t, 5> TEXTURE_SIZES { 256, 128, 64, 256, 32 };
+
+template <typename Function>
+void measure(const char* name, const Function& allocate)
+{
+    std::array<TextureObject::PixelsType, LIVE_TEXTURES> textures {};
+    volatile uint16_t sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < ITERATIONS; i++)
+    {
+        const std::size_t size = TEXTURE_SIZES[i % TEXTURE_SIZES.size()];
+        TextureObject::PixelsType buffer = allocate(size * size);
+        buffer.get()[0] = static_cast<uint16_t>(i);
+        sink = sink + buffer.get()[0];
+        textures[i % LIVE_TEXTURES] = buffer;
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    std::printf("%-24s %10.1f ns/texture\n", name, seconds / ITERATIONS * 1e9);
+}
+
+} // namespace
+
+int main()
+{
+    measure("new[] per texture", [](const std::size_t pixels)
+        { return TextureObject::PixelsType { new uint16_t[pixels], std::default_delete<uint16_t[]>() }; });
+
+    TexturePixelAllocator allocator {};
+    measure("TexturePixelAllocator", [&allocator](const std::size_t pixels)
+        { return allocator.allocate(pixels); });
+    const TexturePixelAllocator::Statistics statistics = allocator.getStatistics();
+    std::printf("allocations %zu reuses %zu peak %zu bytes\n", statistics.allocations, statistics.reuses, statistics.peakBytes);
+    return 0;
+}
@@ -0,0 +1,157 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// Replays a capture of the DeviceCapture into a backend and measures its throughput, isolated from the application.
+// Usage: bench_replay <capture file> [backend] [iterations]
+// Backends:
+//   sw         The SoftwareRasterizer
+//   ddu        The DeviceDataUploader with a bus connector which discards the data. Measures the host side of the
+//              frame transfer protocol.
+//   verilator  The DeviceDataUploader with the Verilator simulation of the RasterIX (bench_replay_verilator only)
+// The capture must be recorded with the same RIX_CORE_* configuration as the replay.
+
+#include "GenericMemoryBusConnector.hpp"
+#include "IBusConnector.hpp"
+#include "SoftwareRasterizerBusConnector.hpp"
+#include "renderer/devicecapture/DeviceCaptureReplay.hpp"
+#include "renderer/devicedatauploader/DeviceDataUploader.hpp"
+#include "renderer/softwarerasterizer/SoftwareRasterizer.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+
+#if RIX_REPLAY_VERILATOR
+#include "VerilatorBusConnector.hpp"
+#endif
+
+using namespace rr;
+
+namespace
+{
+
+static constexpr std::size_t DISPLAY_LIST_BUFFER_COUNT { 33 };
+static constexpr std::size_t DISPLAY_LIST_BUFFER_SIZE { 128 * 1024 };
+
+/// Discards all data. Reads return the content of the read buffer.
+class NullBusConnector : public GenericMemoryBusConnector<DISPLAY_LIST_BUFFER_COUNT, DISPLAY_LIST_BUFFER_SIZE>
+{
+public:
+    void writeData(const uint8_t, const uint32_t, const uint32_t) override { }
+    void readData(const uint8_t, const uint32_t) override { }
+    void blockUntilTransferIsComplete() override { }
+};
+
+static std::array<uint8_t, RenderConfig::MAX_DISPLAY_WIDTH * RenderConfig::MAX_DISPLAY_HEIGHT * 2> framebuffer {};
+
+/// Prints additional backend specific fields. Each field must be terminated with a comma.
+using PrintBackendFields = std::function<void()>;
+
+int replay(devicecapture::DeviceCaptureReplay& capture, IDevice& device, const char* backend, const std::size_t iterations, const PrintBackendFields& printBackendFields = {})
+{
+    // The first replay uploads the initial state (textures) and warms up the caches
+    if (!capture.replay(device))
+    {
+        std::fprintf(stderr, "Replay failed\n");
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; i++)
+    {
+        capture.replay(device);
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const devicecapture::DeviceCaptureReplay::Statistics statistics = capture.getStatistics();
+    const double bytes = static_cast<double>(statistics.displayListBytes + statistics.uploadBytes) * iterations;
+    std::printf("{\n");
+    std::printf("  \"backend\": \"%s\",\n", backend);
+    std::printf("  \"iterations\": %zu,\n", iterations);
+    std::printf("  \"records\": %zu,\n", capture.getRecordCount());
+    std::printf("  \"displayLists\": %zu,\n", statistics.displayLists);
+    std::printf("  \"displayListBytes\": %zu,\n", statistics.displayListBytes);
+    std::printf("  \"uploads\": %zu,\n", statistics.uploads);
+    std::printf("  \"uploadBytes\": %zu,\n", statistics.uploadBytes);
+    std::printf("  \"reads\": %zu,\n", statistics.reads);
+    std::printf("  \"seconds\": %.6f,\n", seconds);
+    std::printf("  \"secondsPerIteration\": %.6f,\n", seconds / iterations);
+    if (printBackendFields)
+    {
+        printBackendFields();
+    }
+    std::printf("  \"displayListsPerSecond\": %.1f,\n", static_cast<double>(statistics.displayLists * iterations) / seconds);
+    std::printf("  \"megabytesPerSecond\": %.3f\n", bytes / seconds / 1e6);
+    std::printf("}\n");
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: %s <capture file> [sw|ddu|verilator] [iterations]\n", argv[0]);
+        return 1;
+    }
+    const char* backend = (argc > 2) ? argv[2] : "sw";
+    const std::size_t iterations = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 10;
+
+    std::ifstream file { argv[1], std::ios::binary };
+    devicecapture::DeviceCaptureReplay capture {};
+    if (!file || !capture.load(file))
+    {
+        std::fprintf(stderr, "Cannot load capture %s\n", argv[1]);
+        return 1;
+    }
+    if (iterations == 0)
+    {
+        std::fprintf(stderr, "At least one iteration is required\n");
+        return 1;
+    }
+
+    if (std::strcmp(backend, "sw") == 0)
+    {
+        static SoftwareRasterizerBusConnector<> busConnector { framebuffer };
+        static softwarerasterizer::SoftwareRasterizer device { busConnector };
+        return replay(capture, device, backend, iterations);
+    }
+    if (std::strcmp(backend, "ddu") == 0)
+    {
+        static NullBusConnector busConnector {};
+        static devicedatauploader::DeviceDataUploader device { busConnector };
+        return replay(capture, device, backend, iterations);
+    }
+#if RIX_REPLAY_VERILATOR
+    if (std::strcmp(backend, "verilator") == 0)
+    {
+        static VerilatorBusConnector<DISPLAY_LIST_BUFFER_COUNT, DISPLAY_LIST_BUFFER_SIZE> busConnector { framebuffer, RenderConfig::MAX_DISPLAY_WIDTH, RenderConfig::MAX_DISPLAY_HEIGHT };
+        static devicedatauploader::DeviceDataUploader device { busConnector };
+        return replay(capture, device, backend, iterations, []()
+            {
+                const auto statistics = busConnector.getStatistics();
+                std::printf("  \"simulatedCycles\": %llu,\n", static_cast<unsigned long long>(statistics.cycles));
+                std::printf("  \"simulatedCyclesPerSecond\": %.1f,\n", busConnector.getCyclesPerSecond());
+            });
+    }
+#endif
+    std::fprintf(stderr, "Unknown backend %s\n", backend);
+    return 1;
+}
@@ -0,0 +1,90 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef FILL_RATE_HPP_
+#define FILL_RATE_HPP_
+
+#include "gl.h"
+#include <cstdint>
+#include <vector>
+
+/// @brief Draws several textured and blended layers which cover the whole screen
+class FillRate
+{
+public:
+    void init(const uint32_t resolutionW, const uint32_t resolutionH)
+    {
+        glViewport(0, 0, resolutionW, resolutionH);
+        glMatrixMode(GL_PROJECTION);
+        glLoadIdentity();
+        glOrtho(0.0, 1.0, 0.0, 1.0, -1.0, 1.0);
+        glMatrixMode(GL_MODELVIEW);
+        glLoadIdentity();
+
+        std::vector<uint8_t> pixels(TEXTURE_SIZE * TEXTURE_SIZE * 4);
+        for (std::size_t i = 0; i < (TEXTURE_SIZE * TEXTURE_SIZE); i++)
+        {
+            const std::size_t x = i % TEXTURE_SIZE;
+            const std::size_t y = i / TEXTURE_SIZE;
+            pixels[(i * 4) + 0] = static_cast<uint8_t>(x * 4);
+            pixels[(i * 4) + 1] = static_cast<uint8_t>(y * 4);
+            pixels[(i * 4) + 2] = static_cast<uint8_t>((x ^ y) * 4);
+            pixels[(i * 4) + 3] = 0x80;
+        }
+        glGenTextures(1, &m_textureId);
+        glBindTexture(GL_TEXTURE_2D, m_textureId);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, TEXTURE_SIZE, TEXTURE_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+        glEnable(GL_TEXTURE_2D);
+        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+
+    void draw()
+    {
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        m_offset += 0.01f;
+        glBegin(GL_QUADS);
+        for (std::size_t layer = 0; layer < LAYERS; layer++)
+        {
+            const float s = m_offset + (static_cast<float>(layer) * 0.1f);
+            glColor4f(1.0f, 1.0f - (static_cast<float>(layer) / LAYERS), 1.0f, 1.0f);
+            glTexCoord2f(s, 0.0f);
+            glVertex2f(0.0f, 0.0f);
+            glTexCoord2f(s + 1.0f, 0.0f);
+            glVertex2f(1.0f, 0.0f);
+            glTexCoord2f(s + 1.0f, 1.0f);
+            glVertex2f(1.0f, 1.0f);
+            glTexCoord2f(s, 1.0f);
+            glVertex2f(0.0f, 1.0f);
+        }
+        glEnd();
+    }
+
+private:
+    static constexpr std::size_t TEXTURE_SIZE { 64 };
+    static constexpr std::size_t LAYERS { 8 };
+
+    GLuint m_textureId { 0 };
+    float m_offset { 0.0f };
+};
+
+#endif // FILL_RATE_HPP_
@@ -0,0 +1,28 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// The main of all scene benchmarks. The scene is selected by add_scenebenchmark() with the definitions
+// RIX_SCENE_NAME (the name of the benchmark), RIX_SCENE_HEADER (the header of the scene) and RIX_SCENE_CLASS.
+
+#include "SceneRunner.hpp"
+#include RIX_SCENE_HEADER
+
+int main(int argc, char** argv)
+{
+    static rr::bench::SceneRunner<RIX_SCENE_CLASS> runner;
+    return runner.execute(RIX_SCENE_NAME, argc, argv);
+}
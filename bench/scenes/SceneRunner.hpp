@@ -0,0 +1,227 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SCENE_RUNNER_HPP_
+#define SCENE_RUNNER_HPP_
+
+#include "IBusConnector.hpp"
+#include "MultiThreadRunner.hpp"
+#include "Profiler.hpp"
+#include "RIXGL.hpp"
+#include "SoftwareRasterizerBusConnector.hpp"
+#include "renderer/IDevice.hpp"
+#include "renderer/devicecapture/DeviceCapture.hpp"
+#include "renderer/softwarerasterizer/SoftwareRasterizer.hpp"
+#include "renderer/threadedvertextransformer/ThreadedVertexTransformer.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace rr::bench
+{
+
+/// @brief Forwards all calls to the software rasterizer and counts the data which would be sent to the hardware
+class CountingDevice : public IDevice
+{
+public:
+    struct Statistics
+    {
+        std::size_t displayLists { 0 }; ///< Number of streamed display lists
+        std::size_t displayListBytes { 0 }; ///< Bytes of the streamed display lists
+        std::size_t uploadBytes { 0 }; ///< Bytes written into the device memory (mostly texture pages)
+        softwarerasterizer::SoftwareRasterizer::Statistics rasterizer {};
+    };
+
+    CountingDevice(softwarerasterizer::SoftwareRasterizer& device)
+        : m_device { device }
+    {
+    }
+
+    void streamDisplayList(const uint8_t index, const uint32_t size) override
+    {
+        m_device.streamDisplayList(index, size);
+        std::lock_guard<std::mutex> lock { m_mutex };
+        m_statistics.displayLists++;
+        m_statistics.displayListBytes += size;
+        m_statistics.rasterizer = m_device.getStatistics();
+    }
+
+    bool writeToDeviceMemory(tcb::span<const uint8_t> data, const uint32_t addr) override
+    {
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+            m_statistics.uploadBytes += data.size();
+        }
+        return m_device.writeToDeviceMemory(data, addr);
+    }
+
+    bool readFromDeviceMemory(tcb::span<uint8_t> data, const uint32_t addr) override
+    {
+        return m_device.readFromDeviceMemory(data, addr);
+    }
+
+    void blockUntilDeviceIsIdle() override
+    {
+        m_device.blockUntilDeviceIsIdle();
+    }
+
+    tcb::span<uint8_t> requestDisplayListBuffer(const uint8_t index) override
+    {
+        return m_device.requestDisplayListBuffer(index);
+    }
+
+    uint8_t getDisplayListBufferCount() const override
+    {
+        return m_device.getDisplayListBufferCount();
+    }
+
+    Statistics getStatistics()
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        return m_statistics;
+    }
+
+private:
+    softwarerasterizer::SoftwareRasterizer& m_device;
+    std::mutex m_mutex {};
+    Statistics m_statistics {};
+};
+
+/// @brief Renders a scene headless with the software rasterizer for a fixed number of frames
+/// @details The scene requires the same interface as the scenes of the examples: init(resolutionW, resolutionH) and
+///     draw(). The results are printed as JSON to stdout. Usage: <binary> [frames] [warmup frames]
+///     If the environment variable RIX_SCENE_CAPTURE is set, the device traffic is captured into this file. It can be
+///     replayed with bench_replay.
+template <typename Scene>
+class SceneRunner
+{
+public:
+    static constexpr uint32_t RESOLUTION_W { 640 };
+    static constexpr uint32_t RESOLUTION_H { 480 };
+    static constexpr std::size_t DEFAULT_FRAMES { 100 };
+    static constexpr std::size_t DEFAULT_WARMUP_FRAMES { 5 };
+
+    SceneRunner()
+    {
+        if (const char* captureFile = std::getenv("RIX_SCENE_CAPTURE"))
+        {
+            m_captureFile.open(captureFile, std::ios::binary);
+            m_capture.start(m_captureFile);
+        }
+        RIXGL::createInstance(m_device);
+        RIXGL::getInstance().setRenderResolution(RESOLUTION_W, RESOLUTION_H);
+    }
+
+    ~SceneRunner()
+    {
+        // The scene might release GL objects
+        m_scene.reset();
+        RIXGL::getInstance().destroy();
+        m_device.deinit();
+        m_capture.stop();
+    }
+
+    int execute(const char* name, const int argc, char** argv)
+    {
+        const std::size_t frames = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : DEFAULT_FRAMES;
+        const std::size_t warmupFrames = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : DEFAULT_WARMUP_FRAMES;
+        if (frames == 0)
+        {
+            std::fprintf(stderr, "usage: %s [frames] [warmup frames]\n", argv[0]);
+            return 1;
+        }
+
+        m_scene->init(RESOLUTION_W, RESOLUTION_H);
+        for (std::size_t i = 0; i < warmupFrames; i++)
+        {
+            drawFrame();
+        }
+        m_device.deinit();
+#if RIX_CORE_ENABLE_PROFILING
+        profiler::Profiler::getInstance().clear();
+#endif
+
+        const CountingDevice::Statistics start = m_countingDevice.getStatistics();
+        const auto startTime = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < frames; i++)
+        {
+            drawFrame();
+        }
+        // Waits until the last frame is rasterized
+        m_device.deinit();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        const CountingDevice::Statistics end = m_countingDevice.getStatistics();
+
+        const double triangles = static_cast<double>(end.rasterizer.triangles - start.rasterizer.triangles);
+        const double fragments = static_cast<double>(end.rasterizer.fragments - start.rasterizer.fragments);
+        std::printf("{\n");
+        std::printf("  \"scene\": \"%s\",\n", name);
+        std::printf("  \"width\": %u,\n", RESOLUTION_W);
+        std::printf("  \"height\": %u,\n", RESOLUTION_H);
+        std::printf("  \"frames\": %zu,\n", frames);
+        std::printf("  \"seconds\": %.6f,\n", seconds);
+        std::printf("  \"framesPerSecond\": %.3f,\n", static_cast<double>(frames) / seconds);
+        std::printf("  \"trianglesPerFrame\": %.1f,\n", triangles / frames);
+        std::printf("  \"trianglesPerSecond\": %.1f,\n", triangles / seconds);
+        std::printf("  \"fragmentsPerSecond\": %.1f,\n", fragments / seconds);
+        std::printf("  \"displayListBytesPerFrame\": %.1f,\n", static_cast<double>(end.displayListBytes - start.displayListBytes) / frames);
+        std::printf("  \"uploadBytesPerFrame\": %.1f\n", static_cast<double>(end.uploadBytes - start.uploadBytes) / frames);
+        std::printf("}\n");
+#if RIX_CORE_ENABLE_PROFILING
+        writeProfile(name);
+#endif
+        return 0;
+    }
+
+private:
+#if RIX_CORE_ENABLE_PROFILING
+    static void writeProfile(const char* name)
+    {
+        const std::string fileName { std::string { name } + "_trace.json" };
+        std::ofstream trace { fileName };
+        profiler::Profiler::getInstance().writeChromeTrace(trace);
+        std::ofstream frames { std::string { name } + "_frames.json" };
+        profiler::Profiler::getInstance().writeFrameSummaries(frames);
+        std::fprintf(stderr, "Profile written to %s and %s_frames.json\n", fileName.c_str(), name);
+    }
+#endif
+
+    void drawFrame()
+    {
+        m_scene->draw();
+        RIXGL::getInstance().swapDisplayList();
+    }
+
+    std::array<uint8_t, RenderConfig::MAX_DISPLAY_WIDTH * RenderConfig::MAX_DISPLAY_HEIGHT * 2> m_framebuffer {};
+    SoftwareRasterizerBusConnector<> m_busConnector { m_framebuffer };
+    softwarerasterizer::SoftwareRasterizer m_softwareRasterizer { m_busConnector };
+    CountingDevice m_countingDevice { m_softwareRasterizer };
+    std::ofstream m_captureFile {};
+    devicecapture::DeviceCapture m_capture { m_countingDevice };
+    MultiThreadRunner m_workerThread {};
+    MultiThreadRunner m_uploadThread {};
+    threadedvertextransformer::ThreadedVertexTransformer m_device { m_capture, m_uploadThread, m_workerThread };
+    std::unique_ptr<Scene> m_scene { std::make_unique<Scene>() };
+};
+
+} // namespace rr::bench
+
+#endif // SCENE_RUNNER_HPP_
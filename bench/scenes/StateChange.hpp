@@ -0,0 +1,107 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef STATE_CHANGE_HPP_
+#define STATE_CHANGE_HPP_
+
+#include "gl.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/// @brief Draws many small quads and changes the texture, the blending, the texture environment and the depth test
+///     between them
+class StateChange
+{
+public:
+    void init(const uint32_t resolutionW, const uint32_t resolutionH)
+    {
+        glViewport(0, 0, resolutionW, resolutionH);
+        glMatrixMode(GL_PROJECTION);
+        glLoadIdentity();
+        glOrtho(0.0, QUADS_PER_ROW, 0.0, QUADS_PER_ROW, -1.0, 1.0);
+        glMatrixMode(GL_MODELVIEW);
+        glLoadIdentity();
+
+        std::vector<uint8_t> pixels(TEXTURE_SIZE * TEXTURE_SIZE * 3);
+        glGenTextures(m_textureIds.size(), m_textureIds.data());
+        for (std::size_t t = 0; t < m_textureIds.size(); t++)
+        {
+            for (std::size_t i = 0; i < pixels.size(); i++)
+            {
+                pixels[i] = static_cast<uint8_t>((i * (t + 1)) ^ (t * 37));
+            }
+            glBindTexture(GL_TEXTURE_2D, m_textureIds[t]);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, TEXTURE_SIZE, TEXTURE_SIZE, 0, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+        }
+        glEnable(GL_TEXTURE_2D);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+
+    void draw()
+    {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        m_frame++;
+        for (std::size_t i = 0; i < (QUADS_PER_ROW * QUADS_PER_ROW); i++)
+        {
+            const std::size_t state = i + m_frame;
+            glBindTexture(GL_TEXTURE_2D, m_textureIds[state % m_textureIds.size()]);
+            glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, (state & 1) ? GL_MODULATE : GL_REPLACE);
+            if (state & 2)
+            {
+                glEnable(GL_BLEND);
+            }
+            else
+            {
+                glDisable(GL_BLEND);
+            }
+            if (state & 4)
+            {
+                glEnable(GL_DEPTH_TEST);
+            }
+            else
+            {
+                glDisable(GL_DEPTH_TEST);
+            }
+
+            const float x = static_cast<float>(i % QUADS_PER_ROW);
+            const float y = static_cast<float>(i / QUADS_PER_ROW);
+            glColor4f(x / QUADS_PER_ROW, y / QUADS_PER_ROW, 1.0f, 0.5f);
+            glBegin(GL_QUADS);
+            glTexCoord2f(0.0f, 0.0f);
+            glVertex2f(x, y);
+            glTexCoord2f(1.0f, 0.0f);
+            glVertex2f(x + 1.0f, y);
+            glTexCoord2f(1.0f, 1.0f);
+            glVertex2f(x + 1.0f, y + 1.0f);
+            glTexCoord2f(0.0f, 1.0f);
+            glVertex2f(x, y + 1.0f);
+            glEnd();
+        }
+    }
+
+private:
+    static constexpr std::size_t TEXTURE_SIZE { 16 };
+    static constexpr std::size_t QUADS_PER_ROW { 16 };
+
+    std::array<GLuint, 8> m_textureIds {};
+    std::size_t m_frame { 0 };
+};
+
+#endif // STATE_CHANGE_HPP_
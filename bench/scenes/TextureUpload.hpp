@@ -0,0 +1,97 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef TEXTURE_UPLOAD_HPP_
+#define TEXTURE_UPLOAD_HPP_
+
+#include "gl.h"
+#include <cstdint>
+#include <vector>
+
+/// @brief Updates a large texture and a part of a second texture every frame and draws both
+class TextureUpload
+{
+public:
+    void init(const uint32_t resolutionW, const uint32_t resolutionH)
+    {
+        glViewport(0, 0, resolutionW, resolutionH);
+        glMatrixMode(GL_PROJECTION);
+        glLoadIdentity();
+        glOrtho(0.0, 2.0, 0.0, 1.0, -1.0, 1.0);
+        glMatrixMode(GL_MODELVIEW);
+        glLoadIdentity();
+
+        GLint maxTextureSize { 0 };
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+        m_textureSize = static_cast<std::size_t>(maxTextureSize);
+        m_pixels.resize(m_textureSize * m_textureSize * 3);
+
+        glGenTextures(2, m_textureIds);
+        for (const GLuint textureId : m_textureIds)
+        {
+            glBindTexture(GL_TEXTURE_2D, textureId);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, m_textureSize, m_textureSize, 0, GL_RGB, GL_UNSIGNED_BYTE, m_pixels.data());
+        }
+        glEnable(GL_TEXTURE_2D);
+        glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+    }
+
+    void draw()
+    {
+        m_frame++;
+        for (std::size_t i = 0; i < m_pixels.size(); i++)
+        {
+            m_pixels[i] = static_cast<uint8_t>(i + m_frame);
+        }
+
+        glClear(GL_COLOR_BUFFER_BIT);
+        // Full update of the first texture
+        glBindTexture(GL_TEXTURE_2D, m_textureIds[0]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, m_textureSize, m_textureSize, 0, GL_RGB, GL_UNSIGNED_BYTE, m_pixels.data());
+        drawQuad(0.0f);
+        // Partial update of a moving region of the second texture
+        const std::size_t regionSize = m_textureSize / 4;
+        const std::size_t offset = (m_frame * 8) % (m_textureSize - regionSize);
+        glBindTexture(GL_TEXTURE_2D, m_textureIds[1]);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, offset, offset, regionSize, regionSize, GL_RGB, GL_UNSIGNED_BYTE, m_pixels.data());
+        drawQuad(1.0f);
+    }
+
+private:
+    void drawQuad(const float x)
+    {
+        glBegin(GL_QUADS);
+        glTexCoord2f(0.0f, 0.0f);
+        glVertex2f(x, 0.0f);
+        glTexCoord2f(1.0f, 0.0f);
+        glVertex2f(x + 1.0f, 0.0f);
+        glTexCoord2f(1.0f, 1.0f);
+        glVertex2f(x + 1.0f, 1.0f);
+        glTexCoord2f(0.0f, 1.0f);
+        glVertex2f(x, 1.0f);
+        glEnd();
+    }
+
+    GLuint m_textureIds[2] {};
+    std::size_t m_textureSize { 0 };
+    std::size_t m_frame { 0 };
+    std::vector<uint8_t> m_pixels {};
+};
+
+#endif // TEXTURE_UPLOAD_HPP_
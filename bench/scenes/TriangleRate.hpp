@@ -0,0 +1,89 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef TRIANGLE_RATE_HPP_
+#define TRIANGLE_RATE_HPP_
+
+#include "gl.h"
+#include <cstdint>
+#include <vector>
+
+/// @brief Draws a rotating grid of many small, vertex colored triangles
+class TriangleRate
+{
+public:
+    void init(const uint32_t resolutionW, const uint32_t resolutionH)
+    {
+        glViewport(0, 0, resolutionW, resolutionH);
+        glMatrixMode(GL_PROJECTION);
+        glLoadIdentity();
+        glOrtho(-1.0, 1.0, -1.0, 1.0, -1.0, 1.0);
+        glEnable(GL_DEPTH_TEST);
+        glDepthMask(GL_TRUE);
+
+        for (std::size_t y = 0; y <= GRID_SIZE; y++)
+        {
+            for (std::size_t x = 0; x <= GRID_SIZE; x++)
+            {
+                m_vertices.push_back((static_cast<float>(x) / GRID_SIZE) - 0.5f);
+                m_vertices.push_back((static_cast<float>(y) / GRID_SIZE) - 0.5f);
+                m_vertices.push_back(0.0f);
+                m_colors.push_back(static_cast<float>(x) / GRID_SIZE);
+                m_colors.push_back(static_cast<float>(y) / GRID_SIZE);
+                m_colors.push_back(0.5f);
+            }
+        }
+        for (std::size_t y = 0; y < GRID_SIZE; y++)
+        {
+            for (std::size_t x = 0; x < GRID_SIZE; x++)
+            {
+                const uint16_t i = static_cast<uint16_t>((y * (GRID_SIZE + 1)) + x);
+                const uint16_t stride = static_cast<uint16_t>(GRID_SIZE + 1);
+                m_indices.insert(m_indices.end(), { i, static_cast<uint16_t>(i + 1), static_cast<uint16_t>(i + stride) });
+                m_indices.insert(m_indices.end(), { static_cast<uint16_t>(i + 1), static_cast<uint16_t>(i + stride + 1), static_cast<uint16_t>(i + stride) });
+            }
+        }
+    }
+
+    void draw()
+    {
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glMatrixMode(GL_MODELVIEW);
+        glLoadIdentity();
+        m_rotation += 1.0f;
+        glRotatef(m_rotation, 0.0f, 0.0f, 1.0f);
+        glScalef(1.6f, 1.6f, 1.0f);
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glVertexPointer(3, GL_FLOAT, 0, m_vertices.data());
+        glEnableClientState(GL_COLOR_ARRAY);
+        glColorPointer(3, GL_FLOAT, 0, m_colors.data());
+        glDrawElements(GL_TRIANGLES, m_indices.size(), GL_UNSIGNED_SHORT, m_indices.data());
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+    }
+
+private:
+    static constexpr std::size_t GRID_SIZE { 64 };
+
+    std::vector<float> m_vertices {};
+    std::vector<float> m_colors {};
+    std::vector<uint16_t> m_indices {};
+    float m_rotation { 0.0f };
+};
+
+#endif // TRIANGLE_RATE_HPP_
@@ -105,6 +105,9 @@ DEFINES += RIX_CORE_DEPTH_BUFFER_LOC=0x01A00000
 DEFINES += RIX_CORE_STENCIL_BUFFER_LOC=0x01900000
 DEFINES += RIX_CORE_THREADED_RASTERIZATION=true
 DEFINES += RIX_CORE_THREADED_RASTERIZATION_DISPLAY_LIST_SIZE=1048576
+DEFINES += RIX_CORE_THREADED_RASTERIZATION_DISPLAY_LIST_RING_DEPTH=2
+DEFINES += RIX_CORE_THREADED_RASTERIZATION_TEXTURE_UPLOAD_LIST_SIZE=1048576
+DEFINES += RIX_CORE_THREADED_RASTERIZATION_MAX_FRAMES_IN_FLIGHT=1
 DEFINES += RIX_CORE_ENABLE_VSYNC=false
 DEFINES += RIX_CORE_MAX_VBO_COUNT=256
 DEFINES += RIX_CORE_PERFORMANCE_MODE=true
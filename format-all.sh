@@ -8,6 +8,7 @@ declare -a files=(
     lib/threadrunner
     unittest/verilator/cpp
     unittest/software
+    bench
     example/minimal
     example/mipmap
     example/stencilShadow
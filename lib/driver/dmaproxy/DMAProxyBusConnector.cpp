@@ -1,135 +1,193 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2023 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
 #include "DMAProxyBusConnector.hpp"
 #include "kernel/dma-proxy/files/include/dma-proxy.h"
 
+#include <algorithm>
 #include <cstring>
-#include <errno.h>
-#include <fcntl.h>
-#include <pthread.h>
-#include <sched.h>
-#include <signal.h>
 #include <spdlog/spdlog.h>
 #include <stdint.h>
-#include <stdio.h>
 #include <stdlib.h>
 #include <sys/ioctl.h>
-#include <sys/mman.h>
-#include <sys/param.h>
-#include <sys/time.h>
-#include <time.h>
-#include <unistd.h>
 
 namespace rr
 {
 
-const std::size_t DMAProxyBusConnector::INVALID_BUFFER { BUFFER_SIZE + 1 };
+static_assert(TX_BUFFER_COUNT <= BUFFER_COUNT, "More tx buffers configured than provided by the driver");
+static_assert(RX_BUFFER_COUNT <= BUFFER_COUNT, "More rx buffers configured than provided by the driver");
 
 DMAProxyBusConnector::DMAProxyBusConnector()
+    : DMAProxyBusConnector { m_defaultDevice }
 {
-    const char* tx_channel_names[] = { "dma_proxy_tx" };
-    const char* rx_channel_names[] = { "dma_proxy_rx" };
+}
 
-    openChannel(m_txChannel, tx_channel_names);
-    openChannel(m_rxChannel, rx_channel_names);
+DMAProxyBusConnector::DMAProxyBusConnector(IDMAProxyDevice& device)
+    : m_device { device }
+{
+    static_assert(TX_BUFFER_COUNT > STAGING_BUFFER_COUNT, "Not enough tx buffers for the staging buffers");
+    m_stagingBufferBase = TX_BUFFER_COUNT - STAGING_BUFFER_COUNT;
+    openChannel(m_txChannel, "dma_proxy_tx", TX_BUFFER_COUNT);
+    openChannel(m_rxChannel, "dma_proxy_rx", RX_BUFFER_COUNT);
 }
 
-void DMAProxyBusConnector::openChannel(Channel& channel, const char* channelName[])
+DMAProxyBusConnector::DMAProxyBusConnector(IDMAProxyDevice& device, const std::size_t writeBufferSize)
+    : DMAProxyBusConnector { device }
+{
+    if (writeBufferSize <= BUFFER_SIZE)
+    {
+        return;
+    }
+    // The host memory of the write buffers is about the size of the channel buffers they replace.
+    // All channel buffers are then used as staging buffers.
+    const std::size_t channelBuffersPerWriteBuffer = (writeBufferSize + BUFFER_SIZE - 1) / BUFFER_SIZE;
+    const std::size_t writeBufferCount = (std::max)(std::size_t { 2 }, (TX_BUFFER_COUNT - STAGING_BUFFER_COUNT) / channelBuffersPerWriteBuffer);
+    m_scatterBuffers.assign(writeBufferCount, std::vector<uint8_t>(writeBufferSize));
+    m_stagingBufferBase = 0;
+    m_stagingBufferCount = TX_BUFFER_COUNT;
+}
+
+void DMAProxyBusConnector::openChannel(Channel& channel, const char* channelName, const std::size_t bufferCount)
 {
     char channel_name[64] = "/dev/";
-    strcat(channel_name, channelName[0]);
-    channel.fd = open(channel_name, O_RDWR);
+    strcat(channel_name, channelName);
+    channel.fd = m_device.open(channel_name);
     if (channel.fd < 1)
     {
         SPDLOG_ERROR("Unable to open DMA proxy device file: {}", channel_name);
         exit(EXIT_FAILURE);
     }
-    channel.buf_ptr = reinterpret_cast<struct channel_buffer*>(mmap(NULL, sizeof(channel_buffer) * BUFFER_COUNT,
-        PROT_READ | PROT_WRITE, MAP_SHARED, channel.fd, 0));
-    if (channel.buf_ptr == MAP_FAILED)
+    channel.buf_ptr = m_device.map(channel.fd, BUFFER_COUNT);
+    if (channel.buf_ptr == nullptr)
     {
         SPDLOG_ERROR("Failed to mmap channel");
         exit(EXIT_FAILURE);
     }
+    channel.bufferCount = bufferCount;
+    channel.inFlight.assign(bufferCount, false);
+}
+
+void DMAProxyBusConnector::closeChannel(Channel& channel)
+{
+    m_device.unmap(channel.buf_ptr, BUFFER_COUNT);
+    m_device.close(channel.fd);
 }
 
 DMAProxyBusConnector::~DMAProxyBusConnector()
 {
     blockUntilTransferIsComplete();
+    closeChannel(m_txChannel);
+    closeChannel(m_rxChannel);
 }
 
 void DMAProxyBusConnector::writeData(const uint8_t index, const uint32_t size, const uint32_t offset)
 {
-    if (index >= TX_BUFFER_COUNT)
+    if (index >= getWriteBufferCount())
     {
         SPDLOG_ERROR("Index {} out of bounds.", index);
         return;
     }
-    if (offset != 0)
+    const std::size_t bufferSize = isScattered() ? m_scatterBuffers[index].size() : BUFFER_SIZE;
+    if ((static_cast<std::size_t>(offset) + size) > bufferSize)
     {
-        SPDLOG_WARN("DMAProxyBusConnector does not support offsets in writeData(). Offset {} will be ignored.", offset);
+        SPDLOG_ERROR("Transfer of {} bytes with offset {} exceeds the buffer size.", size, offset);
+        return;
     }
-    blockUntilTransferIsComplete();
-    int buffer_id = index;
-    m_txChannel.buf_ptr[buffer_id].length = size;
-    ioctl(m_txChannel.fd, START_XFER, &buffer_id);
-    if (m_txChannel.buf_ptr[buffer_id].status != channel_buffer::proxy_status::PROXY_NO_ERROR)
+    if (isScattered())
+    {
+        writeStaged(m_scatterBuffers[index].data() + offset, size);
+        return;
+    }
+    if (offset == 0)
     {
-        SPDLOG_ERROR("Proxy tx transfer error");
+        submitTransfer(m_txChannel, index, size);
+        return;
     }
-    m_busyBufferId = index;
-    m_busyChannel = m_txChannel;
+    // The dma-proxy always transfers from the start of a channel buffer. Copy the data into a staging buffer.
+    writeStaged(reinterpret_cast<const uint8_t*>(&m_txChannel.buf_ptr[index].buffer[0]) + offset, size);
 }
 
-void DMAProxyBusConnector::readData(const uint8_t index, const uint32_t size)
+void DMAProxyBusConnector::writeStaged(const uint8_t* data, const uint32_t size)
 {
-    if (index >= RX_BUFFER_COUNT)
+    for (uint32_t i = 0; i < size; i += BUFFER_SIZE)
     {
-        SPDLOG_ERROR("Index {} out of bounds.", index);
-        return;
+        const uint32_t chunkSize = (std::min)(static_cast<uint32_t>(BUFFER_SIZE), size - i);
+        const int32_t stagingBufferId = acquireStagingBuffer();
+        std::memcpy(&m_txChannel.buf_ptr[stagingBufferId].buffer[0], data + i, chunkSize);
+        submitTransfer(m_txChannel, stagingBufferId, chunkSize);
     }
-    blockUntilTransferIsComplete();
-    int buffer_id = index;
-    m_rxChannel.buf_ptr[buffer_id].length = size;
-    ioctl(m_rxChannel.fd, START_XFER, &buffer_id);
-    if (m_rxChannel.buf_ptr[buffer_id].status != channel_buffer::proxy_status::PROXY_NO_ERROR)
+}
+
+void DMAProxyBusConnector::readData(const uint8_t index, const uint32_t size)
+{
+    if (index >= getReadBufferCount())
     {
-        SPDLOG_ERROR("Proxy rx transfer error 0x{:X}", m_rxChannel.buf_ptr[buffer_id].status);
+        SPDLOG_ERROR("Index {} out of bounds.", index);
         return;
     }
-    blockUntilTransferIsComplete();
-    m_busyBufferId = index;
-    m_busyChannel = m_rxChannel;
+    // The transfer is completed when the buffer is requested
+    submitTransfer(m_rxChannel, index, size);
 }
 
 void DMAProxyBusConnector::blockUntilTransferIsComplete()
 {
-    waitForDma();
+    while (!m_transfersInFlight.empty())
+    {
+        completeOldestTransfer();
+    }
 }
 
 tcb::span<uint8_t> DMAProxyBusConnector::requestWriteBuffer(const uint8_t index)
 {
-    if (index >= TX_BUFFER_COUNT)
+    if (index >= getWriteBufferCount())
     {
         SPDLOG_ERROR("Index {} out of bounds.", index);
         return {};
     }
+    if (isScattered())
+    {
+        // The data was already copied into the staging buffers
+        return { m_scatterBuffers[index] };
+    }
+    // The buffer is handed out for writing. It must not be changed while it is transferred.
+    completeTransfer(m_txChannel, index);
     SPDLOG_DEBUG("Requested memory for index {} with size {}", index, BUFFER_SIZE);
     return { reinterpret_cast<uint8_t*>(&m_txChannel.buf_ptr[index].buffer[0]), BUFFER_SIZE };
 }
 
 tcb::span<uint8_t> DMAProxyBusConnector::requestReadBuffer(const uint8_t index)
 {
-    if (index >= RX_BUFFER_COUNT)
+    if (index >= getReadBufferCount())
     {
         SPDLOG_ERROR("Index {} out of bounds.", index);
         return {};
     }
+    completeTransfer(m_rxChannel, index);
     SPDLOG_DEBUG("Requested memory for index {} with size {}", index, BUFFER_SIZE);
     return { reinterpret_cast<uint8_t*>(&m_rxChannel.buf_ptr[index].buffer[0]), BUFFER_SIZE };
 }
 
 uint8_t DMAProxyBusConnector::getWriteBufferCount() const
 {
-    return TX_BUFFER_COUNT;
+    if (isScattered())
+    {
+        return static_cast<uint8_t>(m_scatterBuffers.size());
+    }
+    return TX_BUFFER_COUNT - STAGING_BUFFER_COUNT;
 }
 
 uint8_t DMAProxyBusConnector::getReadBufferCount() const
@@ -137,16 +195,47 @@ uint8_t DMAProxyBusConnector::getReadBufferCount() const
     return RX_BUFFER_COUNT;
 }
 
-void DMAProxyBusConnector::waitForDma()
+void DMAProxyBusConnector::submitTransfer(Channel& channel, const int32_t bufferId, const uint32_t size)
 {
-    if (m_busyBufferId == INVALID_BUFFER)
+    // A channel buffer can only be submitted once. Wait until a previous transfer of this buffer is done.
+    completeTransfer(channel, bufferId);
+    channel.buf_ptr[bufferId].length = size;
+    if (m_device.ioctl(channel.fd, START_XFER, bufferId) != 0)
+    {
+        SPDLOG_ERROR("Failed to start transfer of buffer {}", bufferId);
         return;
-    ioctl(m_busyChannel.fd, FINISH_XFER, &m_busyBufferId);
-    if (m_busyChannel.buf_ptr[m_busyBufferId].status != channel_buffer::proxy_status::PROXY_NO_ERROR)
+    }
+    channel.inFlight[bufferId] = true;
+    m_transfersInFlight.push_back({ &channel, bufferId });
+}
+
+void DMAProxyBusConnector::completeOldestTransfer()
+{
+    const Transfer transfer = m_transfersInFlight.front();
+    m_transfersInFlight.pop_front();
+    m_device.ioctl(transfer.channel->fd, FINISH_XFER, transfer.bufferId);
+    if (transfer.channel->buf_ptr[transfer.bufferId].status != channel_buffer::proxy_status::PROXY_NO_ERROR)
+    {
+        SPDLOG_ERROR("wait for dma error 0x{:X}", transfer.channel->buf_ptr[transfer.bufferId].status);
+    }
+    transfer.channel->inFlight[transfer.bufferId] = false;
+}
+
+void DMAProxyBusConnector::completeTransfer(const Channel& channel, const int32_t bufferId)
+{
+    // The DMA processes the transfers in submission order. Complete all transfers up to the requested one.
+    while (channel.inFlight[bufferId])
     {
-        SPDLOG_ERROR("wait for dma error 0x{:X}", m_busyChannel.buf_ptr[m_busyBufferId].status);
+        completeOldestTransfer();
     }
-    m_busyBufferId = INVALID_BUFFER;
 }
 
-} // namespace rr
\ No newline at end of file
+int32_t DMAProxyBusConnector::acquireStagingBuffer()
+{
+    const int32_t bufferId = m_stagingBufferBase + m_nextStagingBuffer;
+    m_nextStagingBuffer = (m_nextStagingBuffer + 1) % m_stagingBufferCount;
+    completeTransfer(m_txChannel, bufferId);
+    return bufferId;
+}
+
+} // namespace rr
@@ -18,18 +18,38 @@
 #ifndef DMAPROXYBUSCONNECTOR_HPP
 #define DMAPROXYBUSCONNECTOR_HPP
 
+#include "DMAProxyDevice.hpp"
 #include "IBusConnector.hpp"
-#include <atomic>
+#include "IDMAProxyDevice.hpp"
+#include <deque>
+#include <vector>
 
 struct channel_buffer;
 namespace rr
 {
+
+/// @brief Bus connector for the dma-proxy kernel module (Zynq).
+/// @details Transfers are submitted to the DMA without waiting for their completion (START_XFER) and are
+///     completed in submission order (FINISH_XFER) when a buffer in flight is required again. This allows to fill
+///     a buffer while other buffers are transferred. Transfers with an offset are copied into a ring of staging
+///     buffers, because the dma-proxy always transfers from the start of a channel buffer.
+///     Reads are queued as well and are completed when the read buffer is requested.
+///     Write buffers which are larger than a channel buffer are located in the host memory. They are scattered
+///     across the channel buffers when they are written.
 class DMAProxyBusConnector : public IBusConnector
 {
 public:
     virtual ~DMAProxyBusConnector();
 
     DMAProxyBusConnector();
+    DMAProxyBusConnector(IDMAProxyDevice& device);
+
+    /// @brief Creates a bus connector with write buffers of a custom size
+    /// @param device The dma-proxy device
+    /// @param writeBufferSize The size of a write buffer. Write buffers larger than a channel buffer (BUFFER_SIZE)
+    ///     are copied into the channel buffers in BUFFER_SIZE pieces when they are written. This allows display
+    ///     lists which are larger than a channel buffer at the cost of a copy.
+    DMAProxyBusConnector(IDMAProxyDevice& device, const std::size_t writeBufferSize);
 
     virtual void writeData(const uint8_t index, const uint32_t size, const uint32_t offset) override;
     virtual void readData(const uint8_t index, const uint32_t size) override;
@@ -38,24 +58,49 @@ public:
     virtual tcb::span<uint8_t> requestReadBuffer(const uint8_t index) override;
     virtual uint8_t getWriteBufferCount() const override;
     virtual uint8_t getReadBufferCount() const override;
+    virtual bool queuesTransfers() const override { return true; }
+
+    /// @brief Returns the number of transfers which are submitted but not yet completed
+    std::size_t getTransfersInFlight() const { return m_transfersInFlight.size(); }
 
 private:
     struct Channel
     {
         struct channel_buffer* buf_ptr;
         int fd;
+        std::size_t bufferCount;
+        std::vector<bool> inFlight;
+    };
+
+    struct Transfer
+    {
+        Channel* channel;
+        int32_t bufferId;
     };
 
-    void waitForDma();
-    void openChannel(Channel& channel, const char* channelName[]);
+    void openChannel(Channel& channel, const char* channelName, const std::size_t bufferCount);
+    void closeChannel(Channel& channel);
+    void submitTransfer(Channel& channel, const int32_t bufferId, const uint32_t size);
+    void completeOldestTransfer();
+    void completeTransfer(const Channel& channel, const int32_t bufferId);
+    int32_t acquireStagingBuffer();
+    void writeStaged(const uint8_t* data, const uint32_t size);
+    bool isScattered() const { return !m_scatterBuffers.empty(); }
 
-    static const std::size_t INVALID_BUFFER;
-    Channel m_txChannel;
-    Channel m_rxChannel;
+    // The last tx buffers are reserved for transfers with an offset
+    static constexpr std::size_t STAGING_BUFFER_COUNT { 4 };
 
-    std::size_t m_busyBufferId { INVALID_BUFFER };
-    Channel m_busyChannel {};
+    DMAProxyDevice m_defaultDevice {};
+    IDMAProxyDevice& m_device;
+    Channel m_txChannel {};
+    Channel m_rxChannel {};
+    std::deque<Transfer> m_transfersInFlight {};
+    std::size_t m_stagingBufferBase { 0 };
+    std::size_t m_stagingBufferCount { STAGING_BUFFER_COUNT };
+    std::size_t m_nextStagingBuffer { 0 };
+    // Write buffers in the host memory when the write buffers are larger than a channel buffer
+    std::vector<std::vector<uint8_t>> m_scatterBuffers {};
 };
 
 } // namespace rr
-#endif // #ifndef DMAPROXYBUSCONNECTOR_HPP
\ No newline at end of file
+#endif // #ifndef DMAPROXYBUSCONNECTOR_HPP
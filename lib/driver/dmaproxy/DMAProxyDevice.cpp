@@ -0,0 +1,59 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "DMAProxyDevice.hpp"
+#include "kernel/dma-proxy/files/include/dma-proxy.h"
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace rr
+{
+
+int DMAProxyDevice::open(const char* path)
+{
+    return ::open(path, O_RDWR);
+}
+
+void DMAProxyDevice::close(const int fd)
+{
+    ::close(fd);
+}
+
+channel_buffer* DMAProxyDevice::map(const int fd, const std::size_t count)
+{
+    void* buffers = mmap(NULL, sizeof(channel_buffer) * count, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (buffers == MAP_FAILED)
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<channel_buffer*>(buffers);
+}
+
+void DMAProxyDevice::unmap(channel_buffer* buffers, const std::size_t count)
+{
+    munmap(buffers, sizeof(channel_buffer) * count);
+}
+
+int DMAProxyDevice::ioctl(const int fd, const unsigned long request, int32_t bufferId)
+{
+    return ::ioctl(fd, request, &bufferId);
+}
+
+} // namespace rr
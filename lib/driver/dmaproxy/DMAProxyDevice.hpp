@@ -0,0 +1,38 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef DMAPROXYDEVICE_HPP
+#define DMAPROXYDEVICE_HPP
+
+#include "IDMAProxyDevice.hpp"
+
+namespace rr
+{
+
+/// @brief Accesses the char devices of the dma-proxy kernel module via the linux system calls
+class DMAProxyDevice : public IDMAProxyDevice
+{
+public:
+    virtual int open(const char* path) override;
+    virtual void close(const int fd) override;
+    virtual channel_buffer* map(const int fd, const std::size_t count) override;
+    virtual void unmap(channel_buffer* buffers, const std::size_t count) override;
+    virtual int ioctl(const int fd, const unsigned long request, int32_t bufferId) override;
+};
+
+} // namespace rr
+#endif // DMAPROXYDEVICE_HPP
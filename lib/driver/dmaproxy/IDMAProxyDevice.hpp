@@ -0,0 +1,65 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef IDMAPROXYDEVICE_HPP
+#define IDMAPROXYDEVICE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+struct channel_buffer;
+namespace rr
+{
+
+/// @brief Access to the char devices of the dma-proxy kernel module.
+/// @details Decouples the DMAProxyBusConnector from the operating system. This allows to test the connector
+///     with a mocked char device.
+class IDMAProxyDevice
+{
+public:
+    virtual ~IDMAProxyDevice() = default;
+
+    /// @brief Opens a channel of the dma-proxy
+    /// @param path The path of the channel, for instance /dev/dma_proxy_tx
+    /// @return The file descriptor of the channel, or a negative value on error
+    virtual int open(const char* path) = 0;
+
+    /// @brief Closes a channel
+    /// @param fd The file descriptor of the channel
+    virtual void close(const int fd) = 0;
+
+    /// @brief Maps the channel buffers of a channel
+    /// @param fd The file descriptor of the channel
+    /// @param count The number of channel buffers to map
+    /// @return The mapped channel buffers, or a nullptr on error
+    virtual channel_buffer* map(const int fd, const std::size_t count) = 0;
+
+    /// @brief Unmaps the channel buffers of a channel
+    /// @param buffers The mapped channel buffers
+    /// @param count The number of mapped channel buffers
+    virtual void unmap(channel_buffer* buffers, const std::size_t count) = 0;
+
+    /// @brief Executes a START_XFER, FINISH_XFER or XFER request on a channel buffer
+    /// @param fd The file descriptor of the channel
+    /// @param request The request
+    /// @param bufferId The id of the channel buffer
+    /// @return 0 on success
+    virtual int ioctl(const int fd, const unsigned long request, int32_t bufferId) = 0;
+};
+
+} // namespace rr
+#endif // IDMAPROXYDEVICE_HPP
@@ -1,46 +1,147 @@
 #include "FT60XBusConnector.hpp"
+#include <spdlog/spdlog.h>
 
 namespace rr
 {
 FT60XBusConnector::~FT60XBusConnector()
 {
-    FT_Close(fthandle);
+    blockUntilTransferIsComplete();
+    m_device.close();
 }
 
-FT60XBusConnector::FT60XBusConnector()
+FT60XBusConnector::FT60XBusConnector(IFT60XDevice& device)
+    : m_device { device }
 {
-    FT_STATUS ftStatus = FT_OK;
-    ftStatus = FT_Create(0, FT_OPEN_BY_INDEX, &fthandle);
-    if (!fthandle)
+    m_open = m_device.open();
+}
+
+FT60XBusConnector::FT60XBusConnector(std::unique_ptr<IFT60XDevice> device)
+    : m_defaultDevice { std::move(device) }
+    , m_device { *m_defaultDevice }
+{
+    m_open = m_device.open();
+}
+
+void FT60XBusConnector::writeData(const uint8_t index, const uint32_t size, const uint32_t offset)
+{
+    if (index >= getWriteBufferCount())
     {
-        printf("Failed to create device\r\n");
+        SPDLOG_ERROR("Index {} out of bounds.", index);
         return;
     }
+    if ((static_cast<std::size_t>(offset) + size) > m_dlMemTx[index].size())
+    {
+        SPDLOG_ERROR("Transfer of {} bytes with offset {} exceeds the buffer size.", size, offset);
+        return;
+    }
+    submitTransfer(false, index, m_dlMemTx[index].data() + offset, size);
+}
 
-    ftStatus = FT_EnableGPIO(fthandle, 0x3, 0x3); // bit 0 and 1 both set.
-    ftStatus = FT_SetGPIOPull(fthandle, 0x3, 0x2);
+void FT60XBusConnector::readData(const uint8_t index, const uint32_t size)
+{
+    if (index >= getReadBufferCount())
+    {
+        SPDLOG_ERROR("Index {} out of bounds.", index);
+        return;
+    }
+    if (size > m_dlMemRx[index].size())
+    {
+        SPDLOG_ERROR("Read of {} bytes exceeds the buffer size.", size);
+        return;
+    }
+    // The buffer must not be read by the host while the device writes into it
+    while (m_readsInFlight[index] != 0)
+    {
+        completeOldestTransfer();
+    }
+    // The transfer is completed when the buffer is requested
+    submitTransfer(true, index, m_dlMemRx[index].data(), size);
+}
 
-    ftStatus = FT_WriteGPIO(fthandle, 0x3, 0x0);
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    ftStatus = FT_WriteGPIO(fthandle, 0x3, 0x3);
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    ftStatus = FT_WriteGPIO(fthandle, 0x3, 0x0);
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+void FT60XBusConnector::blockUntilTransferIsComplete()
+{
+    while (!m_transfersInFlight.empty())
+    {
+        completeOldestTransfer();
+    }
 }
 
-void FT60XBusConnector::writeData(const uint8_t index, const uint32_t size, const uint32_t offset)
+tcb::span<uint8_t> FT60XBusConnector::requestWriteBuffer(const uint8_t index)
+{
+    if (index >= getWriteBufferCount())
+    {
+        SPDLOG_ERROR("Index {} out of bounds.", index);
+        return {};
+    }
+    // The buffer is handed out for writing. It must not be changed while it is transferred.
+    while (m_writesInFlight[index] != 0)
+    {
+        completeOldestTransfer();
+    }
+    return GenericMemoryBusConnector::requestWriteBuffer(index);
+}
+
+tcb::span<uint8_t> FT60XBusConnector::requestReadBuffer(const uint8_t index)
 {
-    ULONG transferred;
-    FT_WritePipe(fthandle, 0x2, (PUCHAR)(this->m_dlMemTx[index].data() + offset), size, &transferred, NULL);
+    if (index >= getReadBufferCount())
+    {
+        SPDLOG_ERROR("Index {} out of bounds.", index);
+        return {};
+    }
+    while (m_readsInFlight[index] != 0)
+    {
+        completeOldestTransfer();
+    }
+    return GenericMemoryBusConnector::requestReadBuffer(index);
 }
 
-void FT60XBusConnector::readData(const uint8_t, const uint32_t)
+void FT60XBusConnector::submitTransfer(const bool read, const uint8_t index, uint8_t* data, const uint32_t size)
 {
-    // TODO: Implement
+    if (!m_open)
+    {
+        return;
+    }
+    if (m_transfersInFlight.size() == IFT60XDevice::MAX_TRANSFERS_IN_FLIGHT)
+    {
+        completeOldestTransfer();
+    }
+    // The transfers are completed in submission order. The slot after the newest transfer is always free.
+    const std::size_t slot = m_nextSlot;
+    const bool queued = read ? m_device.readPipeAsync(slot, data, size) : m_device.writePipeAsync(slot, data, size);
+    if (!queued)
+    {
+        SPDLOG_ERROR("Failed to queue a {} of {} bytes", read ? "read" : "write", size);
+        return;
+    }
+    m_nextSlot = (m_nextSlot + 1) % IFT60XDevice::MAX_TRANSFERS_IN_FLIGHT;
+    m_transfersInFlight.push_back({ read, index, slot, size });
+    if (read)
+    {
+        m_readsInFlight[index]++;
+    }
+    else
+    {
+        m_writesInFlight[index]++;
+    }
 }
 
-void FT60XBusConnector::blockUntilTransferIsComplete()
+void FT60XBusConnector::completeOldestTransfer()
 {
+    const Transfer transfer = m_transfersInFlight.front();
+    m_transfersInFlight.pop_front();
+    const int64_t transferred = m_device.waitForTransfer(transfer.slot);
+    if (transferred != transfer.size)
+    {
+        SPDLOG_ERROR("{} of {} bytes failed. Transferred {} bytes.", transfer.read ? "Read" : "Write", transfer.size, transferred);
+    }
+    if (transfer.read)
+    {
+        m_readsInFlight[transfer.index]--;
+    }
+    else
+    {
+        m_writesInFlight[transfer.index]--;
+    }
 }
 
-} // namespace rr
\ No newline at end of file
+} // namespace rr
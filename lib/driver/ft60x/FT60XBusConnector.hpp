@@ -1,32 +1,64 @@
 #ifndef FT60XBUSCONNECTOR_H
 #define FT60XBUSCONNECTOR_H
 
-#include <chrono>
-#include <thread>
-
 #include "GenericMemoryBusConnector.hpp"
-#include <ftd3xx.h>
-
-#include <stdio.h>
+#include "IFT60XDevice.hpp"
+#include <array>
+#include <deque>
+#include <memory>
 
 namespace rr
 {
 // Bus connector to use an FT600 chip configured in the FT245 FIFO mode.
 // Important: Before you use this class, configure the FT600 in the FT245 FIFO mode with FT60X Chip Configuration Programmer. Otherwise, it will not work.
 // This class uses GPIO0 to reset the FPGA
+//
+// Transfers are queued as overlapped transfers without waiting for their completion. Up to
+// IFT60XDevice::MAX_TRANSFERS_IN_FLIGHT transfers are in flight, which keeps the USB busy while the next display
+// list is filled. The transfers are completed in submission order when the limit is reached or when a buffer in
+// flight is requested again.
 class FT60XBusConnector : public GenericMemoryBusConnector<11, 8 * 1024 * 1024>
 {
 public:
     virtual ~FT60XBusConnector();
 
+    /// @brief Opens the first FT60X with the FTD3XX library
     FT60XBusConnector();
 
+    /// @brief Accesses the FT60X via device
+    FT60XBusConnector(IFT60XDevice& device);
+
     virtual void writeData(const uint8_t index, const uint32_t size, const uint32_t offset) override;
     virtual void readData(const uint8_t index, const uint32_t size) override;
     virtual void blockUntilTransferIsComplete() override;
+    virtual tcb::span<uint8_t> requestWriteBuffer(const uint8_t index) override;
+    virtual tcb::span<uint8_t> requestReadBuffer(const uint8_t index) override;
+    virtual bool queuesTransfers() const override { return true; }
+
+    /// @brief Returns the number of transfers which are queued but not yet completed
+    std::size_t getTransfersInFlight() const { return m_transfersInFlight.size(); }
 
 private:
-    FT_HANDLE fthandle;
+    struct Transfer
+    {
+        bool read;
+        uint8_t index;
+        std::size_t slot;
+        uint32_t size;
+    };
+
+    FT60XBusConnector(std::unique_ptr<IFT60XDevice> device);
+
+    void submitTransfer(const bool read, const uint8_t index, uint8_t* data, const uint32_t size);
+    void completeOldestTransfer();
+
+    std::unique_ptr<IFT60XDevice> m_defaultDevice {};
+    IFT60XDevice& m_device;
+    bool m_open { false };
+    std::deque<Transfer> m_transfersInFlight {};
+    std::size_t m_nextSlot { 0 };
+    std::array<std::size_t, std::tuple_size<decltype(m_dlMemTx)>::value> m_writesInFlight {};
+    std::array<std::size_t, std::tuple_size<decltype(m_dlMemRx)>::value> m_readsInFlight {};
 };
 
 } // namespace rr
@@ -0,0 +1,121 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "FT60XDevice.hpp"
+#include "FT60XBusConnector.hpp"
+#include <chrono>
+#include <spdlog/spdlog.h>
+#include <thread>
+
+namespace rr
+{
+
+// The default constructor of the connector lives here, so that the connector itself can be built without the
+// FTD3XX library
+FT60XBusConnector::FT60XBusConnector()
+    : FT60XBusConnector { std::make_unique<FT60XDevice>() }
+{
+}
+
+FT60XDevice::~FT60XDevice()
+{
+    close();
+}
+
+bool FT60XDevice::open()
+{
+    if ((FT_Create(0, FT_OPEN_BY_INDEX, &m_handle) != FT_OK) || !m_handle)
+    {
+        SPDLOG_ERROR("Failed to create device");
+        m_handle = nullptr;
+        return false;
+    }
+
+    FT_EnableGPIO(m_handle, 0x3, 0x3); // bit 0 and 1 both set.
+    FT_SetGPIOPull(m_handle, 0x3, 0x2);
+
+    FT_WriteGPIO(m_handle, 0x3, 0x0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    FT_WriteGPIO(m_handle, 0x3, 0x3);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    FT_WriteGPIO(m_handle, 0x3, 0x0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    for (OVERLAPPED& overlapped : m_overlapped)
+    {
+        if (FT_InitializeOverlapped(m_handle, &overlapped) != FT_OK)
+        {
+            SPDLOG_ERROR("Failed to initialize the overlapped transfers");
+            close();
+            return false;
+        }
+        m_initializedOverlapped++;
+    }
+    return true;
+}
+
+void FT60XDevice::close()
+{
+    if (!m_handle)
+    {
+        return;
+    }
+    FT_AbortPipe(m_handle, OUT_PIPE);
+    FT_AbortPipe(m_handle, IN_PIPE);
+    for (std::size_t i = 0; i < m_initializedOverlapped; i++)
+    {
+        FT_ReleaseOverlapped(m_handle, &m_overlapped[i]);
+    }
+    m_initializedOverlapped = 0;
+    FT_Close(m_handle);
+    m_handle = nullptr;
+}
+
+bool FT60XDevice::writePipeAsync(const std::size_t slot, const uint8_t* data, const uint32_t size)
+{
+    ULONG transferred { 0 };
+#if defined(_WIN32)
+    const FT_STATUS status = FT_WritePipeEx(m_handle, OUT_PIPE, const_cast<PUCHAR>(data), size, &transferred, &m_overlapped[slot]);
+#else
+    // The *Ex functions of this library are blocking and take a timeout instead of an OVERLAPPED
+    const FT_STATUS status = FT_WritePipeAsync(m_handle, FIFO, const_cast<PUCHAR>(data), size, &transferred, &m_overlapped[slot]);
+#endif
+    return (status == FT_IO_PENDING) || (status == FT_OK);
+}
+
+bool FT60XDevice::readPipeAsync(const std::size_t slot, uint8_t* data, const uint32_t size)
+{
+    ULONG transferred { 0 };
+#if defined(_WIN32)
+    const FT_STATUS status = FT_ReadPipeEx(m_handle, IN_PIPE, data, size, &transferred, &m_overlapped[slot]);
+#else
+    const FT_STATUS status = FT_ReadPipeAsync(m_handle, FIFO, data, size, &transferred, &m_overlapped[slot]);
+#endif
+    return (status == FT_IO_PENDING) || (status == FT_OK);
+}
+
+int64_t FT60XDevice::waitForTransfer(const std::size_t slot)
+{
+    ULONG transferred { 0 };
+    if (FT_GetOverlappedResult(m_handle, &m_overlapped[slot], &transferred, TRUE) != FT_OK)
+    {
+        return -1;
+    }
+    return transferred;
+}
+
+} // namespace rr
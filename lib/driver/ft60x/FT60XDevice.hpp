@@ -0,0 +1,57 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef FT60XDEVICE_HPP
+#define FT60XDEVICE_HPP
+
+#include "IFT60XDevice.hpp"
+#include <array>
+#include <ftd3xx.h>
+
+namespace rr
+{
+
+/// @brief Accesses a FT60X in the FT245 FIFO mode with the FTD3XX library.
+/// The transfers use FT_WritePipeEx and FT_ReadPipeEx on Windows and FT_WritePipeAsync and FT_ReadPipeAsync on Linux
+/// and macOS.
+class FT60XDevice : public IFT60XDevice
+{
+public:
+    virtual ~FT60XDevice();
+
+    virtual bool open() override;
+    virtual void close() override;
+    virtual bool writePipeAsync(const std::size_t slot, const uint8_t* data, const uint32_t size) override;
+    virtual bool readPipeAsync(const std::size_t slot, uint8_t* data, const uint32_t size) override;
+    virtual int64_t waitForTransfer(const std::size_t slot) override;
+
+private:
+    // Pipes of the first channel in the FT245 FIFO mode
+    static constexpr UCHAR OUT_PIPE { 0x02 };
+    static constexpr UCHAR IN_PIPE { 0x82 };
+#if !defined(_WIN32)
+    // The asynchronous transfers of the Linux and macOS library address the channel by its FIFO index
+    static constexpr UCHAR FIFO { 0 };
+#endif
+
+    FT_HANDLE m_handle { nullptr };
+    std::array<OVERLAPPED, MAX_TRANSFERS_IN_FLIGHT> m_overlapped {};
+    std::size_t m_initializedOverlapped { 0 };
+};
+
+} // namespace rr
+#endif // FT60XDEVICE_HPP
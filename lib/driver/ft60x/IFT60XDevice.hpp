@@ -0,0 +1,66 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef IFT60XDEVICE_HPP
+#define IFT60XDEVICE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace rr
+{
+
+/// @brief The functions of the FTD3XX library which are used by the FT60XBusConnector
+/// @details Decouples the FT60XBusConnector from the FTD3XX library. This allows to test the queueing of the
+///     connector with a mocked device and to build it without the library. A transfer is tracked by one of
+///     MAX_TRANSFERS_IN_FLIGHT slots, which correspond to the OVERLAPPED structures of the library.
+class IFT60XDevice
+{
+public:
+    /// @brief Number of transfers which can be queued at the same time
+    static constexpr std::size_t MAX_TRANSFERS_IN_FLIGHT { 4 };
+
+    virtual ~IFT60XDevice() = default;
+
+    /// @brief Opens the first FT60X (FT_Create) and resets the FPGA via GPIO0 and GPIO1
+    /// @return false if the device can't be opened
+    virtual bool open() = 0;
+
+    /// @brief Closes the device (FT_Close). Transfers in flight are aborted.
+    virtual void close() = 0;
+
+    /// @brief Queues a write to the out pipe (FT_WritePipeEx with an OVERLAPPED) and returns without waiting
+    /// @param slot The slot which tracks the transfer. It must not be in use.
+    /// @param data The data to write. Must stay valid until the transfer is complete.
+    /// @param size The number of bytes to write
+    /// @return false if the transfer can't be queued
+    virtual bool writePipeAsync(const std::size_t slot, const uint8_t* data, const uint32_t size) = 0;
+
+    /// @brief Queues a read from the in pipe (FT_ReadPipeEx with an OVERLAPPED) and returns without waiting
+    /// @param slot The slot which tracks the transfer. It must not be in use.
+    /// @param data The buffer which receives the data. Must stay valid until the transfer is complete.
+    /// @param size The number of bytes to read
+    /// @return false if the transfer can't be queued
+    virtual bool readPipeAsync(const std::size_t slot, uint8_t* data, const uint32_t size) = 0;
+
+    /// @brief Waits until the transfer of a slot is complete (FT_GetOverlappedResult) and releases the slot
+    /// @return The number of transferred bytes, or a negative value on error
+    virtual int64_t waitForTransfer(const std::size_t slot) = 0;
+};
+
+} // namespace rr
+#endif // IFT60XDEVICE_HPP
@@ -0,0 +1,95 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// Hosts a device in its own process. A renderer connects with the SharedMemoryBusConnector and drives the device
+// with the DeviceDataUploader.
+// Usage: rixserver [shared memory name] [backend]
+// Backends:
+//   sw         The SoftwareRasterizer
+//   verilator  The Verilator simulation of the RasterIX (rixserver_verilator only)
+// The renderer must be built with the same RIX_CORE_* configuration as the server.
+
+#include "SharedMemoryBusConnector.hpp"
+#include "SharedMemoryBusServer.hpp"
+#include "SoftwareRasterizerBusConnector.hpp"
+#include "renderer/devicedatauploader/DeviceDataReceiver.hpp"
+#include "renderer/softwarerasterizer/SoftwareRasterizer.hpp"
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+
+#if RIX_SERVER_VERILATOR
+#include "VerilatorBusConnector.hpp"
+#endif
+
+using namespace rr;
+
+namespace
+{
+
+SharedMemoryBusServer* server { nullptr };
+
+void stopServer(int)
+{
+    server->stop();
+}
+
+int serve(IBusConnector& device, const char* name)
+{
+    static SharedMemoryBusServer sharedMemoryServer { device };
+    server = &sharedMemoryServer;
+    if (!sharedMemoryServer.open(name))
+    {
+        std::fprintf(stderr, "Cannot create %s\n", name);
+        return 1;
+    }
+    std::signal(SIGINT, stopServer);
+    std::signal(SIGTERM, stopServer);
+    std::printf("Serving %s\n", name);
+    sharedMemoryServer.serve();
+    sharedMemoryServer.close();
+
+    const SharedMemoryBusServer::Statistics statistics = sharedMemoryServer.getStatistics();
+    std::printf("Executed %zu transfers, %zu bytes written, %zu bytes read\n", statistics.transfers, statistics.bytesWritten, statistics.bytesRead);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const char* name = (argc > 1) ? argv[1] : SharedMemoryBusConnector::DEFAULT_NAME;
+    const char* backend = (argc > 2) ? argv[2] : "sw";
+
+    if (std::strcmp(backend, "sw") == 0)
+    {
+        // The color buffer stays in the device memory. The renderer reads it back via the bus.
+        static SoftwareRasterizerBusConnector<> busConnector {};
+        static softwarerasterizer::SoftwareRasterizer rasterizer { busConnector };
+        static devicedatauploader::DeviceDataReceiver receiver { rasterizer };
+        return serve(receiver, name);
+    }
+#if RIX_SERVER_VERILATOR
+    if (std::strcmp(backend, "verilator") == 0)
+    {
+        static VerilatorBusConnector<> busConnector { {}, RenderConfig::MAX_DISPLAY_WIDTH, RenderConfig::MAX_DISPLAY_HEIGHT };
+        return serve(busConnector, name);
+    }
+#endif
+    std::fprintf(stderr, "Unknown backend %s\n", backend);
+    return 1;
+}
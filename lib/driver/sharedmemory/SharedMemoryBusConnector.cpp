@@ -0,0 +1,207 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "SharedMemoryBusConnector.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <signal.h>
+#include <spdlog/spdlog.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace rr
+{
+using namespace sharedmemory;
+
+SharedMemoryBusConnector::~SharedMemoryBusConnector()
+{
+    disconnect();
+}
+
+bool SharedMemoryBusConnector::connect(const char* name)
+{
+    disconnect();
+
+    const int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0)
+    {
+        SPDLOG_ERROR("Cannot open the shared memory {}: {}", name, strerror(errno));
+        return false;
+    }
+    struct stat st {};
+    if ((fstat(fd, &st) != 0) || (static_cast<std::size_t>(st.st_size) < ChannelHeader::getHeaderSize()))
+    {
+        SPDLOG_ERROR("The shared memory {} is not initialized", name);
+        ::close(fd);
+        return false;
+    }
+    m_size = st.st_size;
+    void* memory = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED)
+    {
+        SPDLOG_ERROR("Cannot map the shared memory {}: {}", name, strerror(errno));
+        return false;
+    }
+    m_memory = static_cast<uint8_t*>(memory);
+    m_header = reinterpret_cast<ChannelHeader*>(m_memory);
+    m_serverLost = false;
+
+    if ((m_header->magic != ChannelHeader::MAGIC) || (m_header->version != ChannelHeader::VERSION) || (m_header->getSize() > m_size))
+    {
+        SPDLOG_ERROR("The shared memory {} is not a RasterIX bus", name);
+        unmap();
+        return false;
+    }
+    // The server sets the magic after the header
+    std::atomic_thread_fence(std::memory_order_acquire);
+    int32_t noClient = 0;
+    if (!m_header->clientPid.compare_exchange_strong(noClient, getpid()))
+    {
+        SPDLOG_ERROR("Another client (pid {}) is connected to {}", noClient, name);
+        unmap();
+        return false;
+    }
+
+    // Transfers of a previous client might still be executed
+    m_submitted = m_header->submitted.load();
+    waitForTransfer(m_submitted);
+    m_writeSequence.assign(m_header->writeBufferCount, m_submitted);
+    m_readSequence.assign(m_header->readBufferCount, m_submitted);
+    SPDLOG_INFO("Connected to {} with {} write buffers of {} bytes", name, m_header->writeBufferCount, m_header->writeBufferSize);
+    return isConnected();
+}
+
+void SharedMemoryBusConnector::disconnect()
+{
+    if (m_header == nullptr)
+    {
+        return;
+    }
+    if (isConnected())
+    {
+        waitForTransfer(submit({ Transfer::DISCONNECT, 0, 0, 0 }));
+    }
+    unmap();
+}
+
+void SharedMemoryBusConnector::writeData(const uint8_t index, const uint32_t size, const uint32_t offset)
+{
+    if (!isConnected() || (index >= m_writeSequence.size()) || ((static_cast<std::size_t>(offset) + size) > m_header->writeBufferSize))
+    {
+        return;
+    }
+    m_writeSequence[index] = submit({ Transfer::WRITE, index, size, offset });
+}
+
+void SharedMemoryBusConnector::readData(const uint8_t index, const uint32_t size)
+{
+    if (!isConnected() || (index >= m_readSequence.size()) || (size > m_header->readBufferSize))
+    {
+        return;
+    }
+    m_readSequence[index] = submit({ Transfer::READ, index, size, 0 });
+}
+
+void SharedMemoryBusConnector::blockUntilTransferIsComplete()
+{
+    waitForTransfer(m_submitted);
+}
+
+tcb::span<uint8_t> SharedMemoryBusConnector::requestWriteBuffer(const uint8_t index)
+{
+    if ((m_header == nullptr) || (index >= m_writeSequence.size()))
+    {
+        return {};
+    }
+    waitForTransfer(m_writeSequence[index]);
+    return { m_memory + m_header->getWriteBufferOffset(index), m_header->writeBufferSize };
+}
+
+tcb::span<uint8_t> SharedMemoryBusConnector::requestReadBuffer(const uint8_t index)
+{
+    if ((m_header == nullptr) || (index >= m_readSequence.size()))
+    {
+        return {};
+    }
+    waitForTransfer(m_readSequence[index]);
+    return { m_memory + m_header->getReadBufferOffset(index), m_header->readBufferSize };
+}
+
+uint8_t SharedMemoryBusConnector::getWriteBufferCount() const
+{
+    return static_cast<uint8_t>(m_writeSequence.size());
+}
+
+uint8_t SharedMemoryBusConnector::getReadBufferCount() const
+{
+    return static_cast<uint8_t>(m_readSequence.size());
+}
+
+uint32_t SharedMemoryBusConnector::submit(const Transfer& transfer)
+{
+    // Wait for a free slot in the ring
+    waitForTransfer(m_submitted - ChannelHeader::RING_SIZE + 1);
+    if (!isConnected())
+    {
+        return m_submitted;
+    }
+    m_header->ring[m_submitted % ChannelHeader::RING_SIZE] = transfer;
+    m_submitted++;
+    advanceCounter(m_header->submitted, m_header->serverSleeping, m_submitted);
+    return m_submitted;
+}
+
+void SharedMemoryBusConnector::waitForTransfer(const uint32_t sequence)
+{
+    if (!isConnected())
+    {
+        return;
+    }
+    const bool completed = waitUntil(
+        m_header->completed,
+        m_header->clientSleeping,
+        [this, sequence]()
+        { return isCompleted(m_header->completed.load(), sequence); },
+        [this]()
+        { return isServerAlive(); });
+    if (!completed)
+    {
+        // The buffers stay mapped, so that the renderer can continue without a device
+        SPDLOG_ERROR("The server (pid {}) has terminated. All further transfers are ignored.", m_header->serverPid);
+        m_serverLost = true;
+    }
+}
+
+bool SharedMemoryBusConnector::isServerAlive()
+{
+    return (kill(m_header->serverPid, 0) == 0) || (errno != ESRCH);
+}
+
+void SharedMemoryBusConnector::unmap()
+{
+    munmap(m_memory, m_size);
+    m_memory = nullptr;
+    m_header = nullptr;
+    m_size = 0;
+    m_writeSequence.clear();
+    m_readSequence.clear();
+}
+
+} // namespace rr
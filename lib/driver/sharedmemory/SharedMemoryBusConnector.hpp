@@ -0,0 +1,79 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SHAREDMEMORYBUSCONNECTOR_HPP
+#define SHAREDMEMORYBUSCONNECTOR_HPP
+
+#include "IBusConnector.hpp"
+#include "SharedMemoryChannel.hpp"
+#include <string>
+#include <vector>
+
+namespace rr
+{
+
+/// @brief Bus connector to a device in another process, which is hosted by a SharedMemoryBusServer.
+/// @details The buffers are located in a POSIX shared memory, which is created by the server. Transfers are queued
+///     without waiting for their completion, like in a DMA queue. A buffer in flight is completed when it is
+///     requested again. If the server terminates, the connector disconnects and ignores all further transfers.
+class SharedMemoryBusConnector : public IBusConnector
+{
+public:
+    static constexpr const char* DEFAULT_NAME { "/rixbus" };
+
+    virtual ~SharedMemoryBusConnector();
+
+    SharedMemoryBusConnector() = default;
+
+    /// @brief Connects to a server
+    /// @param name The name of the shared memory of the server
+    /// @return True if connected, false if there is no server or another client is connected
+    bool connect(const char* name = DEFAULT_NAME);
+
+    /// @brief Waits until the queued transfers are complete and disconnects from the server
+    void disconnect();
+
+    /// @brief Returns true if the connector is connected to a server
+    bool isConnected() const { return (m_header != nullptr) && !m_serverLost; }
+
+    virtual void writeData(const uint8_t index, const uint32_t size, const uint32_t offset) override;
+    virtual void readData(const uint8_t index, const uint32_t size) override;
+    virtual void blockUntilTransferIsComplete() override;
+    virtual tcb::span<uint8_t> requestWriteBuffer(const uint8_t index) override;
+    virtual tcb::span<uint8_t> requestReadBuffer(const uint8_t index) override;
+    virtual uint8_t getWriteBufferCount() const override;
+    virtual uint8_t getReadBufferCount() const override;
+    virtual bool queuesTransfers() const override { return true; }
+
+private:
+    uint32_t submit(const sharedmemory::Transfer& transfer);
+    void waitForTransfer(const uint32_t sequence);
+    bool isServerAlive();
+    void unmap();
+
+    sharedmemory::ChannelHeader* m_header { nullptr };
+    uint8_t* m_memory { nullptr };
+    std::size_t m_size { 0 };
+    bool m_serverLost { false };
+    uint32_t m_submitted { 0 };
+    // Sequence numbers of the last transfer of each buffer
+    std::vector<uint32_t> m_writeSequence {};
+    std::vector<uint32_t> m_readSequence {};
+};
+
+} // namespace rr
+#endif // SHAREDMEMORYBUSCONNECTOR_HPP
@@ -0,0 +1,210 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "SharedMemoryBusServer.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <signal.h>
+#include <spdlog/spdlog.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace rr
+{
+using namespace sharedmemory;
+
+SharedMemoryBusServer::SharedMemoryBusServer(IBusConnector& device)
+    : m_device { device }
+{
+}
+
+SharedMemoryBusServer::~SharedMemoryBusServer()
+{
+    close();
+}
+
+bool SharedMemoryBusServer::open(const char* name)
+{
+    close();
+
+    // Buffers are rounded up to keep the transfers aligned
+    static constexpr std::size_t BUFFER_SIZE_ALIGNMENT { 64 };
+    const auto alignBufferSize = [](const std::size_t size)
+    { return ((size + BUFFER_SIZE_ALIGNMENT - 1) / BUFFER_SIZE_ALIGNMENT) * BUFFER_SIZE_ALIGNMENT; };
+    ChannelHeader layout {};
+    layout.writeBufferCount = m_device.getWriteBufferCount();
+    layout.writeBufferSize = alignBufferSize((layout.writeBufferCount > 0) ? m_device.requestWriteBuffer(0).size() : 0);
+    layout.readBufferCount = m_device.getReadBufferCount();
+    layout.readBufferSize = alignBufferSize((layout.readBufferCount > 0) ? m_device.requestReadBuffer(0).size() : 0);
+
+    shm_unlink(name);
+    const int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+    {
+        SPDLOG_ERROR("Cannot create the shared memory {}: {}", name, strerror(errno));
+        return false;
+    }
+    m_size = layout.getSize();
+    if (ftruncate(fd, m_size) != 0)
+    {
+        SPDLOG_ERROR("Cannot allocate {} bytes of shared memory: {}", m_size, strerror(errno));
+        ::close(fd);
+        shm_unlink(name);
+        return false;
+    }
+    void* memory = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED)
+    {
+        SPDLOG_ERROR("Cannot map the shared memory {}: {}", name, strerror(errno));
+        shm_unlink(name);
+        return false;
+    }
+    m_name = name;
+    m_memory = static_cast<uint8_t*>(memory);
+    m_header = new (m_memory) ChannelHeader {};
+    m_header->serverPid = getpid();
+    m_header->writeBufferCount = layout.writeBufferCount;
+    m_header->writeBufferSize = layout.writeBufferSize;
+    m_header->readBufferCount = layout.readBufferCount;
+    m_header->readBufferSize = layout.readBufferSize;
+    m_header->version = ChannelHeader::VERSION;
+    // A client accepts the memory only after the magic is set
+    std::atomic_thread_fence(std::memory_order_release);
+    m_header->magic = ChannelHeader::MAGIC;
+    m_lastWriteIndex = -1;
+    SPDLOG_INFO("Created {} with {} bytes", name, m_size);
+    return true;
+}
+
+void SharedMemoryBusServer::close()
+{
+    if (m_header == nullptr)
+    {
+        return;
+    }
+    m_header->magic = 0;
+    munmap(m_memory, m_size);
+    shm_unlink(m_name.c_str());
+    m_header = nullptr;
+    m_memory = nullptr;
+    m_size = 0;
+}
+
+void SharedMemoryBusServer::serve()
+{
+    if (m_header == nullptr)
+    {
+        return;
+    }
+    uint32_t executed = m_header->completed.load();
+    while (!m_stop.load())
+    {
+        const bool submitted = waitUntil(
+            m_header->submitted,
+            m_header->serverSleeping,
+            [this, executed]()
+            { return m_header->submitted.load() != executed; },
+            [this]()
+            {
+                checkClient();
+                return !m_stop.load();
+            });
+        if (!submitted)
+        {
+            break;
+        }
+        execute(m_header->ring[executed % ChannelHeader::RING_SIZE]);
+        executed++;
+        advanceCounter(m_header->completed, m_header->clientSleeping, executed);
+    }
+    m_device.blockUntilTransferIsComplete();
+}
+
+void SharedMemoryBusServer::execute(const Transfer& transfer)
+{
+    m_statistics.transfers++;
+    switch (transfer.op)
+    {
+    case Transfer::WRITE:
+        write(transfer);
+        break;
+    case Transfer::READ:
+        read(transfer);
+        break;
+    case Transfer::DISCONNECT:
+        m_device.blockUntilTransferIsComplete();
+        SPDLOG_INFO("Client (pid {}) disconnected", m_header->clientPid.load());
+        m_header->clientPid.store(0);
+        break;
+    default:
+        SPDLOG_ERROR("Unknown transfer {}", transfer.op);
+        break;
+    }
+}
+
+void SharedMemoryBusServer::write(const Transfer& transfer)
+{
+    if ((transfer.index >= m_header->writeBufferCount) || ((static_cast<std::size_t>(transfer.offset) + transfer.size) > m_header->writeBufferSize))
+    {
+        SPDLOG_ERROR("Invalid write of {} bytes at offset {} into buffer {}", transfer.size, transfer.offset, transfer.index);
+        return;
+    }
+    // The previous transfer might still use the buffer of the device
+    if (m_lastWriteIndex == static_cast<int32_t>(transfer.index))
+    {
+        m_device.blockUntilTransferIsComplete();
+    }
+    tcb::span<uint8_t> buffer = m_device.requestWriteBuffer(transfer.index);
+    if ((static_cast<std::size_t>(transfer.offset) + transfer.size) > buffer.size())
+    {
+        SPDLOG_ERROR("Write of {} bytes at offset {} exceeds the buffer {} of the device", transfer.size, transfer.offset, transfer.index);
+        return;
+    }
+    std::memcpy(buffer.data() + transfer.offset, m_memory + m_header->getWriteBufferOffset(transfer.index) + transfer.offset, transfer.size);
+    m_device.writeData(transfer.index, transfer.size, transfer.offset);
+    m_lastWriteIndex = transfer.index;
+    m_statistics.bytesWritten += transfer.size;
+}
+
+void SharedMemoryBusServer::read(const Transfer& transfer)
+{
+    if ((transfer.index >= m_header->readBufferCount) || (transfer.size > m_header->readBufferSize))
+    {
+        SPDLOG_ERROR("Invalid read of {} bytes into buffer {}", transfer.size, transfer.index);
+        return;
+    }
+    m_device.readData(transfer.index, transfer.size);
+    const tcb::span<uint8_t> buffer = m_device.requestReadBuffer(transfer.index);
+    std::memcpy(m_memory + m_header->getReadBufferOffset(transfer.index), buffer.data(), (std::min)(buffer.size(), static_cast<std::size_t>(transfer.size)));
+    m_statistics.bytesRead += transfer.size;
+}
+
+void SharedMemoryBusServer::checkClient()
+{
+    int32_t pid = m_header->clientPid.load();
+    if ((pid != 0) && (kill(pid, 0) != 0) && (errno == ESRCH))
+    {
+        SPDLOG_WARN("Client (pid {}) has terminated without disconnecting", pid);
+        m_header->clientPid.compare_exchange_strong(pid, 0);
+    }
+}
+
+} // namespace rr
@@ -0,0 +1,80 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SHAREDMEMORYBUSSERVER_HPP
+#define SHAREDMEMORYBUSSERVER_HPP
+
+#include "IBusConnector.hpp"
+#include "SharedMemoryChannel.hpp"
+#include <atomic>
+#include <string>
+
+namespace rr
+{
+
+/// @brief Hosts a device for a SharedMemoryBusConnector in another process.
+/// @details The server creates the shared memory with the buffer layout of the bus connector of the device. The
+///     transfers of the client are copied into the buffers of the device and executed on the device in the order
+///     they were queued. One client can be connected at a time.
+class SharedMemoryBusServer
+{
+public:
+    struct Statistics
+    {
+        std::size_t transfers { 0 }; ///< Executed transfers
+        std::size_t bytesWritten { 0 }; ///< Bytes written to the device
+        std::size_t bytesRead { 0 }; ///< Bytes read from the device
+    };
+
+    SharedMemoryBusServer(IBusConnector& device);
+    ~SharedMemoryBusServer();
+
+    /// @brief Creates the shared memory. An existing shared memory with the same name is replaced.
+    /// @param name The name of the shared memory
+    /// @return True if the shared memory was created
+    bool open(const char* name);
+
+    /// @brief Removes the shared memory
+    void close();
+
+    /// @brief Executes the transfers of the clients until stop() is called
+    void serve();
+
+    /// @brief Stops serve(). Can be called from another thread or from a signal handler.
+    void stop() { m_stop.store(true); }
+
+    /// @brief Returns the statistics. Must not be called while serve() is running.
+    Statistics getStatistics() const { return m_statistics; }
+
+private:
+    void execute(const sharedmemory::Transfer& transfer);
+    void write(const sharedmemory::Transfer& transfer);
+    void read(const sharedmemory::Transfer& transfer);
+    void checkClient();
+
+    IBusConnector& m_device;
+    std::string m_name {};
+    sharedmemory::ChannelHeader* m_header { nullptr };
+    uint8_t* m_memory { nullptr };
+    std::size_t m_size { 0 };
+    std::atomic<bool> m_stop { false };
+    int32_t m_lastWriteIndex { -1 };
+    Statistics m_statistics {};
+};
+
+} // namespace rr
+#endif // SHAREDMEMORYBUSSERVER_HPP
@@ -0,0 +1,45 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "SharedMemoryChannel.hpp"
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace rr::sharedmemory
+{
+
+// The futexes are not private, because the counters are shared between processes
+
+void waitOnCounter(std::atomic<uint32_t>& counter, const uint32_t expected, const std::chrono::milliseconds timeout)
+{
+    const std::chrono::seconds seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+    const struct timespec ts {
+        static_cast<time_t>(seconds.count()),
+        static_cast<long>(std::chrono::duration_cast<std::chrono::nanoseconds>(timeout - seconds).count())
+    };
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&counter), FUTEX_WAIT, expected, &ts, nullptr, 0);
+}
+
+void wakeCounter(std::atomic<uint32_t>& counter)
+{
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&counter), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+} // namespace rr::sharedmemory
@@ -0,0 +1,163 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SHAREDMEMORYCHANNEL_HPP
+#define SHAREDMEMORYCHANNEL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace rr::sharedmemory
+{
+
+/// @brief A transfer of the bus connector, queued in the ring of the channel
+struct Transfer
+{
+    enum Op : uint32_t
+    {
+        WRITE,
+        READ,
+        DISCONNECT,
+    };
+
+    uint32_t op;
+    uint32_t index;
+    uint32_t size;
+    uint32_t offset;
+};
+
+/// @brief Layout of the shared memory which connects a SharedMemoryBusConnector with a SharedMemoryBusServer.
+/// @details The header is followed by the write buffers and the read buffers. The client queues transfers into a
+///     single producer single consumer ring. submitted and completed are free running counters of the transfers.
+///     A side which waits for the counter of the other side sleeps on the counter with a futex. It announces this
+///     with its sleeping flag, so that the other side only calls into the kernel when someone sleeps.
+struct ChannelHeader
+{
+    static constexpr uint32_t MAGIC { 0x52495853 }; // RIXS
+    static constexpr uint32_t VERSION { 1 };
+    static constexpr uint32_t RING_SIZE { 64 };
+    static constexpr std::size_t BUFFER_ALIGNMENT { 4096 };
+
+    uint32_t magic;
+    uint32_t version;
+    int32_t serverPid;
+    uint32_t writeBufferCount;
+    uint32_t writeBufferSize;
+    uint32_t readBufferCount;
+    uint32_t readBufferSize;
+    std::atomic<int32_t> clientPid; ///< 0 if no client is connected
+
+    alignas(64) std::atomic<uint32_t> submitted;
+    std::atomic<uint32_t> serverSleeping;
+    alignas(64) std::atomic<uint32_t> completed;
+    std::atomic<uint32_t> clientSleeping;
+
+    alignas(64) Transfer ring[RING_SIZE];
+
+    static std::size_t getHeaderSize()
+    {
+        return ((sizeof(ChannelHeader) + BUFFER_ALIGNMENT - 1) / BUFFER_ALIGNMENT) * BUFFER_ALIGNMENT;
+    }
+
+    std::size_t getWriteBufferOffset(const std::size_t index) const
+    {
+        return getHeaderSize() + (index * writeBufferSize);
+    }
+
+    std::size_t getReadBufferOffset(const std::size_t index) const
+    {
+        return getWriteBufferOffset(writeBufferCount) + (index * readBufferSize);
+    }
+
+    std::size_t getSize() const
+    {
+        return getReadBufferOffset(readBufferCount);
+    }
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<int32_t>::is_always_lock_free, "The channel requires lock free atomics in the shared memory");
+
+/// @brief Returns true if the transfer with the sequence number (value of submitted after the transfer was queued) is
+///     completed
+inline bool isCompleted(const uint32_t completed, const uint32_t sequence)
+{
+    return static_cast<int32_t>(completed - sequence) >= 0;
+}
+
+/// @brief Sleeps until the counter is woken up or the timeout expires, if the counter still has the expected value
+void waitOnCounter(std::atomic<uint32_t>& counter, const uint32_t expected, const std::chrono::milliseconds timeout);
+
+/// @brief Wakes up the sleepers of the counter
+void wakeCounter(std::atomic<uint32_t>& counter);
+
+/// @brief Waits until the predicate is true. Spins for a short time and sleeps then on the counter.
+/// @param counter The counter which is advanced by the other side
+/// @param sleeping The sleeping flag of the waiting side
+/// @param predicate Returns true when the waiting is done
+/// @param onTimeout Called each time the side woke up without the predicate being true. Returns false to abort
+///     the waiting.
+/// @return True if the predicate is true, false if the waiting was aborted
+template <typename Predicate, typename OnTimeout>
+bool waitUntil(std::atomic<uint32_t>& counter, std::atomic<uint32_t>& sleeping, const Predicate& predicate, const OnTimeout& onTimeout)
+{
+    static constexpr std::size_t SPIN_COUNT { 1000 };
+    static constexpr std::chrono::milliseconds SLEEP_TIMEOUT { 100 };
+    for (std::size_t i = 0; i < SPIN_COUNT; i++)
+    {
+        if (predicate())
+        {
+            return true;
+        }
+    }
+    for (;;)
+    {
+        const uint32_t expected = counter.load();
+        sleeping.store(1);
+        // Check again after the flag is set. The other side checks the flag after it has advanced the counter.
+        if (predicate())
+        {
+            sleeping.store(0);
+            return true;
+        }
+        waitOnCounter(counter, expected, SLEEP_TIMEOUT);
+        sleeping.store(0);
+        if (predicate())
+        {
+            return true;
+        }
+        if (!onTimeout())
+        {
+            return false;
+        }
+    }
+}
+
+/// @brief Advances the counter and wakes up the other side if it sleeps
+inline void advanceCounter(std::atomic<uint32_t>& counter, std::atomic<uint32_t>& sleeping, const uint32_t value)
+{
+    counter.store(value);
+    if (sleeping.load())
+    {
+        wakeCounter(counter);
+    }
+}
+
+} // namespace rr::sharedmemory
+
+#endif // SHAREDMEMORYCHANNEL_HPP
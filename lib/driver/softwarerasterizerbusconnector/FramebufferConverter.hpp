@@ -0,0 +1,132 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef FRAMEBUFFERCONVERTER_H
+#define FRAMEBUFFERCONVERTER_H
+
+#include "SimdLanes.hpp"
+#include <cstdint>
+#include <cstring>
+
+namespace rr
+{
+
+/// @brief Converts the RGB565 color buffer of the software rasterizer into the formats of a presenter
+/// @details The 5 and 6 bit components are expanded to 8 bit by replicating the upper bits, so that white stays
+///     white. Eight pixels are converted at once with SSE2 or NEON if available and with a scalar loop for the
+///     remaining pixels.
+class FramebufferConverter
+{
+public:
+    /// @brief Converts pixelCount RGB565 pixels into BGR888 (blue in the first byte)
+    static void convertRgb565ToBgr888(uint8_t* dst, const uint16_t* src, const std::size_t pixelCount)
+    {
+        std::size_t pixel = 0;
+#if defined(__SSE2__) || defined(__ARM_NEON)
+        // The pixels are stored with overlapping four byte stores. The fourth byte of the last pixel of a block is
+        // overwritten by the next pixel, which is why at least one pixel must follow the block.
+        for (; (pixel + 8) < pixelCount; pixel += 8)
+        {
+            simd::Vector lo;
+            simd::Vector hi;
+            simd::loadWiden16(src + pixel, lo, hi);
+            uint32_t expanded[8];
+            simd::store(expanded, expand<2, 1, 0, NO_ALPHA>(lo));
+            simd::store(expanded + 4, expand<2, 1, 0, NO_ALPHA>(hi));
+            uint8_t* out = dst + (pixel * 3);
+            for (std::size_t i = 0; i < 8; i++)
+            {
+                std::memcpy(out + (i * 3), &expanded[i], sizeof(uint32_t));
+            }
+        }
+#endif
+        for (; pixel < pixelCount; pixel++)
+        {
+            const uint32_t expanded = expand<2, 1, 0, NO_ALPHA>(static_cast<uint32_t>(src[pixel]));
+            dst[(pixel * 3) + 0] = static_cast<uint8_t>(expanded);
+            dst[(pixel * 3) + 1] = static_cast<uint8_t>(expanded >> 8);
+            dst[(pixel * 3) + 2] = static_cast<uint8_t>(expanded >> 16);
+        }
+    }
+
+    /// @brief Converts pixelCount RGB565 pixels into RGBA8888 (red in the first byte) with an opaque alpha
+    static void convertRgb565ToRgba8888(uint8_t* dst, const uint16_t* src, const std::size_t pixelCount)
+    {
+        convertTo32<0, 1, 2, 3>(dst, src, pixelCount);
+    }
+
+    /// @brief Converts pixelCount RGB565 pixels into BGRA8888 (blue in the first byte) with an opaque alpha
+    /// @details This is the layout of 32 bit true color images on little endian X11 servers and of 32 bit DIBs
+    static void convertRgb565ToBgra8888(uint8_t* dst, const uint16_t* src, const std::size_t pixelCount)
+    {
+        convertTo32<2, 1, 0, 3>(dst, src, pixelCount);
+    }
+
+private:
+    static constexpr std::size_t NO_ALPHA { 4 };
+
+    template <std::size_t R, std::size_t G, std::size_t B, std::size_t A>
+    static void convertTo32(uint8_t* dst, const uint16_t* src, const std::size_t pixelCount)
+    {
+        std::size_t pixel = 0;
+#if defined(__SSE2__) || defined(__ARM_NEON)
+        for (; (pixel + 8) <= pixelCount; pixel += 8)
+        {
+            simd::Vector lo;
+            simd::Vector hi;
+            simd::loadWiden16(src + pixel, lo, hi);
+            simd::store(dst + (pixel * 4), expand<R, G, B, A>(lo));
+            simd::store(dst + (pixel * 4) + 16, expand<R, G, B, A>(hi));
+        }
+#endif
+        for (; pixel < pixelCount; pixel++)
+        {
+            const uint32_t expanded = expand<R, G, B, A>(static_cast<uint32_t>(src[pixel]));
+            std::memcpy(dst + (pixel * 4), &expanded, sizeof(uint32_t));
+        }
+    }
+
+    // Expands a RGB565 pixel in the lower 16 bits into a little endian pixel with 8 bit components. R, G, B and A
+    // are the byte positions of the components. A is NO_ALPHA if the pixel has no alpha. T is either a single pixel
+    // or a vector of pixels.
+    template <std::size_t R, std::size_t G, std::size_t B, std::size_t A, typename T>
+    static T expand(const T pixel)
+    {
+        const T rgb = simd::bitOr(simd::bitOr(component<11, 5, R>(pixel), component<5, 6, G>(pixel)), component<0, 5, B>(pixel));
+        if constexpr (A == NO_ALPHA)
+        {
+            return rgb;
+        }
+        else
+        {
+            return simd::bitOr(rgb, simd::broadcast(pixel, 0xffu << (A * 8)));
+        }
+    }
+
+    // Expands the component with Bits at bit position Pos to 8 bits and moves it to the byte position Target
+    template <std::size_t Pos, std::size_t Bits, std::size_t Target, typename T>
+    static T component(const T pixel)
+    {
+        const T c = simd::bitAnd(simd::shiftRight<Pos>(pixel), simd::broadcast(pixel, (1u << Bits) - 1));
+        const T c8 = simd::bitOr(simd::shiftLeft<8 - Bits>(c), simd::shiftRight<(2 * Bits) - 8>(c));
+        return simd::shiftLeft<Target * 8>(c8);
+    }
+};
+
+} // namespace rr
+
+#endif // FRAMEBUFFERCONVERTER_H
@@ -18,7 +18,13 @@
 #ifndef SOFTWARERASTERIZERBUSCONNECTOR_H
 #define SOFTWARERASTERIZERBUSCONNECTOR_H
 
+#include "FramebufferConverter.hpp"
+#include "IBusConnector.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <tcb/span.hpp>
+#include <vector>
 
 namespace rr
 {
@@ -26,15 +32,24 @@ enum SoftwareRasterizerBusConnectorColorFormat
 {
     RGB565,
     BGR888,
+    RGBA8888,
+    BGRA8888,
 };
 
+/// @brief Bus connector of the SoftwareRasterizer. The rasterizer renders directly into the device memory of this
+///     connector. A committed color buffer is copied or converted into the framebuffer of the presenter.
+/// @details If the connector is created without a framebuffer, nothing is copied and the presenter reads the
+///     committed color buffer via getFrontBuffer() directly from the device memory (zero copy).
 template <uint32_t GRAM_SIZE = 32 * 1024 * 1024, SoftwareRasterizerBusConnectorColorFormat colorFormat = SoftwareRasterizerBusConnectorColorFormat::RGB565>
 class SoftwareRasterizerBusConnector : public IBusConnector
 {
 public:
+    /// @brief Number of pixels which are compared and converted at once when only dirty bands are converted
+    static constexpr std::size_t BAND_SIZE { 1024 };
+
     virtual ~SoftwareRasterizerBusConnector() = default;
 
-    SoftwareRasterizerBusConnector(tcb::span<uint8_t> framebuffer)
+    SoftwareRasterizerBusConnector(tcb::span<uint8_t> framebuffer = {})
         : m_framebuffer { framebuffer }
     {
     }
@@ -42,15 +57,35 @@ public:
     virtual void writeData(const uint8_t index, const uint32_t size, const uint32_t offset) override
     {
         tcb::span<uint8_t> deviceMemory = this->requestWriteBuffer(index);
-        tcb::span<const uint8_t> devicefb = tcb::span<const uint8_t> { reinterpret_cast<const uint8_t*>(deviceMemory.data() + offset), size };
+        m_frontBuffer = tcb::span<const uint8_t> { reinterpret_cast<const uint8_t*>(deviceMemory.data() + offset), size };
 
-        if constexpr (colorFormat == SoftwareRasterizerBusConnectorColorFormat::RGB565)
+        if (m_framebuffer.empty())
         {
-            copyRgb565ToFramebuffer(devicefb);
+            return;
         }
-        else
+
+        tcb::span<const uint16_t> devicefb { reinterpret_cast<const uint16_t*>(m_frontBuffer.data()), m_frontBuffer.size() / sizeof(uint16_t) };
+        devicefb = devicefb.first(std::min(devicefb.size(), m_framebuffer.size() / getBytesPerPixel()));
+
+        if (!m_convertDirtyBandsOnly)
         {
-            copyBgr888ToFramebuffer(devicefb);
+            convert(0, devicefb);
+            return;
+        }
+
+        // Compares the color buffer band by band with the last converted color buffer and converts only the
+        // bands which have changed.
+        const bool shadowValid = m_shadow.size() == devicefb.size();
+        m_shadow.resize(devicefb.size());
+        for (std::size_t band = 0; band < devicefb.size(); band += BAND_SIZE)
+        {
+            const tcb::span<const uint16_t> pixels = devicefb.subspan(band, std::min(BAND_SIZE, devicefb.size() - band));
+            if (shadowValid && (std::memcmp(m_shadow.data() + band, pixels.data(), pixels.size_bytes()) == 0))
+            {
+                continue;
+            }
+            std::memcpy(m_shadow.data() + band, pixels.data(), pixels.size_bytes());
+            convert(band, pixels);
         }
     }
 
@@ -82,32 +117,63 @@ public:
         return 0;
     }
 
+    /// @brief Converts only the bands of the color buffer which have changed since the last commit.
+    /// @details Helps if large parts of the screen are static. It costs a copy of the color buffer and a comparison
+    ///     of the whole color buffer per commit.
+    void setConvertDirtyBandsOnly(const bool enable)
+    {
+        m_convertDirtyBandsOnly = enable;
+        m_shadow.clear();
+    }
+
+    /// @brief Returns the RGB565 color buffer of the last commit in the device memory
+    /// @details The color buffers are swapped on each commit. The returned buffer is overwritten when the renderer
+    ///     starts to render the frame after the next commit.
+    tcb::span<const uint8_t> getFrontBuffer() const
+    {
+        return m_frontBuffer;
+    }
+
 private:
-    void copyRgb565ToFramebuffer(const tcb::span<const uint8_t>& devicefb)
+    static constexpr std::size_t getBytesPerPixel()
     {
-        std::size_t fbSize = std::min(devicefb.size(), m_framebuffer.size());
-        for (std::size_t i = 0; i < fbSize; i++)
+        switch (colorFormat)
         {
-            m_framebuffer[i] = devicefb[i];
+        case SoftwareRasterizerBusConnectorColorFormat::BGR888:
+            return 3;
+        case SoftwareRasterizerBusConnectorColorFormat::RGBA8888:
+        case SoftwareRasterizerBusConnectorColorFormat::BGRA8888:
+            return 4;
+        default:
+            return 2;
         }
     }
 
-    void copyBgr888ToFramebuffer(const tcb::span<const uint8_t>& devicefb)
+    void convert(const std::size_t firstPixel, const tcb::span<const uint16_t>& pixels)
     {
-        std::size_t fbSize = std::min(devicefb.size(), m_framebuffer.size());
-        tcb::span<const uint16_t> fbAs16Bit { reinterpret_cast<const uint16_t*>(devicefb.data()), devicefb.size() / 2 };
-        for (std::size_t i = 0; i < fbAs16Bit.size(); i++)
+        uint8_t* dst = m_framebuffer.data() + (firstPixel * getBytesPerPixel());
+        if constexpr (colorFormat == SoftwareRasterizerBusConnectorColorFormat::RGB565)
+        {
+            std::memcpy(dst, pixels.data(), pixels.size_bytes());
+        }
+        else if constexpr (colorFormat == SoftwareRasterizerBusConnectorColorFormat::BGR888)
+        {
+            FramebufferConverter::convertRgb565ToBgr888(dst, pixels.data(), pixels.size());
+        }
+        else if constexpr (colorFormat == SoftwareRasterizerBusConnectorColorFormat::RGBA8888)
+        {
+            FramebufferConverter::convertRgb565ToRgba8888(dst, pixels.data(), pixels.size());
+        }
+        else
         {
-            const uint32_t r = (fbAs16Bit[i] >> 11) & 0x1F;
-            const uint32_t g = (fbAs16Bit[i] >> 5) & 0x3F;
-            const uint32_t b = (fbAs16Bit[i] >> 0) & 0x1F;
-            m_framebuffer[i * 3 + 2] = (r << 3) | (r >> 2);
-            m_framebuffer[i * 3 + 1] = (g << 2) | (g >> 4);
-            m_framebuffer[i * 3 + 0] = (b << 3) | (b >> 2);
+            FramebufferConverter::convertRgb565ToBgra8888(dst, pixels.data(), pixels.size());
         }
     }
 
     tcb::span<uint8_t> m_framebuffer {};
+    tcb::span<const uint8_t> m_frontBuffer {};
+    bool m_convertDirtyBandsOnly { false };
+    std::vector<uint16_t> m_shadow {};
     std::array<uint8_t, GRAM_SIZE> m_gram;
 };
 
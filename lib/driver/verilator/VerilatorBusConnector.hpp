@@ -4,89 +4,198 @@
 #include "GenericMemoryBusConnector.hpp"
 #include "Vtop.h"
 #include "verilated.h"
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <tcb/span.hpp>
+#include <thread>
 #include <verilated_vcd_c.h>
 
 namespace rr
 {
+
+/// @brief Drives the Verilator simulation of rtl/top/Verilator/top.v
+/// @details The simulation runs on its own thread. writeData() hands the buffer to this thread and returns,
+///     so that the host prepares the next display list while the previous one is simulated. The transfers are
+///     queued (see IBusConnector::queuesTransfers()), requestWriteBuffer() waits until the buffer is streamed.
+///     The model is created and evaluated only on the simulation thread, which is required when the model is
+///     verilated with --threads (see rtl/top/Verilator/README.md).
 template <uint32_t NUMBER_OF_DISPLAY_LISTS = 33, uint32_t DISPLAY_LIST_SIZE = 128 * 1024>
 class VerilatorBusConnector : public GenericMemoryBusConnector<NUMBER_OF_DISPLAY_LISTS, DISPLAY_LIST_SIZE>
 {
 public:
-    virtual ~VerilatorBusConnector() = default;
+    struct Statistics
+    {
+        uint64_t cycles { 0 }; ///< Simulated clock cycles
+        uint64_t beatsWritten { 0 }; ///< Beats sent to the command stream
+        uint64_t beatsRead { 0 }; ///< Beats received from the response stream
+        std::chrono::microseconds simulationTime { 0 }; ///< Wall clock time spent in the simulation
+    };
+
+    virtual ~VerilatorBusConnector()
+    {
+        runAndWait([this]()
+            { m_top.reset(); });
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+            m_stop = true;
+        }
+        m_condition.notify_all();
+        m_simulationThread.join();
+    }
 
     VerilatorBusConnector(tcb::span<uint8_t> framebuffer, const uint16_t resolutionW = 128, const uint16_t resolutionH = 128)
         : m_resolutionW(resolutionW)
         , m_resolutionH(resolutionH)
         , m_framebuffer(framebuffer)
     {
-        Verilated::traceEverOn(true);
+        runAndWait([this]()
+            {
+                Verilated::traceEverOn(true);
+                m_top = std::make_unique<Vtop>();
 
-        m_top.m_framebuffer_axis_tready = 1;
-        m_top.s_cmd_axis_tvalid = 0;
+                m_top->m_framebuffer_axis_tready = 1;
+                m_top->s_cmd_axis_tvalid = 0;
 
-        m_top.resetn = 0;
-        clk();
-        clk(); // It needs an additional clock cycle, otherwise it will not work. Currently i dont know why
-        m_top.resetn = 1;
-        clk();
+                m_top->resetn = 0;
+                clk();
+                clk(); // It needs an additional clock cycle, otherwise it will not work. Currently i dont know why
+                m_top->resetn = 1;
+                clk();
+            });
     }
 
     virtual void writeData(const uint8_t index, const uint32_t size, const uint32_t offset) override
+    {
+        run([this, index, size, offset]()
+            { simulate([&]()
+                  { streamToDevice(index, size, offset); }); },
+            index);
+    }
+
+    virtual void readData(const uint8_t index, const uint32_t size) override
+    {
+        runAndWait([this, index, size]()
+            { simulate([&]()
+                  { streamFromDevice(index, size); }); });
+    }
+
+    virtual void blockUntilTransferIsComplete() override
+    {
+        wait();
+    }
+
+    virtual tcb::span<uint8_t> requestWriteBuffer(const uint8_t index) override
+    {
+        // The buffer might still be streamed by the simulation thread
+        std::unique_lock<std::mutex> lock { m_mutex };
+        m_condition.wait(lock, [this, index]()
+            { return !m_job || (m_writeBufferInFlight != index); });
+        return GenericMemoryBusConnector<NUMBER_OF_DISPLAY_LISTS, DISPLAY_LIST_SIZE>::requestWriteBuffer(index);
+    }
+
+    virtual tcb::span<uint8_t> requestReadBuffer(const uint8_t index) override
+    {
+        wait();
+        return GenericMemoryBusConnector<NUMBER_OF_DISPLAY_LISTS, DISPLAY_LIST_SIZE>::requestReadBuffer(index);
+    }
+
+    virtual bool queuesTransfers() const override { return true; }
+
+    void waitForLastFramebufferChunk()
+    {
+        runAndWait([this]()
+            {
+                while (m_streamAddr != 0)
+                {
+                    clk();
+                }
+            });
+    }
+
+    /// @brief Returns the statistics of the simulation. Waits until the current transfer is complete.
+    Statistics getStatistics()
+    {
+        wait();
+        return m_statistics;
+    }
+
+    /// @brief Returns the simulated clock cycles per second of wall clock time spent in the simulation
+    double getCyclesPerSecond()
+    {
+        const Statistics statistics = getStatistics();
+        const double seconds = std::chrono::duration<double>(statistics.simulationTime).count();
+        return (seconds > 0.0) ? (static_cast<double>(statistics.cycles) / seconds) : 0.0;
+    }
+
+private:
+    void streamToDevice(const uint8_t index, const uint32_t size, const uint32_t offset)
     {
         // Convert data to 32 bit variables to ease the access
         const uint32_t* data32 = reinterpret_cast<const uint32_t*>(this->m_dlMemTx[index].data() + offset);
         const uint32_t bytes32 = size / sizeof(*data32);
+        // The whole buffer is streamed in one batch on the simulation thread without handing control back
+        // to the host between the beats
         for (uint32_t i = 0; i < bytes32;)
         {
-            if (m_top.s_cmd_axis_tready)
+            if (m_top->s_cmd_axis_tready)
             {
-                m_top.s_cmd_axis_tdata = data32[i];
-                m_top.s_cmd_axis_tvalid = 1;
+                m_top->s_cmd_axis_tdata = data32[i];
+                m_top->s_cmd_axis_tvalid = 1;
                 i++;
             }
             clk();
         }
-        m_top.s_cmd_axis_tvalid = 0;
+        m_top->s_cmd_axis_tvalid = 0;
+        m_statistics.beatsWritten += bytes32;
     }
 
-    virtual void readData(const uint8_t index, const uint32_t size) override
+    void streamFromDevice(const uint8_t index, const uint32_t size)
     {
         // Convert data to 32 bit variables to ease the access
         uint32_t* data32 = reinterpret_cast<uint32_t*>(this->m_dlMemRx[index].data());
         const uint32_t bytes32 = size / sizeof(*data32);
-        m_top.m_cmd_resp_axis_tready = 1;
+        m_top->m_cmd_resp_axis_tready = 1;
         for (uint32_t i = 0; i < bytes32;)
         {
-            if (m_top.m_cmd_resp_axis_tvalid)
+            if (m_top->m_cmd_resp_axis_tvalid)
             {
-                data32[i] = m_top.m_cmd_resp_axis_tdata;
+                data32[i] = m_top->m_cmd_resp_axis_tdata;
                 i++;
             }
             clk();
         }
-        m_top.m_cmd_resp_axis_tready = 0;
+        m_top->m_cmd_resp_axis_tready = 0;
+        m_statistics.beatsRead += bytes32;
     }
 
-    virtual void blockUntilTransferIsComplete() override
+    template <typename Function>
+    void simulate(const Function& function)
     {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        m_statistics.simulationTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
     }
 
     void clk()
     {
-        m_top.aclk = 1;
-        m_top.eval();
-        m_top.aclk = 0;
-        m_top.eval();
+        m_top->aclk = 1;
+        m_top->eval();
+        m_top->aclk = 0;
+        m_top->eval();
+        m_statistics.cycles++;
 
-        if (m_top.resetn == 0)
+        if (m_top->resetn == 0)
             return;
 
         const std::size_t framebufferSize = (m_resolutionW * m_resolutionH * 3); // 3 for 24 bit color
-        if (m_top.m_framebuffer_axis_tvalid && (m_streamAddr < framebufferSize) && (!m_framebuffer.empty()))
+        if (m_top->m_framebuffer_axis_tvalid && (m_streamAddr < framebufferSize) && (!m_framebuffer.empty()))
         {
-            const uint16_t f0 = m_top.m_framebuffer_axis_tdata & 0xFFFF;
-            const uint16_t f1 = (m_top.m_framebuffer_axis_tdata >> 16) & 0xFFFF;
+            const uint16_t f0 = m_top->m_framebuffer_axis_tdata & 0xFFFF;
+            const uint16_t f1 = (m_top->m_framebuffer_axis_tdata >> 16) & 0xFFFF;
 
             toBgr888(m_framebuffer.subspan(m_streamAddr, 3), f0);
             m_streamAddr += 3;
@@ -94,21 +203,12 @@ public:
             m_streamAddr += 3;
         }
 
-        if ((m_streamAddr >= framebufferSize) && m_top.m_framebuffer_axis_tlast)
+        if ((m_streamAddr >= framebufferSize) && m_top->m_framebuffer_axis_tlast)
         {
             m_streamAddr = 0;
         }
     }
 
-    void waitForLastFramebufferChunk()
-    {
-        while (m_streamAddr != 0)
-        {
-            clk();
-        }
-    }
-
-private:
     void toBgr888(tcb::span<uint8_t> dst, const uint16_t pixelData)
     {
         const uint32_t r = (pixelData >> 11) & 0x1F;
@@ -119,11 +219,65 @@ private:
         dst[0] = (b << 3) | (b >> 2);
     }
 
+    // Hands a job to the simulation thread. Waits until the previous job is finished.
+    void run(const std::function<void()>& job, const std::optional<uint8_t> writeBuffer = std::nullopt)
+    {
+        std::unique_lock<std::mutex> lock { m_mutex };
+        m_condition.wait(lock, [this]()
+            { return !m_job; });
+        m_job = job;
+        m_writeBufferInFlight = writeBuffer;
+        m_condition.notify_all();
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock { m_mutex };
+        m_condition.wait(lock, [this]()
+            { return !m_job; });
+    }
+
+    void runAndWait(const std::function<void()>& job)
+    {
+        run(job);
+        wait();
+    }
+
+    void simulationLoop()
+    {
+        std::unique_lock<std::mutex> lock { m_mutex };
+        for (;;)
+        {
+            m_condition.wait(lock, [this]()
+                { return m_job || m_stop; });
+            if (m_stop)
+            {
+                return;
+            }
+            const std::function<void()> job = m_job;
+            lock.unlock();
+            job();
+            lock.lock();
+            m_job = nullptr;
+            m_writeBufferInFlight = std::nullopt;
+            m_condition.notify_all();
+        }
+    }
+
     const uint16_t m_resolutionW = 128;
     const uint16_t m_resolutionH = 128;
     tcb::span<uint8_t> m_framebuffer;
     uint32_t m_streamAddr = 0;
-    Vtop m_top;
+    Statistics m_statistics {};
+    std::unique_ptr<Vtop> m_top {};
+
+    std::mutex m_mutex {};
+    std::condition_variable m_condition {};
+    std::function<void()> m_job {};
+    std::optional<uint8_t> m_writeBufferInFlight {}; ///< The buffer which is streamed by the current job
+    bool m_stop { false };
+    std::thread m_simulationThread { [this]()
+        { simulationLoop(); } };
 };
 
 } // namespace rr
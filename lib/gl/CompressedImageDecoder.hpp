@@ -0,0 +1,461 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef GL_COMPRESSED_IMAGE_DECODER_HPP_
+#define GL_COMPRESSED_IMAGE_DECODER_HPP_
+
+#include "Enums.hpp"
+#include "ImageConverter.hpp"
+#include "gl.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace rr
+{
+
+/// @brief Decodes block compressed images (ETC1, S3TC DXT1, DXT3 and DXT5) into the device pixel formats
+/// @details The hardware can't sample compressed textures. The blocks are decoded on the host when the texture is
+///     specified. Every 4x4 block builds a small palette which is converted once into the device format. The pixels
+///     are then only looked up from this palette. Only DXT3 and DXT5 convert every pixel, because of the separate alpha.
+///     Not power of two images are decoded into RGBA8888 first and then resampled like uncompressed images.
+class CompressedImageDecoder
+{
+public:
+    static constexpr std::size_t BLOCK_DIM { 4 };
+    static constexpr std::array<GLenum, 5> SUPPORTED_FORMATS {
+        GL_COMPRESSED_RGB_S3TC_DXT1_EXT,
+        GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,
+        GL_COMPRESSED_RGBA_S3TC_DXT3_EXT,
+        GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
+        GL_ETC1_RGB8_OES,
+    };
+
+    /// @brief Selects the internal pixel format which is used to store a compressed format
+    /// @return GL_INVALID_ENUM if the format is not supported
+    static GLenum convertInternalPixelFormat(InternalPixelFormat& ipf, const GLenum format)
+    {
+        switch (format)
+        {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        case GL_ETC1_RGB8_OES:
+            ipf = InternalPixelFormat::RGB;
+            break;
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+            ipf = InternalPixelFormat::RGBA1;
+            break;
+        case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+            ipf = InternalPixelFormat::RGBA;
+            break;
+        default:
+            return GL_INVALID_ENUM;
+        }
+        return GL_NO_ERROR;
+    }
+
+    /// @brief Returns the size of a compressed 4x4 block in bytes or 0 if the format is not supported
+    static std::size_t getBlockSize(const GLenum format)
+    {
+        switch (format)
+        {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+        case GL_ETC1_RGB8_OES:
+            return 8;
+        case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+            return 16;
+        default:
+            return 0;
+        }
+    }
+
+    /// @brief Returns the size of a compressed image in bytes or 0 if the format is not supported
+    static std::size_t getImageSize(const GLenum format, const std::size_t width, const std::size_t height)
+    {
+        const std::size_t blocksX = (width + BLOCK_DIM - 1) / BLOCK_DIM;
+        const std::size_t blocksY = (height + BLOCK_DIM - 1) / BLOCK_DIM;
+        return blocksX * blocksY * getBlockSize(format);
+    }
+
+    /// @brief Decodes a compressed image into a region of a texture
+    /// @param texelsDevice The texture in the device format
+    /// @param ipf The internal pixel format of the texture
+    /// @param rowLength The width of the texture
+    /// @param xoffset The x offset of the region in the texture
+    /// @param yoffset The y offset of the region in the texture
+    /// @param width The width of the region. Blocks which exceed the region are clipped.
+    /// @param height The height of the region
+    /// @param format The compressed format
+    /// @param data The compressed blocks of the region in row major order
+    /// @return false if the format is not supported
+    static bool decode(
+        std::shared_ptr<uint16_t> texelsDevice,
+        const InternalPixelFormat ipf,
+        const std::size_t rowLength,
+        const std::size_t xoffset,
+        const std::size_t yoffset,
+        const std::size_t width,
+        const std::size_t height,
+        const GLenum format,
+        const uint8_t* data)
+    {
+        return decodeImage(texelsDevice.get() + (yoffset * rowLength) + xoffset, rowLength, width, height, format, data,
+            [ipf](const RGBA& color)
+            { return ImageConverter::RGBA8888ToDevice(ipf, color); });
+    }
+
+    /// @brief Decodes a compressed image and resamples it into a region of a texture like
+    ///     ImageConverter::convertUnpackRescaled()
+    /// @param converter The converter which selects the filter of the resampler
+    /// @param textureWidth The width of the resampled image
+    /// @param textureHeight The height of the resampled image
+    /// @param width The width of the compressed image
+    /// @param height The height of the compressed image
+    /// @return false if the format is not supported
+    static bool decodeRescaled(
+        const ImageConverter& converter,
+        std::shared_ptr<uint16_t> texelsDevice,
+        const InternalPixelFormat ipf,
+        const std::size_t rowLength,
+        const std::size_t xoffset,
+        const std::size_t yoffset,
+        const std::size_t textureWidth,
+        const std::size_t textureHeight,
+        const std::size_t width,
+        const std::size_t height,
+        const GLenum format,
+        const uint8_t* data)
+    {
+        std::vector<RGBA> image(width * height);
+        if (!decodeImage(image.data(), width, width, height, format, data, [](const RGBA& color)
+                { return color; }))
+        {
+            return false;
+        }
+        converter.resampleToDevice(texelsDevice, ipf, rowLength, xoffset, yoffset, textureWidth, textureHeight, image.data(), width, height);
+        return true;
+    }
+
+    /// @brief Copies the blocks of a region into a compressed image
+    /// @param image The compressed image
+    /// @param imageWidth The width of the compressed image in pixels
+    /// @param xoffset The x offset of the region. Must be a multiple of BLOCK_DIM.
+    /// @param yoffset The y offset of the region. Must be a multiple of BLOCK_DIM.
+    /// @param width The width of the region. Must be a multiple of BLOCK_DIM or end at the edge of the image.
+    /// @param height The height of the region. Must be a multiple of BLOCK_DIM or end at the edge of the image.
+    /// @param data The compressed blocks of the region in row major order
+    static void copyBlocks(
+        std::vector<uint8_t>& image,
+        const std::size_t imageWidth,
+        const std::size_t xoffset,
+        const std::size_t yoffset,
+        const std::size_t width,
+        const std::size_t height,
+        const GLenum format,
+        const uint8_t* data)
+    {
+        const std::size_t blockSize = getBlockSize(format);
+        const std::size_t imageRowSize = ((imageWidth + BLOCK_DIM - 1) / BLOCK_DIM) * blockSize;
+        const std::size_t rowSize = ((width + BLOCK_DIM - 1) / BLOCK_DIM) * blockSize;
+        const std::size_t rows = (height + BLOCK_DIM - 1) / BLOCK_DIM;
+        for (std::size_t row = 0; row < rows; row++)
+        {
+            std::copy_n(
+                data + (row * rowSize),
+                rowSize,
+                image.data() + (((yoffset / BLOCK_DIM) + row) * imageRowSize) + ((xoffset / BLOCK_DIM) * blockSize));
+        }
+    }
+
+private:
+    using RGBA = ImageConverter::RGBA;
+    template <typename TPixel>
+    using Block = std::array<TPixel, BLOCK_DIM * BLOCK_DIM>; ///< Decoded pixels of a block in row major order
+
+    /// @brief Decodes a compressed image
+    /// @param convert Converts a RGBA8888 color into a TPixel
+    template <typename TPixel, typename TConvert>
+    static bool decodeImage(
+        TPixel* texels,
+        const std::size_t rowLength,
+        const std::size_t width,
+        const std::size_t height,
+        const GLenum format,
+        const uint8_t* data,
+        const TConvert& convert)
+    {
+        switch (format)
+        {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+            decodeBlocks(texels, rowLength, width, height, data, 8, [&convert](Block<TPixel>& block, const uint8_t* src)
+                { decodeDXT1Block(block, convert, src, false); });
+            return true;
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+            decodeBlocks(texels, rowLength, width, height, data, 8, [&convert](Block<TPixel>& block, const uint8_t* src)
+                { decodeDXT1Block(block, convert, src, true); });
+            return true;
+        case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+            decodeBlocks(texels, rowLength, width, height, data, 16, [&convert](Block<TPixel>& block, const uint8_t* src)
+                { decodeDXT3Block(block, convert, src); });
+            return true;
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+            decodeBlocks(texels, rowLength, width, height, data, 16, [&convert](Block<TPixel>& block, const uint8_t* src)
+                { decodeDXT5Block(block, convert, src); });
+            return true;
+        case GL_ETC1_RGB8_OES:
+            decodeBlocks(texels, rowLength, width, height, data, 8, [&convert](Block<TPixel>& block, const uint8_t* src)
+                { decodeETC1Block(block, convert, src); });
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    template <typename TPixel, typename TDecodeBlock>
+    static void decodeBlocks(
+        TPixel* texels,
+        const std::size_t rowLength,
+        const std::size_t width,
+        const std::size_t height,
+        const uint8_t* data,
+        const std::size_t blockSize,
+        const TDecodeBlock& decodeBlock)
+    {
+        Block<TPixel> block;
+        for (std::size_t by = 0; by < height; by += BLOCK_DIM)
+        {
+            const std::size_t rows = (std::min)(BLOCK_DIM, height - by);
+            for (std::size_t bx = 0; bx < width; bx += BLOCK_DIM)
+            {
+                decodeBlock(block, data);
+                data += blockSize;
+                const std::size_t columns = (std::min)(BLOCK_DIM, width - bx);
+                for (std::size_t y = 0; y < rows; y++)
+                {
+                    std::copy_n(block.data() + (y * BLOCK_DIM), columns, texels + ((by + y) * rowLength) + bx);
+                }
+            }
+        }
+    }
+
+    static uint16_t readUint16(const uint8_t* src)
+    {
+        return static_cast<uint16_t>(src[0] | (src[1] << 8));
+    }
+
+    static RGBA expandRGB565(const uint16_t color)
+    {
+        const uint8_t r = (color >> 11) & 0x1f;
+        const uint8_t g = (color >> 5) & 0x3f;
+        const uint8_t b = color & 0x1f;
+        return {
+            static_cast<uint8_t>((r << 3) | (r >> 2)),
+            static_cast<uint8_t>((g << 2) | (g >> 4)),
+            static_cast<uint8_t>((b << 3) | (b >> 2)),
+            0xff,
+        };
+    }
+
+    static RGBA mix(const RGBA& c0, const RGBA& c1, const uint32_t w0, const uint32_t w1)
+    {
+        const uint32_t sum = w0 + w1;
+        return {
+            static_cast<uint8_t>(((c0.r * w0) + (c1.r * w1)) / sum),
+            static_cast<uint8_t>(((c0.g * w0) + (c1.g * w1)) / sum),
+            static_cast<uint8_t>(((c0.b * w0) + (c1.b * w1)) / sum),
+            0xff,
+        };
+    }
+
+    /// @brief Builds the four colors of a S3TC color block
+    /// @param punchThrough DXT1 with alpha: The fourth color is transparent in the three color mode
+    /// @param fourColorMode DXT3 and DXT5 always use the four color mode
+    static std::array<RGBA, 4> getColorPalette(const uint8_t* src, const bool punchThrough, const bool fourColorMode)
+    {
+        const uint16_t c0 = readUint16(src);
+        const uint16_t c1 = readUint16(src + 2);
+        std::array<RGBA, 4> palette;
+        palette[0] = expandRGB565(c0);
+        palette[1] = expandRGB565(c1);
+        if (fourColorMode || (c0 > c1))
+        {
+            palette[2] = mix(palette[0], palette[1], 2, 1);
+            palette[3] = mix(palette[0], palette[1], 1, 2);
+        }
+        else
+        {
+            palette[2] = mix(palette[0], palette[1], 1, 1);
+            palette[3] = { 0, 0, 0, static_cast<uint8_t>(punchThrough ? 0 : 0xff) };
+        }
+        return palette;
+    }
+
+    static uint32_t readColorIndices(const uint8_t* src)
+    {
+        return static_cast<uint32_t>(src[4]) | (static_cast<uint32_t>(src[5]) << 8) | (static_cast<uint32_t>(src[6]) << 16) | (static_cast<uint32_t>(src[7]) << 24);
+    }
+
+    template <typename TPixel, typename TConvert>
+    static void decodeDXT1Block(Block<TPixel>& block, const TConvert& convert, const uint8_t* src, const bool punchThrough)
+    {
+        const std::array<RGBA, 4> palette = getColorPalette(src, punchThrough, false);
+        std::array<TPixel, 4> devicePalette;
+        for (std::size_t i = 0; i < devicePalette.size(); i++)
+        {
+            devicePalette[i] = convert(palette[i]);
+        }
+        const uint32_t indices = readColorIndices(src);
+        for (std::size_t i = 0; i < block.size(); i++)
+        {
+            block[i] = devicePalette[(indices >> (2 * i)) & 0x3];
+        }
+    }
+
+    template <typename TPixel, typename TConvert>
+    static void decodeDXT3Block(Block<TPixel>& block, const TConvert& convert, const uint8_t* src)
+    {
+        const std::array<RGBA, 4> palette = getColorPalette(src + 8, false, true);
+        const uint32_t indices = readColorIndices(src + 8);
+        for (std::size_t i = 0; i < block.size(); i++)
+        {
+            RGBA color = palette[(indices >> (2 * i)) & 0x3];
+            const uint8_t alpha = (src[i / 2] >> ((i % 2) * 4)) & 0xf;
+            color.a = static_cast<uint8_t>(alpha * 17);
+            block[i] = convert(color);
+        }
+    }
+
+    template <typename TPixel, typename TConvert>
+    static void decodeDXT5Block(Block<TPixel>& block, const TConvert& convert, const uint8_t* src)
+    {
+        std::array<uint8_t, 8> alphas;
+        alphas[0] = src[0];
+        alphas[1] = src[1];
+        if (alphas[0] > alphas[1])
+        {
+            for (uint32_t i = 1; i < 7; i++)
+            {
+                alphas[i + 1] = static_cast<uint8_t>((((7 - i) * alphas[0]) + (i * alphas[1])) / 7);
+            }
+        }
+        else
+        {
+            for (uint32_t i = 1; i < 5; i++)
+            {
+                alphas[i + 1] = static_cast<uint8_t>((((5 - i) * alphas[0]) + (i * alphas[1])) / 5);
+            }
+            alphas[6] = 0;
+            alphas[7] = 0xff;
+        }
+        uint64_t alphaIndices = 0;
+        for (std::size_t i = 0; i < 6; i++)
+        {
+            alphaIndices |= static_cast<uint64_t>(src[2 + i]) << (8 * i);
+        }
+
+        const std::array<RGBA, 4> palette = getColorPalette(src + 8, false, true);
+        const uint32_t indices = readColorIndices(src + 8);
+        for (std::size_t i = 0; i < block.size(); i++)
+        {
+            RGBA color = palette[(indices >> (2 * i)) & 0x3];
+            color.a = alphas[(alphaIndices >> (3 * i)) & 0x7];
+            block[i] = convert(color);
+        }
+    }
+
+    template <typename TPixel, typename TConvert>
+    static void decodeETC1Block(Block<TPixel>& block, const TConvert& convert, const uint8_t* src)
+    {
+        static constexpr std::array<std::array<int32_t, 4>, 8> MODIFIERS { {
+            { 2, 8, -2, -8 },
+            { 5, 17, -5, -17 },
+            { 9, 29, -9, -29 },
+            { 13, 42, -13, -42 },
+            { 18, 60, -18, -60 },
+            { 24, 80, -24, -80 },
+            { 33, 106, -33, -106 },
+            { 47, 183, -47, -183 },
+        } };
+
+        // The block is stored in big endian
+        const uint32_t high = (static_cast<uint32_t>(src[0]) << 24) | (static_cast<uint32_t>(src[1]) << 16) | (static_cast<uint32_t>(src[2]) << 8) | src[3];
+        const uint32_t low = (static_cast<uint32_t>(src[4]) << 24) | (static_cast<uint32_t>(src[5]) << 16) | (static_cast<uint32_t>(src[6]) << 8) | src[7];
+        const bool flip = high & 0x1;
+        const bool diff = (high >> 1) & 0x1;
+
+        std::array<std::array<int32_t, 3>, 2> baseColors;
+        if (diff)
+        {
+            for (std::size_t c = 0; c < 3; c++)
+            {
+                const int32_t base = (high >> (27 - (8 * c))) & 0x1f;
+                int32_t delta = (high >> (24 - (8 * c))) & 0x7;
+                delta = (delta >= 4) ? (delta - 8) : delta;
+                const int32_t base2 = (base + delta) & 0x1f;
+                baseColors[0][c] = (base << 3) | (base >> 2);
+                baseColors[1][c] = (base2 << 3) | (base2 >> 2);
+            }
+        }
+        else
+        {
+            for (std::size_t c = 0; c < 3; c++)
+            {
+                const int32_t base = (high >> (28 - (8 * c))) & 0xf;
+                const int32_t base2 = (high >> (24 - (8 * c))) & 0xf;
+                baseColors[0][c] = (base << 4) | base;
+                baseColors[1][c] = (base2 << 4) | base2;
+            }
+        }
+
+        std::array<std::array<TPixel, 4>, 2> devicePalettes;
+        for (std::size_t s = 0; s < devicePalettes.size(); s++)
+        {
+            const uint32_t table = (high >> ((s == 0) ? 5 : 2)) & 0x7;
+            for (std::size_t i = 0; i < 4; i++)
+            {
+                const int32_t modifier = MODIFIERS[table][i];
+                const RGBA color {
+                    static_cast<uint8_t>(std::clamp(baseColors[s][0] + modifier, 0, 255)),
+                    static_cast<uint8_t>(std::clamp(baseColors[s][1] + modifier, 0, 255)),
+                    static_cast<uint8_t>(std::clamp(baseColors[s][2] + modifier, 0, 255)),
+                    0xff,
+                };
+                devicePalettes[s][i] = convert(color);
+            }
+        }
+
+        // The pixel indices are stored column major
+        for (std::size_t x = 0; x < BLOCK_DIM; x++)
+        {
+            for (std::size_t y = 0; y < BLOCK_DIM; y++)
+            {
+                const std::size_t k = (x * BLOCK_DIM) + y;
+                const uint32_t index = (((low >> (16 + k)) & 0x1) << 1) | ((low >> k) & 0x1);
+                const std::size_t subBlock = flip ? (y / 2) : (x / 2);
+                block[(y * BLOCK_DIM) + x] = devicePalettes[subBlock][index];
+            }
+        }
+    }
+};
+
+} // namespace rr
+
+#endif // GL_COMPRESSED_IMAGE_DECODER_HPP_
@@ -33,12 +33,16 @@ public:
     /// @param offset The offset in the buffer to start uploading from
     /// @note: A new transfer is started when the previous one is finished.
     ///     As long as the previous one is ongoing, this function blocks.
+    ///     Implementations which queue transfers (see queuesTransfers()) return without waiting. The buffer is
+    ///     in this case in flight until blockUntilTransferIsComplete() is called or the buffer is requested again.
     virtual void writeData(const uint8_t index, const uint32_t size, const uint32_t offset = 0) = 0;
 
     /// @brief Downloads a chunk of data
     /// @param index The index of the buffer to download
     /// @param size How many bytes of this buffer to download
     /// @note: This function blocks until the read operation is done.
+    ///     Implementations which queue transfers (see queuesTransfers()) might return earlier. The data is in
+    ///     this case valid after requestReadBuffer() or blockUntilTransferIsComplete() was called.
     virtual void readData(const uint8_t index, const uint32_t size) = 0;
 
     /// @brief Blocks until a new read()/write() can be called without blocking.
@@ -62,6 +66,15 @@ public:
     /// @brief Returns the number of buffers available to request
     /// @return The number of buffers which can be requested
     virtual uint8_t getReadBufferCount() const = 0;
+
+    /// @brief Tells if the transfers are queued
+    /// @details A bus connector which queues transfers executes them in submission order and guarantees, that
+    ///     requestWriteBuffer() and requestReadBuffer() wait until the transfers of the requested buffer are
+    ///     complete. The user can therefore reuse a buffer without calling blockUntilTransferIsComplete().
+    ///     Other bus connectors hand out the buffers immediately. A buffer must then only be reused after
+    ///     blockUntilTransferIsComplete() was called.
+    /// @return true if the transfers are queued
+    virtual bool queuesTransfers() const { return false; }
 };
 
 } // namespace rr
@@ -19,12 +19,16 @@
 #define GL_IMAGE_CONVERTER_HPP_
 
 #include "Enums.hpp"
+#include "ImageResampler.hpp"
+#include "MipMapKernels.hpp"
 #include "RIXGL.hpp"
+#include "UnpackKernels.hpp"
 #include "gl.h"
 #include <algorithm>
 #include <cstring>
 #include <memory>
 #include <spdlog/spdlog.h>
+#include <vector>
 
 namespace rr
 {
@@ -32,6 +36,14 @@ namespace rr
 class ImageConverter
 {
 public:
+    /// @brief Selects the power of two size of a not power of two texture
+    enum class NpotRounding
+    {
+        NEXT, ///< Rounds up to the next power of two
+        NEAREST, ///< Rounds to the nearest power of two. Rounds up if both are equally far away.
+        DOWN, ///< Rounds down to the previous power of two to save texture memory
+    };
+
     void convertUnpack(
         std::shared_ptr<uint16_t> texelsDevice,
         const InternalPixelFormat ipf,
@@ -44,6 +56,20 @@ public:
         const GLenum type,
         const uint8_t* texelsClient)
     {
+        const UnpackKernels::RowConverter rowConverter = UnpackKernels::getRowConverter(ipf, format, type);
+        if (rowConverter.convertRow)
+        {
+            const std::size_t rowSize = alignRow(rowConverter.pixelSize * width, m_unpackAlignment);
+            for (GLsizei row = 0; row < height; row++)
+            {
+                rowConverter.convertRow(
+                    texelsDevice.get() + ((row + yoffset) * rowLength) + xoffset,
+                    texelsClient + (row * rowSize),
+                    width);
+            }
+            return;
+        }
+
         const uint8_t* texelsClientRow = texelsClient;
         for (std::size_t row = yoffset; row < static_cast<std::size_t>(height + yoffset); row++)
         {
@@ -59,24 +85,119 @@ public:
         }
     }
 
-    void convertRGB565ToPackedRGBA8888(
-        uint8_t* pixelsClient,
+    /// @brief Converts an image and resamples it to the size of the texture
+    /// @param rowLength The width of the texture
+    /// @param xoffset The column of the texture where the resampled image starts
+    /// @param yoffset The row of the texture where the resampled image starts
+    /// @param textureWidth The width of the resampled image
+    /// @param textureHeight The height of the resampled image
+    /// @param width The width of the client image
+    /// @param height The height of the client image
+    void convertUnpackRescaled(
+        std::shared_ptr<uint16_t> texelsDevice,
+        const InternalPixelFormat ipf,
+        const std::size_t rowLength,
+        const std::size_t xoffset,
+        const std::size_t yoffset,
+        const std::size_t textureWidth,
+        const std::size_t textureHeight,
         const GLsizei width,
         const GLsizei height,
-        const uint16_t* pixelsDevice)
+        const GLenum format,
+        const GLenum type,
+        const uint8_t* texelsClient)
     {
-        uint8_t* pixelsClientRow = pixelsClient;
-        for (std::size_t row = 0; row < static_cast<std::size_t>(height); row++)
+        std::vector<RGBA> image(width * height);
+        const uint8_t* texelsClientRow = texelsClient;
+        for (GLsizei row = 0; row < height; row++)
         {
             std::size_t currentRow { 0 };
-            for (std::size_t column = 0; column < static_cast<std::size_t>(width); column++)
+            for (GLsizei column = 0; column < width; column++)
+            {
+                currentRow += clientToRGBA8888(image[(row * width) + column], format, type, texelsClientRow + currentRow);
+            }
+            texelsClientRow = texelsClientRow + alignRow(currentRow, m_unpackAlignment);
+        }
+        resampleToDevice(texelsDevice, ipf, rowLength, xoffset, yoffset, textureWidth, textureHeight, image.data(), width, height);
+    }
+
+    /// @brief Returns the power of two size which is used to store a texture with the given size
+    /// @return The size selected with the NpotRounding, or zero if size is zero
+    std::size_t getPowerOfTwoSize(const std::size_t size) const
+    {
+        if (size == 0)
+        {
+            return 0;
+        }
+        std::size_t next = 1;
+        while (next < size)
+        {
+            next <<= 1;
+        }
+        if (next == size)
+        {
+            return size;
+        }
+        const std::size_t previous = next >> 1;
+        switch (m_npotRounding)
+        {
+        case NpotRounding::DOWN:
+            return previous;
+        case NpotRounding::NEAREST:
+            return ((next - size) <= (size - previous)) ? next : previous;
+        default:
+            return next;
+        }
+    }
+
+    /// @brief Checks if a format and type combination can be produced by convertPack()
+    static bool isPackFormatSupported(const GLenum format, const GLenum type)
+    {
+        return getPackedPixelSize(format, type) != 0;
+    }
+
+    /// @brief Converts RGB565 pixels from the color buffer into the client format
+    /// @param pixelsClient The client buffer. The rows are aligned to the pack alignment.
+    /// @param getRow Returns a pointer to the width device pixels of a row
+    /// @return false if the format and type combination is not supported
+    template <typename TGetRow>
+    bool convertPack(
+        uint8_t* pixelsClient,
+        const GLsizei width,
+        const GLsizei height,
+        const GLenum format,
+        const GLenum type,
+        TGetRow&& getRow)
+    {
+        const std::size_t pixelSize = getPackedPixelSize(format, type);
+        if (pixelSize == 0)
+        {
+            return false;
+        }
+        const std::size_t rowSize = alignRow(pixelSize * width, m_packAlignment);
+        for (GLsizei row = 0; row < height; row++)
+        {
+            const uint16_t* pixelsDevice = getRow(row);
+            uint8_t* pixelsClientRow = pixelsClient + (row * rowSize);
+            // Select the conversion per row to keep the inner loops free of branches
+            if (type == GL_UNSIGNED_SHORT_5_6_5)
+            {
+                std::memcpy(pixelsClientRow, pixelsDevice, width * sizeof(uint16_t));
+            }
+            else if (format == GL_RGBA)
             {
-                const std::size_t pixelPos { (row * width) + column };
-                clientColorToRGBA8888(pixelsClientRow + currentRow, pixelsDevice[pixelPos]);
-                currentRow += 4;
+                convertRowRGB565ToUnsignedByte<0, 1, 2, true>(pixelsClientRow, width, pixelsDevice);
+            }
+            else if (format == GL_BGRA)
+            {
+                convertRowRGB565ToUnsignedByte<2, 1, 0, true>(pixelsClientRow, width, pixelsDevice);
+            }
+            else
+            {
+                convertRowRGB565ToUnsignedByte<0, 1, 2, false>(pixelsClientRow, width, pixelsDevice);
             }
-            pixelsClientRow = pixelsClientRow + alignRow(currentRow, m_packAlignment);
         }
+        return true;
     }
 
     static GLenum convertInternalPixelFormat(InternalPixelFormat& conf, const GLint internalFormat)
@@ -161,6 +282,25 @@ public:
         const std::size_t baseWidth,
         const std::size_t baseHeight,
         const std::shared_ptr<uint16_t> baseImage)
+    {
+        return computeMipMapLevel(newMipMapLevel, ipf, baseWidth, baseHeight, baseImage, 0, 0, baseWidth / 2, baseHeight / 2);
+    }
+
+    /// @brief Computes only a region of a mip map level. The other pixels of the new level are not touched.
+    /// @param x The x offset of the region in the new level
+    /// @param y The y offset of the region in the new level
+    /// @param width The width of the region in the new level
+    /// @param height The height of the region in the new level
+    static bool computeMipMapLevel(
+        std::shared_ptr<uint16_t> newMipMapLevel,
+        const InternalPixelFormat ipf,
+        const std::size_t baseWidth,
+        const std::size_t baseHeight,
+        const std::shared_ptr<uint16_t> baseImage,
+        const std::size_t x,
+        const std::size_t y,
+        const std::size_t width,
+        const std::size_t height)
     {
         if ((baseWidth <= 1) || (baseHeight <= 1))
         {
@@ -168,41 +308,12 @@ public:
         }
         const std::size_t newWidth = baseWidth / 2;
         const std::size_t newHeight = baseHeight / 2;
-
-        for (std::size_t w = 0; w < newWidth; w++)
+        if (((x + width) > newWidth) || ((y + height) > newHeight))
         {
-            for (std::size_t h = 0; h < newHeight; h++)
-            {
-                const uint16_t baseDeviceColor00 = baseImage.get()[(baseWidth * ((h * 2) + 0)) + ((w * 2) + 0)];
-                const uint16_t baseDeviceColor10 = baseImage.get()[(baseWidth * ((h * 2) + 1)) + ((w * 2) + 0)];
-                const uint16_t baseDeviceColor01 = baseImage.get()[(baseWidth * ((h * 2) + 0)) + ((w * 2) + 1)];
-                const uint16_t baseDeviceColor11 = baseImage.get()[(baseWidth * ((h * 2) + 1)) + ((w * 2) + 1)];
-                const RGBA baseRgbaColor00 = deviceToRGBA8888(baseDeviceColor00, ipf);
-                const RGBA baseRgbaColor10 = deviceToRGBA8888(baseDeviceColor10, ipf);
-                const RGBA baseRgbaColor01 = deviceToRGBA8888(baseDeviceColor01, ipf);
-                const RGBA baseRgbaColor11 = deviceToRGBA8888(baseDeviceColor11, ipf);
-
-                std::function<uint8_t(const uint8_t, const uint8_t, const uint8_t, const uint8_t)> subPixelCombiner =
-                    [](const uint8_t c00, const uint8_t c01, const uint8_t c10, const uint8_t c11)
-                {
-                    const uint16_t c1600 = static_cast<uint16_t>(c00);
-                    const uint16_t c1601 = static_cast<uint16_t>(c01);
-                    const uint16_t c1610 = static_cast<uint16_t>(c10);
-                    const uint16_t c1611 = static_cast<uint16_t>(c11);
-                    const uint16_t cSum = c1600 + c1601 + c1610 + c1611;
-                    return static_cast<uint8_t>(cSum / 4);
-                };
-
-                const RGBA mipMapColor {
-                    subPixelCombiner(baseRgbaColor00.r, baseRgbaColor01.r, baseRgbaColor10.r, baseRgbaColor11.r),
-                    subPixelCombiner(baseRgbaColor00.g, baseRgbaColor01.g, baseRgbaColor10.g, baseRgbaColor11.g),
-                    subPixelCombiner(baseRgbaColor00.b, baseRgbaColor01.b, baseRgbaColor10.b, baseRgbaColor11.b),
-                    subPixelCombiner(baseRgbaColor00.a, baseRgbaColor01.a, baseRgbaColor10.a, baseRgbaColor11.a),
-                };
-
-                newMipMapLevel.get()[(newWidth * h) + w] = RGBA8888ToDevice(ipf, mipMapColor);
-            }
+            return false;
         }
+
+        MipMapKernels::computeRegion(newMipMapLevel.get(), ipf, baseImage.get(), baseWidth, x, y, width, height);
         return true;
     }
 
@@ -211,7 +322,16 @@ public:
     std::size_t getUnpackAlignment() const { return m_unpackAlignment; }
     std::size_t getPackAlignment() const { return m_packAlignment; }
 
+    /// @brief Sets how not power of two textures are rounded to a power of two
+    void setNpotRounding(const NpotRounding rounding) { m_npotRounding = rounding; }
+    /// @brief Sets the filter which resamples not power of two textures
+    void setNpotFilter(const ImageResampler::Filter filter) { m_npotFilter = filter; }
+    NpotRounding getNpotRounding() const { return m_npotRounding; }
+    ImageResampler::Filter getNpotFilter() const { return m_npotFilter; }
+
 private:
+    friend class CompressedImageDecoder;
+
     struct RGBA
     {
         uint8_t r;
@@ -219,6 +339,40 @@ private:
         uint8_t b;
         uint8_t a;
     };
+    static_assert(sizeof(RGBA) == ImageResampler::CHANNELS, "The resampler expects tightly packed RGBA8888 pixels");
+
+    /// @brief Resamples a RGBA8888 image with the NPOT filter and stores it in the device format
+    /// @param image The image with width * height pixels
+    void resampleToDevice(
+        std::shared_ptr<uint16_t> texelsDevice,
+        const InternalPixelFormat ipf,
+        const std::size_t rowLength,
+        const std::size_t xoffset,
+        const std::size_t yoffset,
+        const std::size_t textureWidth,
+        const std::size_t textureHeight,
+        const RGBA* image,
+        const std::size_t width,
+        const std::size_t height) const
+    {
+        std::vector<RGBA> rescaled(textureWidth * textureHeight);
+        ImageResampler::resample(
+            reinterpret_cast<uint8_t*>(rescaled.data()),
+            textureWidth,
+            textureHeight,
+            reinterpret_cast<const uint8_t*>(image),
+            width,
+            height,
+            m_npotFilter);
+
+        for (std::size_t row = 0; row < textureHeight; row++)
+        {
+            for (std::size_t column = 0; column < textureWidth; column++)
+            {
+                texelsDevice.get()[((row + yoffset) * rowLength) + column + xoffset] = RGBA8888ToDevice(ipf, rescaled[(row * textureWidth) + column]);
+            }
+        }
+    }
 
     static RGBA deviceToRGBA8888(const uint16_t deviceColor, const InternalPixelFormat ipf)
     {
@@ -311,12 +465,45 @@ private:
         return currentRow;
     }
 
-    void clientColorToRGBA8888(uint8_t* clientPixels, const uint16_t devicePixels)
+    static std::size_t getPackedPixelSize(const GLenum format, const GLenum type)
+    {
+        if ((format == GL_RGBA) && (type == GL_UNSIGNED_BYTE))
+        {
+            return 4;
+        }
+        if ((format == GL_BGRA) && (type == GL_UNSIGNED_BYTE))
+        {
+            return 4;
+        }
+        if ((format == GL_RGB) && (type == GL_UNSIGNED_BYTE))
+        {
+            return 3;
+        }
+        if ((format == GL_RGB) && (type == GL_UNSIGNED_SHORT_5_6_5))
+        {
+            return 2;
+        }
+        return 0;
+    }
+
+    // Converts a row of RGB565 pixels into 8 bit components. R, G and B are the positions of the
+    // components in the client pixel. The alpha component is always the last one and set to opaque.
+    template <std::size_t R, std::size_t G, std::size_t B, bool HasAlpha>
+    static void convertRowRGB565ToUnsignedByte(uint8_t* clientPixels, const GLsizei width, const uint16_t* devicePixels)
     {
-        clientPixels[0] = convertColorComponentToUint8<11, 5, 0x1f>(devicePixels);
-        clientPixels[1] = convertColorComponentToUint8<5, 6, 0x3f>(devicePixels);
-        clientPixels[2] = convertColorComponentToUint8<0, 5, 0x1f>(devicePixels);
-        clientPixels[3] = 0xff;
+        static constexpr std::size_t PixelSize = HasAlpha ? 4 : 3;
+        for (GLsizei column = 0; column < width; column++)
+        {
+            const uint16_t devicePixel = devicePixels[column];
+            uint8_t* clientPixel = clientPixels + (column * PixelSize);
+            if constexpr (HasAlpha)
+            {
+                clientPixel[3] = 0xff;
+            }
+            clientPixel[R] = convertColorComponentToUint8<11, 5, 0x1f>(devicePixel);
+            clientPixel[G] = convertColorComponentToUint8<5, 6, 0x3f>(devicePixel);
+            clientPixel[B] = convertColorComponentToUint8<0, 5, 0x1f>(devicePixel);
+        }
     }
 
     std::size_t clientToRGBA8888(
@@ -705,6 +892,8 @@ private:
 
     std::size_t m_unpackAlignment { 4 };
     std::size_t m_packAlignment { 4 };
+    NpotRounding m_npotRounding { NpotRounding::NEXT };
+    ImageResampler::Filter m_npotFilter { ImageResampler::Filter::BILINEAR };
 };
 } // namespace rr
 
@@ -0,0 +1,171 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef IMAGE_RESAMPLER_HPP_
+#define IMAGE_RESAMPLER_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace rr
+{
+
+/// @brief Resamples RGBA8888 images to another size with a separable filter
+/// @details The image is first filtered horizontally and then vertically. The weights are computed once per axis
+///     in fixed point. The weights of an output pixel always sum up to one, which keeps constant areas unchanged.
+class ImageResampler
+{
+public:
+    enum class Filter
+    {
+        BOX, ///< Averages all source pixels covered by the output pixel, weighted by the covered area
+        BILINEAR, ///< Interpolates between the two source pixels next to the center of the output pixel
+    };
+
+    static constexpr std::size_t CHANNELS { 4 };
+
+    /// @brief Resamples an image
+    /// @param dst The destination image with dstWidth * dstHeight pixels
+    /// @param src The source image with srcWidth * srcHeight pixels
+    static void resample(
+        uint8_t* dst,
+        const std::size_t dstWidth,
+        const std::size_t dstHeight,
+        const uint8_t* src,
+        const std::size_t srcWidth,
+        const std::size_t srcHeight,
+        const Filter filter)
+    {
+        if ((dstWidth == 0) || (dstHeight == 0) || (srcWidth == 0) || (srcHeight == 0))
+        {
+            return;
+        }
+        const Weights horizontal = computeWeights(dstWidth, srcWidth, filter);
+        const Weights vertical = computeWeights(dstHeight, srcHeight, filter);
+
+        std::vector<uint8_t> tmp(dstWidth * srcHeight * CHANNELS);
+        for (std::size_t row = 0; row < srcHeight; row++)
+        {
+            filterLine(tmp.data() + (row * dstWidth * CHANNELS), CHANNELS, dstWidth, src + (row * srcWidth * CHANNELS), CHANNELS, horizontal);
+        }
+        for (std::size_t column = 0; column < dstWidth; column++)
+        {
+            filterLine(dst + (column * CHANNELS), dstWidth * CHANNELS, dstHeight, tmp.data() + (column * CHANNELS), dstWidth * CHANNELS, vertical);
+        }
+    }
+
+private:
+    static constexpr uint32_t WEIGHT_SHIFT { 14 };
+    static constexpr uint32_t WEIGHT_ONE { 1u << WEIGHT_SHIFT };
+
+    struct Weights
+    {
+        std::size_t taps { 0 }; ///< Number of source pixels per output pixel
+        std::vector<std::size_t> indices {}; ///< taps source pixels per output pixel
+        std::vector<uint32_t> weights {}; ///< taps weights per output pixel
+    };
+
+    // Filters one line. The strides are the distances between two pixels in bytes.
+    static void filterLine(
+        uint8_t* dst,
+        const std::size_t dstStride,
+        const std::size_t dstSize,
+        const uint8_t* src,
+        const std::size_t srcStride,
+        const Weights& weights)
+    {
+        for (std::size_t i = 0; i < dstSize; i++)
+        {
+            const std::size_t* indices = weights.indices.data() + (i * weights.taps);
+            const uint32_t* w = weights.weights.data() + (i * weights.taps);
+            uint32_t acc[CHANNELS] {};
+            for (std::size_t tap = 0; tap < weights.taps; tap++)
+            {
+                const uint8_t* pixel = src + (indices[tap] * srcStride);
+                for (std::size_t c = 0; c < CHANNELS; c++)
+                {
+                    acc[c] += w[tap] * pixel[c];
+                }
+            }
+            for (std::size_t c = 0; c < CHANNELS; c++)
+            {
+                dst[(i * dstStride) + c] = static_cast<uint8_t>((acc[c] + (WEIGHT_ONE / 2)) >> WEIGHT_SHIFT);
+            }
+        }
+    }
+
+    static Weights computeWeights(const std::size_t dstSize, const std::size_t srcSize, const Filter filter)
+    {
+        Weights weights {};
+        if (filter == Filter::BILINEAR)
+        {
+            // The center of the output pixel i is at ((2 * i + 1) * srcSize - dstSize) / (2 * dstSize) in the source
+            weights.taps = 2;
+            weights.indices.resize(dstSize * weights.taps);
+            weights.weights.resize(dstSize * weights.taps);
+            for (std::size_t i = 0; i < dstSize; i++)
+            {
+                const std::size_t pos = ((((2 * i) + 1) * srcSize) > dstSize) ? ((((2 * i) + 1) * srcSize) - dstSize) : 0;
+                std::size_t first = pos / (2 * dstSize);
+                uint32_t second = static_cast<uint32_t>(((pos % (2 * dstSize)) * WEIGHT_ONE) / (2 * dstSize));
+                if (first >= (srcSize - 1))
+                {
+                    first = srcSize - 1;
+                    second = 0;
+                }
+                weights.indices[(i * 2) + 0] = first;
+                weights.indices[(i * 2) + 1] = (std::min)(first + 1, srcSize - 1);
+                weights.weights[(i * 2) + 0] = WEIGHT_ONE - second;
+                weights.weights[(i * 2) + 1] = second;
+            }
+            return weights;
+        }
+
+        // The output pixel i covers [i * srcSize, (i + 1) * srcSize) and the source pixel j covers
+        // [j * dstSize, (j + 1) * dstSize) in units of 1 / dstSize source pixels.
+        weights.taps = ((srcSize + dstSize - 1) / dstSize) + 1;
+        weights.indices.resize(dstSize * weights.taps);
+        weights.weights.resize(dstSize * weights.taps);
+        for (std::size_t i = 0; i < dstSize; i++)
+        {
+            const std::size_t begin = i * srcSize;
+            const std::size_t end = (i + 1) * srcSize;
+            const std::size_t first = begin / dstSize;
+            uint32_t sum = 0;
+            std::size_t largest = 0;
+            for (std::size_t tap = 0; tap < weights.taps; tap++)
+            {
+                const std::size_t j = (std::min)(first + tap, srcSize - 1);
+                const std::size_t coverBegin = (std::max)(begin, (first + tap) * dstSize);
+                const std::size_t coverEnd = (std::min)(end, (first + tap + 1) * dstSize);
+                const uint32_t w = (coverEnd > coverBegin) ? static_cast<uint32_t>(((coverEnd - coverBegin) * WEIGHT_ONE) / srcSize) : 0;
+                weights.indices[(i * weights.taps) + tap] = j;
+                weights.weights[(i * weights.taps) + tap] = w;
+                largest = (w > weights.weights[(i * weights.taps) + largest]) ? tap : largest;
+                sum += w;
+            }
+            // Rounding errors of the fixed point weights are added to the largest weight
+            weights.weights[(i * weights.taps) + largest] += WEIGHT_ONE - sum;
+        }
+        return weights;
+    }
+};
+
+} // namespace rr
+
+#endif // IMAGE_RESAMPLER_HPP_
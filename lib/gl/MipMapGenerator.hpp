@@ -21,6 +21,7 @@
 #include "Enums.hpp"
 #include "ImageConverter.hpp"
 #include "RIXGL.hpp"
+#include "TexturePixelAllocator.hpp"
 #include "gl.h"
 #include "renderer/TextureObject.hpp"
 #include <algorithm>
@@ -33,6 +34,11 @@ namespace rr
 class MipMapGenerator
 {
 public:
+    explicit MipMapGenerator(TexturePixelAllocator& allocator)
+        : m_allocator { allocator }
+    {
+    }
+
     void generateMipMap(TextureObject& textureObject, const std::size_t baseLevel)
     {
         if (m_enableMipMapGeneration)
@@ -41,45 +47,120 @@ public:
         }
     }
 
+    /// @brief Updates the existing mip maps below the base level for a changed region of the base level
+    /// @param onLevelUpdated Called with the level, x, y, width and height of every updated region
+    /// @return false if a mip level is missing. Nothing is changed in this case.
+    template <typename TOnLevelUpdated>
+    bool generateMipMapRegion(
+        TextureObject& textureObject,
+        const std::size_t baseLevel,
+        std::size_t x,
+        std::size_t y,
+        std::size_t width,
+        std::size_t height,
+        const TOnLevelUpdated& onLevelUpdated)
+    {
+        if (!m_enableMipMapGeneration)
+        {
+            return true;
+        }
+
+        const std::size_t levels = textureObject.getLevels();
+        for (std::size_t i = baseLevel; (i < levels - 1) && ((textureObject.getWidth(i) != 1) || (textureObject.getHeight(i) != 1)); i++)
+        {
+            if (!textureObject.getPixels(i + 1))
+            {
+                return false;
+            }
+        }
+
+        for (std::size_t i = baseLevel; i < levels - 1; i++)
+        {
+            // Every pixel of the next level which is computed from at least one changed pixel
+            const std::size_t x0 = x / 2;
+            const std::size_t y0 = y / 2;
+            const std::size_t x1 = (std::min)((x + width + 1) / 2, textureObject.getWidth(i) / 2);
+            const std::size_t y1 = (std::min)((y + height + 1) / 2, textureObject.getHeight(i) / 2);
+            if ((x1 <= x0) || (y1 <= y0))
+            {
+                return true;
+            }
+            if (!ImageConverter::computeMipMapLevel(
+                    textureObject.getPixels(i + 1),
+                    textureObject.getInternalPixelFormat(i),
+                    textureObject.getWidth(i),
+                    textureObject.getHeight(i),
+                    textureObject.getPixels(i),
+                    x0,
+                    y0,
+                    x1 - x0,
+                    y1 - y0))
+            {
+                return true;
+            }
+            x = x0;
+            y = y0;
+            width = x1 - x0;
+            height = y1 - y0;
+            textureObject.setCompressedPixels(i + 1, {});
+            onLevelUpdated(i + 1, x, y, width, height);
+        }
+        return true;
+    }
+
     void setEnableMipMapGeneration(const bool enableGeneration) { m_enableMipMapGeneration = enableGeneration; }
     bool getEnableMipMapGeneration() const { return m_enableMipMapGeneration; }
 
 private:
-    static void mipMapCreator(TextureObject& textureObject, const std::size_t baseLevel)
+    void mipMapCreator(TextureObject& textureObject, const std::size_t baseLevel)
     {
         using PixelType = TextureObject::PixelsType::element_type;
 
+        // Levels are generated until the 1x1 texture or the last level is reached
         const std::size_t levels = textureObject.getLevels();
-        for (std::size_t i = baseLevel; i < levels - 1; i++)
+        std::size_t lastLevel = baseLevel;
+        while (((lastLevel + 1) < levels) && ((textureObject.getWidth(lastLevel) != 1) || (textureObject.getHeight(lastLevel) != 1)))
         {
-            if ((textureObject.getWidth(i) == 1) && (textureObject.getHeight(i) == 1))
-            {
-                // No more mip map reduction is available. The 1x1 texture is reached
-                return;
-            }
+            lastLevel++;
+        }
+        if (lastLevel == baseLevel)
+        {
+            return;
+        }
 
-            std::shared_ptr<PixelType> texMemShared(
-                new PixelType[textureObject.getSizeInBytes(i + 1) / sizeof(PixelType)],
-                [](const PixelType* p)
-                { delete[] p; });
+        // All levels share one allocation
+        std::size_t memorySize = 0;
+        for (std::size_t i = baseLevel + 1; i <= lastLevel; i++)
+        {
+            memorySize += textureObject.getWidth(i) * textureObject.getHeight(i);
+        }
+        std::shared_ptr<PixelType> texMemShared = m_allocator.allocate(memorySize);
 
-            if (!texMemShared)
-            {
-                RIXGL::getInstance().setError(GL_OUT_OF_MEMORY);
-                SPDLOG_ERROR("mipMapCreator Out Of Memory");
-                return;
-            }
-            textureObject.setPixels(i + 1, texMemShared);
+        if (!texMemShared)
+        {
+            RIXGL::getInstance().setError(GL_OUT_OF_MEMORY);
+            SPDLOG_ERROR("mipMapCreator Out Of Memory");
+            return;
+        }
+        std::size_t offset = 0;
+        for (std::size_t i = baseLevel + 1; i <= lastLevel; i++)
+        {
+            textureObject.setPixels(i, { texMemShared, texMemShared.get() + offset });
+            offset += textureObject.getWidth(i) * textureObject.getHeight(i);
+        }
 
+        for (std::size_t level = baseLevel; level < lastLevel; level++)
+        {
             ImageConverter::computeMipMapLevel(
-                textureObject.getPixels(i + 1),
-                textureObject.getInternalPixelFormat(i),
-                textureObject.getWidth(i),
-                textureObject.getHeight(i),
-                textureObject.getPixels(i));
+                textureObject.getPixels(level + 1),
+                textureObject.getInternalPixelFormat(level),
+                textureObject.getWidth(level),
+                textureObject.getHeight(level),
+                textureObject.getPixels(level));
         }
     }
 
+    TexturePixelAllocator& m_allocator;
     bool m_enableMipMapGeneration { false };
 };
 } // namespace rr
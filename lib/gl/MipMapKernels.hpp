@@ -0,0 +1,214 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef MIP_MAP_KERNELS_HPP_
+#define MIP_MAP_KERNELS_HPP_
+
+#include "Enums.hpp"
+#include "SimdLanes.hpp"
+#include <cstdint>
+
+namespace rr
+{
+
+/// @brief 2x2 box filter kernels which compute a mip map level directly on the device formats
+/// @details The result is bit exact to expanding the four pixels to RGBA8888, averaging every component with
+///     truncation and converting the average back into the device format. The expansion and the average are folded
+///     into integer sums of the components:
+///     4 bit: (17 * sum) >> 6, 5 bit: ((sum << 3) + sum(c >> 2)) >> 5, 6 bit: ((sum << 2) + sum(c >> 4)) >> 4,
+///     1 bit: (sum + 1) >> 2.
+///     A lane holds two horizontal neighbours of a row, the left one in the lower 16 bits. This is how 16 bit pixels
+///     are loaded into 32 bit lanes on little endian machines. The kernel is selected once per level.
+class MipMapKernels
+{
+public:
+    /// @brief Computes a region of the next mip map level
+    /// @param newLevel The next level with a width of baseWidth / 2
+    /// @param baseLevel The current level
+    /// @param x The x offset of the region in the new level
+    /// @param y The y offset of the region in the new level
+    /// @param width The width of the region in the new level
+    /// @param height The height of the region in the new level
+    static void computeRegion(
+        uint16_t* newLevel,
+        const InternalPixelFormat ipf,
+        const uint16_t* baseLevel,
+        const std::size_t baseWidth,
+        const std::size_t x,
+        const std::size_t y,
+        const std::size_t width,
+        const std::size_t height)
+    {
+        switch (ipf)
+        {
+        case InternalPixelFormat::ALPHA:
+            computeRegion<InternalPixelFormat::ALPHA>(newLevel, baseLevel, baseWidth, x, y, width, height);
+            break;
+        case InternalPixelFormat::LUMINANCE:
+            computeRegion<InternalPixelFormat::LUMINANCE>(newLevel, baseLevel, baseWidth, x, y, width, height);
+            break;
+        case InternalPixelFormat::INTENSITY:
+            computeRegion<InternalPixelFormat::INTENSITY>(newLevel, baseLevel, baseWidth, x, y, width, height);
+            break;
+        case InternalPixelFormat::LUMINANCE_ALPHA:
+            computeRegion<InternalPixelFormat::LUMINANCE_ALPHA>(newLevel, baseLevel, baseWidth, x, y, width, height);
+            break;
+        case InternalPixelFormat::RGB:
+            computeRegion<InternalPixelFormat::RGB>(newLevel, baseLevel, baseWidth, x, y, width, height);
+            break;
+        case InternalPixelFormat::RGBA:
+            computeRegion<InternalPixelFormat::RGBA>(newLevel, baseLevel, baseWidth, x, y, width, height);
+            break;
+        case InternalPixelFormat::RGBA1:
+            computeRegion<InternalPixelFormat::RGBA1>(newLevel, baseLevel, baseWidth, x, y, width, height);
+            break;
+        default:
+            break;
+        }
+    }
+
+private:
+    template <InternalPixelFormat Ipf>
+    static void computeRegion(
+        uint16_t* newLevel,
+        const uint16_t* baseLevel,
+        const std::size_t baseWidth,
+        const std::size_t x,
+        const std::size_t y,
+        const std::size_t width,
+        const std::size_t height)
+    {
+        const std::size_t newWidth = baseWidth / 2;
+        for (std::size_t row = y; row < (y + height); row++)
+        {
+            const uint16_t* top = baseLevel + (baseWidth * row * 2);
+            const uint16_t* bottom = top + baseWidth;
+            uint16_t* dst = newLevel + (newWidth * row);
+            std::size_t column = x;
+#if defined(__SSE2__) || defined(__ARM_NEON)
+            for (; (column + 8) <= (x + width); column += 8)
+            {
+                simd::storeLow16(
+                    dst + column,
+                    filter<Ipf>(simd::load(top + (column * 2)), simd::load(bottom + (column * 2))),
+                    filter<Ipf>(simd::load(top + (column * 2) + 8), simd::load(bottom + (column * 2) + 8)));
+            }
+#endif
+            for (; column < (x + width); column++)
+            {
+                const uint32_t topPair = static_cast<uint32_t>(top[column * 2]) | (static_cast<uint32_t>(top[(column * 2) + 1]) << 16);
+                const uint32_t bottomPair = static_cast<uint32_t>(bottom[column * 2]) | (static_cast<uint32_t>(bottom[(column * 2) + 1]) << 16);
+                dst[column] = static_cast<uint16_t>(filter<Ipf>(topPair, bottomPair));
+            }
+        }
+    }
+
+    // Filters the two pixels in the lanes of top with the two pixels below them. The result is in the lower 16 bits.
+    template <InternalPixelFormat Ipf, typename T>
+    static T filter(const T top, const T bottom)
+    {
+        if constexpr (Ipf == InternalPixelFormat::ALPHA) // RGBA4444, only alpha is used
+        {
+            return average4<0>(top, bottom);
+        }
+        else if constexpr (Ipf == InternalPixelFormat::LUMINANCE) // RGB565, the red channel is replicated
+        {
+            const T r = simd::shiftRight<2>(expandedSum5<11>(top, bottom));
+            return simd::bitOr(simd::bitOr(
+                                   simd::shiftLeft<11>(simd::shiftRight<3>(r)),
+                                   simd::shiftLeft<5>(simd::shiftRight<2>(r))),
+                simd::shiftRight<3>(r));
+        }
+        else if constexpr (Ipf == InternalPixelFormat::INTENSITY) // RGBA4444, the red channel is replicated
+        {
+            const T r = average4<12>(top, bottom);
+            return simd::bitOr(simd::bitOr(r, simd::shiftLeft<4>(r)), simd::bitOr(simd::shiftLeft<8>(r), simd::shiftLeft<12>(r)));
+        }
+        else if constexpr (Ipf == InternalPixelFormat::LUMINANCE_ALPHA) // RGBA4444, the red channel is replicated
+        {
+            const T r = average4<12>(top, bottom);
+            return simd::bitOr(
+                simd::bitOr(simd::shiftLeft<4>(r), simd::shiftLeft<8>(r)),
+                simd::bitOr(simd::shiftLeft<12>(r), average4<0>(top, bottom)));
+        }
+        else if constexpr (Ipf == InternalPixelFormat::RGB) // RGB565
+        {
+            return simd::bitOr(simd::bitOr(
+                                   simd::shiftLeft<11>(average5<11>(top, bottom)),
+                                   simd::shiftLeft<5>(average6<5>(top, bottom))),
+                average5<0>(top, bottom));
+        }
+        else if constexpr (Ipf == InternalPixelFormat::RGBA) // RGBA4444
+        {
+            return simd::bitOr(
+                simd::bitOr(simd::shiftLeft<12>(average4<12>(top, bottom)), simd::shiftLeft<8>(average4<8>(top, bottom))),
+                simd::bitOr(simd::shiftLeft<4>(average4<4>(top, bottom)), average4<0>(top, bottom)));
+        }
+        else // RGBA5551
+        {
+            return simd::bitOr(
+                simd::bitOr(simd::shiftLeft<11>(average5<11>(top, bottom)), simd::shiftLeft<6>(average5<6>(top, bottom))),
+                simd::bitOr(simd::shiftLeft<1>(average5<1>(top, bottom)), average1<0>(top, bottom)));
+        }
+    }
+
+    // The averages return the component in the lower bits
+    template <std::size_t Pos, typename T>
+    static T average4(const T top, const T bottom)
+    {
+        const T s = sum<Pos, 4>(top, bottom);
+        return simd::shiftRight<6>(simd::add(simd::shiftLeft<4>(s), s));
+    }
+
+    template <std::size_t Pos, typename T>
+    static T average5(const T top, const T bottom)
+    {
+        return simd::shiftRight<5>(expandedSum5<Pos>(top, bottom));
+    }
+
+    template <std::size_t Pos, typename T>
+    static T average6(const T top, const T bottom)
+    {
+        return simd::shiftRight<4>(simd::add(simd::shiftLeft<2>(sum<Pos, 6>(top, bottom)), sum<Pos + 4, 2>(top, bottom)));
+    }
+
+    template <std::size_t Pos, typename T>
+    static T average1(const T top, const T bottom)
+    {
+        return simd::shiftRight<2>(simd::add(sum<Pos, 1>(top, bottom), simd::broadcast(top, 1)));
+    }
+
+    // Sum of the four 5 bit components expanded to 8 bit
+    template <std::size_t Pos, typename T>
+    static T expandedSum5(const T top, const T bottom)
+    {
+        return simd::add(simd::shiftLeft<3>(sum<Pos, 5>(top, bottom)), sum<Pos + 2, 3>(top, bottom));
+    }
+
+    // Sums up the Bits wide field at bit position Pos of the four pixels
+    template <std::size_t Pos, std::size_t Bits, typename T>
+    static T sum(const T top, const T bottom)
+    {
+        const T mask = simd::broadcast(top, ((1u << Bits) - 1) * 0x10001u);
+        const T pairs = simd::add(simd::bitAnd(simd::shiftRight<Pos>(top), mask), simd::bitAnd(simd::shiftRight<Pos>(bottom), mask));
+        return simd::add(simd::bitAnd(pairs, simd::broadcast(top, 0xffff)), simd::shiftRight<16>(pairs));
+    }
+};
+
+} // namespace rr
+
+#endif // MIP_MAP_KERNELS_HPP_
@@ -0,0 +1,410 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef PROFILER_HPP_
+#define PROFILER_HPP_
+
+#ifndef RIX_CORE_ENABLE_PROFILING
+#define RIX_CORE_ENABLE_PROFILING false
+#endif
+
+// Without profiling, only the empty RIX_PROFILE_* macros are defined
+#if RIX_CORE_ENABLE_PROFILING
+
+#include "renderer/FrameStatistics.hpp"
+#include "renderer/commands/Op.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace rr::profiler
+{
+
+enum class Counter : std::size_t
+{
+    TEXTURE_UPLOAD_BYTES, ///< Bytes of the uploaded texture pages
+    UPLOAD_WAIT_TIME_US, ///< Time spent waiting for the completion of transfers to the device
+    RING_STALL_TIME_US, ///< Time the threaded vertex transformer waited for a free display list
+    COUNT,
+};
+
+/// @brief Collects timed scopes and counters of the render pipeline
+/// @details The scopes are recorded as Chrome trace events (chrome://tracing, https://ui.perfetto.dev). The counters
+///     are accumulated per frame and are stored as frame summaries when endFrame() is called. The triangle counts are
+///     not counted again, they are taken from the FrameStatistics the renderer publishes.
+///     Use the RIX_PROFILE_* macros. The profiler only exists if RIX_CORE_ENABLE_PROFILING is set, otherwise the
+///     macros are empty.
+class Profiler
+{
+public:
+    static constexpr std::size_t COUNTERS { static_cast<std::size_t>(Counter::COUNT) };
+    static constexpr std::size_t OPS { 16 };
+    static constexpr std::size_t MAX_EVENTS { 1024 * 1024 };
+    static constexpr std::size_t MAX_FRAMES { 64 * 1024 };
+
+    struct FrameSummary
+    {
+        uint64_t startUs { 0 }; ///< Start of the frame relative to the creation of the profiler
+        uint64_t durationUs { 0 };
+        std::array<uint64_t, COUNTERS> counters {};
+        std::array<uint64_t, OPS> commandBytes {}; ///< Bytes written into display lists, indexed by the op (op >> 28)
+        FrameStatistics statistics {}; ///< The statistics the renderer published at the end of the frame
+    };
+
+    static Profiler& getInstance()
+    {
+        static Profiler profiler {};
+        return profiler;
+    }
+
+    /// @brief Names the track of the calling thread in the trace. Threads with the same name share one track.
+    void setThreadName(const char* name)
+    {
+        ThreadTrack& track = getThreadTrack();
+        if (track.name == name)
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock { m_mutex };
+        const uint32_t tid = findTrack(name);
+        if ((tid == UNASSIGNED) && (track.tid != UNASSIGNED) && (track.name == nullptr))
+        {
+            // The thread has already recorded events without a name
+            m_trackNames[track.tid] = name;
+        }
+        else if (tid == UNASSIGNED)
+        {
+            track.tid = static_cast<uint32_t>(m_trackNames.size());
+            m_trackNames.push_back(name);
+        }
+        else
+        {
+            track.tid = tid;
+        }
+        track.name = name;
+    }
+
+    void addEvent(const char* name, const std::chrono::steady_clock::time_point start, const std::chrono::steady_clock::time_point end)
+    {
+        const uint32_t tid = getTid();
+        std::lock_guard<std::mutex> lock { m_mutex };
+        if (m_events.size() >= MAX_EVENTS)
+        {
+            m_droppedEvents++;
+            return;
+        }
+        m_events.push_back({ name, tid, toUs(start), static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()) });
+    }
+
+    void count(const Counter counter, const uint64_t value)
+    {
+        m_counters[static_cast<std::size_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+    }
+
+    void countCommandBytes(const uint32_t op, const uint64_t bytes)
+    {
+        m_commandBytes[(op & op::MASK) >> 28].fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    /// @brief Stores the counters of the current frame as frame summary and resets them
+    /// @param statistics The last published statistics of the renderer. The threaded vertex transformer publishes
+    ///     them when its worker finished the frame, so they can belong to the previous frame.
+    void endFrame(const FrameStatistics& statistics)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        FrameSummary summary {};
+        summary.statistics = statistics;
+        for (std::size_t i = 0; i < COUNTERS; i++)
+        {
+            summary.counters[i] = m_counters[i].exchange(0, std::memory_order_relaxed);
+        }
+        for (std::size_t i = 0; i < OPS; i++)
+        {
+            summary.commandBytes[i] = m_commandBytes[i].exchange(0, std::memory_order_relaxed);
+        }
+        std::lock_guard<std::mutex> lock { m_mutex };
+        summary.startUs = toUs(m_frameStart);
+        summary.durationUs = toUs(now) - summary.startUs;
+        m_frameStart = now;
+        if (m_frames.size() < MAX_FRAMES)
+        {
+            m_frames.push_back(summary);
+        }
+    }
+
+    std::vector<FrameSummary> getFrameSummaries() const
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        return m_frames;
+    }
+
+    /// @brief Removes all recorded events and frames and resets the counters of the current frame
+    void clear()
+    {
+        for (std::atomic<uint64_t>& counter : m_counters)
+        {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        for (std::atomic<uint64_t>& bytes : m_commandBytes)
+        {
+            bytes.store(0, std::memory_order_relaxed);
+        }
+        std::lock_guard<std::mutex> lock { m_mutex };
+        m_events.clear();
+        m_frames.clear();
+        m_droppedEvents = 0;
+        m_frameStart = std::chrono::steady_clock::now();
+    }
+
+    /// @brief Writes the events and the frame counters in the Chrome trace event format (JSON)
+    void writeChromeTrace(std::ostream& out) const
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool first = true;
+        const auto separator = [&]()
+        {
+            out << (first ? "" : ",\n");
+            first = false;
+        };
+        for (std::size_t tid = 0; tid < m_trackNames.size(); tid++)
+        {
+            separator();
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << tid
+                << ",\"args\":{\"name\":\"" << m_trackNames[tid] << "\"}}";
+        }
+        for (const Event& event : m_events)
+        {
+            separator();
+            out << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.tid
+                << ",\"ts\":" << event.startUs << ",\"dur\":" << event.durationUs << "}";
+        }
+        for (const FrameSummary& frame : m_frames)
+        {
+            const uint64_t ts = frame.startUs + frame.durationUs;
+            separator();
+            out << "{\"name\":\"triangles\",\"ph\":\"C\",\"pid\":0,\"ts\":" << ts << ",\"args\":{"
+                << "\"submitted\":" << frame.statistics.trianglesSubmitted
+                << ",\"culled\":" << frame.statistics.trianglesCulled
+                << ",\"clipped\":" << frame.statistics.trianglesClipped
+                << ",\"rasterized\":" << frame.statistics.trianglesRasterized << "}}";
+            separator();
+            out << "{\"name\":\"display list bytes\",\"ph\":\"C\",\"pid\":0,\"ts\":" << ts << ",\"args\":{";
+            writeCommandBytes(out, frame);
+            out << "}}";
+            separator();
+            out << "{\"name\":\"upload\",\"ph\":\"C\",\"pid\":0,\"ts\":" << ts << ",\"args\":{"
+                << "\"texture bytes\":" << frame.counters[static_cast<std::size_t>(Counter::TEXTURE_UPLOAD_BYTES)]
+                << ",\"wait us\":" << frame.counters[static_cast<std::size_t>(Counter::UPLOAD_WAIT_TIME_US)]
+                << ",\"ring stall us\":" << frame.counters[static_cast<std::size_t>(Counter::RING_STALL_TIME_US)] << "}}";
+        }
+        out << "\n],\"otherData\":{\"droppedEvents\":" << m_droppedEvents << "}}\n";
+    }
+
+    /// @brief Writes the frame summaries as JSON array
+    void writeFrameSummaries(std::ostream& out) const
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        out << "[\n";
+        for (std::size_t i = 0; i < m_frames.size(); i++)
+        {
+            const FrameSummary& frame = m_frames[i];
+            out << "{\"frame\":" << i << ",\"startUs\":" << frame.startUs << ",\"durationUs\":" << frame.durationUs
+                << ",\"trianglesSubmitted\":" << frame.statistics.trianglesSubmitted
+                << ",\"trianglesCulled\":" << frame.statistics.trianglesCulled
+                << ",\"trianglesClipped\":" << frame.statistics.trianglesClipped
+                << ",\"trianglesRasterized\":" << frame.statistics.trianglesRasterized
+                << ",\"textureUploadBytes\":" << frame.counters[static_cast<std::size_t>(Counter::TEXTURE_UPLOAD_BYTES)]
+                << ",\"uploadWaitUs\":" << frame.counters[static_cast<std::size_t>(Counter::UPLOAD_WAIT_TIME_US)]
+                << ",\"ringStallUs\":" << frame.counters[static_cast<std::size_t>(Counter::RING_STALL_TIME_US)]
+                << ",\"commandBytes\":{";
+            writeCommandBytes(out, frame);
+            out << "}}" << ((i + 1) < m_frames.size() ? ",\n" : "\n");
+        }
+        out << "]\n";
+    }
+
+private:
+    struct Event
+    {
+        const char* name;
+        uint32_t tid;
+        uint64_t startUs;
+        uint64_t durationUs;
+    };
+
+    struct ThreadTrack
+    {
+        const char* name { nullptr };
+        uint32_t tid { UNASSIGNED };
+    };
+
+    static constexpr uint32_t UNASSIGNED { 0xffff'ffff };
+
+    Profiler() = default;
+
+    static ThreadTrack& getThreadTrack()
+    {
+        thread_local ThreadTrack track {};
+        return track;
+    }
+
+    static void writeCommandBytes(std::ostream& out, const FrameSummary& frame)
+    {
+        static constexpr std::array<const char*, OPS> OP_NAMES { {
+            "nop",
+            "renderConfig",
+            "framebuffer",
+            "triangleStream",
+            "fogLutStream",
+            "textureStream",
+            "op6",
+            "op7",
+            "op8",
+            "op9",
+            "opA",
+            "setElementGlobalCtx",
+            "setLightingCtx",
+            "pushVertex",
+            "setElementLocalCtx",
+            "drawNewElement",
+        } };
+        bool first = true;
+        for (std::size_t i = 0; i < OPS; i++)
+        {
+            if (frame.commandBytes[i] != 0)
+            {
+                out << (first ? "" : ",") << "\"" << OP_NAMES[i] << "\":" << frame.commandBytes[i];
+                first = false;
+            }
+        }
+    }
+
+    uint32_t getTid()
+    {
+        ThreadTrack& track = getThreadTrack();
+        if (track.tid == UNASSIGNED)
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+            track.tid = static_cast<uint32_t>(m_trackNames.size());
+            m_trackNames.push_back("thread " + std::to_string(track.tid));
+        }
+        return track.tid;
+    }
+
+    uint32_t findTrack(const char* name) const
+    {
+        for (std::size_t i = 0; i < m_trackNames.size(); i++)
+        {
+            if (m_trackNames[i] == name)
+            {
+                return static_cast<uint32_t>(i);
+            }
+        }
+        return UNASSIGNED;
+    }
+
+    uint64_t toUs(const std::chrono::steady_clock::time_point time) const
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(time - m_creation).count());
+    }
+
+    const std::chrono::steady_clock::time_point m_creation { std::chrono::steady_clock::now() };
+    std::chrono::steady_clock::time_point m_frameStart { m_creation };
+    std::array<std::atomic<uint64_t>, COUNTERS> m_counters {};
+    std::array<std::atomic<uint64_t>, OPS> m_commandBytes {};
+    mutable std::mutex m_mutex {};
+    std::vector<Event> m_events {};
+    std::vector<FrameSummary> m_frames {};
+    std::vector<std::string> m_trackNames {};
+    std::size_t m_droppedEvents { 0 };
+};
+
+/// @brief Records the lifetime of the scope as trace event
+class ScopedEvent
+{
+public:
+    explicit ScopedEvent(const char* name)
+        : m_name { name }
+    {
+    }
+
+    ~ScopedEvent()
+    {
+        Profiler::getInstance().addEvent(m_name, m_start, std::chrono::steady_clock::now());
+    }
+
+private:
+    const char* m_name;
+    const std::chrono::steady_clock::time_point m_start { std::chrono::steady_clock::now() };
+};
+
+/// @brief Adds the lifetime of the scope in microseconds to a counter
+class ScopedTimeCounter
+{
+public:
+    explicit ScopedTimeCounter(const Counter counter)
+        : m_counter { counter }
+    {
+    }
+
+    ~ScopedTimeCounter()
+    {
+        const auto duration = std::chrono::steady_clock::now() - m_start;
+        Profiler::getInstance().count(m_counter, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count()));
+    }
+
+private:
+    const Counter m_counter;
+    const std::chrono::steady_clock::time_point m_start { std::chrono::steady_clock::now() };
+};
+
+} // namespace rr::profiler
+
+#define RIX_PROFILE_CONCAT_IMPL(a, b) a##b
+#define RIX_PROFILE_CONCAT(a, b) RIX_PROFILE_CONCAT_IMPL(a, b)
+
+/// Records the rest of the enclosing scope as trace event with the given name (string literal)
+#define RIX_PROFILE_SCOPE(name) const ::rr::profiler::ScopedEvent RIX_PROFILE_CONCAT(rixProfileScope, __LINE__) { name }
+/// Adds the rest of the enclosing scope in microseconds to a counter
+#define RIX_PROFILE_TIME(counter) const ::rr::profiler::ScopedTimeCounter RIX_PROFILE_CONCAT(rixProfileTime, __LINE__) { ::rr::profiler::Counter::counter }
+/// Names the trace track of the calling thread (string literal)
+#define RIX_PROFILE_THREAD(name) ::rr::profiler::Profiler::getInstance().setThreadName(name)
+/// Adds a value to a counter
+#define RIX_PROFILE_COUNT(counter, value) ::rr::profiler::Profiler::getInstance().count(::rr::profiler::Counter::counter, value)
+/// Adds the bytes of a display list command to the statistics of its op
+#define RIX_PROFILE_COMMAND_BYTES(op, bytes) ::rr::profiler::Profiler::getInstance().countCommandBytes(op, bytes)
+/// Closes the current frame summary with the published FrameStatistics
+#define RIX_PROFILE_END_FRAME(statistics) ::rr::profiler::Profiler::getInstance().endFrame(statistics)
+
+#else // RIX_CORE_ENABLE_PROFILING
+
+#define RIX_PROFILE_SCOPE(name)
+#define RIX_PROFILE_TIME(counter)
+#define RIX_PROFILE_THREAD(name)
+#define RIX_PROFILE_COUNT(counter, value)
+#define RIX_PROFILE_COMMAND_BYTES(op, bytes)
+#define RIX_PROFILE_END_FRAME(statistics)
+
+#endif // RIX_CORE_ENABLE_PROFILING
+
+#endif // PROFILER_HPP_
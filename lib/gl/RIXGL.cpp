@@ -19,6 +19,7 @@
 #include "ImageConverter.hpp"
 #include "MipMapGenerator.hpp"
 #include "RenderConfigs.hpp"
+#include "TexturePixelAllocator.hpp"
 #include "opengl/GLImpl.h"
 #include "pixelpipeline/PixelPipeline.hpp"
 #include "vertexpipeline/VertexArray.hpp"
@@ -59,13 +60,15 @@ public:
         pixelPipeline.deinit();
     }
 
+    // Declared first, because the textures of the pipelines must be released before the allocator is destroyed
+    TexturePixelAllocator texturePixelAllocator {};
     PixelPipeline pixelPipeline;
     VertexPipeline vertexPipeline;
     VertexQueue vertexQueue {};
     VertexArray vertexArray {};
     VertexBuffer vertexBuffer {};
     ImageConverter imageConverter {};
-    MipMapGenerator mipMapGenerator {};
+    MipMapGenerator mipMapGenerator { texturePixelAllocator };
 };
 
 alignas(RenderDevice) std::byte renderDeviceBuffer[sizeof(RenderDevice)];
@@ -84,6 +87,8 @@ void RIXGL::destroy()
 {
     if (instance)
     {
+        [[maybe_unused]] const TexturePixelAllocator::Statistics statistics = instance->texturePixelAllocator().getStatistics();
+        SPDLOG_INFO("Texture pixel memory: peak {} bytes, {} allocations, {} reused buffers", statistics.peakBytes, statistics.allocations, statistics.reuses);
         instance->m_renderDevice->deinit();
         instance->~RIXGL();
         instance = nullptr;
@@ -492,7 +497,10 @@ RIXGL::RIXGL(IDevice& device)
     addLibExtension("GL_ARB_texture_env_combine");
     // addLibExtension("GL_ARB_texture_cube_map");
     addLibExtension("GL_ARB_texture_env_dot3");
+    addLibExtension("GL_EXT_texture_compression_s3tc");
+    addLibExtension("GL_OES_compressed_ETC1_RGB8_texture");
     addLibExtension("GL_ARB_multitexture");
+    addLibExtension("GL_RIX_statistics");
     {
 
         addLibProcedure("glMultiTexCoord1dARB", ADDRESS_OF(impl_glMultiTexCoord1d));
@@ -642,6 +650,11 @@ MipMapGenerator& RIXGL::mipMapGenerator()
     return m_renderDevice->mipMapGenerator;
 }
 
+TexturePixelAllocator& RIXGL::texturePixelAllocator()
+{
+    return m_renderDevice->texturePixelAllocator;
+}
+
 std::size_t RIXGL::getMaxTextureSize() const
 {
     return RenderConfig::MAX_TEXTURE_SIZE;
@@ -37,6 +37,7 @@ class VertexQueue;
 class VertexBuffer;
 class ImageConverter;
 class MipMapGenerator;
+class TexturePixelAllocator;
 class RIXGL
 {
 public:
@@ -64,6 +65,7 @@ public:
     VertexBuffer& vertexBuffer();
     ImageConverter& imageConverter();
     MipMapGenerator& mipMapGenerator();
+    TexturePixelAllocator& texturePixelAllocator();
 
     void swapDisplayList();
 
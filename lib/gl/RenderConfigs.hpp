@@ -43,6 +43,9 @@ struct RenderConfig
     // Misc
     static constexpr bool THREADED_RASTERIZATION { RIX_CORE_THREADED_RASTERIZATION };
     static constexpr std::size_t THREADED_RASTERIZATION_DISPLAY_LIST_BUFFER_SIZE { RIX_CORE_THREADED_RASTERIZATION_DISPLAY_LIST_SIZE };
+    static constexpr std::size_t THREADED_RASTERIZATION_DISPLAY_LIST_RING_DEPTH { RIX_CORE_THREADED_RASTERIZATION_DISPLAY_LIST_RING_DEPTH };
+    static constexpr std::size_t THREADED_RASTERIZATION_TEXTURE_UPLOAD_LIST_SIZE { RIX_CORE_THREADED_RASTERIZATION_TEXTURE_UPLOAD_LIST_SIZE };
+    static constexpr std::size_t THREADED_RASTERIZATION_MAX_FRAMES_IN_FLIGHT { RIX_CORE_THREADED_RASTERIZATION_MAX_FRAMES_IN_FLIGHT };
     static constexpr bool ENABLE_VSYNC { RIX_CORE_ENABLE_VSYNC };
     static constexpr std::size_t MAX_VBO_COUNT { RIX_CORE_MAX_VBO_COUNT };
     static constexpr bool PERFORMANCE_MODE { RIX_CORE_PERFORMANCE_MODE };
@@ -0,0 +1,139 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SIMD_LANES_HPP_
+#define SIMD_LANES_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// Operations on a single 32 bit lane (uint32_t) and on a Vector of four 32 bit lanes. Pixel kernels are written once
+// as template over the lane type and are instantiated for the vector loop and for the scalar remainder.
+// The Vector type and the load and store functions are only available with SSE2 or NEON.
+namespace rr::simd
+{
+
+template <std::size_t N>
+inline uint32_t shiftLeft(const uint32_t val) { return val << N; }
+template <std::size_t N>
+inline uint32_t shiftRight(const uint32_t val) { return val >> N; }
+inline uint32_t bitAnd(const uint32_t a, const uint32_t b) { return a & b; }
+inline uint32_t bitOr(const uint32_t a, const uint32_t b) { return a | b; }
+inline uint32_t add(const uint32_t a, const uint32_t b) { return a + b; }
+// The first argument only selects the type
+inline uint32_t broadcast(const uint32_t, const uint32_t val) { return val; }
+
+#if defined(__SSE2__)
+using Vector = __m128i;
+
+template <std::size_t N>
+inline Vector shiftLeft(const Vector val) { return _mm_slli_epi32(val, N); }
+template <std::size_t N>
+inline Vector shiftRight(const Vector val) { return _mm_srli_epi32(val, N); }
+inline Vector bitAnd(const Vector a, const Vector b) { return _mm_and_si128(a, b); }
+inline Vector bitOr(const Vector a, const Vector b) { return _mm_or_si128(a, b); }
+inline Vector add(const Vector a, const Vector b) { return _mm_add_epi32(a, b); }
+inline Vector broadcast(const Vector, const uint32_t val) { return _mm_set1_epi32(static_cast<int>(val)); }
+
+/// @brief Loads 16 unaligned bytes
+inline Vector load(const void* src)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+}
+
+/// @brief Stores 16 unaligned bytes
+inline void store(void* dst, const Vector val)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), val);
+}
+
+/// @brief Loads eight unaligned 16 bit values and zero extends the first four into lo and the last four into hi
+inline void loadWiden16(const uint16_t* src, Vector& lo, Vector& hi)
+{
+    const Vector val = load(src);
+    lo = _mm_unpacklo_epi16(val, _mm_setzero_si128());
+    hi = _mm_unpackhi_epi16(val, _mm_setzero_si128());
+}
+
+/// @brief Stores the lower 16 bits of the lanes of lo followed by the lower 16 bits of the lanes of hi
+inline void storeLow16(uint16_t* dst, const Vector lo, const Vector hi)
+{
+    // SSE2 only has a signed saturating pack. Sign extend the 16 bit values to keep them unchanged.
+    const Vector packed = _mm_packs_epi32(
+        _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16),
+        _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), packed);
+}
+#elif defined(__ARM_NEON)
+using Vector = uint32x4_t;
+
+template <std::size_t N>
+inline Vector shiftLeft(const Vector val) { return vshlq_n_u32(val, N); }
+template <std::size_t N>
+inline Vector shiftRight(const Vector val)
+{
+    // vshrq_n_u32 does not accept a shift of zero
+    if constexpr (N == 0)
+    {
+        return val;
+    }
+    else
+    {
+        return vshrq_n_u32(val, N);
+    }
+}
+inline Vector bitAnd(const Vector a, const Vector b) { return vandq_u32(a, b); }
+inline Vector bitOr(const Vector a, const Vector b) { return vorrq_u32(a, b); }
+inline Vector add(const Vector a, const Vector b) { return vaddq_u32(a, b); }
+inline Vector broadcast(const Vector, const uint32_t val) { return vdupq_n_u32(val); }
+
+/// @brief Loads 16 unaligned bytes
+inline Vector load(const void* src)
+{
+    return vreinterpretq_u32_u8(vld1q_u8(static_cast<const uint8_t*>(src)));
+}
+
+/// @brief Stores 16 unaligned bytes
+inline void store(void* dst, const Vector val)
+{
+    vst1q_u8(static_cast<uint8_t*>(dst), vreinterpretq_u8_u32(val));
+}
+
+/// @brief Loads eight unaligned 16 bit values and zero extends the first four into lo and the last four into hi
+inline void loadWiden16(const uint16_t* src, Vector& lo, Vector& hi)
+{
+    const uint16x8_t val = vld1q_u16(src);
+    lo = vmovl_u16(vget_low_u16(val));
+    hi = vmovl_u16(vget_high_u16(val));
+}
+
+/// @brief Stores the lower 16 bits of the lanes of lo followed by the lower 16 bits of the lanes of hi
+inline void storeLow16(uint16_t* dst, const Vector lo, const Vector hi)
+{
+    vst1q_u16(dst, vcombine_u16(vmovn_u32(lo), vmovn_u32(hi)));
+}
+#endif
+
+} // namespace rr::simd
+
+#endif // SIMD_LANES_HPP_
@@ -0,0 +1,181 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef TEXTURE_PIXEL_ALLOCATOR_HPP_
+#define TEXTURE_PIXEL_ALLOCATOR_HPP_
+
+#include "RenderConfigs.hpp"
+#include "renderer/TextureObject.hpp"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+namespace rr
+{
+
+/// @brief Allocates the pixel storage of textures and recycles released buffers
+/// @details Released buffers are kept in a free list per size and are handed out again for the next texture with
+///     the same size. Textures usually have a few recurring sizes, and a texture update releases the old buffer
+///     shortly after the new one is allocated. The free lists are bounded by setMaxCachedBytes().
+///     The buffers must be released before the allocator is destroyed. They can be released from any thread
+///     when the allocator is thread safe.
+class TexturePixelAllocator
+{
+public:
+    using PixelType = TextureObject::PixelsType::element_type;
+
+    struct Statistics
+    {
+        std::size_t allocations { 0 }; ///< Buffers allocated from the heap
+        std::size_t reuses { 0 }; ///< Buffers taken from the free lists
+        std::size_t bytesInUse { 0 }; ///< Bytes of the buffers which are currently used by textures
+        std::size_t bytesCached { 0 }; ///< Bytes of the buffers in the free lists
+        std::size_t peakBytes { 0 }; ///< Maximum of bytesInUse + bytesCached
+    };
+
+    static constexpr std::size_t DEFAULT_MAX_CACHED_BYTES { 4 * 1024 * 1024 };
+
+    /// @brief Creates an allocator
+    /// @param threadSafe Locks the free lists. Only the threaded rasterization releases texture buffers from another
+    ///     thread, without it the lock is skipped.
+    explicit TexturePixelAllocator(const bool threadSafe = RenderConfig::THREADED_RASTERIZATION)
+    {
+        m_pool.threadSafe = threadSafe;
+    }
+
+    TexturePixelAllocator(const TexturePixelAllocator&) = delete;
+    TexturePixelAllocator& operator=(const TexturePixelAllocator&) = delete;
+
+    /// @brief Allocates a buffer
+    /// @param pixels The number of pixels of the buffer
+    /// @return The buffer or an empty pointer if the memory is exhausted. The content is undefined.
+    TextureObject::PixelsType allocate(const std::size_t pixels)
+    {
+        PixelType* buffer = m_pool.take(pixels);
+        if (!buffer)
+        {
+            return {};
+        }
+        return { buffer, [pool = &m_pool, pixels](PixelType* p)
+            { pool->release(p, pixels); } };
+    }
+
+    /// @brief Sets the maximum size of the free lists. Buffers which do not fit are freed.
+    void setMaxCachedBytes(const std::size_t maxCachedBytes)
+    {
+        const std::unique_lock<std::mutex> guard = m_pool.lock();
+        m_pool.maxCachedBytes = maxCachedBytes;
+    }
+
+    /// @brief Frees all buffers in the free lists
+    void trim()
+    {
+        const std::unique_lock<std::mutex> guard = m_pool.lock();
+        m_pool.freeCachedBuffers();
+    }
+
+    Statistics getStatistics() const
+    {
+        const std::unique_lock<std::mutex> guard = m_pool.lock();
+        return m_pool.statistics;
+    }
+
+private:
+    struct Pool
+    {
+        ~Pool()
+        {
+            freeCachedBuffers();
+        }
+
+        std::unique_lock<std::mutex> lock() const
+        {
+            return threadSafe ? std::unique_lock<std::mutex> { mutex } : std::unique_lock<std::mutex> {};
+        }
+
+        PixelType* take(const std::size_t pixels)
+        {
+            const std::unique_lock<std::mutex> guard = lock();
+            const std::size_t bytes = pixels * sizeof(PixelType);
+            PixelType* buffer { nullptr };
+            auto freeList = freeBuffers.find(pixels);
+            if ((freeList != freeBuffers.end()) && !freeList->second.empty())
+            {
+                buffer = freeList->second.back();
+                freeList->second.pop_back();
+                statistics.bytesCached -= bytes;
+                statistics.reuses++;
+            }
+            else
+            {
+                buffer = new (std::nothrow) PixelType[pixels];
+                if (!buffer)
+                {
+                    return nullptr;
+                }
+                statistics.allocations++;
+            }
+            statistics.bytesInUse += bytes;
+            statistics.peakBytes = (std::max)(statistics.peakBytes, statistics.bytesInUse + statistics.bytesCached);
+            return buffer;
+        }
+
+        void release(PixelType* buffer, const std::size_t pixels)
+        {
+            const std::unique_lock<std::mutex> guard = lock();
+            const std::size_t bytes = pixels * sizeof(PixelType);
+            statistics.bytesInUse -= bytes;
+            if ((statistics.bytesCached + bytes) <= maxCachedBytes)
+            {
+                freeBuffers[pixels].push_back(buffer);
+                statistics.bytesCached += bytes;
+            }
+            else
+            {
+                delete[] buffer;
+            }
+        }
+
+        void freeCachedBuffers()
+        {
+            for (auto& [pixels, buffers] : freeBuffers)
+            {
+                for (PixelType* buffer : buffers)
+                {
+                    delete[] buffer;
+                }
+                buffers.clear();
+            }
+            statistics.bytesCached = 0;
+        }
+
+        mutable std::mutex mutex {};
+        bool threadSafe { false };
+        std::unordered_map<std::size_t, std::vector<PixelType*>> freeBuffers {};
+        std::size_t maxCachedBytes { DEFAULT_MAX_CACHED_BYTES };
+        Statistics statistics {};
+    };
+
+    Pool m_pool {};
+};
+
+} // namespace rr
+
+#endif // TEXTURE_PIXEL_ALLOCATOR_HPP_
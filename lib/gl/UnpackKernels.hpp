@@ -0,0 +1,175 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef UNPACK_KERNELS_HPP_
+#define UNPACK_KERNELS_HPP_
+
+#include "Enums.hpp"
+#include "SimdLanes.hpp"
+#include "gl.h"
+#include <cstdint>
+#include <cstring>
+
+namespace rr
+{
+
+/// @brief Specialized row conversions for the common client format and internal pixel format combinations
+/// @details The generic conversion of the ImageConverter decodes every pixel into RGBA8888 and converts it then into
+///     the device format. Both steps branch on the format per pixel. The kernels here are selected once per image.
+///     Client pixels which already have the device format are copied. 8 bit components are converted with SSE2 or
+///     NEON if available and with a scalar loop for the remaining pixels.
+class UnpackKernels
+{
+public:
+    using ConvertRowFunc = void (*)(uint16_t* texelsDevice, const uint8_t* texelsClient, const std::size_t width);
+
+    struct RowConverter
+    {
+        ConvertRowFunc convertRow { nullptr }; ///< nullptr if there is no specialized kernel
+        std::size_t pixelSize { 0 }; ///< Size of a client pixel in bytes
+    };
+
+    /// @brief Selects the kernel for a combination
+    /// @return A RowConverter without convertRow if the combination has to use the generic conversion
+    static RowConverter getRowConverter(const InternalPixelFormat ipf, const GLenum format, const GLenum type)
+    {
+        if (type == GL_UNSIGNED_BYTE)
+        {
+            switch (format)
+            {
+            case GL_RGBA:
+                return selectUnsignedByte<4, 0, 1, 2, 3>(ipf);
+            case GL_BGRA:
+                return selectUnsignedByte<4, 2, 1, 0, 3>(ipf);
+            case GL_RGB:
+                return selectUnsignedByte<3, 0, 1, 2, NO_ALPHA>(ipf);
+            case GL_BGR:
+                return selectUnsignedByte<3, 2, 1, 0, NO_ALPHA>(ipf);
+            default:
+                return {};
+            }
+        }
+        if (((format == GL_RGB) && (type == GL_UNSIGNED_SHORT_5_6_5) && (ipf == InternalPixelFormat::RGB))
+            || ((format == GL_RGBA) && (type == GL_UNSIGNED_SHORT_4_4_4_4) && (ipf == InternalPixelFormat::RGBA))
+            || ((format == GL_RGBA) && (type == GL_UNSIGNED_SHORT_5_5_5_1) && (ipf == InternalPixelFormat::RGBA1)))
+        {
+            return { &copyRow, sizeof(uint16_t) };
+        }
+        return {};
+    }
+
+private:
+    static constexpr std::size_t NO_ALPHA { 4 };
+
+    template <std::size_t PixelSize, std::size_t R, std::size_t G, std::size_t B, std::size_t A>
+    static RowConverter selectUnsignedByte(const InternalPixelFormat ipf)
+    {
+        switch (ipf)
+        {
+        case InternalPixelFormat::RGB:
+            return { &convertRowUnsignedByte<InternalPixelFormat::RGB, PixelSize, R, G, B, A>, PixelSize };
+        case InternalPixelFormat::RGBA:
+            return { &convertRowUnsignedByte<InternalPixelFormat::RGBA, PixelSize, R, G, B, A>, PixelSize };
+        case InternalPixelFormat::RGBA1:
+            return { &convertRowUnsignedByte<InternalPixelFormat::RGBA1, PixelSize, R, G, B, A>, PixelSize };
+        default:
+            return {};
+        }
+    }
+
+    static void copyRow(uint16_t* texelsDevice, const uint8_t* texelsClient, const std::size_t width)
+    {
+        std::memcpy(texelsDevice, texelsClient, width * sizeof(uint16_t));
+    }
+
+    // Converts a row of pixels with 8 bit components. R, G, B and A are the byte positions of the components in the
+    // client pixel. A is NO_ALPHA if the client pixel has no alpha.
+    template <InternalPixelFormat Ipf, std::size_t PixelSize, std::size_t R, std::size_t G, std::size_t B, std::size_t A>
+    static void convertRowUnsignedByte(uint16_t* texelsDevice, const uint8_t* texelsClient, const std::size_t width)
+    {
+        std::size_t column = 0;
+        if constexpr (PixelSize == 4)
+        {
+#if defined(__SSE2__) || defined(__ARM_NEON)
+            for (; (column + 8) <= width; column += 8)
+            {
+                const uint8_t* src = texelsClient + (column * PixelSize);
+                simd::storeLow16(
+                    texelsDevice + column,
+                    packPixel<Ipf, R, G, B, A>(simd::load(src)),
+                    packPixel<Ipf, R, G, B, A>(simd::load(src + 16)));
+            }
+#endif
+        }
+        for (; column < width; column++)
+        {
+            const uint8_t* src = texelsClient + (column * PixelSize);
+            uint32_t pixel = static_cast<uint32_t>(src[0]) | (static_cast<uint32_t>(src[1]) << 8) | (static_cast<uint32_t>(src[2]) << 16);
+            if constexpr (PixelSize == 4)
+            {
+                pixel |= static_cast<uint32_t>(src[3]) << 24;
+            }
+            texelsDevice[column] = static_cast<uint16_t>(packPixel<Ipf, R, G, B, A>(pixel));
+        }
+    }
+
+    // Converts little endian pixels (the first component is in the lowest byte) into the device format. The result
+    // is in the lower 16 bits. T is either a single pixel or a vector of pixels.
+    template <InternalPixelFormat Ipf, std::size_t R, std::size_t G, std::size_t B, std::size_t A, typename T>
+    static T packPixel(const T pixel)
+    {
+        if constexpr (Ipf == InternalPixelFormat::RGB) // RGB565
+        {
+            return simd::bitOr(simd::bitOr(component<R, 5, 11>(pixel), component<G, 6, 5>(pixel)), component<B, 5, 0>(pixel));
+        }
+        else if constexpr (Ipf == InternalPixelFormat::RGBA) // RGBA4444
+        {
+            const T rgb = simd::bitOr(simd::bitOr(component<R, 4, 12>(pixel), component<G, 4, 8>(pixel)), component<B, 4, 4>(pixel));
+            if constexpr (A == NO_ALPHA)
+            {
+                return simd::bitOr(rgb, simd::broadcast(pixel, 0xf));
+            }
+            else
+            {
+                return simd::bitOr(rgb, component<A, 4, 0>(pixel));
+            }
+        }
+        else // RGBA5551
+        {
+            const T rgb = simd::bitOr(simd::bitOr(component<R, 5, 11>(pixel), component<G, 5, 6>(pixel)), component<B, 5, 1>(pixel));
+            if constexpr (A == NO_ALPHA)
+            {
+                return simd::bitOr(rgb, simd::broadcast(pixel, 0x1));
+            }
+            else
+            {
+                return simd::bitOr(rgb, component<A, 1, 0>(pixel));
+            }
+        }
+    }
+
+    // Moves the upper Bits of the component at byte position Pos to bit position Target
+    template <std::size_t Pos, std::size_t Bits, std::size_t Target, typename T>
+    static T component(const T pixel)
+    {
+        return simd::shiftLeft<Target>(simd::bitAnd(simd::shiftRight<(Pos * 8) + 8 - Bits>(pixel), simd::broadcast(pixel, (1u << Bits) - 1)));
+    }
+};
+
+} // namespace rr
+
+#endif // UNPACK_KERNELS_HPP_
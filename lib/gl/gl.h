@@ -877,6 +877,11 @@ extern "C"
 #define GL_TEXTURE_COMPRESSED 0x86A1
 #define GL_NUM_COMPRESSED_TEXTURE_FORMATS 0x86A2
 #define GL_COMPRESSED_TEXTURE_FORMATS 0x86A3
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT 0x83F2
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#define GL_ETC1_RGB8_OES 0x8D64
 #define GL_CLAMP_TO_BORDER 0x812D
 #define GL_CLAMP_TO_BORDER_SGIS 0x812D
 #define GL_COMBINE 0x8570
@@ -928,6 +933,35 @@ extern "C"
 #define GL_IMPLEMENTATION_COLOR_READ_TYPE_OES 0x8B9A
 #define GL_IMPLEMENTATION_COLOR_READ_FORMAT_OES 0x8B9B
 
+    // GL_RIX_statistics
+    // Runtime statistics of the renderer, queried with glGetIntegerv or glGetFloatv.
+    // The values are RasterIX specific and not registered with Khronos. Frame values
+    // refer to the last completed frame. Times are in microseconds.
+#define GL_RIX_statistics 1
+#define GL_FRAME_COUNT_RIX 0x1A200
+#define GL_FRAME_TIME_RIX 0x1A201
+#define GL_TRIANGLES_SUBMITTED_RIX 0x1A202
+#define GL_TRIANGLES_CULLED_RIX 0x1A203
+#define GL_TRIANGLES_CLIPPED_RIX 0x1A204
+#define GL_TRIANGLES_RASTERIZED_RIX 0x1A205
+#define GL_DISPLAY_LIST_USED_BYTES_RIX 0x1A206
+#define GL_DISPLAY_LIST_SIZE_RIX 0x1A207
+#define GL_TEXTURE_PAGES_USED_RIX 0x1A208
+#define GL_TEXTURE_PAGES_FREE_RIX 0x1A209
+#define GL_UPLOAD_TIME_RIX 0x1A20A
+#define GL_UPLOAD_STALLS_RIX 0x1A20B
+#define GL_UPLOAD_STALL_TIME_RIX 0x1A20C
+
+    // GL_RIX_texture_npot
+    // Not power of two images are resampled to a power of two. glHint selects how.
+    // GL_TEXTURE_NPOT_ROUNDING_HINT_RIX: GL_NICEST rounds up, GL_DONT_CARE rounds to the
+    // nearest and GL_FASTEST rounds down to the next power of two. The initial value is GL_NICEST.
+    // GL_TEXTURE_NPOT_FILTER_HINT_RIX: GL_FASTEST uses a box filter, GL_NICEST and
+    // GL_DONT_CARE use a bilinear filter.
+#define GL_RIX_texture_npot 1
+#define GL_TEXTURE_NPOT_ROUNDING_HINT_RIX 0x1A210
+#define GL_TEXTURE_NPOT_FILTER_HINT_RIX 0x1A211
+
     // Wrapper Functions
     // Open GL 1.0
     // -------------------------------------------------------
@@ -0,0 +1,212 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef GL_COLOR_BUFFER_REGION_HPP_
+#define GL_COLOR_BUFFER_REGION_HPP_
+
+#include "Helpers.hpp"
+#include "ImageConverter.hpp"
+#include "RIXGL.hpp"
+#include "gl.h"
+#include "vertexpipeline/VertexPipeline.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace rr
+{
+
+/// @brief Reads a rectangular region of the color buffer
+/// @details If the region is inside of the color buffer, its rows are read when they are requested. readRows() reads
+///     them directly into the destination, getRow() reads one row after the other into a scratch row.
+///     Otherwise the span of the color buffer memory which is covered by the region is read and pixels outside of the
+///     color buffer are clamped to the color buffer memory.
+class ColorBufferRegion
+{
+public:
+    ColorBufferRegion(const GLint x, const GLint y, const GLsizei width, const GLsizei height, const bool readFromBackBuffer)
+        : m_cbw { static_cast<GLint>(RIXGL::getInstance().pipeline().getFramebufferWidth()) }
+        , m_cbh { static_cast<GLint>(RIXGL::getInstance().pipeline().getFramebufferHeight()) }
+        , m_x { x }
+        , m_y { y }
+        , m_width { width }
+        , m_height { height }
+        , m_readFromBackBuffer { readFromBackBuffer }
+    {
+        if ((width <= 0) || (height <= 0) || (m_cbw <= 0) || (m_cbh <= 0))
+        {
+            return;
+        }
+        m_row.resize(width);
+        m_inside = (x >= 0) && (y >= 0) && ((x + width) <= m_cbw) && ((y + height) <= m_cbh);
+        if (m_inside)
+        {
+            m_valid = true;
+            return;
+        }
+
+        // The color buffer is stored top down. The top row of the region is the first row in memory.
+        m_spanStart = clampAddr(getAddr(height - 1, 0));
+        m_span.resize(clampAddr(getAddr(0, width - 1)) - m_spanStart + 1);
+        m_valid = readColorBufferRows(toBytes(m_span.data(), m_span.size()), m_spanStart, static_cast<GLsizei>(m_span.size()));
+    }
+
+    /// @brief Reads the RGB565 pixels of the region in OpenGL order directly into a continuous buffer
+    /// @param pixels The buffer which receives width * height pixels
+    /// @return false if the region is partly outside of the color buffer (use getRow() then) or if the read failed
+    bool readRows(uint8_t* pixels)
+    {
+        if (!m_valid || !m_inside)
+        {
+            return false;
+        }
+        const std::size_t rowSize = static_cast<std::size_t>(m_width) * sizeof(uint16_t);
+        m_valid = readColorBufferRows({ pixels, rowSize * m_height }, getAddr(m_height - 1, 0), m_width);
+        // The rows are read top down. Flip them into OpenGL order.
+        for (GLint row = 0; row < (m_height / 2); row++)
+        {
+            uint8_t* const top = pixels + (static_cast<std::size_t>(row) * rowSize);
+            std::swap_ranges(top, top + rowSize, pixels + (static_cast<std::size_t>(m_height - row - 1) * rowSize));
+        }
+        return m_valid;
+    }
+
+    /// @brief Returns the pixels of a row of the region
+    /// @param row The row in OpenGL order (row 0 is the lowest row of the region)
+    /// @return Pointer to width pixels. Valid until the next call of getRow() or until the region is destroyed.
+    const uint16_t* getRow(const GLint row)
+    {
+        if (m_inside)
+        {
+            m_valid = m_valid && readColorBufferRows(toBytes(m_row.data(), m_row.size()), getAddr(row, 0), m_width);
+            return m_row.data();
+        }
+        for (GLint column = 0; column < m_width; column++)
+        {
+            m_row[column] = m_span[clampAddr(getAddr(row, column)) - m_spanStart];
+        }
+        return m_row.data();
+    }
+
+    /// @brief Copies the region into a continuous buffer
+    /// @return The pixels of the region in OpenGL order
+    std::vector<uint16_t> toVector()
+    {
+        if (!m_valid)
+        {
+            return {};
+        }
+        std::vector<uint16_t> pixels(static_cast<std::size_t>(m_width) * m_height);
+        if (m_inside)
+        {
+            if (!readRows(reinterpret_cast<uint8_t*>(pixels.data())))
+            {
+                return {};
+            }
+            return pixels;
+        }
+        for (GLint row = 0; row < m_height; row++)
+        {
+            const uint16_t* src = getRow(row);
+            std::copy(src, src + m_width, pixels.begin() + (static_cast<std::size_t>(row) * m_width));
+        }
+        return pixels;
+    }
+
+    bool isValid() const { return m_valid; }
+    bool isInside() const { return m_inside; }
+    GLsizei getWidth() const { return m_width; }
+    GLsizei getHeight() const { return m_height; }
+
+private:
+    static tcb::span<uint8_t> toBytes(uint16_t* pixels, const std::size_t size)
+    {
+        return { reinterpret_cast<uint8_t*>(pixels), size * sizeof(uint16_t) };
+    }
+
+    // Reads rows of rowPixels pixels, starting at the pixel addr of the color buffer, directly into the buffer
+    bool readColorBufferRows(const tcb::span<uint8_t> buffer, const GLint addr, const GLsizei rowPixels)
+    {
+        const uint32_t offset = static_cast<uint32_t>(addr) * sizeof(uint16_t);
+        const uint32_t rowSize = static_cast<uint32_t>(rowPixels) * sizeof(uint16_t);
+        const uint32_t stride = static_cast<uint32_t>(m_cbw) * sizeof(uint16_t);
+        if (m_readFromBackBuffer)
+        {
+            return RIXGL::getInstance().pipeline().readBackColorBufferRows(buffer, offset, rowSize, stride);
+        }
+        return RIXGL::getInstance().pipeline().readFrontColorBufferRows(buffer, offset, rowSize, stride);
+    }
+
+    GLint getAddr(const GLint row, const GLint column) const
+    {
+        return ((m_cbh - row - m_y - 1) * m_cbw) + column + m_x;
+    }
+
+    GLint clampAddr(const GLint addr) const
+    {
+        return std::clamp(addr, 0, (m_cbw * m_cbh) - 1);
+    }
+
+    const GLint m_cbw;
+    const GLint m_cbh;
+    const GLint m_x;
+    const GLint m_y;
+    const GLsizei m_width;
+    const GLsizei m_height;
+    const bool m_readFromBackBuffer;
+    bool m_inside { false };
+    bool m_valid { false };
+    GLint m_spanStart { 0 };
+    std::vector<uint16_t> m_span {};
+    std::vector<uint16_t> m_row {};
+};
+
+/// @brief Reads a region of the color buffer into a continuous buffer
+/// @return The RGB565 pixels of the region in OpenGL order
+[[maybe_unused]] static std::vector<uint16_t> readFromColorBuffer(const GLint x, const GLint y, const GLint width, const GLint height, const bool readFromBackBuffer)
+{
+    return ColorBufferRegion { x, y, width, height, readFromBackBuffer }.toVector();
+}
+
+/// @brief Copies a region of the color buffer into a level of the bound texture
+/// @details The rows of the region are read one by one and converted from RGB565 directly into the storage of the level.
+/// @param region The region of the color buffer which is copied
+/// @return GL_NO_ERROR on success, otherwise the error which has to be set
+[[maybe_unused]] static GLenum copyColorBufferToTexture(ColorBufferRegion& region, const GLint level, const GLint xoffset, const GLint yoffset)
+{
+    return writeTextureRegion(level, xoffset, yoffset, region.getWidth(), region.getHeight(), region.isValid(),
+        [&](const TextureObject::PixelsType& texels, const InternalPixelFormat ipf, const std::size_t rowLength)
+        {
+            for (GLint row = 0; row < region.getHeight(); row++)
+            {
+                RIXGL::getInstance().imageConverter().convertUnpack(
+                    texels,
+                    ipf,
+                    rowLength,
+                    xoffset,
+                    yoffset + row,
+                    region.getWidth(),
+                    1,
+                    GL_RGB,
+                    GL_UNSIGNED_SHORT_5_6_5,
+                    reinterpret_cast<const uint8_t*>(region.getRow(row)));
+            }
+        });
+}
+
+} // namespace rr
+
+#endif // GL_COLOR_BUFFER_REGION_HPP_
@@ -18,45 +18,112 @@
 #ifndef GL_HELPERS_HPP_
 #define GL_HELPERS_HPP_
 
+#include "MipMapGenerator.hpp"
 #include "RIXGL.hpp"
+#include "TexturePixelAllocator.hpp"
 #include "gl.h"
 #include "vertexpipeline/VertexPipeline.hpp"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <spdlog/spdlog.h>
 
 namespace rr
 {
 
-[[maybe_unused]] static const uint16_t* readFromColorBuffer(const GLint x, const GLint y, const GLint width, const GLint height, const bool readFromBackBuffer)
+/// @brief Writes a region of a level of the bound texture and updates its mip maps
+/// @details If the texture is already uploaded and was not drawn in the current frame, the region is written directly
+///     into the existing storage of the level. Only the pages touched by the region and its mip maps are uploaded
+///     afterwards. Otherwise a new level is allocated and the whole texture is uploaded into a new slot, so that the
+///     draws of the current frame still sample the old texels.
+/// @param hasData Indicates that the region has data. If not, the level is only allocated.
+/// @param write Called as write(pixels, ipf, rowLength) to write the region into the pixels of the level
+/// @param compressedPixels The compressed image of the whole level after the write. Null drops the compressed image.
+/// @return GL_NO_ERROR on success, otherwise the error which has to be set
+template <typename TWrite>
+GLenum writeTextureRegion(
+    const GLint level,
+    const GLint xoffset,
+    const GLint yoffset,
+    const GLsizei width,
+    const GLsizei height,
+    const bool hasData,
+    const TWrite& write,
+    const TextureObject::CompressedPixelsType& compressedPixels = {})
 {
-    const GLint cbw = RIXGL::getInstance().pipeline().getFramebufferWidth();
-    const GLint cbh = RIXGL::getInstance().pipeline().getFramebufferHeight();
-    const GLint colorBufferSize = cbw * cbh;
+    if ((xoffset < 0) || (yoffset < 0) || (width < 0) || (height < 0))
+    {
+        return GL_INVALID_VALUE;
+    }
+
+    Texture& texture = RIXGL::getInstance().pipeline().texture();
+    MipMapGenerator& mipMapGenerator = RIXGL::getInstance().mipMapGenerator();
 
-    uint16_t* colorBuffer = new uint16_t[colorBufferSize];
-    if (readFromBackBuffer)
+    // A pending update uploads the whole texture anyway
+    if (!texture.hasPendingTextureUpdate() && !texture.isDrawnInCurrentFrame() && hasData)
     {
-        RIXGL::getInstance().pipeline().readBackColorBuffer({ reinterpret_cast<uint8_t*>(colorBuffer), static_cast<std::size_t>(colorBufferSize * 2) });
+        TextureObject texObj = texture.getBoundTextureObject();
+        if (texObj.getPixels(level)
+            && ((xoffset + width) <= static_cast<GLint>(texObj.getWidth(level)))
+            && ((yoffset + height) <= static_cast<GLint>(texObj.getHeight(level))))
+        {
+            write(texObj.getPixels(level), texObj.getInternalPixelFormat(level), texObj.getWidth(level));
+            texObj.setCompressedPixels(level, compressedPixels);
+
+            bool ret = texture.updateTextureRegion(texObj, level, xoffset, yoffset, width, height);
+            const bool mipMapsUpdated = mipMapGenerator.generateMipMapRegion(texObj, level, xoffset, yoffset, width, height,
+                [&](const std::size_t l, const std::size_t x, const std::size_t y, const std::size_t w, const std::size_t h)
+                { ret = ret && texture.updateTextureRegion(texObj, l, x, y, w, h); });
+            if (!ret || !mipMapsUpdated)
+            {
+                // For instance missing mip levels which change the size of the texture. Upload the whole texture.
+                texture.getTexture() = texObj;
+                mipMapGenerator.generateMipMap(texture.getTexture(), level);
+            }
+            return GL_NO_ERROR;
+        }
     }
-    else
+
+    TextureObject& texObj { texture.getTexture() };
+    if (((xoffset + width) > static_cast<GLint>(texObj.getWidth(level)))
+        || ((yoffset + height) > static_cast<GLint>(texObj.getHeight(level))))
     {
-        RIXGL::getInstance().pipeline().readFrontColorBuffer({ reinterpret_cast<uint8_t*>(colorBuffer), static_cast<std::size_t>(colorBufferSize * 2) });
+        return GL_INVALID_VALUE;
     }
 
-    uint16_t* texBuffer = new uint16_t[width * height];
+    using PixelType = TextureObject::PixelsType::element_type;
 
-    for (GLint ih = 0; ih < height; ih++)
+    const std::size_t texMemSize = texObj.getWidth(level) * texObj.getHeight(level) * sizeof(PixelType);
+    if (texMemSize == 0)
     {
-        for (GLint iw = 0; iw < width; iw++)
-        {
-            GLint cba = ((cbh - ih - y - 1) * cbw) + iw + x;
-            cba = std::min(cba, colorBufferSize - 1);
-            cba = std::max(0, cba);
-            texBuffer[(ih * width) + iw] = colorBuffer[cba];
-        }
+        SPDLOG_DEBUG("writeTextureRegion texture with zero dimensions loaded.");
+        return GL_NO_ERROR;
     }
 
-    delete colorBuffer;
+    std::shared_ptr<PixelType> texMemShared = RIXGL::getInstance().texturePixelAllocator().allocate(texMemSize / sizeof(PixelType));
 
-    return texBuffer;
+    if (!texMemShared)
+    {
+        return GL_OUT_OF_MEMORY;
+    }
+    if (texObj.getPixels(level))
+    {
+        std::memcpy(texMemShared.get(), texObj.getPixels(level).get(), std::min(texObj.getSizeInBytes(level), texMemSize));
+    }
+    else
+    {
+        std::memset(texMemShared.get(), 0, texMemSize);
+    }
+    texObj.setPixels(level, texMemShared);
+
+    // Without data, just set the empty memory area and don't copy anything.
+    if (hasData)
+    {
+        write(texObj.getPixels(level), texObj.getInternalPixelFormat(level), texObj.getWidth(level));
+        texObj.setCompressedPixels(level, compressedPixels);
+        mipMapGenerator.generateMipMap(texObj, level);
+    }
+    return GL_NO_ERROR;
 }
 
 } // namespace rr
@@ -16,13 +16,46 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "GLImpl.h"
+#include "RIXGL.hpp"
+#include "vertexpipeline/VertexPipeline.hpp"
 #include <spdlog/spdlog.h>
 
+using namespace rr;
+
 GLAPI GLboolean APIENTRY impl_glAreTexturesResident(
-    [[maybe_unused]] GLsizei n,
-    [[maybe_unused]] const GLuint* textures,
-    [[maybe_unused]] GLboolean* residences)
+    GLsizei n,
+    const GLuint* textures,
+    GLboolean* residences)
 {
-    SPDLOG_WARN("glAreTexturesResident not implemented");
-    return false;
-}
\ No newline at end of file
+    SPDLOG_DEBUG("glAreTexturesResident n {} called", n);
+    if (n < 0)
+    {
+        RIXGL::getInstance().setError(GL_INVALID_VALUE);
+        SPDLOG_ERROR("glAreTexturesResident n is negative");
+        return GL_FALSE;
+    }
+    for (GLsizei i = 0; i < n; i++)
+    {
+        if (!RIXGL::getInstance().pipeline().texture().isTextureValid(textures[i]))
+        {
+            RIXGL::getInstance().setError(GL_INVALID_VALUE);
+            SPDLOG_ERROR("glAreTexturesResident texture {} is not a texture", textures[i]);
+            return GL_FALSE;
+        }
+    }
+
+    // The residences are only written when at least one texture is not resident
+    bool allResident { true };
+    for (GLsizei i = 0; i < n; i++)
+    {
+        allResident = allResident && RIXGL::getInstance().pipeline().texture().isTextureResident(textures[i]);
+    }
+    if (!allResident)
+    {
+        for (GLsizei i = 0; i < n; i++)
+        {
+            residences[i] = RIXGL::getInstance().pipeline().texture().isTextureResident(textures[i]) ? GL_TRUE : GL_FALSE;
+        }
+    }
+    return allResident ? GL_TRUE : GL_FALSE;
+}
@@ -15,9 +15,15 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
+#include "CompressedImageDecoder.hpp"
 #include "GLImpl.h"
+#include "Helpers.hpp"
+#include "RIXGL.hpp"
+#include "vertexpipeline/VertexPipeline.hpp"
 #include <spdlog/spdlog.h>
 
+using namespace rr;
+
 GLAPI void APIENTRY impl_glCompressedTexImage3D(
     [[maybe_unused]] GLenum target,
     [[maybe_unused]] GLint level,
@@ -34,15 +40,131 @@ GLAPI void APIENTRY impl_glCompressedTexImage3D(
 
 GLAPI void APIENTRY impl_glCompressedTexImage2D(
     [[maybe_unused]] GLenum target,
-    [[maybe_unused]] GLint level,
-    [[maybe_unused]] GLenum internalformat,
-    [[maybe_unused]] GLsizei width,
-    [[maybe_unused]] GLsizei height,
-    [[maybe_unused]] GLint border,
-    [[maybe_unused]] GLsizei imageSize,
-    [[maybe_unused]] const GLvoid* data)
+    GLint level,
+    GLenum internalformat,
+    GLsizei width,
+    GLsizei height,
+    GLint border,
+    GLsizei imageSize,
+    const GLvoid* data)
 {
-    SPDLOG_WARN("glCompressedTexImage2D not implemented");
+    SPDLOG_DEBUG("glCompressedTexImage2D target 0x{:X} level 0x{:X} internalformat 0x{:X} width {} height {} border 0x{:X} imageSize {} called", target, level, internalformat, width, height, border, imageSize);
+
+    if ((border != 0) || (level < 0) || (width < 0) || (height < 0))
+    {
+        RIXGL::getInstance().setError(GL_INVALID_VALUE);
+        SPDLOG_ERROR("glCompressedTexImage2D border, level or size invalid");
+        return;
+    }
+
+    const std::size_t maxTexSize { RIXGL::getInstance().getMaxTextureSize() };
+
+    if (static_cast<std::size_t>(level) > RIXGL::getInstance().getMaxLOD())
+    {
+        SPDLOG_ERROR("glCompressedTexImage2D invalid lod.");
+        return;
+    }
+
+    if ((static_cast<std::size_t>(width) > maxTexSize) || (static_cast<std::size_t>(height) > maxTexSize))
+    {
+        RIXGL::getInstance().setError(GL_INVALID_VALUE);
+        SPDLOG_ERROR("glCompressedTexImage2D texture is too big.");
+        return;
+    }
+
+    if (!RIXGL::getInstance().isMipmappingAvailable() && (level != 0))
+    {
+        RIXGL::getInstance().setError(GL_INVALID_VALUE);
+        SPDLOG_ERROR("glCompressedTexImage2D mipmapping on hardware not supported.");
+        return;
+    }
+
+    InternalPixelFormat internalPixelFormat;
+    const GLenum formatError = CompressedImageDecoder::convertInternalPixelFormat(internalPixelFormat, internalformat);
+    if (formatError != GL_NO_ERROR)
+    {
+        RIXGL::getInstance().setError(formatError);
+        SPDLOG_ERROR("glCompressedTexImage2D internal format 0x{:X} not supported", internalformat);
+        return;
+    }
+
+    if (static_cast<std::size_t>(imageSize) != CompressedImageDecoder::getImageSize(internalformat, width, height))
+    {
+        RIXGL::getInstance().setError(GL_INVALID_VALUE);
+        SPDLOG_ERROR("glCompressedTexImage2D image size {} does not match the format", imageSize);
+        return;
+    }
+
+    // Not power of two textures are resampled to a power of two like in glTexImage2D
+    ImageConverter& imageConverter { RIXGL::getInstance().imageConverter() };
+    const std::size_t widthRounded = imageConverter.getPowerOfTwoSize(width);
+    const std::size_t heightRounded = imageConverter.getPowerOfTwoSize(height);
+
+    if ((widthRounded == 0) || (heightRounded == 0))
+    {
+        RIXGL::getInstance().setError(GL_INVALID_VALUE);
+        SPDLOG_ERROR("glCompressedTexImage2D texture with invalid size detected ({} (rounded to {}), {} (rounded to {}))", width, widthRounded, height, heightRounded);
+        return;
+    }
+
+    TextureObject& texObj { RIXGL::getInstance().pipeline().texture().getTexture() };
+
+    texObj.setWidth(level, widthRounded);
+    texObj.setHeight(level, heightRounded);
+    texObj.setInternalPixelFormat(level, internalPixelFormat);
+
+    // The hardware can't sample compressed textures. The image is decoded and stored like an uncompressed texture.
+    // The compressed image is kept for glGetCompressedTexImage.
+    TextureObject::CompressedPixelsType compressedPixels {};
+    if (data)
+    {
+        const uint8_t* blocks = reinterpret_cast<const uint8_t*>(data);
+        compressedPixels = std::make_shared<const TextureObject::CompressedImage>(
+            TextureObject::CompressedImage { internalformat, { blocks, blocks + imageSize } });
+    }
+    const bool resampled = (widthRounded != static_cast<std::size_t>(width)) || (heightRounded != static_cast<std::size_t>(height));
+    const GLenum error = writeTextureRegion(level, 0, 0, widthRounded, heightRounded, data != nullptr,
+        [&](const TextureObject::PixelsType& texels, const InternalPixelFormat ipf, const std::size_t rowLength)
+        {
+            if (resampled)
+            {
+                CompressedImageDecoder::decodeRescaled(
+                    imageConverter,
+                    texels,
+                    ipf,
+                    rowLength,
+                    0,
+                    0,
+                    widthRounded,
+                    heightRounded,
+                    width,
+                    height,
+                    internalformat,
+                    reinterpret_cast<const uint8_t*>(data));
+            }
+            else
+            {
+                CompressedImageDecoder::decode(
+                    texels,
+                    ipf,
+                    rowLength,
+                    0,
+                    0,
+                    width,
+                    height,
+                    internalformat,
+                    reinterpret_cast<const uint8_t*>(data));
+            }
+        },
+        compressedPixels);
+    if (error != GL_NO_ERROR)
+    {
+        RIXGL::getInstance().setError(error);
+        SPDLOG_ERROR("glCompressedTexImage2D failed to store the texture (error 0x{:X})", error);
+    }
+
+    // Recorded after the image is written, so that glCompressedTexSubImage2D can scale its regions into the resampled texture
+    RIXGL::getInstance().pipeline().texture().getTexture().setClientSize(level, width, height);
 }
 
 GLAPI void APIENTRY impl_glCompressedTexImage1D(
@@ -15,9 +15,15 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
+#include "CompressedImageDecoder.hpp"
 #include "GLImpl.h"
+#include "Helpers.hpp"
+#include "RIXGL.hpp"
+#include "vertexpipeline/VertexPipeline.hpp"
 #include <spdlog/spdlog.h>
 
+using namespace rr;
+
 GLAPI void APIENTRY impl_glCompressedTexSubImage3D(
     [[maybe_unused]] GLenum target,
     [[maybe_unused]] GLint level,
@@ -36,16 +42,155 @@ GLAPI void APIENTRY impl_glCompressedTexSubImage3D(
 
 GLAPI void APIENTRY impl_glCompressedTexSubImage2D(
     [[maybe_unused]] GLenum target,
-    [[maybe_unused]] GLint level,
-    [[maybe_unused]] GLint xoffset,
-    [[maybe_unused]] GLint yoffset,
-    [[maybe_unused]] GLsizei width,
-    [[maybe_unused]] GLsizei height,
-    [[maybe_unused]] GLenum format,
-    [[maybe_unused]] GLsizei imageSize,
-    [[maybe_unused]] const GLvoid* data)
+    GLint level,
+    GLint xoffset,
+    GLint yoffset,
+    GLsizei width,
+    GLsizei height,
+    GLenum format,
+    GLsizei imageSize,
+    const GLvoid* data)
 {
-    SPDLOG_WARN("glCompressedTexSubImage2D not implemented");
+    SPDLOG_DEBUG("glCompressedTexSubImage2D target 0x{:X} level 0x{:X} xoffset {} yoffset {} width {} height {} format 0x{:X} imageSize {} called", target, level, xoffset, yoffset, width, height, format, imageSize);
+
+    if ((level < 0) || (static_cast<std::size_t>(level) > RIXGL::getInstance().getMaxLOD()))
+    {
+        RIXGL::getInstance().setError(GL_INVALID_VALUE);
+        SPDLOG_ERROR("glCompressedTexSubImage2D invalid lod.");
+        return;
+    }
+
+    if (!RIXGL::getInstance().isMipmappingAvailable() && (level != 0))
+    {
+        RIXGL::getInstance().setError(GL_INVALID_VALUE);
+        SPDLOG_ERROR("glCompressedTexSubImage2D mipmapping on hardware not supported.");
+        return;
+    }
+
+    InternalPixelFormat internalPixelFormat;
+    const GLenum formatError = CompressedImageDecoder::convertInternalPixelFormat(internalPixelFormat, format);
+    if (formatError != GL_NO_ERROR)
+    {
+        RIXGL::getInstance().setError(formatError);
+        SPDLOG_ERROR("glCompressedTexSubImage2D format 0x{:X} not supported", format);
+        return;
+    }
+
+    // OES_compressed_ETC1_RGB8_texture does not allow to update sub images
+    if (format == GL_ETC1_RGB8_OES)
+    {
+        RIXGL::getInstance().setError(GL_INVALID_OPERATION);
+        SPDLOG_ERROR("glCompressedTexSubImage2D ETC1 sub images are not supported");
+        return;
+    }
+
+    if ((width < 0) || (height < 0)
+        || (static_cast<std::size_t>(imageSize) != CompressedImageDecoder::getImageSize(format, width, height)))
+    {
+        RIXGL::getInstance().setError(GL_INVALID_VALUE);
+        SPDLOG_ERROR("glCompressedTexSubImage2D image size {} does not match the format", imageSize);
+        return;
+    }
+
+    // The region must be aligned to the blocks. Only blocks at the right or bottom edge of the level can be partial.
+    // The edges are the ones of the client image, because a not power of two image was resampled.
+    Texture& texture = RIXGL::getInstance().pipeline().texture();
+    const TextureObject texObj = texture.hasPendingTextureUpdate() ? texture.getTexture() : texture.getBoundTextureObject();
+    const GLint clientWidth = static_cast<GLint>(texObj.getClientWidth(level));
+    const GLint clientHeight = static_cast<GLint>(texObj.getClientHeight(level));
+    static constexpr GLint BLOCK_DIM { static_cast<GLint>(CompressedImageDecoder::BLOCK_DIM) };
+    if (((xoffset % BLOCK_DIM) != 0) || ((yoffset % BLOCK_DIM) != 0)
+        || (((width % BLOCK_DIM) != 0) && ((xoffset + width) != clientWidth))
+        || (((height % BLOCK_DIM) != 0) && ((yoffset + height) != clientHeight))
+        || (texObj.getInternalPixelFormat(level) != internalPixelFormat))
+    {
+        RIXGL::getInstance().setError(GL_INVALID_OPERATION);
+        SPDLOG_ERROR("glCompressedTexSubImage2D region is not aligned to the blocks or the format does not match the texture");
+        return;
+    }
+    if ((xoffset < 0) || (yoffset < 0) || ((xoffset + width) > clientWidth) || ((yoffset + height) > clientHeight))
+    {
+        RIXGL::getInstance().setError(GL_INVALID_VALUE);
+        SPDLOG_ERROR("glCompressedTexSubImage2D region exceeds the texture");
+        return;
+    }
+
+    // Patch the region into a copy of the kept compressed image. The old one might still be used by a pending upload.
+    TextureObject::CompressedPixelsType compressedPixels {};
+    const TextureObject::CompressedPixelsType oldCompressedPixels = texObj.getCompressedPixels(level);
+    if (data && oldCompressedPixels && (oldCompressedPixels->format == format))
+    {
+        std::shared_ptr<TextureObject::CompressedImage> patched = std::make_shared<TextureObject::CompressedImage>(*oldCompressedPixels);
+        CompressedImageDecoder::copyBlocks(patched->data, clientWidth, xoffset, yoffset, width, height, format, reinterpret_cast<const uint8_t*>(data));
+        compressedPixels = patched;
+    }
+
+    if (texObj.isResampled(level))
+    {
+        // Scale the region to the covered texels and resample it into them, like glTexSubImage2D
+        if ((width == 0) || (height == 0))
+        {
+            return;
+        }
+        const std::size_t texWidth = texObj.getWidth(level);
+        const std::size_t texHeight = texObj.getHeight(level);
+        const std::size_t x0 = (xoffset * texWidth) / clientWidth;
+        const std::size_t y0 = (yoffset * texHeight) / clientHeight;
+        const std::size_t x1 = (((xoffset + width) * texWidth) + clientWidth - 1) / clientWidth;
+        const std::size_t y1 = (((yoffset + height) * texHeight) + clientHeight - 1) / clientHeight;
+
+        const GLenum error = writeTextureRegion(
+            level,
+            static_cast<GLint>(x0),
+            static_cast<GLint>(y0),
+            static_cast<GLsizei>(x1 - x0),
+            static_cast<GLsizei>(y1 - y0),
+            data != nullptr,
+            [&](const TextureObject::PixelsType& texels, const InternalPixelFormat ipf, const std::size_t rowLength)
+            {
+                CompressedImageDecoder::decodeRescaled(
+                    RIXGL::getInstance().imageConverter(),
+                    texels,
+                    ipf,
+                    rowLength,
+                    x0,
+                    y0,
+                    x1 - x0,
+                    y1 - y0,
+                    width,
+                    height,
+                    format,
+                    reinterpret_cast<const uint8_t*>(data));
+            },
+            compressedPixels);
+        if (error != GL_NO_ERROR)
+        {
+            RIXGL::getInstance().setError(error);
+            SPDLOG_ERROR("glCompressedTexSubImage2D failed to store the resampled region (error 0x{:X})", error);
+        }
+        return;
+    }
+
+    const GLenum error = writeTextureRegion(level, xoffset, yoffset, width, height, data != nullptr,
+        [&](const TextureObject::PixelsType& texels, const InternalPixelFormat ipf, const std::size_t rowLength)
+        {
+            CompressedImageDecoder::decode(
+                texels,
+                ipf,
+                rowLength,
+                xoffset,
+                yoffset,
+                width,
+                height,
+                format,
+                reinterpret_cast<const uint8_t*>(data));
+        },
+        compressedPixels);
+    if (error != GL_NO_ERROR)
+    {
+        RIXGL::getInstance().setError(error);
+        SPDLOG_ERROR("glCompressedTexSubImage2D offsets or texture sizes are invalid (error 0x{:X})", error);
+    }
 }
 
 GLAPI void APIENTRY impl_glCompressedTexSubImage1D(
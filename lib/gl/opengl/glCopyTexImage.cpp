@@ -15,8 +15,8 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
+#include "ColorBufferRegion.hpp"
 #include "GLImpl.h"
-#include "Helpers.hpp"
 #include "ImageConverter.hpp"
 #include "RIXGL.hpp"
 #include "TypeConverters.hpp"
@@ -79,10 +79,8 @@ GLAPI void APIENTRY impl_glCopyTexImage2D(
         return;
     }
 
-    const uint16_t* texBuffer = readFromColorBuffer(x, y, width, height, true);
+    const std::vector<uint16_t> texBuffer = readFromColorBuffer(x, y, width, height, true);
 
     SPDLOG_DEBUG("glCopyTexImage2D redirect to glTexImage2D");
-    impl_glTexImage2D(target, level, internalformat, width, height, border, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, texBuffer);
-
-    delete texBuffer;
+    impl_glTexImage2D(target, level, internalformat, width, height, border, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, texBuffer.data());
 }
@@ -15,8 +15,8 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
+#include "ColorBufferRegion.hpp"
 #include "GLImpl.h"
-#include "Helpers.hpp"
 #include "RIXGL.hpp"
 #include "vertexpipeline/VertexPipeline.hpp"
 #include <spdlog/spdlog.h>
@@ -39,12 +39,34 @@ GLAPI void APIENTRY impl_glCopyTexSubImage2D(GLenum target, GLint level, GLint x
     SPDLOG_DEBUG("glCopyTexSubImage2D target 0x{:X} level 0x{:X} xoffset {} yoffset {} x {} y {} width {} height {} called",
         target, level, xoffset, yoffset, x, y, width, height);
 
-    const uint16_t* texBuffer = readFromColorBuffer(x, y, width, height, true);
+    if (target != GL_TEXTURE_2D)
+    {
+        RIXGL::getInstance().setError(GL_INVALID_ENUM);
+        SPDLOG_ERROR("glCopyTexSubImage2D target 0x{:X} not supported", target);
+        return;
+    }
 
-    SPDLOG_DEBUG("glCopyTexSubImage2D redirect to glTexSubImage2D");
-    impl_glTexSubImage2D(target, level, xoffset, yoffset, width, height, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, texBuffer);
+    if (static_cast<std::size_t>(level) > RIXGL::getInstance().getMaxLOD())
+    {
+        SPDLOG_ERROR("glCopyTexSubImage2D invalid lod.");
+        return;
+    }
 
-    delete texBuffer;
+    if (!RIXGL::getInstance().isMipmappingAvailable() && (level != 0))
+    {
+        RIXGL::getInstance().setError(GL_INVALID_VALUE);
+        SPDLOG_ERROR("glCopyTexSubImage2D mipmapping on hardware not supported.");
+        return;
+    }
+
+    // Only the rows of the source rectangle are read and converted directly into the texture
+    ColorBufferRegion region { x, y, width, height, true };
+    const GLenum error = copyColorBufferToTexture(region, level, xoffset, yoffset);
+    if (error != GL_NO_ERROR)
+    {
+        RIXGL::getInstance().setError(error);
+        SPDLOG_ERROR("glCopyTexSubImage2D offsets or texture sizes are invalid (error 0x{:X})", error);
+    }
 }
 
 GLAPI void APIENTRY impl_glCopyTexSubImage3D(
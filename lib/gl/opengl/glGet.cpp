@@ -15,6 +15,7 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
+#include "CompressedImageDecoder.hpp"
 #include "GLImpl.h"
 #include "ImageConverter.hpp"
 #include "RIXGL.hpp"
@@ -26,6 +27,78 @@
 
 using namespace rr;
 
+/// @brief Looks up a value of the GL_RIX_statistics extension
+/// @return false if pname is not a statistics value
+static bool getStatisticsValue(const GLenum pname, uint64_t& value)
+{
+    switch (pname)
+    {
+    case GL_FRAME_COUNT_RIX:
+    case GL_FRAME_TIME_RIX:
+    case GL_TRIANGLES_SUBMITTED_RIX:
+    case GL_TRIANGLES_CULLED_RIX:
+    case GL_TRIANGLES_CLIPPED_RIX:
+    case GL_TRIANGLES_RASTERIZED_RIX:
+    case GL_DISPLAY_LIST_USED_BYTES_RIX:
+    case GL_DISPLAY_LIST_SIZE_RIX:
+    case GL_TEXTURE_PAGES_USED_RIX:
+    case GL_TEXTURE_PAGES_FREE_RIX:
+    case GL_UPLOAD_TIME_RIX:
+    case GL_UPLOAD_STALLS_RIX:
+    case GL_UPLOAD_STALL_TIME_RIX:
+        break;
+    default:
+        return false;
+    }
+
+    const Renderer::Statistics statistics = RIXGL::getInstance().pipeline().getStatistics();
+    switch (pname)
+    {
+    case GL_FRAME_COUNT_RIX:
+        value = statistics.frames;
+        break;
+    case GL_FRAME_TIME_RIX:
+        value = statistics.frameTime.count();
+        break;
+    case GL_TRIANGLES_SUBMITTED_RIX:
+        value = statistics.frame.trianglesSubmitted;
+        break;
+    case GL_TRIANGLES_CULLED_RIX:
+        value = statistics.frame.trianglesCulled;
+        break;
+    case GL_TRIANGLES_CLIPPED_RIX:
+        value = statistics.frame.trianglesClipped;
+        break;
+    case GL_TRIANGLES_RASTERIZED_RIX:
+        value = statistics.frame.trianglesRasterized;
+        break;
+    case GL_DISPLAY_LIST_USED_BYTES_RIX:
+        value = statistics.frame.displayListBytes;
+        break;
+    case GL_DISPLAY_LIST_SIZE_RIX:
+        value = statistics.frame.displayListSize;
+        break;
+    case GL_TEXTURE_PAGES_USED_RIX:
+        value = statistics.texture.usedPages;
+        break;
+    case GL_TEXTURE_PAGES_FREE_RIX:
+        value = statistics.texture.freePages;
+        break;
+    case GL_UPLOAD_TIME_RIX:
+        value = statistics.uploadTime.count();
+        break;
+    case GL_UPLOAD_STALLS_RIX:
+        value = statistics.frame.uploadStalls;
+        break;
+    case GL_UPLOAD_STALL_TIME_RIX:
+        value = statistics.frame.uploadStallTime;
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
 GLAPI void APIENTRY impl_glGetBooleanv(GLenum pname, GLboolean* params)
 {
     SPDLOG_DEBUG("glGetBooleanv pname 0x{:X} called", pname);
@@ -77,6 +150,13 @@ GLAPI void APIENTRY impl_glGetFloatv(GLenum pname, GLfloat* params)
 {
     SPDLOG_DEBUG("glGetFloatv pname 0x{:X} called", pname);
 
+    uint64_t statisticsValue {};
+    if (getStatisticsValue(pname, statisticsValue))
+    {
+        params[0] = static_cast<GLfloat>(statisticsValue);
+        return;
+    }
+
     switch (pname)
     {
     case GL_ACTIVE_TEXTURE:
@@ -160,7 +240,8 @@ GLAPI void APIENTRY impl_glGetFloatv(GLenum pname, GLfloat* params)
         params[3] = static_cast<GLfloat>(convertBoolToGLboolean(RIXGL::getInstance().pipeline().fragmentPipeline().getColorMaskA()));
         break;
     case GL_COMPRESSED_TEXTURE_FORMATS:
-        params[0] = 0.0f;
+        for (std::size_t i = 0; i < CompressedImageDecoder::SUPPORTED_FORMATS.size(); i++)
+            params[i] = static_cast<GLfloat>(CompressedImageDecoder::SUPPORTED_FORMATS[i]);
         break;
     case GL_CULL_FACE:
         params[0] = static_cast<GLfloat>(convertBoolToGLboolean(RIXGL::getInstance().pipeline().getCulling().isCullingEnabled()));
@@ -348,7 +429,7 @@ GLAPI void APIENTRY impl_glGetFloatv(GLenum pname, GLfloat* params)
         params[0] = static_cast<GLfloat>(convertBoolToGLboolean(RIXGL::getInstance().pipeline().getLighting().getNormalNormalizationEnabled()));
         break;
     case GL_NUM_COMPRESSED_TEXTURE_FORMATS:
-        params[0] = 0.0f;
+        params[0] = static_cast<GLfloat>(CompressedImageDecoder::SUPPORTED_FORMATS.size());
         break;
     case GL_PACK_ALIGNMENT:
         params[0] = static_cast<GLfloat>(RIXGL::getInstance().imageConverter().getPackAlignment());
@@ -557,6 +638,22 @@ GLAPI void APIENTRY impl_glGetIntegerv(GLenum pname, GLint* params)
 {
     SPDLOG_DEBUG("glGetIntegerv pname 0x{:X} called", pname);
 
+    // The list of formats does not fit into the redirect buffer
+    if (pname == GL_COMPRESSED_TEXTURE_FORMATS)
+    {
+        for (std::size_t i = 0; i < CompressedImageDecoder::SUPPORTED_FORMATS.size(); i++)
+            params[i] = static_cast<GLint>(CompressedImageDecoder::SUPPORTED_FORMATS[i]);
+        return;
+    }
+
+    // The counters can exceed the precision of the redirect buffer
+    uint64_t statisticsValue {};
+    if (getStatisticsValue(pname, statisticsValue))
+    {
+        params[0] = static_cast<GLint>((std::min)(statisticsValue, static_cast<uint64_t>(std::numeric_limits<GLint>::max())));
+        return;
+    }
+
     GLfloat floatVals[4] = { 0.0f };
     SPDLOG_DEBUG("glGetIntegerv redirected to glGetFloatv", pname);
     impl_glGetFloatv(pname, floatVals);
@@ -16,12 +16,36 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "GLImpl.h"
+#include "RIXGL.hpp"
+#include "vertexpipeline/VertexPipeline.hpp"
+#include <algorithm>
 #include <spdlog/spdlog.h>
 
+using namespace rr;
+
 GLAPI void APIENTRY impl_glGetCompressedTexImage(
     [[maybe_unused]] GLenum target,
-    [[maybe_unused]] GLint level,
-    [[maybe_unused]] GLvoid* pixels)
+    GLint level,
+    GLvoid* pixels)
 {
-    SPDLOG_WARN("glGetCompressedTexImage not implemented");
-}
\ No newline at end of file
+    SPDLOG_DEBUG("glGetCompressedTexImage target 0x{:X} level 0x{:X} called", target, level);
+
+    if ((level < 0) || (static_cast<std::size_t>(level) > RIXGL::getInstance().getMaxLOD()))
+    {
+        RIXGL::getInstance().setError(GL_INVALID_VALUE);
+        SPDLOG_ERROR("glGetCompressedTexImage invalid lod.");
+        return;
+    }
+
+    // Only levels which were specified with glCompressedTexImage2D keep their compressed image
+    Texture& texture = RIXGL::getInstance().pipeline().texture();
+    const TextureObject texObj = texture.hasPendingTextureUpdate() ? texture.getTexture() : texture.getBoundTextureObject();
+    const TextureObject::CompressedPixelsType compressedPixels = texObj.getCompressedPixels(level);
+    if (!compressedPixels)
+    {
+        RIXGL::getInstance().setError(GL_INVALID_OPERATION);
+        SPDLOG_ERROR("glGetCompressedTexImage level {} is not compressed", level);
+        return;
+    }
+    std::copy(compressedPixels->data.begin(), compressedPixels->data.end(), static_cast<uint8_t*>(pixels));
+}
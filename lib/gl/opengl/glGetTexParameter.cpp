@@ -27,6 +27,12 @@ using namespace rr;
 
 GLAPI void APIENTRY impl_glGetTexParameterfv(GLenum target, GLenum pname, GLfloat* params)
 {
+    if ((target == GL_TEXTURE_2D) && (pname == GL_TEXTURE_PRIORITY))
+    {
+        SPDLOG_DEBUG("glGetTexParameterfv GL_TEXTURE_PRIORITY called");
+        *params = RIXGL::getInstance().pipeline().texture().getPriority();
+        return;
+    }
     SPDLOG_DEBUG("glGetTexParameterfv redirected to glGetTexParameteriv");
     impl_glGetTexParameteriv(target, pname, reinterpret_cast<GLint*>(params));
 }
@@ -57,6 +63,12 @@ GLAPI void APIENTRY impl_glGetTexParameteriv(GLenum target, GLenum pname, GLint*
     case GL_GENERATE_MIPMAP:
         *params = convertBoolToGLboolean(RIXGL::getInstance().mipMapGenerator().getEnableMipMapGeneration());
         break;
+    case GL_TEXTURE_RESIDENT:
+        *params = convertBoolToGLboolean(RIXGL::getInstance().pipeline().texture().isResident());
+        break;
+    case GL_TEXTURE_PRIORITY:
+        *params = static_cast<GLint>(static_cast<double>(RIXGL::getInstance().pipeline().texture().getPriority()) * 2147483647.0);
+        break;
     default:
         SPDLOG_ERROR("glGetTexParameteriv pname 0x{:X} not supported", pname);
         RIXGL::getInstance().setError(GL_INVALID_ENUM);
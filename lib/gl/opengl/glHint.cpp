@@ -16,9 +16,55 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "GLImpl.h"
+#include "ImageConverter.hpp"
+#include "RIXGL.hpp"
 #include <spdlog/spdlog.h>
 
-GLAPI void APIENTRY impl_glHint([[maybe_unused]] GLenum target, [[maybe_unused]] GLenum mode)
+using namespace rr;
+
+GLAPI void APIENTRY impl_glHint(GLenum target, GLenum mode)
 {
-    SPDLOG_WARN("glHint not implemented");
-}
\ No newline at end of file
+    SPDLOG_DEBUG("glHint target 0x{:X} mode 0x{:X} called", target, mode);
+
+    ImageConverter& imageConverter { RIXGL::getInstance().imageConverter() };
+    switch (target)
+    {
+    case GL_TEXTURE_NPOT_ROUNDING_HINT_RIX:
+        switch (mode)
+        {
+        case GL_NICEST:
+            imageConverter.setNpotRounding(ImageConverter::NpotRounding::NEXT);
+            break;
+        case GL_DONT_CARE:
+            imageConverter.setNpotRounding(ImageConverter::NpotRounding::NEAREST);
+            break;
+        case GL_FASTEST:
+            imageConverter.setNpotRounding(ImageConverter::NpotRounding::DOWN);
+            break;
+        default:
+            SPDLOG_ERROR("glHint GL_TEXTURE_NPOT_ROUNDING_HINT_RIX mode 0x{:X} not supported", mode);
+            RIXGL::getInstance().setError(GL_INVALID_ENUM);
+            break;
+        }
+        break;
+    case GL_TEXTURE_NPOT_FILTER_HINT_RIX:
+        switch (mode)
+        {
+        case GL_NICEST:
+        case GL_DONT_CARE:
+            imageConverter.setNpotFilter(ImageResampler::Filter::BILINEAR);
+            break;
+        case GL_FASTEST:
+            imageConverter.setNpotFilter(ImageResampler::Filter::BOX);
+            break;
+        default:
+            SPDLOG_ERROR("glHint GL_TEXTURE_NPOT_FILTER_HINT_RIX mode 0x{:X} not supported", mode);
+            RIXGL::getInstance().setError(GL_INVALID_ENUM);
+            break;
+        }
+        break;
+    default:
+        SPDLOG_WARN("glHint target 0x{:X} not implemented", target);
+        break;
+    }
+}
@@ -16,12 +16,30 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "GLImpl.h"
+#include "RIXGL.hpp"
+#include "vertexpipeline/VertexPipeline.hpp"
 #include <spdlog/spdlog.h>
 
+using namespace rr;
+
 GLAPI void APIENTRY impl_glPrioritizeTextures(
-    [[maybe_unused]] GLsizei n,
-    [[maybe_unused]] const GLuint* textures,
-    [[maybe_unused]] const GLclampf* priorities)
+    GLsizei n,
+    const GLuint* textures,
+    const GLclampf* priorities)
 {
-    SPDLOG_WARN("glPrioritizeTextures not implemented");
+    SPDLOG_DEBUG("glPrioritizeTextures n {} called", n);
+    if (n < 0)
+    {
+        RIXGL::getInstance().setError(GL_INVALID_VALUE);
+        SPDLOG_ERROR("glPrioritizeTextures n is negative");
+        return;
+    }
+    for (GLsizei i = 0; i < n; i++)
+    {
+        // Names which are zero or which do not correspond to a texture are silently ignored
+        if (RIXGL::getInstance().pipeline().texture().isTextureValid(textures[i]))
+        {
+            RIXGL::getInstance().pipeline().texture().setTexturePriority(textures[i], priorities[i]);
+        }
+    }
 }
@@ -15,8 +15,8 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
+#include "ColorBufferRegion.hpp"
 #include "GLImpl.h"
-#include "Helpers.hpp"
 #include "ImageConverter.hpp"
 #include "RIXGL.hpp"
 #include "vertexpipeline/VertexPipeline.hpp"
@@ -29,25 +29,54 @@ GLAPI void APIENTRY impl_glReadPixels(GLint x, GLint y, GLsizei width, GLsizei h
     SPDLOG_DEBUG("glReadPixels x {} y {} width {} height {} format 0x{:X} type {:X} called",
         x, y, width, height, format, type);
 
-    if (format != GL_RGBA)
+    switch (format)
     {
+    case GL_RGB:
+    case GL_RGBA:
+    case GL_BGRA:
+        break;
+    default:
         SPDLOG_WARN("glReadPixels format not supported");
         RIXGL::getInstance().setError(GL_INVALID_ENUM);
         return;
     }
-    if (type != GL_UNSIGNED_BYTE)
+    switch (type)
     {
+    case GL_UNSIGNED_BYTE:
+    case GL_UNSIGNED_SHORT_5_6_5:
+        break;
+    default:
         SPDLOG_WARN("glReadPixels type not supported");
         RIXGL::getInstance().setError(GL_INVALID_ENUM);
         return;
     }
-    if (!((format == GL_RGBA) && (type == GL_UNSIGNED_BYTE)))
+    if (!ImageConverter::isPackFormatSupported(format, type))
     {
-        SPDLOG_WARN("glReadPixels only GL_RGBA/GL_UNSIGNED_BYTE is supported");
+        SPDLOG_WARN("glReadPixels only GL_RGBA, GL_BGRA and GL_RGB with GL_UNSIGNED_BYTE and GL_RGB with GL_UNSIGNED_SHORT_5_6_5 are supported");
         RIXGL::getInstance().setError(GL_INVALID_OPERATION);
         return;
     }
-    const uint16_t* pixelsDevice = readFromColorBuffer(x, y, width, height, false);
-    RIXGL::getInstance().imageConverter().convertRGB565ToPackedRGBA8888(reinterpret_cast<uint8_t*>(pixels), width, height, pixelsDevice);
-    delete pixelsDevice;
-}
\ No newline at end of file
+    if ((width < 0) || (height < 0))
+    {
+        RIXGL::getInstance().setError(GL_INVALID_VALUE);
+        return;
+    }
+
+    // Only the rows of the color buffer covered by the region are read
+    ColorBufferRegion region { x, y, width, height, false };
+    if (!region.isValid())
+    {
+        return;
+    }
+    // The client format matches the color buffer. Without padding between the rows, they are read directly into the client buffer.
+    if ((type == GL_UNSIGNED_SHORT_5_6_5)
+        && (((width * sizeof(uint16_t)) % RIXGL::getInstance().imageConverter().getPackAlignment()) == 0)
+        && region.isInside())
+    {
+        region.readRows(reinterpret_cast<uint8_t*>(pixels));
+        return;
+    }
+    // Otherwise each row is read into a scratch row and converted into the client buffer
+    RIXGL::getInstance().imageConverter().convertPack(reinterpret_cast<uint8_t*>(pixels), width, height, format, type, [&region](const GLint row)
+        { return region.getRow(row); });
+}
@@ -16,6 +16,7 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "GLImpl.h"
+#include "Helpers.hpp"
 #include "ImageConverter.hpp"
 #include "RIXGL.hpp"
 #include "vertexpipeline/VertexPipeline.hpp"
@@ -70,10 +71,10 @@ GLAPI void APIENTRY impl_glTexImage2D(GLenum target, GLint level, GLint internal
         return;
     }
 
-    // It can happen, that a not power of two texture is used. This little hack allows that the texture can sill be used
-    // without crashing the software. But it is likely that it will produce graphical errors.
-    const std::size_t widthRounded = powf(2.0f, ceilf(logf(width) / logf(2.0f)));
-    const std::size_t heightRounded = powf(2.0f, ceilf(logf(height) / logf(2.0f)));
+    // Not power of two textures are resampled to a power of two. This keeps the texture coordinates valid.
+    ImageConverter& imageConverter { RIXGL::getInstance().imageConverter() };
+    const std::size_t widthRounded = imageConverter.getPowerOfTwoSize(width);
+    const std::size_t heightRounded = imageConverter.getPowerOfTwoSize(height);
 
     if ((widthRounded == 0) || (heightRounded == 0))
     {
@@ -97,8 +98,39 @@ GLAPI void APIENTRY impl_glTexImage2D(GLenum target, GLint level, GLint internal
     texObj.setHeight(level, heightRounded);
     texObj.setInternalPixelFormat(level, internalPixelFormat);
 
-    SPDLOG_DEBUG("glTexImage2D redirect to glTexSubImage2D");
-    impl_glTexSubImage2D(target, level, 0, 0, width, height, format, type, pixels);
+    if (pixels && ((widthRounded != static_cast<std::size_t>(width)) || (heightRounded != static_cast<std::size_t>(height))))
+    {
+        const GLenum error = writeTextureRegion(level, 0, 0, widthRounded, heightRounded, true,
+            [&](const TextureObject::PixelsType& texels, const InternalPixelFormat ipf, const std::size_t rowLength)
+            {
+                imageConverter.convertUnpackRescaled(
+                    texels,
+                    ipf,
+                    rowLength,
+                    0,
+                    0,
+                    widthRounded,
+                    heightRounded,
+                    width,
+                    height,
+                    format,
+                    type,
+                    reinterpret_cast<const uint8_t*>(pixels));
+            });
+        if (error != GL_NO_ERROR)
+        {
+            RIXGL::getInstance().setError(error);
+            SPDLOG_ERROR("glTexImage2D failed to store the resampled texture (error 0x{:X})", error);
+        }
+    }
+    else
+    {
+        SPDLOG_DEBUG("glTexImage2D redirect to glTexSubImage2D");
+        impl_glTexSubImage2D(target, level, 0, 0, widthRounded, heightRounded, format, type, pixels);
+    }
+
+    // Recorded after the image is written, so that glTexSubImage2D can scale its regions into the resampled texture
+    RIXGL::getInstance().pipeline().texture().getTexture().setClientSize(level, width, height);
 }
 
 GLAPI void APIENTRY impl_glTexImage3D(
@@ -26,6 +26,12 @@ using namespace rr;
 
 GLAPI void APIENTRY impl_glTexParameterf(GLenum target, GLenum pname, GLfloat param)
 {
+    if ((target == GL_TEXTURE_2D) && (pname == GL_TEXTURE_PRIORITY))
+    {
+        SPDLOG_DEBUG("glTexParameterf GL_TEXTURE_PRIORITY param {}", param);
+        RIXGL::getInstance().pipeline().texture().setPriority(param);
+        return;
+    }
     SPDLOG_DEBUG("glTexParameterf target 0x{:X} pname 0x{:X} param {} redirected to glTexParameteri", target, pname, param);
     impl_glTexParameteri(target, pname, static_cast<GLint>(param));
 }
@@ -105,6 +111,10 @@ GLAPI void APIENTRY impl_glTexParameteri(GLenum target, GLenum pname, GLint para
                 break;
             }
             break;
+        case GL_TEXTURE_PRIORITY:
+            // Integers are mapped linearly from [0, 2^31 - 1] to [0, 1]
+            RIXGL::getInstance().pipeline().texture().setPriority(static_cast<float>(static_cast<double>(param) / 2147483647.0));
+            break;
         case GL_GENERATE_MIPMAP:
             if ((param == GL_TRUE) || (param == GL_FALSE))
             {
@@ -16,7 +16,7 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "GLImpl.h"
-#include "MipMapGenerator.hpp"
+#include "Helpers.hpp"
 #include "RIXGL.hpp"
 #include "vertexpipeline/VertexPipeline.hpp"
 #include <spdlog/spdlog.h>
@@ -61,61 +61,83 @@ GLAPI void APIENTRY impl_glTexSubImage2D(
         return;
     }
 
-    TextureObject& texObj { RIXGL::getInstance().pipeline().texture().getTexture() };
-    if (((xoffset + width) > static_cast<GLint>(texObj.getWidth(level)))
-        || ((yoffset + height) > static_cast<GLint>(texObj.getHeight(level))))
+    Texture& texture = RIXGL::getInstance().pipeline().texture();
+    const TextureObject texObj = texture.hasPendingTextureUpdate() ? texture.getTexture() : texture.getBoundTextureObject();
+    if (texObj.isResampled(level))
     {
-        RIXGL::getInstance().setError(GL_INVALID_VALUE);
-        SPDLOG_ERROR("glTexSubImage2D offsets or texture sizes are too big");
-        return;
-    }
-
-    using PixelType = TextureObject::PixelsType::element_type;
-
-    const std::size_t texMemSize = texObj.getWidth(level) * texObj.getHeight(level) * sizeof(PixelType);
-    if (texMemSize == 0)
-    {
-        SPDLOG_DEBUG("glTexSubImage2D texture with zero dimensions loaded.");
-        return;
-    }
-
-    std::shared_ptr<PixelType> texMemShared(
-        new PixelType[texMemSize / sizeof(PixelType)],
-        [](const PixelType* p)
-        { delete[] p; });
-
-    if (!texMemShared)
-    {
-        RIXGL::getInstance().setError(GL_OUT_OF_MEMORY);
-        SPDLOG_ERROR("glTexSubImage2D Out Of Memory");
+        // The texture was resampled from a not power of two image. The region is specified in the coordinates
+        // of the client image, scale it to the covered texels and resample it into them.
+        const std::size_t clientWidth = texObj.getClientWidth(level);
+        const std::size_t clientHeight = texObj.getClientHeight(level);
+        if ((xoffset < 0) || (yoffset < 0) || (width < 0) || (height < 0)
+            || (static_cast<std::size_t>(xoffset + width) > clientWidth)
+            || (static_cast<std::size_t>(yoffset + height) > clientHeight))
+        {
+            RIXGL::getInstance().setError(GL_INVALID_VALUE);
+            SPDLOG_ERROR("glTexSubImage2D region exceeds the client image of a resampled texture");
+            return;
+        }
+        if ((width == 0) || (height == 0))
+        {
+            return;
+        }
+        const std::size_t texWidth = texObj.getWidth(level);
+        const std::size_t texHeight = texObj.getHeight(level);
+        const std::size_t x0 = (xoffset * texWidth) / clientWidth;
+        const std::size_t y0 = (yoffset * texHeight) / clientHeight;
+        const std::size_t x1 = (((xoffset + width) * texWidth) + clientWidth - 1) / clientWidth;
+        const std::size_t y1 = (((yoffset + height) * texHeight) + clientHeight - 1) / clientHeight;
+
+        const GLenum error = writeTextureRegion(
+            level,
+            static_cast<GLint>(x0),
+            static_cast<GLint>(y0),
+            static_cast<GLsizei>(x1 - x0),
+            static_cast<GLsizei>(y1 - y0),
+            pixels != nullptr,
+            [&](const TextureObject::PixelsType& texels, const InternalPixelFormat ipf, const std::size_t rowLength)
+            {
+                RIXGL::getInstance().imageConverter().convertUnpackRescaled(
+                    texels,
+                    ipf,
+                    rowLength,
+                    x0,
+                    y0,
+                    x1 - x0,
+                    y1 - y0,
+                    width,
+                    height,
+                    format,
+                    type,
+                    reinterpret_cast<const uint8_t*>(pixels));
+            });
+        if (error != GL_NO_ERROR)
+        {
+            RIXGL::getInstance().setError(error);
+            SPDLOG_ERROR("glTexSubImage2D failed to store the resampled region (error 0x{:X})", error);
+        }
         return;
     }
-    if (texObj.getPixels(level))
-    {
-        std::memcpy(texMemShared.get(), texObj.getPixels(level).get(), std::min(texObj.getSizeInBytes(level), texMemSize));
-    }
-    else
-    {
-        std::memset(texMemShared.get(), 0, texMemSize);
-    }
-    texObj.setPixels(level, texMemShared);
 
-    // Check if pixels is null. If so, just set the empty memory area and don't copy anything.
-    if (pixels != nullptr)
+    const GLenum error = writeTextureRegion(level, xoffset, yoffset, width, height, pixels != nullptr,
+        [&](const TextureObject::PixelsType& texels, const InternalPixelFormat ipf, const std::size_t rowLength)
+        {
+            RIXGL::getInstance().imageConverter().convertUnpack(
+                texels,
+                ipf,
+                rowLength,
+                xoffset,
+                yoffset,
+                width,
+                height,
+                format,
+                type,
+                reinterpret_cast<const uint8_t*>(pixels));
+        });
+    if (error != GL_NO_ERROR)
     {
-        RIXGL::getInstance().imageConverter().convertUnpack(
-            texObj.getPixels(level),
-            texObj.getInternalPixelFormat(level),
-            texObj.getWidth(level),
-            xoffset,
-            yoffset,
-            width,
-            height,
-            format,
-            type,
-            reinterpret_cast<const uint8_t*>(pixels));
-
-        RIXGL::getInstance().mipMapGenerator().generateMipMap(RIXGL::getInstance().pipeline().texture().getTexture(), level);
+        RIXGL::getInstance().setError(error);
+        SPDLOG_ERROR("glTexSubImage2D offsets or texture sizes are invalid (error 0x{:X})", error);
     }
 }
 
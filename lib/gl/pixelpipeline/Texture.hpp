@@ -32,22 +32,34 @@ public:
 
     bool updateTexture();
     TextureObject& getTexture();
+    bool hasPendingTextureUpdate() const { return m_textureObject.has_value(); }
+    TextureObject getBoundTextureObject() { return m_renderer.getTexture(m_tmuConf[m_tmu].boundTexture); }
+    bool updateTextureRegion(const TextureObject& textureObject, const std::size_t level, const std::size_t x, const std::size_t y, const std::size_t width, const std::size_t height)
+    {
+        return m_renderer.updateTextureRegion(m_tmuConf[m_tmu].boundTexture, textureObject, level, x, y, width, height);
+    }
     bool useTexture();
     bool isTextureValid(const uint16_t texId) const { return m_renderer.isTextureValid(texId); };
     std::pair<bool, uint16_t> createTexture() { return m_renderer.createTexture(); }
     bool createTextureWithName(const uint16_t texId) { return m_renderer.createTextureWithName(texId); };
     bool deleteTexture(const uint16_t texture) { return m_renderer.deleteTexture(texture); }
+    bool isTextureResident(const uint16_t texId) const { return m_renderer.isTextureResident(texId); }
+    bool isDrawnInCurrentFrame() const { return m_renderer.isTextureDrawnInCurrentFrame(m_tmuConf[m_tmu].boundTexture); }
+    void setTexturePriority(const uint16_t texId, const float priority) { m_renderer.setTexturePriority(texId, priority); }
     void setBoundTexture(const uint16_t val);
     uint16_t getBoundTexture() const { return m_tmuConf[m_tmu].boundTexture; }
     void setTexWrapModeS(const TextureWrapMode mode) { m_renderer.setTextureWrapModeS(m_tmu, m_tmuConf[m_tmu].boundTexture, mode); }
     void setTexWrapModeT(const TextureWrapMode mode) { m_renderer.setTextureWrapModeT(m_tmu, m_tmuConf[m_tmu].boundTexture, mode); }
     void setEnableMagFilter(const bool val) { m_renderer.enableTextureMagFiltering(m_tmu, m_tmuConf[m_tmu].boundTexture, val); }
     void setEnableMinFilter(const bool val) { m_renderer.enableTextureMinFiltering(m_tmu, m_tmuConf[m_tmu].boundTexture, val); }
+    void setPriority(const float priority) { m_renderer.setTexturePriority(m_tmuConf[m_tmu].boundTexture, priority); }
 
     TextureWrapMode getTexWrapModeS() const { return m_renderer.getTextureWrapModeS(m_tmuConf[m_tmu].boundTexture); }
     TextureWrapMode getTexWrapModeT() const { return m_renderer.getTextureWrapModeT(m_tmuConf[m_tmu].boundTexture); }
     bool magFilterEnabled() const { return m_renderer.textureMagFilteringEnabled(m_tmuConf[m_tmu].boundTexture); }
     bool minFilterEnabled() const { return m_renderer.textureMinFilteringEnabled(m_tmuConf[m_tmu].boundTexture); }
+    float getPriority() const { return m_renderer.getTexturePriority(m_tmuConf[m_tmu].boundTexture); }
+    bool isResident() const { return m_renderer.isTextureResident(m_tmuConf[m_tmu].boundTexture); }
 
     bool setTexEnvMode(const TexEnvMode mode);
     void setCombineRgb(const Combine val) { texEnv().setCombineRgb(val); }
@@ -0,0 +1,104 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef FRAME_STATISTICS_HPP_
+#define FRAME_STATISTICS_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace rr
+{
+
+/// @brief Statistics of the last completed frame, collected where the vertices are transformed
+struct FrameStatistics
+{
+    std::size_t trianglesSubmitted { 0 }; ///< Triangles which entered the clipping stage
+    std::size_t trianglesCulled { 0 }; ///< Triangles discarded by the clipper or the face culling
+    std::size_t trianglesClipped { 0 }; ///< Triangles which intersected the clipping planes
+    std::size_t trianglesRasterized { 0 }; ///< Visible triangles added to the display list
+    std::size_t displayListBytes { 0 }; ///< Highest fill level of a display list in this frame
+    std::size_t displayListSize { 0 }; ///< Capacity of a display list
+    std::size_t uploadStalls { 0 }; ///< Accumulated number of display lists which had to wait for a free upload slot
+    uint64_t uploadStallTime { 0 }; ///< Accumulated time in microseconds spent waiting for a free upload slot
+};
+
+/// @brief Hands the FrameStatistics from the thread which assembles the frames to the thread which queries them
+/// @details Each value is stored in its own atomic. A reader racing with publish() can observe values of two
+///     consecutive frames, which is acceptable for statistics. The values are stored with 32 bit, because 64 bit
+///     atomics require libatomic on cores like the Cortex-M0+. Larger values wrap around.
+class FrameStatisticsPublisher
+{
+public:
+    void publish(const FrameStatistics& statistics)
+    {
+        storeValue(TRIANGLES_SUBMITTED, statistics.trianglesSubmitted);
+        storeValue(TRIANGLES_CULLED, statistics.trianglesCulled);
+        storeValue(TRIANGLES_CLIPPED, statistics.trianglesClipped);
+        storeValue(TRIANGLES_RASTERIZED, statistics.trianglesRasterized);
+        storeValue(DISPLAY_LIST_BYTES, statistics.displayListBytes);
+        storeValue(DISPLAY_LIST_SIZE, statistics.displayListSize);
+        storeValue(UPLOAD_STALLS, statistics.uploadStalls);
+        storeValue(UPLOAD_STALL_TIME, statistics.uploadStallTime);
+        m_published.store(true, std::memory_order_release);
+    }
+
+    /// @brief Loads the last published statistics
+    /// @return false if no frame was published yet
+    bool load(FrameStatistics& statistics) const
+    {
+        if (!m_published.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        statistics.trianglesSubmitted = loadValue(TRIANGLES_SUBMITTED);
+        statistics.trianglesCulled = loadValue(TRIANGLES_CULLED);
+        statistics.trianglesClipped = loadValue(TRIANGLES_CLIPPED);
+        statistics.trianglesRasterized = loadValue(TRIANGLES_RASTERIZED);
+        statistics.displayListBytes = loadValue(DISPLAY_LIST_BYTES);
+        statistics.displayListSize = loadValue(DISPLAY_LIST_SIZE);
+        statistics.uploadStalls = loadValue(UPLOAD_STALLS);
+        statistics.uploadStallTime = loadValue(UPLOAD_STALL_TIME);
+        return true;
+    }
+
+private:
+    enum Value : std::size_t
+    {
+        TRIANGLES_SUBMITTED,
+        TRIANGLES_CULLED,
+        TRIANGLES_CLIPPED,
+        TRIANGLES_RASTERIZED,
+        DISPLAY_LIST_BYTES,
+        DISPLAY_LIST_SIZE,
+        UPLOAD_STALLS,
+        UPLOAD_STALL_TIME,
+        VALUE_COUNT
+    };
+
+    void storeValue(const Value value, const uint64_t v) { m_values[value].store(static_cast<uint32_t>(v), std::memory_order_relaxed); }
+    uint32_t loadValue(const Value value) const { return m_values[value].load(std::memory_order_relaxed); }
+
+    std::array<std::atomic<uint32_t>, VALUE_COUNT> m_values {};
+    std::atomic<bool> m_published { false };
+};
+
+} // namespace rr
+
+#endif // FRAME_STATISTICS_HPP_
@@ -0,0 +1,117 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef FREEINDEXLIST_HPP
+#define FREEINDEXLIST_HPP
+
+#include <array>
+#include <cstdint>
+
+namespace rr
+{
+
+/// @brief Stack of free indices in the range [0, Size)
+/// @details The indices are linked in a doubly linked list which is stored in arrays. This allows to push, pop and
+///     remove any index in constant time without allocating memory.
+///     After reset(), pop() returns the indices in ascending order. Freed indices are reused first.
+template <std::size_t Size>
+class FreeIndexList
+{
+public:
+    static_assert(Size < UINT32_MAX, "Size exceeds the index type");
+
+    /// @brief Marks the indices in [first, Size) as free and all others as used
+    void reset(const std::size_t first = 0)
+    {
+        m_head = NONE;
+        m_size = 0;
+        m_linked.fill(false);
+        for (std::size_t i = Size; i > first; i--)
+        {
+            push(i - 1);
+        }
+    }
+
+    bool empty() const { return m_size == 0; }
+    std::size_t size() const { return m_size; }
+
+    /// @brief Checks if an index is free
+    bool contains(const std::size_t index) const { return m_linked[index]; }
+
+    /// @brief Takes the next free index. The list must not be empty.
+    std::size_t pop()
+    {
+        const std::size_t index = m_head;
+        remove(index);
+        return index;
+    }
+
+    /// @brief Marks an index as free. Does nothing if the index is already free.
+    void push(const std::size_t index)
+    {
+        if (m_linked[index])
+        {
+            return;
+        }
+        m_next[index] = m_head;
+        m_prev[index] = NONE;
+        if (m_head != NONE)
+        {
+            m_prev[m_head] = index;
+        }
+        m_head = index;
+        m_linked[index] = true;
+        m_size++;
+    }
+
+    /// @brief Marks a free index as used. Does nothing if the index is not free.
+    void remove(const std::size_t index)
+    {
+        if (!m_linked[index])
+        {
+            return;
+        }
+        const uint32_t next = m_next[index];
+        const uint32_t prev = m_prev[index];
+        if (prev != NONE)
+        {
+            m_next[prev] = next;
+        }
+        else
+        {
+            m_head = next;
+        }
+        if (next != NONE)
+        {
+            m_prev[next] = prev;
+        }
+        m_linked[index] = false;
+        m_size--;
+    }
+
+private:
+    static constexpr uint32_t NONE { UINT32_MAX };
+
+    std::array<uint32_t, Size> m_next {};
+    std::array<uint32_t, Size> m_prev {};
+    std::array<bool, Size> m_linked {};
+    uint32_t m_head { NONE };
+    std::size_t m_size { 0 };
+};
+
+} // namespace rr
+#endif // FREEINDEXLIST_HPP
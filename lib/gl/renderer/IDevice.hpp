@@ -18,6 +18,7 @@
 #ifndef _IDEVICE_HPP_
 #define _IDEVICE_HPP_
 
+#include "renderer/FrameStatistics.hpp"
 #include <cstdint>
 #include <tcb/span.hpp>
 
@@ -27,6 +28,9 @@ namespace rr
 class IDevice
 {
 public:
+    /// @brief Identifies an asynchronous read
+    using ReadHandle = uint32_t;
+
     virtual ~IDevice() = default;
 
     /// @brief Streams a display list to the device.
@@ -49,6 +53,31 @@ public:
     /// @return True if the read operation was successful, false otherwise.
     virtual bool readFromDeviceMemory(tcb::span<uint8_t> data, const uint32_t addr) = 0;
 
+    /// @brief Queues a read of the devices memory and returns without waiting for the data.
+    /// @details Devices which can overlap the read with the rendering of the next frame complete it
+    ///     while display lists are streamed. The reads are completed in the order they were queued.
+    ///     The data must stay valid until the read is complete. The default implementation reads synchronously.
+    ///
+    /// @param data The data where to store the loaded data.
+    /// @param addr The address to read from.
+    /// @return The handle to query the completion of the read.
+    virtual ReadHandle readFromDeviceMemoryAsync(tcb::span<uint8_t> data, const uint32_t addr)
+    {
+        readFromDeviceMemory(data, addr);
+        return 0;
+    }
+
+    /// @brief Checks if a read queued with readFromDeviceMemoryAsync is complete.
+    ///
+    /// @param handle The handle of the read.
+    /// @return True if the data of the read is available, false otherwise.
+    virtual bool isReadComplete([[maybe_unused]] const ReadHandle handle) const { return true; }
+
+    /// @brief Blocks until the read and all reads queued before it are complete.
+    ///
+    /// @param handle The handle of the read.
+    virtual void waitForRead([[maybe_unused]] const ReadHandle handle) { }
+
     /// @brief Waits until the device is idle and ready for new commands.
     ///     When this method returns, the buffer used in streamDisplayList can be safely reused.
     ///     Same is true for the buffer in writeToDeviceMemory.
@@ -61,6 +90,12 @@ public:
 
     /// @brief Gets the number of display list buffers available on this device.
     virtual uint8_t getDisplayListBufferCount() const = 0;
+
+    /// @brief Gets the statistics of the last frame, if the device transforms the vertices itself.
+    ///
+    /// @param statistics The statistics of the last completed frame.
+    /// @return True if the device provides statistics, false otherwise.
+    virtual bool getFrameStatistics([[maybe_unused]] FrameStatistics& statistics) { return false; }
 };
 
 } // namespace rr
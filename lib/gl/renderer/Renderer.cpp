@@ -15,6 +15,7 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include "Renderer.hpp"
+#include "Profiler.hpp"
 
 namespace rr
 {
@@ -57,6 +58,7 @@ bool Renderer::drawTriangle(const TransformedTriangle& triangle)
     {
         return true;
     }
+    m_frameStatistics.trianglesRasterized++;
     return addCommand(triangleCmd);
 }
 
@@ -107,6 +109,7 @@ void Renderer::setLightingContext(const lighting::LightingData& ctx)
 
 void Renderer::drawNewElement()
 {
+    m_textureManager.markBoundTexturesDrawn();
     if constexpr (RenderConfig::THREADED_RASTERIZATION)
     {
         addCommand(DrawNewElementCmd {});
@@ -140,9 +143,56 @@ void Renderer::intermediateUpload()
 
 void Renderer::swapDisplayList()
 {
-    endFrame(true);
-    initAndUploadDisplayList();
-    initNewFrame(true);
+    {
+        RIX_PROFILE_SCOPE("swapDisplayList");
+        endFrame(true);
+        initAndUploadDisplayList();
+        initNewFrame(true);
+    }
+    updateFrameStatistics();
+    RIX_PROFILE_END_FRAME(getPublishedFrameStatistics());
+}
+
+void Renderer::updateFrameStatistics()
+{
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (m_frames > 0)
+    {
+        m_frameTime = std::chrono::duration_cast<std::chrono::microseconds>(now - m_lastSwap);
+    }
+    m_lastSwap = now;
+    m_frames++;
+    m_lastUploadTime = m_uploadTime;
+    m_uploadTime = std::chrono::microseconds { 0 };
+
+    const auto& transformStatistics = m_vertexTransform.getStatistics();
+    m_frameStatistics.trianglesSubmitted = transformStatistics.trianglesSubmitted;
+    m_frameStatistics.trianglesCulled = transformStatistics.trianglesCulled;
+    m_frameStatistics.trianglesClipped = transformStatistics.trianglesClipped;
+    m_lastFrameStatistics = m_frameStatistics;
+    m_vertexTransform.resetStatistics();
+    m_frameStatistics = {};
+}
+
+Renderer::Statistics Renderer::getStatistics()
+{
+    Statistics statistics {};
+    statistics.frames = m_frames;
+    statistics.frameTime = m_frameTime;
+    statistics.uploadTime = m_lastUploadTime;
+    statistics.frame = getPublishedFrameStatistics();
+    statistics.texture = m_textureManager.getStatistics();
+    return statistics;
+}
+
+FrameStatistics Renderer::getPublishedFrameStatistics()
+{
+    FrameStatistics statistics {};
+    if (!m_device.getFrameStatistics(statistics))
+    {
+        statistics = m_lastFrameStatistics;
+    }
+    return statistics;
 }
 
 void Renderer::endFrame(const bool swapScreen)
@@ -157,9 +207,15 @@ void Renderer::endFrame(const bool swapScreen)
 
 void Renderer::initAndUploadDisplayList()
 {
+    const std::size_t displayListBytes = m_displayListBuffer.getBack().getDisplayListSize();
+    m_frameStatistics.displayListBytes = (std::max)(m_frameStatistics.displayListBytes, displayListBytes);
+    m_frameStatistics.displayListSize = displayListBytes + m_displayListBuffer.getBack().getFreeSpace();
+
     // Upload new constructed displaylist
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
     uploadTextures();
     uploadDisplayList();
+    m_uploadTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
 
     // Swap to a new display list
     switchDisplayLists();
@@ -227,7 +283,7 @@ bool Renderer::clear(const bool colorBuffer, const bool depthBuffer, const bool
 
 bool Renderer::useTexture(const std::size_t tmu, const uint16_t texId)
 {
-    if (!m_textureManager.textureValid(texId))
+    if (!m_textureManager.useTexture(tmu, texId))
     {
         return false;
     }
@@ -334,9 +390,11 @@ bool Renderer::setColorBufferAddress(const uint32_t addr)
 
 void Renderer::uploadTextures()
 {
+    RIX_PROFILE_SCOPE("uploadTextures");
     m_textureManager.uploadTextures(
         [&](uint32_t gramAddr, const tcb::span<const uint8_t> data)
         {
+            RIX_PROFILE_COUNT(TEXTURE_UPLOAD_BYTES, data.size());
             return m_device.writeToDeviceMemory(data, gramAddr);
         });
 }
@@ -346,17 +404,75 @@ bool Renderer::readFromDeviceMemory(const tcb::span<uint8_t> data, const uint32_
     return m_device.readFromDeviceMemory(data, deviceAddr);
 }
 
-bool Renderer::readBackColorBuffer(const tcb::span<uint8_t> buffer)
+IDevice::ReadHandle Renderer::readFromDeviceMemoryAsync(const tcb::span<uint8_t> data, const uint32_t deviceAddr)
 {
-    endFrame(false);
-    initAndUploadDisplayList();
-    initNewFrame(false);
-    return readFromDeviceMemory(buffer, getCurrentColorBufferAddr(true));
+    return m_device.readFromDeviceMemoryAsync(data, deviceAddr);
 }
 
-bool Renderer::readFrontColorBuffer(const tcb::span<uint8_t> buffer)
+bool Renderer::readBackColorBuffer(const tcb::span<uint8_t> buffer, const uint32_t offset)
 {
-    return readFromDeviceMemory(buffer, getCurrentColorBufferAddr(false));
+    commitBackColorBuffer();
+    return readFromDeviceMemory(buffer, getCurrentColorBufferAddr(true) + offset);
+}
+
+bool Renderer::readFrontColorBuffer(const tcb::span<uint8_t> buffer, const uint32_t offset)
+{
+    return readFromDeviceMemory(buffer, getCurrentColorBufferAddr(false) + offset);
+}
+
+IDevice::ReadHandle Renderer::readFrontColorBufferAsync(const tcb::span<uint8_t> buffer, const uint32_t offset)
+{
+    return readFromDeviceMemoryAsync(buffer, getCurrentColorBufferAddr(false) + offset);
+}
+
+bool Renderer::readBackColorBufferRows(const tcb::span<uint8_t> buffer, const uint32_t offset, const uint32_t rowSize, const uint32_t stride)
+{
+    commitBackColorBuffer();
+    return readRowsFromDeviceMemory(buffer, getCurrentColorBufferAddr(true) + offset, rowSize, stride);
+}
+
+bool Renderer::readFrontColorBufferRows(const tcb::span<uint8_t> buffer, const uint32_t offset, const uint32_t rowSize, const uint32_t stride)
+{
+    return readRowsFromDeviceMemory(buffer, getCurrentColorBufferAddr(false) + offset, rowSize, stride);
+}
+
+bool Renderer::readRowsFromDeviceMemory(const tcb::span<uint8_t> buffer, const uint32_t deviceAddr, const uint32_t rowSize, const uint32_t stride)
+{
+    if ((rowSize == 0) || ((buffer.size() % rowSize) != 0))
+    {
+        return false;
+    }
+    if (buffer.empty())
+    {
+        return true;
+    }
+    // A rectangle which spans whole rows or a single row is continuous in the device memory
+    if ((rowSize == stride) || (buffer.size() == rowSize))
+    {
+        return readFromDeviceMemory(buffer, deviceAddr);
+    }
+    // Read the rows directly into the buffer. The reads are queued and only the last one is waited for.
+    const std::size_t rows = buffer.size() / rowSize;
+    IDevice::ReadHandle handle {};
+    for (std::size_t row = 0; row < rows; row++)
+    {
+        handle = m_device.readFromDeviceMemoryAsync(buffer.subspan(row * rowSize, rowSize), deviceAddr + (row * stride));
+    }
+    m_device.waitForRead(handle);
+    return true;
+}
+
+void Renderer::commitBackColorBuffer()
+{
+    // The back color buffer is up to date when nothing was added to the display list since the last commit
+    if (m_backColorBufferCommitted)
+    {
+        return;
+    }
+    endFrame(false);
+    initAndUploadDisplayList();
+    initNewFrame(false);
+    m_backColorBufferCommitted = true;
 }
 
 void Renderer::swapFramebuffer()
@@ -18,6 +18,7 @@
 #ifndef RENDERER_HPP
 #define RENDERER_HPP
 
+#include "FrameStatistics.hpp"
 #include "IThreadRunner.hpp"
 #include "Rasterizer.hpp"
 #include "Renderer.hpp"
@@ -31,6 +32,7 @@
 #include "renderer/IDevice.hpp"
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <limits>
 #include <optional>
 #include <stdint.h>
@@ -76,6 +78,16 @@ namespace rr
 class Renderer
 {
 public:
+    /// @brief Runtime statistics of the renderer
+    struct Statistics
+    {
+        std::size_t frames { 0 }; ///< Number of swapped frames
+        std::chrono::microseconds frameTime { 0 }; ///< Time between the last two swaps
+        std::chrono::microseconds uploadTime { 0 }; ///< Time the last frame spent handing the display lists and textures to the device
+        FrameStatistics frame {}; ///< Statistics of the last frame collected by the vertex transformation
+        TextureMemoryManager<RenderConfig>::Statistics texture {}; ///< Current usage of the texture memory
+    };
+
     Renderer(IDevice& device);
 
     void deinit();
@@ -128,6 +140,27 @@ public:
     /// @return true if succeeded, false if it was not possible to apply this command (for instance, displaylist was out if memory)
     bool updateTexture(const uint16_t texId, const TextureObject& textureObject) { return m_textureManager.updateTexture(texId, textureObject); }
 
+    /// @brief Updates a region of a texture whose pixels were modified in place. Only the changed pages are uploaded.
+    /// @param texId The texture id which texture has to be updated
+    /// @param textureObject The object with the modified pixels. The size and format must not change.
+    /// @param level The mip level of the region
+    /// @param x The x offset of the region
+    /// @param y The y offset of the region
+    /// @param width The width of the region
+    /// @param height The height of the region
+    /// @return true if succeeded
+    bool updateTextureRegion(
+        const uint16_t texId,
+        const TextureObject& textureObject,
+        const std::size_t level,
+        const std::size_t x,
+        const std::size_t y,
+        const std::size_t width,
+        const std::size_t height)
+    {
+        return m_textureManager.updateTextureRegion(texId, textureObject, level, x, y, width, height);
+    }
+
     /// @brief Returns a texture associated to the texId
     /// @param texId The texture id of the texture to get the data from
     /// @return The texture object
@@ -138,6 +171,27 @@ public:
     /// @return true if the current texture id is mapped to a valid texture
     bool isTextureValid(const uint16_t texId) const { return m_textureManager.textureValid(texId); }
 
+    /// @brief Queries if a texture is stored in the device memory
+    /// @param texId Texture id to query
+    /// @return true if the texture is resident. Evicted textures are uploaded again when they are used.
+    bool isTextureResident(const uint16_t texId) const { return m_textureManager.textureResident(texId); }
+
+    /// @brief Queries if a texture was drawn in the current frame
+    /// @param texId Texture id to query
+    /// @return true if a draw call of the current frame used the texture. Its pages must not be changed in this frame.
+    bool isTextureDrawnInCurrentFrame(const uint16_t texId) const { return m_textureManager.textureDrawnInCurrentFrame(texId); }
+
+    /// @brief Sets the priority of a texture. When the device memory is exhausted, textures with a low
+    /// priority are evicted first, and from those the least recently used ones.
+    /// @param texId The texture id
+    /// @param priority The priority in the range of [0, 1]
+    void setTexturePriority(const uint16_t texId, const float priority) { m_textureManager.setTexturePriority(texId, priority); }
+
+    /// @brief Gets the priority of a texture
+    /// @param texId The texture id
+    /// @return The priority
+    float getTexturePriority(const uint16_t texId) const { return m_textureManager.getTexturePriority(texId); }
+
     /// @brief Activates a texture which then is used for rendering
     /// @param tmu The used TMU
     /// @param texId The id of the texture to use
@@ -301,15 +355,57 @@ public:
     /// @return true if succeeded, false if it was not possible to apply this command (for instance, displaylist was out if memory)
     bool readFromDeviceMemory(const tcb::span<uint8_t> data, const uint32_t deviceAddr);
 
+    /// @brief Queues a read from device memory and returns without waiting for the data
+    /// @details The read can overlap with the rendering of the next frame. The data must stay valid until the read is complete.
+    /// @param data The data where to store the data from the device
+    /// @param deviceAddr The address in the devices memory to read from
+    /// @return The handle to query the completion of the read
+    IDevice::ReadHandle readFromDeviceMemoryAsync(const tcb::span<uint8_t> data, const uint32_t deviceAddr);
+
+    /// @brief Queues a read from the current front color buffer
+    /// @param data The data where to store the data from the front color buffer
+    /// @param offset The offset in bytes in the color buffer where the read starts
+    /// @return The handle to query the completion of the read
+    IDevice::ReadHandle readFrontColorBufferAsync(const tcb::span<uint8_t> buffer, const uint32_t offset = 0);
+
+    /// @brief Checks if a queued read is complete
+    /// @param handle The handle of the read
+    /// @return true if the data of the read is available
+    bool isReadComplete(const IDevice::ReadHandle handle) const { return m_device.isReadComplete(handle); }
+
+    /// @brief Blocks until the read and all reads queued before it are complete
+    /// @param handle The handle of the read
+    void waitForRead(const IDevice::ReadHandle handle) { m_device.waitForRead(handle); }
+
     /// @brief Reads data from the current back color buffer
     /// @param data The data where to store the data from the back color buffer
+    /// @param offset The offset in bytes in the color buffer where the read starts
     /// @return true if succeeded, false if it was not possible to apply this command (for instance, displaylist was out if memory)
-    bool readBackColorBuffer(const tcb::span<uint8_t> buffer);
+    bool readBackColorBuffer(const tcb::span<uint8_t> buffer, const uint32_t offset = 0);
 
     /// @brief Reads data from the current front color buffer
     /// @param data The data where to store the data from the font color buffer
+    /// @param offset The offset in bytes in the color buffer where the read starts
+    /// @return true if succeeded, false if it was not possible to apply this command (for instance, displaylist was out if memory)
+    bool readFrontColorBuffer(const tcb::span<uint8_t> buffer, const uint32_t offset = 0);
+
+    /// @brief Reads a rectangle from the current back color buffer
+    /// @details The rows are read directly into the buffer. The reads of the rows are queued, the device is not waited for per row.
+    /// @param buffer The buffer where to store the rows. Its size must be a multiple of rowSize.
+    /// @param offset The offset in bytes in the color buffer where the first row starts
+    /// @param rowSize The size of one row of the rectangle in bytes
+    /// @param stride The distance in bytes between two rows in the color buffer
     /// @return true if succeeded, false if it was not possible to apply this command (for instance, displaylist was out if memory)
-    bool readFrontColorBuffer(const tcb::span<uint8_t> buffer);
+    bool readBackColorBufferRows(const tcb::span<uint8_t> buffer, const uint32_t offset, const uint32_t rowSize, const uint32_t stride);
+
+    /// @brief Reads a rectangle from the current front color buffer
+    /// @details The rows are read directly into the buffer. The reads of the rows are queued, the device is not waited for per row.
+    /// @param buffer The buffer where to store the rows. Its size must be a multiple of rowSize.
+    /// @param offset The offset in bytes in the color buffer where the first row starts
+    /// @param rowSize The size of one row of the rectangle in bytes
+    /// @param stride The distance in bytes between two rows in the color buffer
+    /// @return true if succeeded, false if it was not possible to apply this command (for instance, displaylist was out if memory)
+    bool readFrontColorBufferRows(const tcb::span<uint8_t> buffer, const uint32_t offset, const uint32_t rowSize, const uint32_t stride);
 
     /// @brief Get the current frame buffer width
     /// @return The current frame buffer width
@@ -319,6 +415,12 @@ public:
     /// @return The current frame buffer height
     std::size_t getFramebufferHeight() const { return m_resolutionY; }
 
+    /// @brief Gets the runtime statistics
+    /// @note The frame statistics are taken from the device when it transforms the vertices itself
+    ///     (threaded rasterization), otherwise they are collected by the renderer.
+    /// @return The statistics of the last completed frame and the current texture memory usage
+    Statistics getStatistics();
+
 private:
     using DisplayListAssemblerType = displaylist::DisplayListAssembler<RenderConfig::TMU_COUNT, displaylist::DisplayList>;
     using TextureManagerType = TextureMemoryManager<RenderConfig>;
@@ -346,6 +448,7 @@ private:
         {
             intermediateUpload();
         }
+        m_backColorBufferCommitted = false;
         return m_displayListBuffer.getBack().addCommand(cmd);
     }
 
@@ -392,12 +495,26 @@ private:
     void loadFramebuffer();
     // If back is true, then the back buffer is returned, otherwise the front buffer address
     uint32_t getCurrentColorBufferAddr(const bool back) const;
+    bool readRowsFromDeviceMemory(const tcb::span<uint8_t> buffer, const uint32_t deviceAddr, const uint32_t rowSize, const uint32_t stride);
+    void commitBackColorBuffer();
 
     void endFrame(const bool swapScreen);
     void initAndUploadDisplayList();
     void initNewFrame(const bool swapScreen);
+    void updateFrameStatistics();
+    // The statistics of the device if it publishes them, otherwise the ones collected by the renderer
+    FrameStatistics getPublishedFrameStatistics();
+
+    std::size_t m_frames { 0 };
+    std::chrono::steady_clock::time_point m_lastSwap {};
+    std::chrono::microseconds m_frameTime { 0 };
+    std::chrono::microseconds m_uploadTime { 0 };
+    std::chrono::microseconds m_lastUploadTime { 0 };
+    FrameStatistics m_frameStatistics {};
+    FrameStatistics m_lastFrameStatistics {};
 
     bool m_selectedColorBuffer { true };
+    bool m_backColorBufferCommitted { false }; // Nothing was added to the display list since the back color buffer was committed
     bool m_enableVSync { RenderConfig::ENABLE_VSYNC };
 
     std::size_t m_resolutionX { 640 };
@@ -17,9 +17,12 @@
 
 #ifndef TEXTUREMEMORYMANAGER_HPP
 #define TEXTUREMEMORYMANAGER_HPP
+#include "FreeIndexList.hpp"
 #include "TextureObject.hpp"
 #include "registers/TmuTextureReg.hpp"
+#include <algorithm>
 #include <array>
+#include <bitset>
 #include <cmath>
 #include <cstring>
 #include <functional>
@@ -36,25 +39,52 @@ public:
     static constexpr std::size_t TEXTURE_PAGE_SIZE { RenderConfig::TEXTURE_PAGE_SIZE };
     static constexpr std::size_t MAX_PAGES_PER_TEXTURE { static_cast<std::size_t>((static_cast<float>(RenderConfig::MAX_TEXTURE_SIZE * RenderConfig::MAX_TEXTURE_SIZE * 2.0f * 1.33f) / static_cast<float>(RenderConfig::TEXTURE_PAGE_SIZE)) + 1.0f) };
 
+    /// @brief Usage statistics of the texture memory
+    struct Statistics
+    {
+        std::size_t usedPages { 0 };
+        std::size_t freePages { 0 };
+        std::size_t peakUsedPages { 0 };
+        std::size_t usedTextureSlots { 0 };
+        std::size_t freeTextureSlots { 0 };
+        std::size_t unusedBytesInPages { 0 }; ///< Bytes of the used pages which are not covered by texture data
+        std::size_t freePageRuns { 0 }; ///< Number of continuous runs of free pages
+        std::size_t largestFreePageRun { 0 }; ///< Number of pages of the largest continuous run of free pages
+        std::size_t evictions { 0 }; ///< Number of textures which were evicted to free pages for other textures
+        std::size_t reuploadedBytes { 0 }; ///< Bytes of evicted textures which were uploaded again
+    };
+
     TextureMemoryManager()
     {
+        // Texture name and slot 0 are reserved
+        m_freeTextureNames.reset(1);
+        m_freeTextureSlots.reset(1);
+        m_freePages.reset();
     }
 
     std::pair<bool, uint16_t> createTexture()
     {
-        for (std::size_t i = 1; i < RenderConfig::NUMBER_OF_TEXTURES; i++)
+        if (m_freeTextureNames.empty())
         {
-            if (!m_textureLut[i])
-            {
-                return { createTextureWithName(i), static_cast<uint16_t>(i) };
-            }
+            return { false, 0 };
         }
-        return { false, 0 };
+        const uint16_t texId = static_cast<uint16_t>(m_freeTextureNames.pop());
+        return { createTextureWithName(texId), texId };
     }
 
     bool createTextureWithName(const uint16_t texId)
     {
+        if (texId >= RenderConfig::NUMBER_OF_TEXTURES)
+        {
+            SPDLOG_ERROR("createTextureWithName with invalid texID called");
+            return false;
+        }
+        m_freeTextureNames.remove(texId);
         m_textureLut[texId] = allocTexture();
+        if (!m_textureLut[texId])
+        {
+            releaseTextureName(texId);
+        }
         if (m_textureLut[texId])
         {
             m_textureEntryFlags[*m_textureLut[texId]].requiresUpload = false;
@@ -78,13 +108,18 @@ public:
         std::size_t textureSlot = *m_textureLut[texId];
         const std::size_t textureSlotOld = *m_textureLut[texId];
 
-        if (m_textureEntryFlags[textureSlot].requiresUpload)
+        // A texture which is not uploaded or which was drawn in the current frame gets a new slot. The display list
+        // of the current frame still references the old pages, which keep their content until the frame is uploaded.
+        if (m_textureEntryFlags[textureSlot].requiresUpload || textureDrawnInCurrentFrame(texId))
         {
             m_textureEntryFlags[textureSlot].requiresDelete = true;
+            queueTexture(textureSlot);
             std::optional<std::size_t> newTextureSlot = allocTexture();
 
             if (!newTextureSlot)
             {
+                // Keep the texture in its current slot
+                m_textureEntryFlags[textureSlot].requiresDelete = false;
                 SPDLOG_ERROR("Was not able to allocate new texture");
                 return false;
             }
@@ -99,9 +134,11 @@ public:
             deallocPages(m_textures[textureSlot]);
         }
         m_textures[textureSlot].textures = textureObject;
+        m_textures[textureSlot].dirtyPages.reset();
 
         m_textureEntryFlags[textureSlot].requiresUpload = true;
         m_textureEntryFlags[textureSlot].requiresDelete = false;
+        queueTexture(textureSlot);
 
         m_textures[textureSlot].tmuConfig.setWrapModeS(m_textures[textureSlotOld].tmuConfig.getWrapModeS());
         m_textures[textureSlot].tmuConfig.setWrapModeT(m_textures[textureSlotOld].tmuConfig.getWrapModeT());
@@ -112,22 +149,188 @@ public:
         m_textures[textureSlot].tmuConfig.setTextureWidth(textureObject.getWidth(0));
         m_textures[textureSlot].tmuConfig.setTextureHeight(textureObject.getHeight(0));
 
-        // Allocate memory pages
-        const std::size_t textureSize = m_textures[textureSlot].getTextureSize();
-        const std::size_t texturePages = (textureSize / TEXTURE_PAGE_SIZE) + ((textureSize % TEXTURE_PAGE_SIZE) ? 1 : 0);
-        SPDLOG_DEBUG("Use number of pages: {}", texturePages);
-        ret = allocPages(m_textures[textureSlot], texturePages);
+        m_textures[textureSlot].priority = m_textures[textureSlotOld].priority;
+        m_textures[textureSlot].lastUsedFrame = m_textures[textureSlotOld].lastUsedFrame;
+        m_textures[textureSlot].lastUse = ++m_useCounter;
+        m_textures[textureSlot].evicted = false;
+
+        ret = allocTextureMemory(m_textures[textureSlot]);
         if (!ret)
         {
+            // Keep the texture as evicted texture. It is uploaded when it is used and enough pages can be freed.
             SPDLOG_ERROR("Ran out of memory during page allocation");
             deallocPages(m_textures[textureSlot]);
+            m_textures[textureSlot].evicted = true;
+            m_textureEntryFlags[textureSlot].requiresUpload = false;
         }
 
-        m_textureUpdateRequired = true;
-
         return ret;
     }
 
+    /// @brief Updates a region of a mip level of a texture whose pixels were modified in place
+    /// @details Other than updateTexture(), the pages of the texture are kept. Only the pages which are touched
+    ///     by the region are uploaded with the next uploadTextures(). Because the pages are uploaded before the display
+    ///     list of the current frame, the texture must not be drawn in the current frame (see textureDrawnInCurrentFrame()).
+    /// @param texId The texture id which texture has to be updated
+    /// @param textureObject The texture object with the modified pixels. It must have the same layout as the current texture.
+    /// @param level The mip level of the region
+    /// @param x The x offset of the region in pixels
+    /// @param y The y offset of the region in pixels
+    /// @param width The width of the region in pixels
+    /// @param height The height of the region in pixels
+    /// @return true if succeeded
+    bool updateTextureRegion(
+        const uint16_t texId,
+        const TextureObject& textureObject,
+        const std::size_t level,
+        const std::size_t x,
+        const std::size_t y,
+        const std::size_t width,
+        const std::size_t height)
+    {
+        if (!m_textureLut[texId])
+        {
+            SPDLOG_ERROR("updateTextureRegion with invalid texID called");
+            return false;
+        }
+        const std::size_t textureSlot = *m_textureLut[texId];
+        Texture& texture = m_textures[textureSlot];
+        if (texture.lastDrawnFrame == m_frame)
+        {
+            SPDLOG_ERROR("updateTextureRegion called for a texture which was drawn in the current frame");
+            return false;
+        }
+        if ((!texture.evicted && (texture.pages == 0)) || !hasSameLayout(texture.textures, textureObject))
+        {
+            SPDLOG_ERROR("updateTextureRegion called for a texture with a different layout");
+            return false;
+        }
+        if (((x + width) > textureObject.getWidth(level)) || ((y + height) > textureObject.getHeight(level)))
+        {
+            SPDLOG_ERROR("updateTextureRegion called with a region outside of the texture");
+            return false;
+        }
+        texture.textures = textureObject;
+
+        if (m_textureEntryFlags[textureSlot].requiresUpload || texture.evicted || (width == 0))
+        {
+            // The whole texture is uploaded anyway
+            return true;
+        }
+
+        std::size_t levelOffset = 0;
+        for (std::size_t i = 0; i < level; i++)
+        {
+            levelOffset += textureObject.getSizeInBytes(i);
+        }
+        const std::size_t pixelSize = sizeof(TextureObject::PixelsType::element_type);
+        const std::size_t rowSize = textureObject.getWidth(level) * pixelSize;
+        for (std::size_t row = y; row < (y + height); row++)
+        {
+            const std::size_t first = levelOffset + (row * rowSize) + (x * pixelSize);
+            const std::size_t last = first + (width * pixelSize) - 1;
+            for (std::size_t page = first / TEXTURE_PAGE_SIZE; page <= (last / TEXTURE_PAGE_SIZE); page++)
+            {
+                texture.dirtyPages.set(page);
+            }
+        }
+        queueTexture(textureSlot);
+        return true;
+    }
+
+    /// @brief Marks a texture as used by a TMU in the current frame
+    /// @details Textures which are bound to a TMU or which are used in the current frame are never evicted.
+    ///     An evicted texture allocates new pages (which might evict other textures) and is uploaded again.
+    /// @param tmu The TMU which uses the texture
+    /// @param texId The texture id
+    /// @return true if the texture is valid and resident
+    bool useTexture(const std::size_t tmu, const uint16_t texId)
+    {
+        m_boundTextures[tmu] = texId;
+        if (!textureValid(texId))
+        {
+            return false;
+        }
+        const std::size_t textureSlot = *m_textureLut[texId];
+        Texture& texture = m_textures[textureSlot];
+        texture.lastUsedFrame = m_frame;
+        texture.lastUse = ++m_useCounter;
+        if (texture.evicted)
+        {
+            if (!allocTextureMemory(texture))
+            {
+                SPDLOG_ERROR("Was not able to make texture {} resident", texId);
+                return false;
+            }
+            texture.evicted = false;
+            m_textureEntryFlags[textureSlot].requiresUpload = true;
+            queueTexture(textureSlot);
+            m_reuploadedBytes += texture.sizeInBytes;
+            SPDLOG_DEBUG("Texture {} is resident again", texId);
+        }
+        return true;
+    }
+
+    /// @brief Marks the textures which are bound to the TMUs as drawn in the current frame
+    /// @details Called for every draw call. The display list of the current frame samples the pages of these textures.
+    void markBoundTexturesDrawn()
+    {
+        for (const uint16_t texId : m_boundTextures)
+        {
+            if (m_textureLut[texId])
+            {
+                m_textures[*m_textureLut[texId]].lastDrawnFrame = m_frame;
+            }
+        }
+    }
+
+    /// @brief Checks if a texture was drawn in the current frame
+    /// @param texId The texture id
+    /// @return true if a draw call of the current frame used the texture
+    bool textureDrawnInCurrentFrame(const uint16_t texId) const
+    {
+        if (!m_textureLut[texId])
+        {
+            return false;
+        }
+        return m_textures[*m_textureLut[texId]].lastDrawnFrame == m_frame;
+    }
+
+    /// @brief Checks if a texture is stored in the device memory
+    /// @param texId The texture id
+    /// @return true if the texture has pages in the device memory
+    bool textureResident(const uint16_t texId) const
+    {
+        if (!textureValid(texId))
+        {
+            return false;
+        }
+        return m_textures[*m_textureLut[texId]].pages != 0;
+    }
+
+    /// @brief Sets the priority of a texture. Textures with lower priorities are evicted first.
+    /// @param texId The texture id
+    /// @param priority The priority. Clamped to [0, 1].
+    void setTexturePriority(const uint16_t texId, const float priority)
+    {
+        if (!m_textureLut[texId])
+        {
+            SPDLOG_ERROR("setTexturePriority with invalid texID called");
+            return;
+        }
+        m_textures[*m_textureLut[texId]].priority = std::clamp(priority, 0.0f, 1.0f);
+    }
+
+    float getTexturePriority(const uint16_t texId) const
+    {
+        if (!m_textureLut[texId])
+        {
+            SPDLOG_ERROR("getTexturePriority with invalid texID called");
+            return 1.0f;
+        }
+        return m_textures[*m_textureLut[texId]].priority;
+    }
+
     void setTextureWrapModeS(const uint16_t texId, TextureWrapMode mode)
     {
         if (!m_textureLut[texId])
@@ -271,65 +474,207 @@ public:
         }
         const std::size_t texLutId = *m_textureLut[texId];
         m_textureLut[texId] = std::nullopt;
+        releaseTextureName(texId);
         m_textureEntryFlags[texLutId].requiresDelete = true;
-        m_textureUpdateRequired = true;
+        queueTexture(texLutId);
         return true;
     }
 
     bool uploadTextures(const std::function<bool(uint32_t gramAddr, const tcb::span<const uint8_t> data)> uploader)
     {
-        if (!m_textureUpdateRequired)
-            return true;
-        m_textureUpdateRequired = false;
-
-        // Upload textures
-        for (std::size_t i = 0; i < RenderConfig::NUMBER_OF_TEXTURES; i++)
+        // Only the textures which changed since the last upload are visited
+        std::size_t remaining = 0;
+        for (std::size_t d = 0; d < m_dirtyTextureCount; d++)
         {
+            const std::size_t i = m_dirtyTextures[d];
             Texture& texture = m_textures[i];
             TextureEntry& textureEntry = m_textureEntryFlags[i];
             if (textureEntry.requiresUpload)
             {
+                // Textures which are going to be deleted are still uploaded, because the current display list might use them
                 bool ret { true };
                 std::array<uint8_t, TEXTURE_PAGE_SIZE> buffer;
+                PageIterator pageIterator { texture.textures, buffer };
                 std::size_t j = 0;
-                for (tcb::span<const uint8_t> b = texture.getPageData(j, buffer); !b.empty(); b = texture.getPageData(++j, buffer))
+                for (tcb::span<const uint8_t> b = pageIterator.next(); !b.empty(); b = pageIterator.next(), j++)
                 {
-                    ret = ret && uploader(static_cast<std::size_t>(texture.pageTable[j]) * TEXTURE_PAGE_SIZE, { buffer });
+                    ret = ret && uploader(static_cast<std::size_t>(texture.pageTable[j]) * TEXTURE_PAGE_SIZE, b);
                 }
                 textureEntry.requiresUpload = !ret;
             }
+            else if (texture.dirtyPages.any())
+            {
+                // Only the pages which were changed by updateTextureRegion()
+                bool ret { true };
+                std::array<uint8_t, TEXTURE_PAGE_SIZE> buffer;
+                PageIterator pageIterator { texture.textures, buffer };
+                std::size_t j = 0;
+                for (tcb::span<const uint8_t> b = pageIterator.next(); !b.empty(); b = pageIterator.next(), j++)
+                {
+                    if (texture.dirtyPages[j])
+                    {
+                        ret = ret && uploader(static_cast<std::size_t>(texture.pageTable[j]) * TEXTURE_PAGE_SIZE, b);
+                    }
+                }
+                if (ret)
+                {
+                    texture.dirtyPages.reset();
+                }
+            }
 
             if (textureEntry.requiresDelete)
             {
                 textureEntry.requiresDelete = false;
                 textureEntry.inUse = false;
                 texture.textures = {};
+                texture.dirtyPages.reset();
+                texture.evicted = false;
                 deallocPages(texture);
+                m_freeTextureSlots.push(i);
+            }
+
+            // Keep failed uploads in the queue to retry them with the next upload
+            textureEntry.queued = textureEntry.requiresUpload || texture.dirtyPages.any();
+            if (textureEntry.queued)
+            {
+                m_dirtyTextures[remaining++] = i;
             }
         }
+        m_dirtyTextureCount = remaining;
+        m_frame++;
 
         return true;
     }
 
-private:
-    struct PageEntry
+    /// @brief Collects the usage statistics of the texture memory
+    /// @note The page runs are counted by iterating over all pages. All other values are tracked during the allocations.
+    Statistics getStatistics() const
     {
-        bool inUse { false };
-    };
+        Statistics stats {};
+        stats.usedPages = RenderConfig::NUMBER_OF_TEXTURE_PAGES - m_freePages.size();
+        stats.freePages = m_freePages.size();
+        stats.peakUsedPages = m_peakUsedPages;
+        stats.evictions = m_evictions;
+        stats.reuploadedBytes = m_reuploadedBytes;
+        stats.freeTextureSlots = m_freeTextureSlots.size();
+        stats.usedTextureSlots = RenderConfig::NUMBER_OF_TEXTURES - 1 - m_freeTextureSlots.size();
+        stats.unusedBytesInPages = (stats.usedPages * TEXTURE_PAGE_SIZE) - m_usedBytes;
+        std::size_t run = 0;
+        for (std::size_t p = 0; p < RenderConfig::NUMBER_OF_TEXTURE_PAGES; p++)
+        {
+            if (m_freePages.contains(p))
+            {
+                run++;
+                stats.freePageRuns += (run == 1) ? 1 : 0;
+                stats.largestFreePageRun = (std::max)(stats.largestFreePageRun, run);
+            }
+            else
+            {
+                run = 0;
+            }
+        }
+        return stats;
+    }
 
+private:
     struct TextureEntry
     {
         bool inUse { false };
         bool requiresUpload { false };
         bool requiresDelete { false };
+        bool queued { false }; ///< The texture is in the dirty queue
+    };
+
+    /// @brief Iterates over the pages of a texture
+    /// @details A page which is covered by a single mip level points directly into the pixels of this level.
+    ///     Only pages which contain several mip levels are assembled in the buffer.
+    class PageIterator
+    {
+    public:
+        PageIterator(TextureObject& texture, const tcb::span<uint8_t> buffer)
+            : m_texture { texture }
+            , m_buffer { buffer }
+            , m_levels { texture.getLevels() }
+        {
+            for (std::size_t level = 0; level < m_levels; level++)
+            {
+                m_remaining += m_texture.getSizeInBytes(level);
+            }
+        }
+
+        /// @brief Returns the data of the next page or an empty span if all pages are visited.
+        ///     The last page might be smaller than a page.
+        tcb::span<const uint8_t> next()
+        {
+            skipCompletedLevels();
+            if (m_remaining == 0)
+            {
+                return {};
+            }
+
+            const std::size_t levelRemaining = m_texture.getSizeInBytes(m_level) - m_offset;
+            if ((levelRemaining >= m_buffer.size()) || (levelRemaining == m_remaining))
+            {
+                const std::size_t size = (std::min)(levelRemaining, m_buffer.size());
+                const tcb::span<const uint8_t> page { getPixels() + m_offset, size };
+                advance(size);
+                return page;
+            }
+
+            std::size_t bufferSize = 0;
+            while ((bufferSize < m_buffer.size()) && (m_remaining != 0))
+            {
+                skipCompletedLevels();
+                const std::size_t size = (std::min)(m_texture.getSizeInBytes(m_level) - m_offset, m_buffer.size() - bufferSize);
+                std::memcpy(m_buffer.data() + bufferSize, getPixels() + m_offset, size);
+                bufferSize += size;
+                advance(size);
+            }
+            return { m_buffer.data(), bufferSize };
+        }
+
+    private:
+        const uint8_t* getPixels()
+        {
+            return reinterpret_cast<const uint8_t*>(m_texture.getPixels(m_level).get());
+        }
+
+        void skipCompletedLevels()
+        {
+            while ((m_level < m_levels) && (m_offset == m_texture.getSizeInBytes(m_level)))
+            {
+                m_level++;
+                m_offset = 0;
+            }
+        }
+
+        void advance(const std::size_t size)
+        {
+            m_offset += size;
+            m_remaining -= size;
+        }
+
+        TextureObject& m_texture;
+        const tcb::span<uint8_t> m_buffer;
+        const std::size_t m_levels;
+        std::size_t m_level { 0 };
+        std::size_t m_offset { 0 };
+        std::size_t m_remaining { 0 };
     };
 
     struct Texture
     {
         std::array<std::size_t, MAX_PAGES_PER_TEXTURE> pageTable {};
         std::size_t pages { 0 };
+        std::size_t sizeInBytes { 0 };
         TextureObject textures {};
         TmuTextureReg tmuConfig {};
+        std::bitset<MAX_PAGES_PER_TEXTURE> dirtyPages {}; ///< Pages changed by updateTextureRegion() which are not uploaded yet
+        uint32_t lastUsedFrame { 0 }; ///< The frame in which the texture was used the last time by a TMU
+        uint32_t lastDrawnFrame { 0 }; ///< The frame in which the texture was drawn the last time
+        uint64_t lastUse { 0 }; ///< Orders the textures by their last use or update
+        float priority { 1.0f };
+        bool evicted { false }; ///< The pages were freed for other textures. The texture object still contains the pixels.
 
         std::size_t getTextureSize() const
         {
@@ -341,113 +686,194 @@ private:
             }
             return counter;
         }
+    };
 
-        tcb::span<const uint8_t> getPageData(std::size_t page, const tcb::span<uint8_t>& buffer)
+    static bool hasSameLayout(const TextureObject& a, const TextureObject& b)
+    {
+        if ((a.getWidth(0) != b.getWidth(0))
+            || (a.getHeight(0) != b.getHeight(0))
+            || (a.getDevicePixelFormat(0) != b.getDevicePixelFormat(0)))
         {
-            const uint32_t addr = page * buffer.size();
-            uint32_t level = 0;
-            uint32_t mipMapAddr = 0;
-            const std::size_t levels = textures.getLevels();
-            for (level = 0; level < levels; level++)
-            {
-                if (addr < (mipMapAddr + textures.getSizeInBytes(level)))
-                {
-                    mipMapAddr = addr - mipMapAddr;
-                    break;
-                }
-                mipMapAddr += textures.getSizeInBytes(level);
-            }
-
-            tcb::span<const uint8_t> ret {};
-            std::size_t bufferSize = 0;
-            for (; level < levels; level++)
-            {
-                const std::size_t texSize = textures.getSizeInBytes(level);
-                const uint8_t* pixels = std::reinterpret_pointer_cast<const uint8_t, const uint16_t>(textures.getPixels(level)).get() + mipMapAddr;
-                const std::size_t dataSize = (std::min)(texSize - static_cast<std::size_t>(mipMapAddr), buffer.size() - bufferSize);
-                std::memcpy(buffer.data() + bufferSize, pixels, dataSize);
-                bufferSize += dataSize;
-                if (bufferSize == buffer.size())
-                {
-                    break;
-                }
-                mipMapAddr = 0; // When arriving at this point, then the current mipmap level is completely in the buffer and the next mipmap level is selected.
-            }
-            if (bufferSize != 0)
+            return false;
+        }
+        for (std::size_t i = 0; i < a.getLevels(); i++)
+        {
+            if (a.getSizeInBytes(i) != b.getSizeInBytes(i))
             {
-                ret = { buffer.data(), bufferSize };
+                return false;
             }
-            return ret;
         }
-    };
+        return true;
+    }
 
     bool allocPages(Texture& tex, const std::size_t numberOfPages)
     {
-        std::size_t cp = 0;
         if (numberOfPages == 0)
         {
             SPDLOG_ERROR("Called allocPages with numberOfPages == 0");
             return false;
         }
-        for (std::size_t p = 0; p < m_pageTable.size(); p++)
+        if (numberOfPages > tex.pageTable.size())
         {
-            if (m_pageTable[p].inUse == false)
-            {
-                tex.pageTable[cp] = p;
-                m_pageTable[p].inUse = true;
-                SPDLOG_DEBUG("Use page: {}", p);
-                cp++;
-                tex.pages = cp;
-                if (cp == numberOfPages)
-                {
-                    break;
-                }
-                if (cp >= tex.pageTable.size())
-                {
-                    SPDLOG_ERROR("Texture specific page table overflown");
-                    return false;
-                }
-            }
+            SPDLOG_ERROR("Texture specific page table overflown");
+            return false;
         }
-        if (cp != numberOfPages)
+        if ((numberOfPages > m_freePages.size()) && !evictTextures(numberOfPages, tex))
         {
             SPDLOG_ERROR("Not enough pages available for texture");
             return false;
         }
+        for (std::size_t cp = 0; cp < numberOfPages; cp++)
+        {
+            tex.pageTable[cp] = m_freePages.pop();
+            SPDLOG_DEBUG("Use page: {}", tex.pageTable[cp]);
+        }
+        tex.pages = numberOfPages;
+        m_peakUsedPages = (std::max)(m_peakUsedPages, RenderConfig::NUMBER_OF_TEXTURE_PAGES - m_freePages.size());
+        return true;
+    }
+
+    bool allocTextureMemory(Texture& tex)
+    {
+        const std::size_t textureSize = tex.getTextureSize();
+        const std::size_t texturePages = (textureSize / TEXTURE_PAGE_SIZE) + ((textureSize % TEXTURE_PAGE_SIZE) ? 1 : 0);
+        SPDLOG_DEBUG("Use number of pages: {}", texturePages);
+        if (!allocPages(tex, texturePages))
+        {
+            return false;
+        }
+        tex.sizeInBytes = textureSize;
+        m_usedBytes += textureSize;
         return true;
     }
 
+    bool isBound(const std::size_t textureSlot) const
+    {
+        for (const uint16_t texId : m_boundTextures)
+        {
+            if (m_textureLut[texId] && (*m_textureLut[texId] == textureSlot))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool isEvictable(const std::size_t textureSlot) const
+    {
+        // Textures used in the current frame are referenced by the display list which is not yet uploaded
+        const Texture& tex = m_textures[textureSlot];
+        return m_textureEntryFlags[textureSlot].inUse
+            && (tex.pages != 0)
+            && (tex.lastUsedFrame != m_frame)
+            && !isBound(textureSlot);
+    }
+
+    /// @brief Evicts the textures with the lowest priority, and from those the least recently used ones,
+    /// until the requested number of pages is free
+    bool evictTextures(const std::size_t numberOfPages, const Texture& requester)
+    {
+        // Sort the candidates once. Evicting a texture does not change the order or the evictability of the others.
+        std::size_t candidateCount = 0;
+        for (std::size_t i = 0; i < m_textures.size(); i++)
+        {
+            if ((&m_textures[i] != &requester) && isEvictable(i))
+            {
+                m_evictionCandidates[candidateCount++] = i;
+            }
+        }
+        std::sort(m_evictionCandidates.begin(), m_evictionCandidates.begin() + candidateCount,
+            [this](const std::size_t a, const std::size_t b)
+            {
+                if (m_textures[a].priority != m_textures[b].priority)
+                {
+                    return m_textures[a].priority < m_textures[b].priority;
+                }
+                return m_textures[a].lastUse < m_textures[b].lastUse;
+            });
+
+        for (std::size_t c = 0; (c < candidateCount) && (m_freePages.size() < numberOfPages); c++)
+        {
+            const std::size_t victim = m_evictionCandidates[c];
+            Texture& tex = m_textures[victim];
+            SPDLOG_DEBUG("Evict texture slot {}", victim);
+            deallocPages(tex);
+            tex.dirtyPages.reset();
+            tex.evicted = !m_textureEntryFlags[victim].requiresDelete;
+            m_textureEntryFlags[victim].requiresUpload = false;
+            m_evictions++;
+        }
+        return m_freePages.size() >= numberOfPages;
+    }
+
     void deallocPages(Texture& tex)
     {
-        for (std::size_t j = 0; j < tex.pages; j++)
+        // Free the pages in reverse order, so that a reallocation gets the pages in the same order
+        for (std::size_t j = tex.pages; j > 0; j--)
         {
-            m_pageTable[tex.pageTable[j]].inUse = false;
+            m_freePages.push(tex.pageTable[j - 1]);
         }
         tex.pages = 0;
+        m_usedBytes -= tex.sizeInBytes;
+        tex.sizeInBytes = 0;
     }
 
     std::optional<std::size_t> allocTexture()
     {
-        for (std::size_t i = 1; i < RenderConfig::NUMBER_OF_TEXTURES; i++)
+        if (m_freeTextureSlots.empty())
         {
-            if (m_textureEntryFlags[i].inUse == false)
-            {
-                m_textureEntryFlags[i].inUse = true;
-                SPDLOG_DEBUG("Allocating texture {}", i);
-                return std::make_optional(i);
-            }
+            SPDLOG_ERROR("Ran out of memory during texture allocation");
+            return std::nullopt;
+        }
+        const std::size_t i = m_freeTextureSlots.pop();
+        m_textureEntryFlags[i].inUse = true;
+        m_textures[i].lastUsedFrame = 0;
+        m_textures[i].lastDrawnFrame = 0;
+        m_textures[i].lastUse = 0;
+        m_textures[i].priority = 1.0f;
+        m_textures[i].evicted = false;
+        SPDLOG_DEBUG("Allocating texture {}", i);
+        return std::make_optional(i);
+    }
+
+    void queueTexture(const std::size_t textureSlot)
+    {
+        if (!m_textureEntryFlags[textureSlot].queued)
+        {
+            m_textureEntryFlags[textureSlot].queued = true;
+            m_dirtyTextures[m_dirtyTextureCount++] = textureSlot;
+        }
+    }
+
+    void releaseTextureName(const uint16_t texId)
+    {
+        if (texId != 0)
+        {
+            m_freeTextureNames.push(texId);
         }
-        SPDLOG_ERROR("Ran out of memory during texture allocation");
-        return std::nullopt;
     }
 
     // Texture memory allocator
     std::array<Texture, RenderConfig::NUMBER_OF_TEXTURES> m_textures;
     std::array<TextureEntry, RenderConfig::NUMBER_OF_TEXTURES> m_textureEntryFlags {};
     std::array<std::optional<std::size_t>, RenderConfig::NUMBER_OF_TEXTURES> m_textureLut {};
-    std::array<PageEntry, RenderConfig::NUMBER_OF_TEXTURE_PAGES> m_pageTable {};
-
-    bool m_textureUpdateRequired { false };
+    FreeIndexList<RenderConfig::NUMBER_OF_TEXTURES> m_freeTextureNames {};
+    FreeIndexList<RenderConfig::NUMBER_OF_TEXTURES> m_freeTextureSlots {};
+    FreeIndexList<RenderConfig::NUMBER_OF_TEXTURE_PAGES> m_freePages {};
+    std::size_t m_peakUsedPages { 0 };
+    std::size_t m_usedBytes { 0 };
+
+    // Residency
+    std::array<uint16_t, RenderConfig::TMU_COUNT> m_boundTextures {};
+    uint32_t m_frame { 1 };
+    uint64_t m_useCounter { 0 };
+    std::size_t m_evictions { 0 };
+    std::size_t m_reuploadedBytes { 0 };
+    std::array<std::size_t, RenderConfig::NUMBER_OF_TEXTURES> m_evictionCandidates {};
+
+    // Slots with pending uploads or deletions. Every slot is queued at most once.
+    std::array<std::size_t, RenderConfig::NUMBER_OF_TEXTURES> m_dirtyTextures {};
+    std::size_t m_dirtyTextureCount { 0 };
 };
 
 } // namespace rr
@@ -22,13 +22,23 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace rr
 {
 struct TextureObject
 {
     using PixelsType = std::shared_ptr<uint16_t>;
+
+    /// @brief A compressed image which was decoded into the pixels of a level
+    struct CompressedImage
+    {
+        uint32_t format {}; ///< The compressed format, for instance GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+        std::vector<uint8_t> data {}; ///< The compressed blocks in row major order
+    };
+    using CompressedPixelsType = std::shared_ptr<const CompressedImage>;
     static constexpr std::size_t MAX_LOD { 9 };
 
     DevicePixelFormat getDevicePixelFormat([[maybe_unused]] const std::size_t level) const
@@ -89,6 +99,7 @@ struct TextureObject
             return;
         }
         width = w;
+        clientWidth = w;
     }
 
     void setHeight(const std::size_t level, const std::size_t h)
@@ -98,6 +109,36 @@ struct TextureObject
             return;
         }
         height = h;
+        clientHeight = h;
+    }
+
+    /// @brief Sets the size of the image the client specified for this texture
+    /// @note Must be called after setWidth() and setHeight(). Differs from the texture size when
+    /// the client image was resampled to a power of two.
+    void setClientSize(const std::size_t level, const std::size_t w, const std::size_t h)
+    {
+        if (level != 0)
+        {
+            return;
+        }
+        clientWidth = w;
+        clientHeight = h;
+    }
+
+    std::size_t getClientWidth(const std::size_t level) const
+    {
+        return std::max(std::size_t { 1 }, clientWidth >> level);
+    }
+
+    std::size_t getClientHeight(const std::size_t level) const
+    {
+        return std::max(std::size_t { 1 }, clientHeight >> level);
+    }
+
+    /// @brief Checks if the level was resampled from a client image with a different size
+    bool isResampled(const std::size_t level) const
+    {
+        return (getClientWidth(level) != getWidth(level)) || (getClientHeight(level) != getHeight(level));
     }
 
     InternalPixelFormat getInternalPixelFormat([[maybe_unused]] const std::size_t level) const
@@ -119,9 +160,23 @@ struct TextureObject
         return pixels[level];
     }
 
+    /// @brief Sets the pixels of a level. The compressed image of the level is dropped.
     void setPixels(const std::size_t level, PixelsType p)
     {
         pixels[level] = p;
+        compressedPixels[level] = {};
+    }
+
+    CompressedPixelsType getCompressedPixels(const std::size_t level) const
+    {
+        return compressedPixels[level];
+    }
+
+    /// @brief Sets the compressed image which was decoded into the pixels of a level
+    /// @note Must be called after setPixels(). Every other change of the pixels must drop the compressed image.
+    void setCompressedPixels(const std::size_t level, CompressedPixelsType p)
+    {
+        compressedPixels[level] = p;
     }
 
     std::size_t getLevels() const
@@ -138,11 +193,16 @@ struct TextureObject
 
 private:
     /// @brief The texture in the format defined by DevicePixelFormat. Do not reuse this pointer.
-    /// The memory allocated in this pointer might be already queued for texture upload.
-    /// It is safe to read from this pointer, but not safe to write to it.
+    /// The memory is shared with the copy of the texture in the TextureMemoryManager. Changes in place
+    /// must be announced with Renderer::updateTextureRegion(), otherwise they are not uploaded.
     std::array<PixelsType, TextureObject::MAX_LOD> pixels {};
+    /// @brief The compressed images the levels were decoded from. They are kept on the host to return
+    /// them with glGetCompressedTexImage and are never uploaded.
+    std::array<CompressedPixelsType, TextureObject::MAX_LOD> compressedPixels {};
     std::size_t width {}; ///< The width of the texture
     std::size_t height {}; ///< The height of the texture
+    std::size_t clientWidth {}; ///< The width of the image the client specified
+    std::size_t clientHeight {}; ///< The height of the image the client specified
     InternalPixelFormat internalPixelFormat {}; ///< The intended pixel format which is converted to a type of DevicePixelFormat
 };
 } // namespace rr
@@ -18,6 +18,8 @@
 #ifndef OP_HPP
 #define OP_HPP
 
+#include <cstdint>
+
 namespace rr::op
 {
 // In Hardware supported commands
@@ -0,0 +1,202 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef _DEVICE_CAPTURE_HPP_
+#define _DEVICE_CAPTURE_HPP_
+
+#include "renderer/IDevice.hpp"
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <spdlog/spdlog.h>
+#include <tcb/span.hpp>
+
+namespace rr::devicecapture
+{
+
+/// @brief Layout of a capture file
+/// @details A capture starts with a FileHeader, followed by records. Each record is a RecordHeader, followed by
+///     RecordHeader::size bytes of payload for the records which carry data. All values are stored in the byte order
+///     of the capturing host.
+struct CaptureFormat
+{
+    static constexpr std::array<char, 4> MAGIC { 'R', 'I', 'X', 'C' };
+    static constexpr uint32_t VERSION { 1 };
+
+    enum class RecordType : uint32_t
+    {
+        STREAM_DISPLAY_LIST = 1, ///< arg: display list index, payload: the display list
+        WRITE_TO_DEVICE_MEMORY = 2, ///< arg: device address, payload: the written data
+        READ_FROM_DEVICE_MEMORY = 3, ///< arg: device address, size: number of read bytes, no payload
+        BLOCK_UNTIL_DEVICE_IS_IDLE = 4, ///< No arg and no payload
+    };
+
+    struct FileHeader
+    {
+        std::array<char, 4> magic { MAGIC };
+        uint32_t version { VERSION };
+        uint32_t displayListBufferCount { 0 }; ///< Number of display list buffers of the captured device
+        uint32_t displayListBufferSize { 0 }; ///< Size of the first display list buffer of the captured device
+    };
+
+    struct RecordHeader
+    {
+        RecordType type { RecordType::BLOCK_UNTIL_DEVICE_IS_IDLE };
+        uint32_t arg { 0 };
+        uint32_t size { 0 };
+    };
+
+    static bool hasPayload(const RecordType type)
+    {
+        return (type == RecordType::STREAM_DISPLAY_LIST) || (type == RecordType::WRITE_TO_DEVICE_MEMORY);
+    }
+};
+
+/// @brief Forwards all calls to a device and records them with their data into a stream
+/// @details Use it as device for the renderer (or the ThreadedVertexTransformer) to capture the traffic of an
+///     application. The capture can be replayed with the DeviceCaptureReplay into another device, to measure a backend
+///     without the application. Start the capture before the device is used the first time (before
+///     RIXGL::createInstance()), otherwise the textures which are already uploaded are missing in the capture.
+class DeviceCapture : public IDevice
+{
+public:
+    DeviceCapture(IDevice& device)
+        : m_device { device }
+    {
+    }
+
+    /// @brief Starts the recording
+    /// @param out The stream for the capture. Must be opened in binary mode and must outlive the capture.
+    /// @return true if the file header was written
+    bool start(std::ostream& out)
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        CaptureFormat::FileHeader header {};
+        header.displayListBufferCount = m_device.getDisplayListBufferCount();
+        header.displayListBufferSize = (header.displayListBufferCount > 0) ? m_device.requestDisplayListBuffer(0).size() : 0;
+        m_out = &out;
+        m_bytes = 0;
+        if (!write(&header, sizeof(header)))
+        {
+            SPDLOG_ERROR("Failed to write the device capture header");
+            m_out = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    /// @brief Stops the recording and flushes the stream
+    void stop()
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        if (m_out)
+        {
+            m_out->flush();
+        }
+        m_out = nullptr;
+    }
+
+    bool isCapturing() const
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        return m_out != nullptr;
+    }
+
+    /// @brief Returns the number of bytes written into the capture since start()
+    std::size_t getCapturedBytes() const
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        return m_bytes;
+    }
+
+    void streamDisplayList(const uint8_t index, const uint32_t size) override
+    {
+        // Record before the device might modify the buffer (for instance the DeviceDataUploader fills it up)
+        record(CaptureFormat::RecordType::STREAM_DISPLAY_LIST, index, m_device.requestDisplayListBuffer(index).first(size));
+        m_device.streamDisplayList(index, size);
+    }
+
+    bool writeToDeviceMemory(tcb::span<const uint8_t> data, const uint32_t addr) override
+    {
+        record(CaptureFormat::RecordType::WRITE_TO_DEVICE_MEMORY, addr, data);
+        return m_device.writeToDeviceMemory(data, addr);
+    }
+
+    bool readFromDeviceMemory(tcb::span<uint8_t> data, const uint32_t addr) override
+    {
+        record(CaptureFormat::RecordType::READ_FROM_DEVICE_MEMORY, addr, {}, data.size());
+        return m_device.readFromDeviceMemory(data, addr);
+    }
+
+    void blockUntilDeviceIsIdle() override
+    {
+        record(CaptureFormat::RecordType::BLOCK_UNTIL_DEVICE_IS_IDLE, 0, {});
+        m_device.blockUntilDeviceIsIdle();
+    }
+
+    tcb::span<uint8_t> requestDisplayListBuffer(const uint8_t index) override
+    {
+        return m_device.requestDisplayListBuffer(index);
+    }
+
+    uint8_t getDisplayListBufferCount() const override
+    {
+        return m_device.getDisplayListBufferCount();
+    }
+
+    bool getFrameStatistics(FrameStatistics& statistics) override
+    {
+        return m_device.getFrameStatistics(statistics);
+    }
+
+private:
+    void record(const CaptureFormat::RecordType type, const uint32_t arg, const tcb::span<const uint8_t> payload, const std::size_t size = 0)
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        if (!m_out)
+        {
+            return;
+        }
+        const CaptureFormat::RecordHeader header { type, arg, static_cast<uint32_t>(payload.empty() ? size : payload.size()) };
+        if (!write(&header, sizeof(header)) || !write(payload.data(), payload.size()))
+        {
+            SPDLOG_ERROR("Failed to write the device capture. Capture stopped.");
+            m_out = nullptr;
+        }
+    }
+
+    bool write(const void* data, const std::size_t size)
+    {
+        if (size == 0)
+        {
+            return true;
+        }
+        m_out->write(reinterpret_cast<const char*>(data), size);
+        m_bytes += size;
+        return m_out->good();
+    }
+
+    IDevice& m_device;
+    mutable std::mutex m_mutex {};
+    std::ostream* m_out { nullptr };
+    std::size_t m_bytes { 0 };
+};
+
+} // namespace rr::devicecapture
+
+#endif // _DEVICE_CAPTURE_HPP_
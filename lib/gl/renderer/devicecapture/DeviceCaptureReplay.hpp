@@ -0,0 +1,187 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef _DEVICE_CAPTURE_REPLAY_HPP_
+#define _DEVICE_CAPTURE_REPLAY_HPP_
+
+#include "DeviceCapture.hpp"
+#include "renderer/IDevice.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <spdlog/spdlog.h>
+#include <tcb/span.hpp>
+#include <vector>
+
+namespace rr::devicecapture
+{
+
+/// @brief Loads a capture of the DeviceCapture and replays it into a device
+/// @details The whole capture is loaded into memory, so that a replay only measures the device.
+class DeviceCaptureReplay
+{
+public:
+    struct Statistics
+    {
+        std::size_t displayLists { 0 }; ///< Number of streamed display lists
+        std::size_t displayListBytes { 0 }; ///< Bytes of the streamed display lists
+        std::size_t uploads { 0 }; ///< Number of writes into the device memory
+        std::size_t uploadBytes { 0 }; ///< Bytes written into the device memory
+        std::size_t reads { 0 }; ///< Number of reads from the device memory
+        std::size_t readBytes { 0 }; ///< Bytes read from the device memory
+        std::size_t waits { 0 }; ///< Number of calls of blockUntilDeviceIsIdle()
+    };
+
+    /// @brief Loads a capture
+    /// @param in The stream of the capture. Must be opened in binary mode.
+    /// @return true if the capture is valid
+    bool load(std::istream& in)
+    {
+        m_records.clear();
+        m_payload.clear();
+        m_statistics = {};
+
+        if (!in.read(reinterpret_cast<char*>(&m_header), sizeof(m_header))
+            || (m_header.magic != CaptureFormat::MAGIC)
+            || (m_header.version != CaptureFormat::VERSION))
+        {
+            SPDLOG_ERROR("Invalid device capture header");
+            return false;
+        }
+
+        CaptureFormat::RecordHeader header {};
+        while (in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        {
+            Record record { header, m_payload.size() };
+            if (CaptureFormat::hasPayload(header.type))
+            {
+                m_payload.resize(m_payload.size() + header.size);
+                if (!in.read(reinterpret_cast<char*>(m_payload.data() + record.offset), header.size))
+                {
+                    SPDLOG_ERROR("Device capture is truncated");
+                    return false;
+                }
+            }
+            if (!count(header))
+            {
+                SPDLOG_ERROR("Unknown record type {} in device capture", static_cast<uint32_t>(header.type));
+                return false;
+            }
+            m_records.push_back(record);
+        }
+        if (in.gcount() != 0)
+        {
+            SPDLOG_ERROR("Device capture is truncated");
+            return false;
+        }
+        return true;
+    }
+
+    /// @brief Replays the loaded capture into a device
+    /// @details The display lists are copied into the display list buffers of the device before they are streamed.
+    ///     Devices with less display list buffers than the captured device use the buffers round robin.
+    ///     Waits at the end until the device is idle.
+    /// @return true if all records could be replayed
+    bool replay(IDevice& device)
+    {
+        const uint8_t bufferCount = device.getDisplayListBufferCount();
+        if (bufferCount == 0)
+        {
+            SPDLOG_ERROR("Device has no display list buffers");
+            return false;
+        }
+        bool ret = true;
+        for (const Record& record : m_records)
+        {
+            const tcb::span<const uint8_t> payload { m_payload.data() + record.offset, record.header.size };
+            switch (record.header.type)
+            {
+            case CaptureFormat::RecordType::STREAM_DISPLAY_LIST:
+            {
+                const uint8_t index = static_cast<uint8_t>(record.header.arg % bufferCount);
+                const tcb::span<uint8_t> buffer = device.requestDisplayListBuffer(index);
+                if (buffer.size() < payload.size())
+                {
+                    SPDLOG_ERROR("Display list with {} bytes does not fit into the display list buffer {} with {} bytes", payload.size(), index, buffer.size());
+                    return false;
+                }
+                std::copy(payload.begin(), payload.end(), buffer.begin());
+                device.streamDisplayList(index, record.header.size);
+                break;
+            }
+            case CaptureFormat::RecordType::WRITE_TO_DEVICE_MEMORY:
+                ret = device.writeToDeviceMemory(payload, record.header.arg) && ret;
+                break;
+            case CaptureFormat::RecordType::READ_FROM_DEVICE_MEMORY:
+                m_readBuffer.resize((std::max)(m_readBuffer.size(), static_cast<std::size_t>(record.header.size)));
+                ret = device.readFromDeviceMemory({ m_readBuffer.data(), record.header.size }, record.header.arg) && ret;
+                break;
+            case CaptureFormat::RecordType::BLOCK_UNTIL_DEVICE_IS_IDLE:
+                device.blockUntilDeviceIsIdle();
+                break;
+            }
+        }
+        device.blockUntilDeviceIsIdle();
+        return ret;
+    }
+
+    const CaptureFormat::FileHeader& getHeader() const { return m_header; }
+    std::size_t getRecordCount() const { return m_records.size(); }
+
+    /// @brief Returns the statistics of one replay of the loaded capture
+    Statistics getStatistics() const { return m_statistics; }
+
+private:
+    struct Record
+    {
+        CaptureFormat::RecordHeader header;
+        std::size_t offset; ///< Offset of the payload in m_payload
+    };
+
+    bool count(const CaptureFormat::RecordHeader& header)
+    {
+        switch (header.type)
+        {
+        case CaptureFormat::RecordType::STREAM_DISPLAY_LIST:
+            m_statistics.displayLists++;
+            m_statistics.displayListBytes += header.size;
+            return true;
+        case CaptureFormat::RecordType::WRITE_TO_DEVICE_MEMORY:
+            m_statistics.uploads++;
+            m_statistics.uploadBytes += header.size;
+            return true;
+        case CaptureFormat::RecordType::READ_FROM_DEVICE_MEMORY:
+            m_statistics.reads++;
+            m_statistics.readBytes += header.size;
+            return true;
+        case CaptureFormat::RecordType::BLOCK_UNTIL_DEVICE_IS_IDLE:
+            m_statistics.waits++;
+            return true;
+        }
+        return false;
+    }
+
+    CaptureFormat::FileHeader m_header {};
+    std::vector<Record> m_records {};
+    std::vector<uint8_t> m_payload {};
+    std::vector<uint8_t> m_readBuffer {};
+    Statistics m_statistics {};
+};
+
+} // namespace rr::devicecapture
+
+#endif // _DEVICE_CAPTURE_REPLAY_HPP_
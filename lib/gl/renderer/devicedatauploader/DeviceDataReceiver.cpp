@@ -0,0 +1,136 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "DeviceDataReceiver.hpp"
+#include "Profiler.hpp"
+#include "RenderConfigs.hpp"
+#include <algorithm>
+#include <cstring>
+#include <spdlog/spdlog.h>
+
+namespace rr::devicedatauploader
+{
+
+DeviceDataReceiver::DeviceDataReceiver(IDevice& device, const std::size_t readBufferCount, const std::size_t readBufferSize)
+    : m_device { device }
+{
+    const std::size_t displayListBufferCount = device.getDisplayListBufferCount();
+    const std::size_t writeBufferSize = ((displayListBufferCount > 0) ? device.requestDisplayListBuffer(0).size() : 0) + sizeof(Command);
+    m_writeBuffers.resize((std::min)(displayListBufferCount + 1, static_cast<std::size_t>(UINT8_MAX)), std::vector<uint8_t>(writeBufferSize));
+    m_readBuffers.resize(readBufferCount, std::vector<uint8_t>(readBufferSize));
+}
+
+void DeviceDataReceiver::writeData(const uint8_t index, const uint32_t size, const uint32_t offset)
+{
+    RIX_PROFILE_SCOPE("receive");
+    if ((index >= m_writeBuffers.size()) || ((static_cast<std::size_t>(offset) + size) > m_writeBuffers[index].size()))
+    {
+        SPDLOG_ERROR("Transfer of {} bytes at offset {} exceeds write buffer {}", size, offset, index);
+        return;
+    }
+    tcb::span<const uint8_t> data { m_writeBuffers[index].data() + offset, size };
+    while ((data.size() >= sizeof(Command)) && executeCommand(index, data))
+    {
+    }
+}
+
+void DeviceDataReceiver::readData(const uint8_t index, const uint32_t size)
+{
+    if (index >= m_readBuffers.size())
+    {
+        SPDLOG_ERROR("Read buffer {} does not exist", index);
+        return;
+    }
+    const std::size_t available = (std::min)({ static_cast<std::size_t>(size), m_response.size(), m_readBuffers[index].size() });
+    if (available < size)
+    {
+        SPDLOG_ERROR("Read of {} bytes but only {} bytes were loaded", size, available);
+    }
+    std::copy_n(m_response.begin(), available, m_readBuffers[index].begin());
+    m_response.erase(m_response.begin(), m_response.begin() + available);
+}
+
+tcb::span<uint8_t> DeviceDataReceiver::requestWriteBuffer(const uint8_t index)
+{
+    if (index >= m_writeBuffers.size())
+    {
+        return {};
+    }
+    return { m_writeBuffers[index] };
+}
+
+tcb::span<uint8_t> DeviceDataReceiver::requestReadBuffer(const uint8_t index)
+{
+    if (index >= m_readBuffers.size())
+    {
+        return {};
+    }
+    return { m_readBuffers[index] };
+}
+
+bool DeviceDataReceiver::executeCommand(const uint8_t index, tcb::span<const uint8_t>& data)
+{
+    Command cmd;
+    std::memcpy(&cmd, data.data(), sizeof(cmd));
+    data = data.subspan(sizeof(cmd));
+    const uint32_t op = cmd.op & OP_MASK;
+    const uint32_t size = cmd.op & IMM_MASK;
+    // The uploader announces at least DEVICE_MIN_TRANSFER_SIZE bytes but sends only the payload of a store
+    const tcb::span<const uint8_t> payload = data.first((std::min)(static_cast<std::size_t>(size), data.size()));
+
+    switch (op)
+    {
+    case OP_NOP:
+        break;
+    case OP_STREAM:
+    {
+        if (m_device.getDisplayListBufferCount() == 0)
+        {
+            SPDLOG_ERROR("The device has no display list buffers");
+            return false;
+        }
+        const uint8_t displayList = index % m_device.getDisplayListBufferCount();
+        tcb::span<uint8_t> buffer = m_device.requestDisplayListBuffer(displayList);
+        if (payload.size() > buffer.size())
+        {
+            SPDLOG_ERROR("Display list of {} bytes exceeds the display list buffer of {} bytes", payload.size(), buffer.size());
+            return false;
+        }
+        std::copy(payload.begin(), payload.end(), buffer.begin());
+        m_device.streamDisplayList(displayList, static_cast<uint32_t>(payload.size()));
+        break;
+    }
+    case OP_STORE:
+        m_device.writeToDeviceMemory(payload, cmd.addr - RenderConfig::GRAM_MEMORY_LOC);
+        break;
+    case OP_LOAD:
+    {
+        std::vector<uint8_t> loaded(size);
+        m_device.readFromDeviceMemory(loaded, cmd.addr - RenderConfig::GRAM_MEMORY_LOC);
+        m_response.insert(m_response.end(), loaded.begin(), loaded.end());
+        // A load has no payload
+        return true;
+    }
+    default:
+        SPDLOG_ERROR("Unknown frame transfer command 0x{:08x}", cmd.op);
+        return false;
+    }
+    data = data.subspan(payload.size());
+    return true;
+}
+
+} // namespace rr::devicedatauploader
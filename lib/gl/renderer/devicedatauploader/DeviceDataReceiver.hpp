@@ -0,0 +1,66 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef _DEVICEDATARECEIVER_HPP_
+#define _DEVICEDATARECEIVER_HPP_
+
+#include "DeviceDataUploaderCommands.hpp"
+#include "IBusConnector.hpp"
+#include "renderer/IDevice.hpp"
+#include <cstdint>
+#include <deque>
+#include <tcb/span.hpp>
+#include <vector>
+
+namespace rr::devicedatauploader
+{
+
+/// @brief Device side of the Frame Transfer Protocol.
+/// @details Executes the commands of the DeviceDataUploader on an IDevice, like the FrameStreamingCore does it in
+///     the RTL. This allows to put a software device (for instance the SoftwareRasterizer) behind a bus, for
+///     instance behind a bus which connects to another process.
+///     STREAM commands are streamed from the display list buffer with the index of the transfer. STORE commands
+///     write the device memory. LOAD commands queue the device memory, which is returned by the next reads.
+class DeviceDataReceiver : public IBusConnector
+{
+public:
+    static constexpr std::size_t DEFAULT_READ_BUFFER_SIZE { 64 * 1024 };
+
+    /// @brief Creates a receiver with a write buffer for each display list buffer of the device plus one for the
+    ///     memory transfers. The write buffers are big enough for a whole display list.
+    DeviceDataReceiver(IDevice& device, const std::size_t readBufferCount = 2, const std::size_t readBufferSize = DEFAULT_READ_BUFFER_SIZE);
+
+    void writeData(const uint8_t index, const uint32_t size, const uint32_t offset) override;
+    void readData(const uint8_t index, const uint32_t size) override;
+    void blockUntilTransferIsComplete() override { }
+    tcb::span<uint8_t> requestWriteBuffer(const uint8_t index) override;
+    tcb::span<uint8_t> requestReadBuffer(const uint8_t index) override;
+    uint8_t getWriteBufferCount() const override { return static_cast<uint8_t>(m_writeBuffers.size()); }
+    uint8_t getReadBufferCount() const override { return static_cast<uint8_t>(m_readBuffers.size()); }
+
+private:
+    bool executeCommand(const uint8_t index, tcb::span<const uint8_t>& data);
+
+    IDevice& m_device;
+    std::vector<std::vector<uint8_t>> m_writeBuffers {};
+    std::vector<std::vector<uint8_t>> m_readBuffers {};
+    std::deque<uint8_t> m_response {};
+};
+
+} // namespace rr::devicedatauploader
+
+#endif // _DEVICEDATARECEIVER_HPP_
@@ -16,6 +16,7 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "DeviceDataUploader.hpp"
+#include "Profiler.hpp"
 #include "RenderConfigs.hpp"
 #include <algorithm>
 
@@ -24,14 +25,23 @@ namespace rr::devicedatauploader
 
 void DeviceDataUploader::streamDisplayList(const uint8_t index, uint32_t size)
 {
-    blockUntilDeviceIsIdle();
+    RIX_PROFILE_SCOPE("streamDisplayList");
+    // Bus connectors which queue transfers serialize this transfer with the previous ones. This allows
+    // to stream the display lines back to back.
+    blockUntilBusIsFree();
     size = fillWhenDataIsTooSmall(index, size);
     const uint32_t commandSize = addDduStreamCommand(index, size);
     m_busConnector.writeData(index, size + commandSize);
+    if (m_busConnector.queuesTransfers())
+    {
+        // Progress the asynchronous reads. Without a queue, the load would wait for the display list.
+        loadNextChunk();
+    }
 }
 
 bool DeviceDataUploader::writeToDeviceMemory(tcb::span<const uint8_t> data, const uint32_t addr)
 {
+    RIX_PROFILE_SCOPE("writeToDeviceMemory");
     blockUntilDeviceIsIdle();
     const uint32_t commandSize = addDduStoreCommand(
         (std::max)(static_cast<uint32_t>(data.size()), DEVICE_MIN_TRANSFER_SIZE),
@@ -43,21 +53,53 @@ bool DeviceDataUploader::writeToDeviceMemory(tcb::span<const uint8_t> data, cons
 
 bool DeviceDataUploader::readFromDeviceMemory(tcb::span<uint8_t> data, const uint32_t addr)
 {
-    if (hasLoadBuffer())
+    RIX_PROFILE_SCOPE("readFromDeviceMemory");
+    waitForRead(readFromDeviceMemoryAsync(data, addr));
+    return true;
+}
+
+DeviceDataUploader::ReadHandle DeviceDataUploader::readFromDeviceMemoryAsync(tcb::span<uint8_t> data, const uint32_t addr)
+{
+    if (!hasLoadBuffer() || data.empty())
+    {
+        // Nothing to load. Return a handle which is already complete.
+        return m_completedReads - 1;
+    }
+    if (m_pendingReadsCount == MAX_PENDING_READS)
+    {
+        waitForRead(m_completedReads);
+    }
+    // The FTE only transfers whole blocks. A read which does not start on a block boundary also loads the bytes in front of it.
+    const uint32_t alignedAddr = addr & ~(DEVICE_MIN_TRANSFER_SIZE - 1);
+    const std::size_t leadingBytes = addr - alignedAddr;
+    const std::size_t alignedSize = ((leadingBytes + data.size() + DEVICE_MIN_TRANSFER_SIZE - 1) / DEVICE_MIN_TRANSFER_SIZE) * DEVICE_MIN_TRANSFER_SIZE;
+    m_pendingReads[(m_pendingReadsHead + m_pendingReadsCount) % MAX_PENDING_READS] = { data, alignedAddr, leadingBytes, alignedSize, 0 };
+    m_pendingReadsCount++;
+    return m_queuedReads++;
+}
+
+void DeviceDataUploader::waitForRead(const ReadHandle handle)
+{
+    RIX_PROFILE_SCOPE("waitForRead");
+    while (!isReadComplete(handle) && loadNextChunk())
+    {
+    }
+}
+
+void DeviceDataUploader::blockUntilDeviceIsIdle()
+{
+    RIX_PROFILE_SCOPE("blockUntilDeviceIsIdle");
+    RIX_PROFILE_TIME(UPLOAD_WAIT_TIME_US);
+    m_busConnector.blockUntilTransferIsComplete();
+}
+
+void DeviceDataUploader::blockUntilBusIsFree()
+{
+    // A bus connector which does not queue transfers hands out buffers which might still be transferred
+    if (!m_busConnector.queuesTransfers())
     {
         blockUntilDeviceIsIdle();
-        const std::size_t alignedSize = ((data.size() + DEVICE_MIN_TRANSFER_SIZE - 1) / DEVICE_MIN_TRANSFER_SIZE) * DEVICE_MIN_TRANSFER_SIZE;
-        const std::size_t loadBufferSize = m_busConnector.requestReadBuffer(getLoadBufferIndex()).size();
-        const std::size_t chunkSize = (loadBufferSize / DEVICE_MIN_TRANSFER_SIZE) * DEVICE_MIN_TRANSFER_SIZE;
-        for (std::size_t i = 0; i < alignedSize; i += (std::min)(chunkSize, alignedSize - i))
-        {
-            loadChunk(
-                data.subspan(i, (std::min)(data.size() - i, chunkSize)),
-                (std::min)(alignedSize - i, chunkSize),
-                addr + RenderConfig::GRAM_MEMORY_LOC + i);
-        }
     }
-    return true;
 }
 
 uint32_t DeviceDataUploader::addDduStorePayload(const std::size_t offset, const tcb::span<const uint8_t> payload)
@@ -90,17 +132,96 @@ uint32_t DeviceDataUploader::fillWhenDataIsTooSmall(const uint8_t index, const u
     return (std::max)(size, DEVICE_MIN_TRANSFER_SIZE);
 }
 
-void DeviceDataUploader::loadChunk(const tcb::span<uint8_t> data, const std::size_t alignedSize, const uint32_t addr)
+std::size_t DeviceDataUploader::getLoadChunkSize()
 {
-    const uint32_t commandSize = addDduLoadCommand(alignedSize, addr);
-    m_busConnector.writeData(getStoreBufferIndex(), commandSize);
-    blockUntilDeviceIsIdle();
+    if (m_loadChunkSize == 0)
+    {
+        // Requesting the buffer must not overlap with an ongoing transfer
+        blockUntilBusIsFree();
+        const std::size_t loadBufferSize = m_busConnector.requestReadBuffer(getLoadBufferIndex(0)).size();
+        m_loadChunkSize = (loadBufferSize / DEVICE_MIN_TRANSFER_SIZE) * DEVICE_MIN_TRANSFER_SIZE;
+    }
+    return m_loadChunkSize;
+}
 
-    m_busConnector.readData(getLoadBufferIndex(), alignedSize);
-    blockUntilDeviceIsIdle();
+bool DeviceDataUploader::loadNextChunk()
+{
+    // The next chunk belongs to the oldest read or, when all chunks of the oldest read are requested, to the next read
+    PendingRead* read = nullptr;
+    for (std::size_t i = 0; (i < m_pendingReadsCount) && (read == nullptr); i++)
+    {
+        PendingRead& pendingRead = m_pendingReads[(m_pendingReadsHead + i) % MAX_PENDING_READS];
+        if (pendingRead.requestedSize < pendingRead.alignedSize)
+        {
+            read = &pendingRead;
+        }
+    }
+
+    if (read == nullptr)
+    {
+        if (!m_loadedChunk)
+        {
+            return false;
+        }
+        copyLoadedChunk();
+        return true;
+    }
+
+    const std::size_t offset = read->requestedSize;
+    const std::size_t size = (std::min)(getLoadChunkSize(), read->alignedSize - offset);
+    const uint32_t loadBufferIndex = getLoadBufferIndex(m_loadedChunks);
+    if (m_loadedChunk && (m_loadedChunk->loadBufferIndex == loadBufferIndex))
+    {
+        // Only one load buffer available
+        copyLoadedChunk();
+    }
+    // Request the next chunk before the previous chunk is copied. This hides the latency of the device.
+    loadChunk(loadBufferIndex, size, read->addr + RenderConfig::GRAM_MEMORY_LOC + offset);
+    read->requestedSize += size;
+    if (m_loadedChunk)
+    {
+        // The copy overlaps with the transfer of the next chunk on bus connectors which queue transfers
+        copyLoadedChunk();
+    }
+
+    // Only the part of the chunk which overlaps with the requested data is copied
+    const std::size_t begin = (std::max)(offset, read->leadingBytes);
+    const std::size_t end = (std::min)(offset + size, read->leadingBytes + read->data.size());
+    m_loadedChunk = LoadedChunk {
+        read->data.subspan(begin - read->leadingBytes, end - begin),
+        begin - offset,
+        loadBufferIndex,
+        read->requestedSize == read->alignedSize,
+    };
+    m_loadedChunks++;
+    return true;
+}
 
-    tcb::span<uint8_t> loadedData = m_busConnector.requestReadBuffer(getLoadBufferIndex()).subspan(0, data.size());
-    std::copy(loadedData.begin(), loadedData.end(), data.begin());
+void DeviceDataUploader::loadChunk(const uint32_t loadBufferIndex, const std::size_t size, const uint32_t addr)
+{
+    // The LOAD command is written into the store buffer, which might still be in flight
+    blockUntilBusIsFree();
+    const uint32_t commandSize = addDduLoadCommand(size, addr);
+    m_busConnector.writeData(getStoreBufferIndex(), commandSize);
+    blockUntilBusIsFree();
+    m_busConnector.readData(loadBufferIndex, size);
+}
+
+void DeviceDataUploader::copyLoadedChunk()
+{
+    // The load buffer is only valid when the read is complete
+    blockUntilBusIsFree();
+    const LoadedChunk& chunk = *m_loadedChunk;
+    tcb::span<uint8_t> loadedData = m_busConnector.requestReadBuffer(chunk.loadBufferIndex).subspan(chunk.skip, chunk.data.size());
+    std::copy(loadedData.begin(), loadedData.end(), chunk.data.begin());
+    if (chunk.lastChunk)
+    {
+        // Reads are loaded in order. The chunk completes the oldest read.
+        m_pendingReadsHead = (m_pendingReadsHead + 1) % MAX_PENDING_READS;
+        m_pendingReadsCount--;
+        m_completedReads++;
+    }
+    m_loadedChunk.reset();
 }
 
 } // namespace rr::devicedatauploader
@@ -21,6 +21,9 @@
 #include "DeviceDataUploaderCommands.hpp"
 #include "IBusConnector.hpp"
 #include "renderer/IDevice.hpp"
+#include <algorithm>
+#include <array>
+#include <optional>
 
 namespace rr::devicedatauploader
 {
@@ -42,7 +45,19 @@ public:
     bool writeToDeviceMemory(tcb::span<const uint8_t> data, const uint32_t addr) override;
     bool readFromDeviceMemory(tcb::span<uint8_t> data, const uint32_t addr) override;
 
-    void blockUntilDeviceIsIdle() override { m_busConnector.blockUntilTransferIsComplete(); }
+    /// @brief Queues a read of the device memory. The read is executed chunk wise.
+    /// @details On bus connectors which queue transfers, each streamed display list
+    ///     loads the next chunk. Otherwise the chunks are loaded in waitForRead().
+    ReadHandle readFromDeviceMemoryAsync(tcb::span<uint8_t> data, const uint32_t addr) override;
+
+    bool isReadComplete(const ReadHandle handle) const override
+    {
+        return static_cast<int32_t>(handle - m_completedReads) < 0;
+    }
+
+    void waitForRead(const ReadHandle handle) override;
+
+    void blockUntilDeviceIsIdle() override;
 
     tcb::span<uint8_t> requestDisplayListBuffer(const uint8_t index) override
     {
@@ -56,14 +71,18 @@ public:
     }
 
 private:
+    void blockUntilBusIsFree();
+
     bool hasLoadBuffer() const
     {
         return m_busConnector.getReadBufferCount() != 0;
     }
 
-    uint32_t getLoadBufferIndex() const
+    uint32_t getLoadBufferIndex(const std::size_t chunk) const
     {
-        return m_busConnector.getReadBufferCount() - 1;
+        // Use two load buffers when available to receive the next chunk while the previous one is copied
+        const std::size_t loadBufferCount = (std::min)(m_busConnector.getReadBufferCount(), static_cast<uint8_t>(2));
+        return m_busConnector.getReadBufferCount() - 1 - (chunk % loadBufferCount);
     }
 
     uint32_t getStoreBufferIndex() const
@@ -89,9 +108,41 @@ private:
         const uint32_t size,
         const uint32_t addr);
     uint32_t fillWhenDataIsTooSmall(const uint8_t index, const uint32_t size);
-    void loadChunk(const tcb::span<uint8_t> data, const std::size_t alignedSize, const uint32_t addr);
+
+    struct PendingRead
+    {
+        tcb::span<uint8_t> data;
+        uint32_t addr; // Aligned to DEVICE_MIN_TRANSFER_SIZE
+        std::size_t leadingBytes; // Bytes between the aligned addr and the requested addr
+        std::size_t alignedSize;
+        std::size_t requestedSize;
+    };
+
+    struct LoadedChunk
+    {
+        tcb::span<uint8_t> data; // Destination of the chunk in the buffer of the read
+        std::size_t skip; // Bytes at the beginning of the chunk which are not part of the read
+        uint32_t loadBufferIndex;
+        bool lastChunk; // Last chunk of the oldest pending read
+    };
+
+    bool loadNextChunk();
+    void loadChunk(const uint32_t loadBufferIndex, const std::size_t size, const uint32_t addr);
+    void copyLoadedChunk();
+    std::size_t getLoadChunkSize();
+
+    static constexpr std::size_t MAX_PENDING_READS { 4 };
 
     IBusConnector& m_busConnector;
+
+    std::array<PendingRead, MAX_PENDING_READS> m_pendingReads {};
+    std::size_t m_pendingReadsHead { 0 };
+    std::size_t m_pendingReadsCount { 0 };
+    ReadHandle m_queuedReads { 0 };
+    ReadHandle m_completedReads { 0 };
+    std::optional<LoadedChunk> m_loadedChunk {};
+    std::size_t m_loadedChunks { 0 };
+    std::size_t m_loadChunkSize { 0 };
 };
 
 } // namespace rr::devicedatauploader
@@ -2,6 +2,7 @@
 #define DISPLAYLISTDISASSEMBLER_HPP_
 
 #include "renderer/commands/CommandVariant.hpp"
+#include "renderer/commands/Op.hpp"
 #include "renderer/displaylist/DisplayList.hpp"
 #include <spdlog/spdlog.h>
 
@@ -26,6 +27,53 @@ public:
         return decodeCommand(m_displayList);
     }
 
+    // Decodes the next command and calls the visitor with it. Other than getNextCommand(), the command
+    // is selected via a jump table indexed by the op code and is not copied into a CommandVariant.
+    // The payload of the command passed to the visitor points directly into the display list memory
+    // and is only valid during the visitor call.
+    template <typename TVisitor>
+    bool visitNextCommand(const TVisitor& visitor)
+    {
+        if (m_displayList.atEnd())
+        {
+            return false;
+        }
+
+        const uint32_t op = *(m_displayList.lookAhead<uint32_t>());
+        switch (op & op::MASK)
+        {
+        case op::NOP:
+            return visitor(deserializeCommand<NopCmd>(m_displayList));
+        case op::RENDER_CONFIG:
+            return visitor(deserializeCommand<WriteRegisterCmd>(m_displayList));
+        case op::FRAMEBUFFER:
+            return visitor(deserializeCommand<FramebufferCmd>(m_displayList));
+        case op::TRIANGLE_STREAM:
+            return visitor(deserializeCommand<TriangleStreamCmd>(m_displayList));
+        case op::FOG_LUT_STREAM:
+            return visitor(deserializeCommand<FogLutStreamCmd>(m_displayList));
+        case op::TEXTURE_STREAM:
+            return visitor(deserializeCommand<TextureStreamCmd>(m_displayList));
+        case op::SET_ELEMENT_GLOBAL_CTX:
+            return visitor(deserializeCommand<SetElementGlobalCtxCmd>(m_displayList));
+        case op::SET_LIGHTING_CTX:
+            return visitor(deserializeCommand<SetLightingCtxCmd>(m_displayList));
+        case op::PUSH_VERTEX:
+            return visitor(deserializeCommand<PushVertexCmd>(m_displayList));
+        case op::SET_ELEMENT_LOCAL_CTX:
+            return visitor(deserializeCommand<SetElementLocalCtxCmd>(m_displayList));
+        case op::DRAW_NEW_ELEMENT:
+            return visitor(deserializeCommand<DrawNewElementCmd>(m_displayList));
+        default:
+            break;
+        }
+
+        // Skip the op to guarantee that the disassembler is not stuck on this command
+        m_displayList.getNext<uint32_t>();
+        SPDLOG_CRITICAL("Unknown command (0x{:X}) found. This might cause the renderer to crash ...", op);
+        return false;
+    }
+
     bool hasNextCommand() const
     {
         return !m_displayList.atEnd();
@@ -86,7 +134,7 @@ private:
     }
 
     template <typename TCmd>
-    CommandVariant deserializeCommand(DisplayList& src)
+    static TCmd deserializeCommand(DisplayList& src)
     {
         using PayloadType = typename std::remove_const<typename std::remove_reference<decltype(TCmd {}.payload()[0])>::type>::type;
         const typename TCmd::CommandType* op = src.getNext<typename TCmd::CommandType>();
@@ -110,4 +158,4 @@ private:
 };
 
 } // namespace rr::displaylist
-#endif // DISPLAYLISTDISASSEMBLER_HPP_
\ No newline at end of file
+#endif // DISPLAYLISTDISASSEMBLER_HPP_
@@ -0,0 +1,149 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef DISPLAYLISTRINGBUFFER_HPP
+#define DISPLAYLISTRINGBUFFER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+namespace rr::displaylist
+{
+
+/// @brief Ring of display lists. One list (the back) is assembled while the other lists are in flight
+/// (waiting for or currently being uploaded). The oldest list in flight is the front.
+/// @details The ring is not thread safe. Concurrent access from a producer and a consumer must be
+/// synchronized by the caller. The producer only touches the back, the consumer only the front.
+/// @tparam TDisplayList Type of the display list
+/// @tparam MaxDepth Maximum number of display lists in the ring
+template <typename TDisplayList, std::size_t MaxDepth>
+class DisplayListRingBuffer
+{
+public:
+    static_assert(MaxDepth >= 2, "A display list ring requires at least two display lists");
+
+    DisplayListRingBuffer(std::array<TDisplayList, MaxDepth>& displayLists)
+    {
+        for (std::size_t i = 0; i < MaxDepth; i++)
+        {
+            m_displayList[i] = &displayLists[i];
+        }
+    }
+
+    /// @brief Sets the number of used display lists and the maximum number of lists in flight.
+    /// Must only be called when no list is in flight.
+    /// @param depth Number of used display lists (clamped to 1 .. MaxDepth). With a single list, the back
+    /// is in flight after a commit and can only be assembled again when it is released (see backInFlight()).
+    /// @param maxInFlight Maximum number of lists in flight (clamped to 1 .. depth - 1, or 1 for a single list)
+    void setDepth(const std::size_t depth, const std::size_t maxInFlight)
+    {
+        m_depth = (std::max)(std::size_t { 1 }, (std::min)(depth, MaxDepth));
+        m_maxInFlight = (std::max)(std::size_t { 1 }, (std::min)(maxInFlight, m_depth - 1));
+        m_back = 0;
+        m_inFlight = 0;
+    }
+
+    /// @brief Moves the back into flight and selects the next list as back.
+    /// Must only be called when the ring is not full().
+    void commit()
+    {
+        m_back = next(m_back);
+        m_inFlight++;
+        m_peakInFlight = (std::max)(m_peakInFlight, m_inFlight);
+    }
+
+    /// @brief Releases the front. Must only be called when lists are in flight.
+    void release()
+    {
+        m_inFlight--;
+    }
+
+    /// @brief The ring is full when the maximum number of lists is in flight. The back can't be
+    /// committed until the front is released.
+    bool full() const
+    {
+        return m_inFlight >= m_maxInFlight;
+    }
+
+    bool empty() const
+    {
+        return m_inFlight == 0;
+    }
+
+    /// @brief The back is in flight when all lists are in flight. This only happens with a single list.
+    bool backInFlight() const
+    {
+        return m_inFlight >= m_depth;
+    }
+
+    TDisplayList& getBack()
+    {
+        return *m_displayList[m_back];
+    }
+
+    TDisplayList& getFront()
+    {
+        return *m_displayList[getFrontIndex()];
+    }
+
+    std::size_t getBackIndex() const
+    {
+        return m_back;
+    }
+
+    std::size_t getFrontIndex() const
+    {
+        return (m_back + m_depth - m_inFlight) % m_depth;
+    }
+
+    std::size_t getInFlight() const
+    {
+        return m_inFlight;
+    }
+
+    std::size_t getPeakInFlight() const
+    {
+        return m_peakInFlight;
+    }
+
+    std::size_t getMaxInFlight() const
+    {
+        return m_maxInFlight;
+    }
+
+    std::size_t getDepth() const
+    {
+        return m_depth;
+    }
+
+private:
+    std::size_t next(const std::size_t index) const
+    {
+        return (index + 1) % m_depth;
+    }
+
+    std::array<TDisplayList*, MaxDepth> m_displayList {};
+    std::size_t m_depth { MaxDepth };
+    std::size_t m_maxInFlight { MaxDepth - 1 };
+    std::size_t m_back { 0 };
+    std::size_t m_inFlight { 0 };
+    std::size_t m_peakInFlight { 0 };
+};
+
+} // namespace rr::displaylist
+#endif // DISPLAYLISTRINGBUFFER_HPP
@@ -18,6 +18,7 @@
 #ifndef RIXDISPLAYLISTASSEMBLER_HPP
 #define RIXDISPLAYLISTASSEMBLER_HPP
 
+#include "Profiler.hpp"
 #include <algorithm>
 #include <array>
 #include <stdint.h>
@@ -54,10 +55,12 @@ public:
     template <typename TCommand>
     bool addCommand(const TCommand& cmd)
     {
-        if (getCommandSize<TCommand>(cmd) >= m_displayList.getFreeSpace())
+        const std::size_t commandSize = getCommandSize<TCommand>(cmd);
+        if (commandSize >= m_displayList.getFreeSpace())
         {
             return false;
         }
+        RIX_PROFILE_COMMAND_BYTES(static_cast<uint32_t>(cmd.command()), commandSize);
         writeCommand(cmd);
         return true;
     }
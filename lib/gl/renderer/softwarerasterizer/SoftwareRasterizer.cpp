@@ -16,6 +16,7 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "SoftwareRasterizer.hpp"
+#include "Profiler.hpp"
 #include <variant>
 
 namespace rr::softwarerasterizer
@@ -35,6 +36,7 @@ SoftwareRasterizer::SoftwareRasterizer(IBusConnector& busConnector)
 
 void SoftwareRasterizer::streamDisplayList(const uint8_t index, const uint32_t size)
 {
+    RIX_PROFILE_SCOPE("rasterize");
     displaylist::DisplayList srcList {};
     srcList.setBuffer(requestDisplayListBuffer(index));
     srcList.resetGet();
@@ -43,9 +45,8 @@ void SoftwareRasterizer::streamDisplayList(const uint8_t index, const uint32_t s
 
     while (disassembler.hasNextCommand())
     {
-        const bool ret = std::visit([this](const auto& cmd)
-            { return handleCommand(cmd); },
-            disassembler.getNextCommand());
+        const bool ret = disassembler.visitNextCommand([this](const auto& cmd)
+            { return handleCommand(cmd); });
         if (!ret)
         {
             SPDLOG_ERROR("Failed to handle command in display list. This might cause the renderer to crash ...");
@@ -112,11 +113,13 @@ bool SoftwareRasterizer::handleCommand(const TriangleStreamCmd& cmd)
 {
     const TriangleStreamTypes::TriangleDesc attributesData = cmd.payload()[0];
     m_rasterizer.init(attributesData);
+    m_statistics.triangles++;
     while (!m_rasterizer.isDone())
     {
         const FragmentData fmd = m_rasterizer.hit();
         if (fmd.hit)
         {
+            m_statistics.fragments++;
             const InterpolatedAttributesData interpolatedAttributes = m_attributeInterpolator.interpolate(attributesData, fmd.bbx, fmd.bby);
             const uint16_t depth = m_depthBuffer.readFragment(fmd.index);
             const uint8_t stencil = m_stencilBuffer.readFragment(fmd.index);
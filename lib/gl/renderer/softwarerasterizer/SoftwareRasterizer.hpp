@@ -53,6 +53,13 @@ namespace rr::softwarerasterizer
 class SoftwareRasterizer : public IDevice
 {
 public:
+    /// @brief Work done by the rasterizer since its construction
+    struct Statistics
+    {
+        std::size_t triangles { 0 }; ///< Number of rasterized triangles
+        std::size_t fragments { 0 }; ///< Number of fragments covered by the triangles, before any test
+    };
+
     SoftwareRasterizer(IBusConnector& busConnector);
 
     void deinit()
@@ -87,6 +94,12 @@ public:
         return m_buffer.size();
     }
 
+    /// @brief Returns the statistics. Must not be called while a display list is streamed.
+    Statistics getStatistics() const
+    {
+        return m_statistics;
+    }
+
 private:
     bool handleCommand(const FramebufferCmd& cmd);
     bool handleCommand(const FogLutStreamCmd& cmd);
@@ -120,7 +133,7 @@ private:
 
     IBusConnector& m_busConnector;
 
-    std::array<std::array<uint8_t, RenderConfig::THREADED_RASTERIZATION_DISPLAY_LIST_BUFFER_SIZE>, 2> m_buffer;
+    std::array<std::array<uint8_t, RenderConfig::THREADED_RASTERIZATION_DISPLAY_LIST_BUFFER_SIZE>, RenderConfig::THREADED_RASTERIZATION_DISPLAY_LIST_RING_DEPTH> m_buffer;
 
     tcb::span<uint8_t> m_gram {};
 
@@ -141,6 +154,7 @@ private:
     BlendFunc m_blendFunc {};
     LogicOp m_logicOp {};
     StencilOp m_stencilOp {};
+    Statistics m_statistics {};
 };
 
 } // namespace rr::softwarerasterizer
@@ -80,6 +80,12 @@ public:
         return m_pageList.getSize() == 0;
     }
 
+    /// @brief Checks if another page fits into the list
+    bool full() const
+    {
+        return m_pageList.getFreeSpace() < displaylist::DisplayList::sizeOf<Page>();
+    }
+
     void clear()
     {
         m_pageList.resetGet();
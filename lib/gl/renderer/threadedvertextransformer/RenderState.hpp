@@ -47,20 +47,25 @@ public:
         }
     }
 
-    void storeCommand(const CommandVariant& cmd)
+    void storeCommand(const WriteRegisterCmd& cmd)
     {
-        if (std::holds_alternative<WriteRegisterCmd>(cmd))
-        {
-            storeRegister(std::get<WriteRegisterCmd>(cmd));
-        }
-        else if (std::holds_alternative<TextureStreamCmd>(cmd))
-        {
-            storeTextureStream(std::get<TextureStreamCmd>(cmd));
-        }
-        else if (std::holds_alternative<FogLutStreamCmd>(cmd))
-        {
-            storeFogLut(std::get<FogLutStreamCmd>(cmd));
-        }
+        storeRegister(cmd);
+    }
+
+    void storeCommand(const TextureStreamCmd& cmd)
+    {
+        storeTextureStream(cmd);
+    }
+
+    void storeCommand(const FogLutStreamCmd& cmd)
+    {
+        storeFogLut(cmd);
+    }
+
+    template <typename TCmd>
+    void storeCommand(const TCmd&)
+    {
+        // Commands which are not part of the render state
     }
 
 private:
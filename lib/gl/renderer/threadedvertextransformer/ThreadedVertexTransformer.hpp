@@ -19,16 +19,21 @@
 #define _THREADED_VERTEX_TRANSFORMER_HPP_
 
 #include "IThreadRunner.hpp"
+#include "Profiler.hpp"
 #include "RenderConfigs.hpp"
 #include "renderer/IDevice.hpp"
 #include "renderer/displaylist/DisplayList.hpp"
 #include "renderer/displaylist/DisplayListAssembler.hpp"
 #include "renderer/displaylist/DisplayListDispatcher.hpp"
-#include "renderer/displaylist/DisplayListDoubleBuffer.hpp"
+#include "renderer/displaylist/DisplayListRingBuffer.hpp"
 #include "renderer/displaylist/RIXDisplayListAssembler.hpp"
 #include "transform/VertexTransformer.hpp"
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <mutex>
 #include <tcb/span.hpp>
+#include <utility>
 
 #include "renderer/commands/CommandVariant.hpp"
 
@@ -48,6 +53,17 @@ namespace rr::threadedvertextransformer
 class ThreadedVertexTransformer : public IDevice
 {
 public:
+    /// @brief Back-pressure accounting of the display list ring
+    struct RingStatistics
+    {
+        std::size_t depth { 0 }; ///< Number of used display lists
+        std::size_t maxFramesInFlight { 0 }; ///< Configured maximum of frames waiting for their upload
+        std::size_t peakFramesInFlight { 0 }; ///< Highest observed number of frames waiting for their upload
+        std::size_t frames { 0 }; ///< Number of committed display lists
+        std::size_t stalls { 0 }; ///< Number of commits which had to wait for a free display list
+        std::chrono::microseconds stallTime { 0 }; ///< Accumulated time spent waiting for a free display list
+    };
+
     ThreadedVertexTransformer(IDevice& device, IThreadRunner& uploadThread, IThreadRunner& workerThread)
         : m_device { device }
         , m_uploadThread { uploadThread }
@@ -68,6 +84,8 @@ public:
     {
         const std::function<void()> compute = [this, index, size]()
         {
+            RIX_PROFILE_THREAD("worker");
+            RIX_PROFILE_SCOPE("transform");
             displaylist::DisplayList srcList {};
             srcList.setBuffer(requestDisplayListBuffer(index));
             srcList.resetGet();
@@ -87,20 +105,23 @@ public:
 
             while (disassembler.hasNextCommand())
             {
-                const bool ret = std::visit([this](const auto& cmd)
+                const bool ret = disassembler.visitNextCommand([this](const auto& cmd)
                     { 
                         if constexpr (!DisplayListDispatcherType::singleList())
                         {
                             m_renderState.storeCommand(cmd);
                         }
-                        return handleCommand(cmd); },
-                    disassembler.getNextCommand());
+                        return handleCommand(cmd); });
                 if (!ret)
                 {
                     SPDLOG_ERROR("Failed to handle command in display list. This might cause the renderer to crash ...");
                 }
             }
             swapAndUploadDisplayLists();
+            if (m_frameCompleted)
+            {
+                publishFrameStatistics();
+            }
         };
         m_workerThread.wait();
         m_workerThread.run(compute);
@@ -109,7 +130,17 @@ public:
     bool writeToDeviceMemory(tcb::span<const uint8_t> data, const uint32_t addr) override
     {
         m_workerThread.wait();
-        if (!m_textureUploadList.addPage(data, addr))
+        // The back is never accessed by the upload thread. The pages are uploaded right before the display list.
+        DeviceUploadListType& textureUploadList = m_textureUploadList[m_displayListRing.getBackIndex()];
+        if (textureUploadList.full())
+        {
+            // Keeps the order of the pages: When the previous frames are uploaded, the pages of the back can be written
+            // directly, because the device isn't used by another thread and the display list of the back comes later.
+            m_uploadThread.wait();
+            textureUpload(textureUploadList);
+            return m_device.writeToDeviceMemory(data, addr);
+        }
+        if (!textureUploadList.addPage(data, addr))
         {
             SPDLOG_ERROR("Failed to add page to texture upload list");
             return false;
@@ -139,48 +170,123 @@ public:
         return m_buffer.size();
     }
 
+    RingStatistics getRingStatistics()
+    {
+        std::unique_lock<std::mutex> lock { m_ringMutex };
+        RingStatistics statistics { m_ringStatistics };
+        statistics.depth = m_displayListRing.getDepth();
+        statistics.maxFramesInFlight = m_displayListRing.getMaxInFlight();
+        statistics.peakFramesInFlight = m_displayListRing.getPeakInFlight();
+        return statistics;
+    }
+
+    bool getFrameStatistics(FrameStatistics& statistics) override
+    {
+        return m_frameStatisticsPublisher.load(statistics);
+    }
+
 private:
     using DisplayListAssemblerType = displaylist::DisplayListAssembler<RenderConfig::TMU_COUNT, displaylist::DisplayList>;
     using DisplayListAssemblerArrayType = std::array<DisplayListAssemblerType, RenderConfig::getDisplayLines()>;
     using DisplayListDispatcherType = displaylist::DisplayListDispatcher<RenderConfig, DisplayListAssemblerArrayType>;
-    using DisplayListDoubleBufferType = displaylist::DisplayListDoubleBuffer<DisplayListDispatcherType>;
+    using DeviceUploadListType = DeviceUploadList<RenderConfig::THREADED_RASTERIZATION_TEXTURE_UPLOAD_LIST_SIZE, RenderConfig::TEXTURE_PAGE_SIZE>;
+    static constexpr std::size_t RING_DEPTH { RenderConfig::THREADED_RASTERIZATION_DISPLAY_LIST_RING_DEPTH };
+    using DisplayListRingBufferType = displaylist::DisplayListRingBuffer<DisplayListDispatcherType, RING_DEPTH>;
+    static_assert(RenderConfig::THREADED_RASTERIZATION_MAX_FRAMES_IN_FLIGHT >= 1, "At least one frame must be allowed to be in flight");
+    static_assert(RenderConfig::THREADED_RASTERIZATION_MAX_FRAMES_IN_FLIGHT < RING_DEPTH, "The ring requires a free display list to assemble the next frame");
+
+    template <std::size_t... I>
+    static std::array<DisplayListDispatcherType, RING_DEPTH> createDispatchers(
+        std::array<DisplayListAssemblerArrayType, RING_DEPTH>& assemblers,
+        std::index_sequence<I...>)
+    {
+        return { DisplayListDispatcherType { assemblers[I] }... };
+    }
 
     void initDisplayLists()
     {
-        for (std::size_t i = 0, buffId = 0; i < m_displayListAssembler[0].size(); i++)
+        const std::size_t lines = RenderConfig::getDisplayLines();
+        const std::size_t bufferCount = m_device.getDisplayListBufferCount();
+        const std::size_t availableDepth = bufferCount / lines;
+        if (availableDepth == 0)
         {
-            m_displayListAssembler[0][i].setBuffer(m_device.requestDisplayListBuffer(buffId), buffId);
-            buffId++;
-            m_displayListAssembler[1][i].setBuffer(m_device.requestDisplayListBuffer(buffId), buffId);
-            buffId++;
+            SPDLOG_CRITICAL("Device provides only {} display list buffers but {} are required. This will brake the rendering.",
+                bufferCount, lines);
         }
-        m_displayListBuffer.getFront().clearDisplayListAssembler();
-        m_displayListBuffer.getBack().clearDisplayListAssembler();
+        else if (availableDepth < RING_DEPTH)
+        {
+            SPDLOG_WARN("Device provides only {} display list buffers. Display list ring depth is reduced from {} to {}.",
+                bufferCount, RING_DEPTH, availableDepth);
+        }
+        m_displayListRing.setDepth(availableDepth, RenderConfig::THREADED_RASTERIZATION_MAX_FRAMES_IN_FLIGHT);
+        if (m_displayListRing.getMaxInFlight() < RenderConfig::THREADED_RASTERIZATION_MAX_FRAMES_IN_FLIGHT)
+        {
+            SPDLOG_WARN("Frames in flight are reduced from {} to {}.",
+                RenderConfig::THREADED_RASTERIZATION_MAX_FRAMES_IN_FLIGHT, m_displayListRing.getMaxInFlight());
+        }
+
+        for (std::size_t i = 0, buffId = 0; i < lines; i++)
+        {
+            for (std::size_t j = 0; (j < m_displayListRing.getDepth()) && (buffId < bufferCount); j++)
+            {
+                m_displayListAssembler[j][i].setBuffer(m_device.requestDisplayListBuffer(buffId), buffId);
+                m_displayListBufferSize = m_device.requestDisplayListBuffer(buffId).size();
+                buffId++;
+            }
+        }
+        for (DisplayListDispatcherType& dispatcher : m_displayListDispatcher)
+        {
+            dispatcher.clearDisplayListAssembler();
+        }
+    }
+
+    void uploadDisplayList(DisplayListDispatcherType& displayList)
+    {
+        RIX_PROFILE_SCOPE("uploadDisplayList");
+        displayList.displayListLooper(
+            [this](
+                DisplayListDispatcherType& dispatcher,
+                const std::size_t i,
+                const std::size_t,
+                const std::size_t,
+                const std::size_t)
+            {
+                if (dispatcher.getDisplayListSize(i) > 0)
+                {
+                    m_device.streamDisplayList(
+                        dispatcher.getDisplayListBufferId(i),
+                        dispatcher.getDisplayListSize(i));
+                }
+                return true;
+            });
+        m_device.blockUntilDeviceIsIdle();
     }
 
-    void uploadDisplayList()
+    void uploadDisplayLists()
     {
-        const std::function<void()> uploader = [this]()
+        // Uploads the display lists in flight in the order they were committed. Runs until the ring is
+        // drained. The worker starts a new upload thread when it commits a display list into an empty ring.
+        RIX_PROFILE_THREAD("upload");
+        for (;;)
         {
-            m_displayListBuffer.getFront().displayListLooper(
-                [this](
-                    DisplayListDispatcherType& dispatcher,
-                    const std::size_t i,
-                    const std::size_t,
-                    const std::size_t,
-                    const std::size_t)
+            std::size_t index {};
+            {
+                std::unique_lock<std::mutex> lock { m_ringMutex };
+                if (m_displayListRing.empty())
                 {
-                    if (dispatcher.getDisplayListSize(i) > 0)
-                    {
-                        m_device.streamDisplayList(
-                            dispatcher.getDisplayListBufferId(i),
-                            dispatcher.getDisplayListSize(i));
-                    }
-                    return true;
-                });
-            m_device.blockUntilDeviceIsIdle();
-        };
-        m_uploadThread.run(uploader);
+                    m_uploadRunning = false;
+                    return;
+                }
+                index = m_displayListRing.getFrontIndex();
+            }
+            textureUpload(m_textureUploadList[index]);
+            uploadDisplayList(m_displayListDispatcher[index]);
+            {
+                std::unique_lock<std::mutex> lock { m_ringMutex };
+                m_displayListRing.release();
+            }
+            m_ringCondition.notify_one();
+        }
     }
 
     template <typename TArg>
@@ -192,11 +298,11 @@ private:
     template <typename Command>
     bool addCommand(const Command& cmd)
     {
-        bool ret = m_displayListBuffer.getBack().addCommand(cmd);
+        bool ret = m_displayListRing.getBack().addCommand(cmd);
         if (!ret)
         {
             intermediateUpload();
-            ret = m_displayListBuffer.getBack().addCommand(cmd);
+            ret = m_displayListRing.getBack().addCommand(cmd);
         }
         return ret;
     }
@@ -204,13 +310,13 @@ private:
     template <typename Command>
     bool addLastCommand(const Command& cmd)
     {
-        return m_displayListBuffer.getBack().addLastCommand(cmd);
+        return m_displayListRing.getBack().addLastCommand(cmd);
     }
 
     template <typename Factory>
     bool addLastCommandWithFactory(const Factory& commandFactory)
     {
-        return m_displayListBuffer.getBack().addLastCommandWithFactory_if(commandFactory,
+        return m_displayListRing.getBack().addLastCommandWithFactory_if(commandFactory,
             [](std::size_t, std::size_t, std::size_t, std::size_t)
             { return true; });
     }
@@ -226,19 +332,43 @@ private:
     template <typename Factory, typename Pred>
     bool addCommandWithFactory_if(const Factory& commandFactory, const Pred& pred)
     {
-        return m_displayListBuffer.getBack().addCommandWithFactory_if(commandFactory, pred);
+        return m_displayListRing.getBack().addCommandWithFactory_if(commandFactory, pred);
     }
 
     template <typename Function>
     bool displayListLooper(const Function& func)
     {
-        return m_displayListBuffer.getBack().displayListLooper(func);
+        return m_displayListRing.getBack().displayListLooper(func);
     }
 
-    void switchDisplayLists()
+    bool commitDisplayList()
     {
-        m_displayListBuffer.swap();
-        m_displayListBuffer.getBack().clearDisplayListAssembler();
+        std::unique_lock<std::mutex> lock { m_ringMutex };
+        if (m_displayListRing.full())
+        {
+            // Back-pressure: Bound the latency by waiting until the oldest frame is uploaded
+            const auto start = std::chrono::steady_clock::now();
+            m_ringCondition.wait(lock, [this]()
+                { return !m_displayListRing.full(); });
+            const auto stallTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+            m_ringStatistics.stalls++;
+            m_ringStatistics.stallTime += stallTime;
+            RIX_PROFILE_COUNT(RING_STALL_TIME_US, stallTime.count());
+        }
+        m_displayListRing.commit();
+        m_ringStatistics.frames++;
+        const bool startUpload = !m_uploadRunning;
+        m_uploadRunning = true;
+        return startUpload;
+    }
+
+    void prepareBackDisplayList()
+    {
+        if (m_resolutionX && m_resolutionY)
+        {
+            m_displayListRing.getBack().setResolution(m_resolutionX, m_resolutionY);
+        }
+        m_displayListRing.getBack().clearDisplayListAssembler();
     }
 
     template <typename TriangleCmd>
@@ -272,6 +402,7 @@ private:
         {
             return true;
         }
+        m_frameStatistics.trianglesRasterized++;
 
         if constexpr (DisplayListDispatcherType::singleList())
         {
@@ -321,6 +452,7 @@ private:
     {
         if (cmd.getSwapFramebuffer())
         {
+            m_frameCompleted = true;
             addLastCommand(WriteRegisterCmd { ColorBufferAddrReg { m_colorBufferAddr } });
             return addLastCommandWithFactory(
                 [&cmd](const std::size_t, const std::size_t displayLines, const std::size_t resX, const std::size_t resY)
@@ -499,14 +631,16 @@ private:
 
     bool handleRegister(RenderResolutionReg reg)
     {
-        if (!m_displayListBuffer.getBack().setResolution(reg.getX(), reg.getY())
-            || !m_displayListBuffer.getFront().setResolution(reg.getX(), reg.getY()))
+        // Only the back is changed. The lists in flight are uploaded with the resolution they were assembled with.
+        if (!m_displayListRing.getBack().setResolution(reg.getX(), reg.getY()))
         {
             SPDLOG_ERROR("Invalid resolution set in RenderResolutionReg: {}x{}",
                 reg.getX(), reg.getY());
             return false;
         }
-        reg.setY(m_displayListBuffer.getBack().getYLineResolution());
+        m_resolutionX = reg.getX();
+        m_resolutionY = reg.getY();
+        reg.setY(m_displayListRing.getBack().getYLineResolution());
         return writeReg(reg);
     }
 
@@ -567,15 +701,51 @@ private:
 
     void swapAndUploadDisplayLists()
     {
-        m_uploadThread.wait();
-        switchDisplayLists();
-        textureUpload();
-        uploadDisplayList();
+        displayListLooper(
+            [this](DisplayListDispatcherType& dispatcher, const std::size_t i, const std::size_t, const std::size_t, const std::size_t)
+            {
+                m_frameStatistics.displayListBytes = (std::max)(m_frameStatistics.displayListBytes, dispatcher.getDisplayListSize(i));
+                return true;
+            });
+        const bool startUpload = commitDisplayList();
+        if (startUpload)
+        {
+            // The previous upload thread has drained the ring and is about to finish
+            m_uploadThread.wait();
+            m_uploadThread.run([this]()
+                { uploadDisplayLists(); });
+        }
+        waitUntilBackIsReleased();
+        prepareBackDisplayList();
+    }
+
+    void waitUntilBackIsReleased()
+    {
+        // Only a ring with a single display list uploads the back. It can be assembled again after the upload.
+        std::unique_lock<std::mutex> lock { m_ringMutex };
+        m_ringCondition.wait(lock, [this]()
+            { return !m_displayListRing.backInFlight(); });
+    }
+
+    void publishFrameStatistics()
+    {
+        const auto& transformStatistics = m_vertexTransform.getStatistics();
+        const RingStatistics ringStatistics = getRingStatistics();
+        m_frameStatistics.trianglesSubmitted = transformStatistics.trianglesSubmitted;
+        m_frameStatistics.trianglesCulled = transformStatistics.trianglesCulled;
+        m_frameStatistics.trianglesClipped = transformStatistics.trianglesClipped;
+        m_frameStatistics.displayListSize = m_displayListBufferSize;
+        m_frameStatistics.uploadStalls = ringStatistics.stalls;
+        m_frameStatistics.uploadStallTime = ringStatistics.stallTime.count();
+        m_frameStatisticsPublisher.publish(m_frameStatistics);
+        m_vertexTransform.resetStatistics();
+        m_frameStatistics = {};
+        m_frameCompleted = false;
     }
 
     void intermediateUpload()
     {
-        if (m_displayListBuffer.getBack().singleList())
+        if (m_displayListRing.getBack().singleList())
         {
             swapAndUploadDisplayLists();
         }
@@ -587,19 +757,20 @@ private:
 
     bool setStencilBufferConfig(const StencilReg& stencilConf)
     {
-        return m_displayListBuffer.getBack().addCommand(WriteRegisterCmd { stencilConf });
+        return m_displayListRing.getBack().addCommand(WriteRegisterCmd { stencilConf });
     }
 
-    void textureUpload()
+    void textureUpload(DeviceUploadListType& textureUploadList)
     {
-        if (m_textureUploadList.empty())
+        if (textureUploadList.empty())
         {
             return;
         }
+        RIX_PROFILE_SCOPE("textureUpload");
 
-        while (!m_textureUploadList.atEnd())
+        while (!textureUploadList.atEnd())
         {
-            const auto* page = m_textureUploadList.getNextPage();
+            const auto* page = textureUploadList.getNextPage();
             if (page)
             {
                 if (!m_device.writeToDeviceMemory(page->data, page->addr))
@@ -608,7 +779,7 @@ private:
                 }
             }
         }
-        m_textureUploadList.clear();
+        textureUploadList.clear();
         m_device.blockUntilDeviceIsIdle();
     }
 
@@ -618,10 +789,21 @@ private:
     IDevice& m_device;
     IThreadRunner& m_uploadThread;
     IThreadRunner& m_workerThread;
-    std::array<DisplayListAssemblerArrayType, 2> m_displayListAssembler {};
-    std::array<DisplayListDispatcherType, 2> m_displayListDispatcher { m_displayListAssembler[0], m_displayListAssembler[1] };
-    DisplayListDoubleBufferType m_displayListBuffer { m_displayListDispatcher[0], m_displayListDispatcher[1] };
-    DeviceUploadList<RenderConfig::THREADED_RASTERIZATION_DISPLAY_LIST_BUFFER_SIZE, RenderConfig::TEXTURE_PAGE_SIZE> m_textureUploadList {};
+    std::array<DisplayListAssemblerArrayType, RING_DEPTH> m_displayListAssembler {};
+    std::array<DisplayListDispatcherType, RING_DEPTH> m_displayListDispatcher { createDispatchers(m_displayListAssembler, std::make_index_sequence<RING_DEPTH> {}) };
+    DisplayListRingBufferType m_displayListRing { m_displayListDispatcher };
+    // One list per display list of the ring, see RIX_CORE_THREADED_RASTERIZATION_TEXTURE_UPLOAD_LIST_SIZE
+    std::array<DeviceUploadListType, RING_DEPTH> m_textureUploadList {};
+    std::mutex m_ringMutex {};
+    std::condition_variable m_ringCondition {};
+    bool m_uploadRunning { false };
+    RingStatistics m_ringStatistics {};
+    FrameStatistics m_frameStatistics {};
+    FrameStatisticsPublisher m_frameStatisticsPublisher {};
+    bool m_frameCompleted { false };
+    std::size_t m_displayListBufferSize { 0 };
+    std::size_t m_resolutionX { 0 };
+    std::size_t m_resolutionY { 0 };
 
     std::array<std::array<uint8_t, RenderConfig::THREADED_RASTERIZATION_DISPLAY_LIST_BUFFER_SIZE>, NUMBER_OF_DISPLAY_LISTS> m_buffer;
 
@@ -85,6 +85,13 @@ class VertexTransformerCalc
     using Triangle = std::array<TransformingVertexParameter, 3>;
 
 public:
+    struct Statistics
+    {
+        std::size_t trianglesSubmitted { 0 }; ///< Triangles which entered the clipping stage
+        std::size_t trianglesCulled { 0 }; ///< Triangles discarded by the clipper or the face culling
+        std::size_t trianglesClipped { 0 }; ///< Triangles which intersected the clipping planes
+    };
+
     VertexTransformerCalc(
         const VertexTransformerData& data,
         const TDrawTriangleFunc& drawTriangleFunc,
@@ -121,6 +128,9 @@ public:
         updateNormalMatrix();
     }
 
+    const Statistics& getStatistics() const { return m_statistics; }
+    void resetStatistics() { m_statistics = {}; }
+
 private:
     void updateNormalMatrix()
     {
@@ -263,6 +273,7 @@ private:
         // facing backwards, then all in the clipping list will do this and vice versa.
         if (culling::CullingCalc { m_data.culling }.cull(list[0].vertex, list[1].vertex, list[2].vertex))
         {
+            m_statistics.trianglesCulled++;
             return true;
         }
 
@@ -327,6 +338,7 @@ private:
 
         if (culling::CullingCalc { m_data.culling }.cull(v0, v1, v2))
         {
+            m_statistics.trianglesCulled++;
             return true;
         }
 
@@ -372,6 +384,7 @@ private:
 
     bool drawClippedTriangle(const Triangle& triangle)
     {
+        m_statistics.trianglesClipped++;
         Clipper::ClipList list;
         Clipper::ClipList listBuffer;
 
@@ -383,6 +396,7 @@ private:
 
         if (clippedVertexParameter.empty())
         {
+            m_statistics.trianglesCulled++;
             return true;
         }
 
@@ -391,6 +405,7 @@ private:
 
     bool drawPreClippedTriangle(const Triangle& triangle)
     {
+        m_statistics.trianglesSubmitted++;
         if (Clipper::isInside(triangle[0].vertex, triangle[1].vertex, triangle[2].vertex))
         {
             return drawUnclippedTriangle(triangle);
@@ -398,6 +413,7 @@ private:
 
         if (Clipper::isOutside(triangle[0].vertex, triangle[1].vertex, triangle[2].vertex))
         {
+            m_statistics.trianglesCulled++;
             return true;
         }
         return drawClippedTriangle(triangle);
@@ -527,6 +543,7 @@ private:
         m_data.viewPort.viewportHeight
     };
     lighting::LightingCalc m_lighting { m_data.lighting };
+    Statistics m_statistics {};
 };
 
 } // namespace rr::vertextransformer
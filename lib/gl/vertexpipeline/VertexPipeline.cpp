@@ -16,6 +16,7 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "VertexPipeline.hpp"
+#include "Profiler.hpp"
 #include "math/Vec.hpp"
 #include "math/Veci.hpp"
 #include <cmath>
@@ -72,6 +73,8 @@ void VertexPipeline::updateGlobalElementContext()
 
 bool VertexPipeline::drawObj(const RenderObj& obj)
 {
+    RIX_PROFILE_THREAD("producer");
+    RIX_PROFILE_SCOPE("drawObj");
     if (!obj.vertexArrayEnabled())
     {
         SPDLOG_INFO("drawObj(): Vertex array disabled. No primitive is rendered.");
@@ -70,10 +70,19 @@ public:
     }
     std::tuple<int32_t, int32_t, uint32_t, uint32_t> getScissorBox() const { return m_renderer.getScissorBox(); }
     void enableVSync(const bool enable) { m_renderer.enableVSync(enable); }
-    bool readBackColorBuffer(tcb::span<uint8_t> buffer) { return m_renderer.readBackColorBuffer(buffer); }
-    bool readFrontColorBuffer(tcb::span<uint8_t> buffer) { return m_renderer.readFrontColorBuffer(buffer); }
+    bool readBackColorBuffer(tcb::span<uint8_t> buffer, const uint32_t offset = 0) { return m_renderer.readBackColorBuffer(buffer, offset); }
+    bool readFrontColorBuffer(tcb::span<uint8_t> buffer, const uint32_t offset = 0) { return m_renderer.readFrontColorBuffer(buffer, offset); }
+    bool readBackColorBufferRows(tcb::span<uint8_t> buffer, const uint32_t offset, const uint32_t rowSize, const uint32_t stride)
+    {
+        return m_renderer.readBackColorBufferRows(buffer, offset, rowSize, stride);
+    }
+    bool readFrontColorBufferRows(tcb::span<uint8_t> buffer, const uint32_t offset, const uint32_t rowSize, const uint32_t stride)
+    {
+        return m_renderer.readFrontColorBufferRows(buffer, offset, rowSize, stride);
+    }
     std::size_t getFramebufferWidth() const { return m_renderer.getFramebufferWidth(); }
     std::size_t getFramebufferHeight() const { return m_renderer.getFramebufferHeight(); }
+    Renderer::Statistics getStatistics() { return m_renderer.getStatistics(); }
 
     // Framebuffer
     bool clearFramebuffer(const bool frameBuffer, const bool zBuffer, const bool stencilBuffer);
@@ -0,0 +1,397 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "XShmPresenter.hpp"
+#include "FramebufferConverter.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <poll.h>
+#include <spdlog/spdlog.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+namespace rr
+{
+
+namespace
+{
+// Time after which a put request is considered lost, for instance because the drawable was destroyed
+static constexpr int PUT_TIMEOUT_MS { 1000 };
+
+bool isBgra8888(const Visual* visual, const int depth)
+{
+    return ((depth == 24) || (depth == 32))
+        && (visual->red_mask == 0xff0000)
+        && (visual->green_mask == 0x00ff00)
+        && (visual->blue_mask == 0x0000ff);
+}
+
+bool isRgb565(const Visual* visual, const int depth)
+{
+    return (depth == 16)
+        && (visual->red_mask == 0xf800)
+        && (visual->green_mask == 0x07e0)
+        && (visual->blue_mask == 0x001f);
+}
+
+std::chrono::microseconds since(const std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
+} // namespace
+
+XShmPresenter::~XShmPresenter()
+{
+    close();
+}
+
+bool XShmPresenter::open(Display* display, const Drawable drawable, const uint32_t width, const uint32_t height)
+{
+    close();
+
+    m_display = XOpenDisplay(DisplayString(display));
+    if (!m_display)
+    {
+        SPDLOG_ERROR("Can't open a connection to the display {}", DisplayString(display));
+        return false;
+    }
+
+    XWindowAttributes attributes {};
+    if (!XGetWindowAttributes(m_display, drawable, &attributes))
+    {
+        SPDLOG_ERROR("Can't query the attributes of the drawable 0x{:x}", drawable);
+        close();
+        return false;
+    }
+    // The converter writes the pixels in little endian order
+    if ((!isBgra8888(attributes.visual, attributes.depth) && !isRgb565(attributes.visual, attributes.depth))
+        || (ImageByteOrder(m_display) != LSBFirst))
+    {
+        SPDLOG_ERROR("The visual of the drawable 0x{:x} with depth {} is not supported", drawable, attributes.depth);
+        close();
+        return false;
+    }
+
+    m_drawable = drawable;
+    m_visual = attributes.visual;
+    m_depth = attributes.depth;
+    m_width = width;
+    m_height = height;
+    m_gc = XCreateGC(m_display, m_drawable, 0, nullptr);
+    m_useShm = XShmQueryExtension(m_display);
+    if (m_useShm)
+    {
+        m_completionEvent = XShmGetEventBase(m_display) + ShmCompletion;
+    }
+
+    bool created = createImages();
+    if (!created && m_useShm)
+    {
+        SPDLOG_WARN("MIT-SHM is not available. Falls back to XPutImage.");
+        m_useShm = false;
+        created = createImages();
+    }
+    if (!created)
+    {
+        SPDLOG_ERROR("Can't create the images with {}x{} pixel", width, height);
+        close();
+        return false;
+    }
+
+    m_backImage = 0;
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        m_stop = false;
+        m_open = true;
+    }
+    m_presenterThread = std::thread { [this]()
+        { presenterLoop(); } };
+    return true;
+}
+
+void XShmPresenter::close()
+{
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        m_open = false;
+        m_stop = true;
+        m_lastCommit = {};
+    }
+    m_condition.notify_all();
+    if (m_presenterThread.joinable())
+    {
+        m_presenterThread.join();
+    }
+
+    if (!m_display)
+    {
+        return;
+    }
+    for (Image& image : m_images)
+    {
+        destroyImage(image);
+    }
+    if (m_gc)
+    {
+        XFreeGC(m_display, m_gc);
+        m_gc = nullptr;
+    }
+    XCloseDisplay(m_display);
+    m_display = nullptr;
+    m_drawable = 0;
+}
+
+bool XShmPresenter::isOpenFor(const Drawable drawable, const uint32_t width, const uint32_t height) const
+{
+    return m_open && (m_drawable == drawable) && (m_width == width) && (m_height == height);
+}
+
+void XShmPresenter::present(const tcb::span<const uint8_t> colorBuffer)
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock { m_mutex };
+    if (!m_open)
+    {
+        return;
+    }
+    if (colorBuffer.size() != (m_width * m_height * sizeof(uint16_t)))
+    {
+        // A frame which was rendered before the resolution changed
+        m_statistics.droppedFrames++;
+        return;
+    }
+    m_condition.wait(lock, [this]()
+        { return !m_hasPending; });
+
+    const std::chrono::steady_clock::time_point handedOver = std::chrono::steady_clock::now();
+    if (m_lastCommit != std::chrono::steady_clock::time_point {})
+    {
+        m_statistics.renderTime += std::chrono::duration_cast<std::chrono::microseconds>(start - m_lastCommit);
+    }
+    m_statistics.stallTime += std::chrono::duration_cast<std::chrono::microseconds>(handedOver - start);
+    m_lastCommit = handedOver;
+
+    m_pending = colorBuffer;
+    m_hasPending = true;
+    m_condition.notify_all();
+}
+
+XShmPresenter::Statistics XShmPresenter::getStatistics()
+{
+    std::lock_guard<std::mutex> lock { m_mutex };
+    return m_statistics;
+}
+
+bool XShmPresenter::createImages()
+{
+    for (Image& image : m_images)
+    {
+        if (!createImage(image))
+        {
+            for (Image& i : m_images)
+            {
+                destroyImage(i);
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+bool XShmPresenter::createImage(Image& image)
+{
+    if (!m_useShm)
+    {
+        const uint32_t bytesPerPixel = (m_depth == 16) ? 2 : 4;
+        char* data = static_cast<char*>(std::malloc(m_width * m_height * bytesPerPixel));
+        if (!data)
+        {
+            return false;
+        }
+        // XDestroyImage frees the data
+        image.image = XCreateImage(m_display, m_visual, m_depth, ZPixmap, 0, data, m_width, m_height, bytesPerPixel * 8, 0);
+        if (!image.image)
+        {
+            std::free(data);
+        }
+        return image.image != nullptr;
+    }
+
+    image.image = XShmCreateImage(m_display, m_visual, m_depth, ZPixmap, nullptr, &image.shmInfo, m_width, m_height);
+    if (!image.image)
+    {
+        return false;
+    }
+    image.shmInfo.shmid = shmget(IPC_PRIVATE, image.image->bytes_per_line * image.image->height, IPC_CREAT | 0600);
+    if (image.shmInfo.shmid < 0)
+    {
+        XDestroyImage(image.image);
+        image.image = nullptr;
+        return false;
+    }
+    image.shmInfo.shmaddr = static_cast<char*>(shmat(image.shmInfo.shmid, nullptr, 0));
+    image.image->data = image.shmInfo.shmaddr;
+    image.shmInfo.readOnly = False;
+    const bool attached = (image.shmInfo.shmaddr != reinterpret_cast<char*>(-1)) && XShmAttach(m_display, &image.shmInfo);
+    XSync(m_display, False);
+    // The segment is released when both processes have detached it, even if one of them crashes
+    shmctl(image.shmInfo.shmid, IPC_RMID, nullptr);
+    if (!attached)
+    {
+        if (image.shmInfo.shmaddr != reinterpret_cast<char*>(-1))
+        {
+            shmdt(image.shmInfo.shmaddr);
+        }
+        image.image->data = nullptr;
+        XDestroyImage(image.image);
+        image.image = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void XShmPresenter::destroyImage(Image& image)
+{
+    if (!image.image)
+    {
+        return;
+    }
+    if (m_useShm)
+    {
+        waitForImage(image);
+        XShmDetach(m_display, &image.shmInfo);
+        XSync(m_display, False);
+        shmdt(image.shmInfo.shmaddr);
+        image.image->data = nullptr;
+    }
+    XDestroyImage(image.image);
+    image.image = nullptr;
+    image.inFlight = false;
+}
+
+void XShmPresenter::waitForImage(Image& image)
+{
+    while (image.inFlight)
+    {
+        if (XPending(m_display) == 0)
+        {
+            pollfd fd { ConnectionNumber(m_display), POLLIN, 0 };
+            if (poll(&fd, 1, PUT_TIMEOUT_MS) <= 0)
+            {
+                SPDLOG_WARN("The X server has not completed the put request of a frame");
+                image.inFlight = false;
+                return;
+            }
+        }
+        // Only the completion events are selected on this connection
+        XEvent event {};
+        XNextEvent(m_display, &event);
+        if (event.type == m_completionEvent)
+        {
+            const XShmCompletionEvent& completion = reinterpret_cast<const XShmCompletionEvent&>(event);
+            for (Image& i : m_images)
+            {
+                if (i.shmInfo.shmseg == completion.shmseg)
+                {
+                    i.inFlight = false;
+                }
+            }
+        }
+    }
+}
+
+void XShmPresenter::convert(Image& image, const tcb::span<const uint8_t> colorBuffer)
+{
+    // The lines of the image can be padded
+    const uint16_t* src = reinterpret_cast<const uint16_t*>(colorBuffer.data());
+    for (uint32_t y = 0; y < m_height; y++)
+    {
+        uint8_t* dst = reinterpret_cast<uint8_t*>(image.image->data) + (y * image.image->bytes_per_line);
+        if (m_depth == 16)
+        {
+            std::memcpy(dst, src + (y * m_width), m_width * sizeof(uint16_t));
+        }
+        else
+        {
+            FramebufferConverter::convertRgb565ToBgra8888(dst, src + (y * m_width), m_width);
+        }
+    }
+}
+
+void XShmPresenter::put(Image& image)
+{
+    if (m_useShm)
+    {
+        XShmPutImage(m_display, m_drawable, m_gc, image.image, 0, 0, 0, 0, m_width, m_height, True);
+        image.inFlight = true;
+    }
+    else
+    {
+        XPutImage(m_display, m_drawable, m_gc, image.image, 0, 0, 0, 0, m_width, m_height);
+    }
+    XFlush(m_display);
+}
+
+void XShmPresenter::presenterLoop()
+{
+    std::unique_lock<std::mutex> lock { m_mutex };
+    for (;;)
+    {
+        m_condition.wait(lock, [this]()
+            { return m_hasPending || m_stop; });
+        if (!m_hasPending)
+        {
+            break;
+        }
+        const tcb::span<const uint8_t> colorBuffer = m_pending;
+        lock.unlock();
+
+        // The X server might still read the image of the frame before the last one
+        Image& image = m_images[m_backImage];
+        const std::chrono::steady_clock::time_point waitStart = std::chrono::steady_clock::now();
+        waitForImage(image);
+        const std::chrono::microseconds waitTime = since(waitStart);
+
+        const std::chrono::steady_clock::time_point convertStart = std::chrono::steady_clock::now();
+        convert(image, colorBuffer);
+        const std::chrono::microseconds convertTime = since(convertStart);
+
+        // The color buffer is released. The rasterizer can now render into it.
+        lock.lock();
+        m_hasPending = false;
+        m_condition.notify_all();
+        lock.unlock();
+
+        const std::chrono::steady_clock::time_point putStart = std::chrono::steady_clock::now();
+        put(image);
+        const std::chrono::microseconds putTime = since(putStart) + waitTime;
+        m_backImage = (m_backImage + 1) % IMAGE_COUNT;
+
+        lock.lock();
+        m_statistics.frames++;
+        m_statistics.convertTime += convertTime;
+        m_statistics.putTime += putTime;
+    }
+    lock.unlock();
+
+    for (Image& image : m_images)
+    {
+        waitForImage(image);
+    }
+}
+
+} // namespace rr
@@ -0,0 +1,119 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef XSHMPRESENTER_HPP_
+#define XSHMPRESENTER_HPP_
+
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/extensions/XShm.h>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <tcb/span.hpp>
+#include <thread>
+
+namespace rr
+{
+
+/// @brief Shows the color buffers of the software rasterizer in an X11 drawable
+/// @details The presenter uses its own connection to the X server and its own thread. A committed color buffer is
+///     converted into one of two XImages in MIT-SHM memory and put into the drawable while the rasterizer renders
+///     the next frame. Without MIT-SHM (remote displays) the images are sent with XPutImage.
+class XShmPresenter
+{
+public:
+    /// @brief Accumulated times of all presented frames
+    struct Statistics
+    {
+        uint64_t frames { 0 }; ///< Presented frames
+        uint64_t droppedFrames { 0 }; ///< Committed color buffers which did not match the size of the drawable
+        std::chrono::microseconds renderTime { 0 }; ///< Time of the rasterizer between two commits, without the stall time
+        std::chrono::microseconds stallTime { 0 }; ///< Time the rasterizer waited for the presenter
+        std::chrono::microseconds convertTime { 0 }; ///< Conversion of the color buffers into the XImages
+        std::chrono::microseconds putTime { 0 }; ///< Put requests and the wait until the X server has read an XImage
+    };
+
+    ~XShmPresenter();
+
+    /// @brief Opens a connection to the display of the application and creates the images for the drawable
+    /// @param display The display of the application. It is only used to open a second connection.
+    /// @param drawable The window which shows the frames
+    /// @param width Width of the color buffer in pixel
+    /// @param height Height of the color buffer in pixel
+    /// @return false if the visual of the drawable is not supported or the images can't be created
+    bool open(Display* display, const Drawable drawable, const uint32_t width, const uint32_t height);
+
+    /// @brief Waits until the last frame is presented and releases the images and the connection
+    void close();
+
+    /// @brief Checks if the presenter shows frames in drawable
+    bool isOpenFor(const Drawable drawable, const uint32_t width, const uint32_t height) const;
+
+    /// @brief Hands a committed RGB565 color buffer to the presenter thread
+    /// @details Called by the rasterizer. Waits until the previous color buffer is converted, because the
+    ///     rasterizer renders the frame after the next one into the buffer of the previous frame.
+    void present(const tcb::span<const uint8_t> colorBuffer);
+
+    Statistics getStatistics();
+
+private:
+    static constexpr std::size_t IMAGE_COUNT { 2 };
+
+    struct Image
+    {
+        XImage* image { nullptr };
+        XShmSegmentInfo shmInfo {};
+        bool inFlight { false };
+    };
+
+    bool createImages();
+    bool createImage(Image& image);
+    void destroyImage(Image& image);
+    void waitForImage(Image& image);
+    void convert(Image& image, const tcb::span<const uint8_t> colorBuffer);
+    void put(Image& image);
+    void presenterLoop();
+
+    Display* m_display { nullptr };
+    Drawable m_drawable { 0 };
+    GC m_gc { nullptr };
+    Visual* m_visual { nullptr };
+    int m_depth { 0 };
+    bool m_useShm { false };
+    int m_completionEvent { 0 };
+    uint32_t m_width { 0 };
+    uint32_t m_height { 0 };
+    std::array<Image, IMAGE_COUNT> m_images {};
+    std::size_t m_backImage { 0 };
+
+    std::mutex m_mutex {};
+    std::condition_variable m_condition {};
+    tcb::span<const uint8_t> m_pending {};
+    bool m_hasPending { false };
+    bool m_open { false };
+    bool m_stop { false };
+    std::thread m_presenterThread {};
+    Statistics m_statistics {};
+    std::chrono::steady_clock::time_point m_lastCommit {};
+};
+
+} // namespace rr
+
+#endif // XSHMPRESENTER_HPP_
@@ -16,14 +16,198 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "glx.h"
-#include "DMAProxyBusConnector.hpp"
 #include "MultiThreadRunner.hpp"
 #include "RIXGL.hpp"
-#include "renderer/devicedatauploader/DeviceDataUploader.hpp"
 #include "renderer/threadedvertextransformer/ThreadedVertexTransformer.hpp"
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/spdlog.h>
+#if RIX_CORE_SOFTWARE_RENDERING
+#include "SoftwareRasterizerBusConnector.hpp"
+#include "XShmPresenter.hpp"
+#include "renderer/softwarerasterizer/SoftwareRasterizer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#else
+#include "DMAProxyBusConnector.hpp"
+#include "renderer/devicedatauploader/DeviceDataUploader.hpp"
+#endif
+
+void addProcedures()
+{
+#define ADDRESS_OF(X) reinterpret_cast<const void*>(&X)
+    rr::RIXGL::getInstance().addLibProcedure("glXChooseVisual", ADDRESS_OF(glXChooseVisual));
+    rr::RIXGL::getInstance().addLibProcedure("glXCreateContext", ADDRESS_OF(glXCreateContext));
+    rr::RIXGL::getInstance().addLibProcedure("glXDestroyContext", ADDRESS_OF(glXDestroyContext));
+    rr::RIXGL::getInstance().addLibProcedure("glXMakeCurrent", ADDRESS_OF(glXMakeCurrent));
+    rr::RIXGL::getInstance().addLibProcedure("glXSwapBuffers", ADDRESS_OF(glXSwapBuffers));
+    rr::RIXGL::getInstance().addLibProcedure("glXQueryDrawable", ADDRESS_OF(glXQueryDrawable));
+    rr::RIXGL::getInstance().addLibProcedure("glXGetCurrentContext", ADDRESS_OF(glXGetCurrentContext));
+    rr::RIXGL::getInstance().addLibProcedure("glXGetCurrentDrawable", ADDRESS_OF(glXGetCurrentDrawable));
+#undef ADDRESS_OF
+}
+
+#if RIX_CORE_SOFTWARE_RENDERING
+/// @brief Renders with the software rasterizer and shows the frames in the current drawable via MIT-SHM
+/// @details Set RIX_GLX_BENCHMARK=<n> to print the present and render times every n frames to stderr.
+class GLInitGuard
+{
+public:
+    GLInitGuard()
+    {
+        // No XInitThreads(). The presenter thread only uses its own connection to the X server, never the one of
+        // the application, so the application keeps control over the Xlib thread initialization.
+        rr::RIXGL::createInstance(m_threadedRasterizer);
+        addProcedures();
+        const char* benchmark = std::getenv("RIX_GLX_BENCHMARK");
+        m_benchmarkInterval = benchmark ? std::strtoul(benchmark, nullptr, 10) : 0;
+    }
+    ~GLInitGuard()
+    {
+        deinit();
+    }
+
+    void init()
+    {
+        // The resolution is set when a drawable is made current
+    }
+
+    void deinit()
+    {
+        rr::RIXGL::getInstance().destroy();
+        m_threadedRasterizer.deinit();
+        m_presenter.close();
+    }
+
+    XVisualInfo* chooseVisual(Display* dpy, const int screen)
+    {
+        // The presenter supports 32 bit and RGB565 true color visuals
+        XVisualInfo visualTemplate {};
+        visualTemplate.screen = screen;
+        visualTemplate.c_class = TrueColor;
+        int count { 0 };
+        for (const int depth : { 24, 16 })
+        {
+            visualTemplate.depth = depth;
+            XVisualInfo* vi = XGetVisualInfo(dpy, VisualScreenMask | VisualDepthMask | VisualClassMask, &visualTemplate, &count);
+            if (vi)
+            {
+                return vi;
+            }
+        }
+        SPDLOG_ERROR("No true color visual found");
+        return nullptr;
+    }
+
+    bool makeCurrent(Display* dpy, const GLXDrawable drawable)
+    {
+        m_drawable = drawable;
+        if (drawable == 0)
+        {
+            m_presenter.close();
+            return true;
+        }
+        Window root {};
+        int x { 0 };
+        int y { 0 };
+        unsigned int w { 0 };
+        unsigned int h { 0 };
+        unsigned int border { 0 };
+        unsigned int depth { 0 };
+        if (!XGetGeometry(dpy, drawable, &root, &x, &y, &w, &h, &border, &depth))
+        {
+            SPDLOG_ERROR("Can't query the size of the drawable 0x{:x}", drawable);
+            return false;
+        }
+        const uint32_t width = (std::min)(static_cast<uint32_t>(w), static_cast<uint32_t>(rr::RenderConfig::MAX_DISPLAY_WIDTH));
+        const uint32_t height = (std::min)(static_cast<uint32_t>(h), static_cast<uint32_t>(rr::RenderConfig::MAX_DISPLAY_HEIGHT));
+        if ((width != w) || (height != h))
+        {
+            SPDLOG_WARN("The drawable with {}x{} pixel is larger than the maximum display size. Renders {}x{} pixel.", w, h, width, height);
+        }
+        if (m_presenter.isOpenFor(drawable, width, height))
+        {
+            return true;
+        }
+        rr::RIXGL::getInstance().setRenderResolution(width, height);
+        return m_presenter.open(dpy, drawable, width, height);
+    }
+
+    void render()
+    {
+        rr::RIXGL::getInstance().swapDisplayList();
+        if ((m_benchmarkInterval != 0) && ((++m_swaps % m_benchmarkInterval) == 0))
+        {
+            printBenchmark();
+        }
+    }
+
+    GLXDrawable getCurrentDrawable() const
+    {
+        return m_drawable;
+    }
+
+    rr::RIXGL& getInst()
+    {
+        return rr::RIXGL::getInstance();
+    }
 
+private:
+    // Hands each committed color buffer to the presenter
+    class PresentingBusConnector : public rr::SoftwareRasterizerBusConnector<>
+    {
+    public:
+        PresentingBusConnector(rr::XShmPresenter& presenter)
+            : m_presenter { presenter }
+        {
+        }
+
+        void writeData(const uint8_t index, const uint32_t size, const uint32_t offset) override
+        {
+            SoftwareRasterizerBusConnector::writeData(index, size, offset);
+            m_presenter.present(getFrontBuffer());
+        }
+
+    private:
+        rr::XShmPresenter& m_presenter;
+    };
+
+    void printBenchmark()
+    {
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        const rr::XShmPresenter::Statistics statistics = m_presenter.getStatistics();
+        const uint64_t frames = statistics.frames - m_lastStatistics.frames;
+        if ((frames != 0) && (m_lastReport != std::chrono::steady_clock::time_point {}))
+        {
+            const auto msPerFrame = [frames](const std::chrono::microseconds time)
+            { return std::chrono::duration<double, std::milli>(time).count() / frames; };
+            const double seconds = std::chrono::duration<double>(now - m_lastReport).count();
+            std::fprintf(stderr, "RIX_GLX_BENCHMARK %.1f fps, render %.2f ms, stall %.2f ms, convert %.2f ms, put %.2f ms, dropped %llu\n",
+                m_benchmarkInterval / seconds,
+                msPerFrame(statistics.renderTime - m_lastStatistics.renderTime),
+                msPerFrame(statistics.stallTime - m_lastStatistics.stallTime),
+                msPerFrame(statistics.convertTime - m_lastStatistics.convertTime),
+                msPerFrame(statistics.putTime - m_lastStatistics.putTime),
+                static_cast<unsigned long long>(statistics.droppedFrames - m_lastStatistics.droppedFrames));
+        }
+        m_lastStatistics = statistics;
+        m_lastReport = now;
+    }
+
+    rr::XShmPresenter m_presenter {};
+    GLXDrawable m_drawable { 0 };
+    unsigned long m_benchmarkInterval { 0 };
+    unsigned long m_swaps { 0 };
+    rr::XShmPresenter::Statistics m_lastStatistics {};
+    std::chrono::steady_clock::time_point m_lastReport {};
+    rr::MultiThreadRunner m_workerThread {};
+    rr::MultiThreadRunner m_uploadThread {};
+    PresentingBusConnector m_busConnector { m_presenter };
+    rr::softwarerasterizer::SoftwareRasterizer m_softwareRasterizer { m_busConnector };
+    rr::threadedvertextransformer::ThreadedVertexTransformer m_threadedRasterizer { m_softwareRasterizer, m_workerThread, m_uploadThread };
+} guard;
+#else
 static constexpr uint32_t RESOLUTION_H = 600;
 static constexpr uint32_t RESOLUTION_W = 1024;
 
@@ -33,25 +217,50 @@ public:
     GLInitGuard()
     {
         rr::RIXGL::createInstance(m_threadedRasterizer);
-#define ADDRESS_OF(X) reinterpret_cast<const void*>(&X)
-        rr::RIXGL::getInstance().addLibProcedure("glXChooseVisual", ADDRESS_OF(glXChooseVisual));
-        rr::RIXGL::getInstance().addLibProcedure("glXCreateContext", ADDRESS_OF(glXCreateContext));
-        rr::RIXGL::getInstance().addLibProcedure("glXDestroyContext", ADDRESS_OF(glXDestroyContext));
-        rr::RIXGL::getInstance().addLibProcedure("glXMakeCurrent", ADDRESS_OF(glXMakeCurrent));
-        rr::RIXGL::getInstance().addLibProcedure("glXSwapBuffers", ADDRESS_OF(glXSwapBuffers));
-        rr::RIXGL::getInstance().addLibProcedure("glXQueryDrawable", ADDRESS_OF(glXQueryDrawable));
-        rr::RIXGL::getInstance().addLibProcedure("glXGetCurrentContext", ADDRESS_OF(glXGetCurrentContext));
-        rr::RIXGL::getInstance().addLibProcedure("glXGetCurrentDrawable", ADDRESS_OF(glXGetCurrentDrawable));
-#undef ADDRESS_OF
+        addProcedures();
     }
     ~GLInitGuard()
     {
         deinit();
     }
 
+    void init()
+    {
+        rr::RIXGL::getInstance().setRenderResolution(RESOLUTION_W, RESOLUTION_H);
+    }
+
     void deinit()
     {
         rr::RIXGL::getInstance().destroy();
+        m_threadedRasterizer.deinit();
+    }
+
+    XVisualInfo* chooseVisual([[maybe_unused]] Display* dpy, [[maybe_unused]] const int screen)
+    {
+        XVisualInfo* vi = new XVisualInfo;
+        vi->visual = new Visual;
+        vi->visualid = 0x21;
+        vi->screen = 0;
+        vi->depth = 16;
+        vi->red_mask = 0x1f;
+        vi->green_mask = 0x3f;
+        vi->blue_mask = 0x1f;
+        vi->colormap_size = 16;
+        vi->bits_per_rgb = log2(16);
+        vi->visual->visualid = 0x21;
+        vi->visual->bits_per_rgb = log2(16);
+        vi->visual->red_mask = 0x1f << 11;
+        vi->visual->green_mask = 0x3f << 5;
+        vi->visual->blue_mask = 0x1f;
+        vi->visual->c_class = TrueColor;
+        vi->visual->map_entries = 0x20;
+        return vi;
+    }
+
+    bool makeCurrent([[maybe_unused]] Display* dpy, [[maybe_unused]] const GLXDrawable drawable)
+    {
+        // Nothing todo. Only one context exists and the device drives its own display
+        return true;
     }
 
     void render()
@@ -59,6 +268,11 @@ public:
         rr::RIXGL::getInstance().swapDisplayList();
     }
 
+    GLXDrawable getCurrentDrawable() const
+    {
+        return 1;
+    }
+
     rr::RIXGL& getInst()
     {
         return rr::RIXGL::getInstance();
@@ -71,31 +285,15 @@ private:
     rr::devicedatauploader::DeviceDataUploader m_dduDevice { m_busConnector };
     rr::threadedvertextransformer::ThreadedVertexTransformer m_threadedRasterizer { m_dduDevice, m_workerThread, m_uploadThread };
 } guard;
+#endif
 
 GLAPI XVisualInfo* APIENTRY glXChooseVisual(
-    [[maybe_unused]] Display* dpy,
-    [[maybe_unused]] int screen,
+    Display* dpy,
+    int screen,
     [[maybe_unused]] int* attribList)
 {
     SPDLOG_DEBUG("glXChooseVisual called");
-    XVisualInfo* vi = new XVisualInfo;
-    vi->visual = new Visual;
-    vi->visualid = 0x21;
-    vi->screen = 0;
-    vi->depth = 16;
-    vi->red_mask = 0x1f;
-    vi->green_mask = 0x3f;
-    vi->blue_mask = 0x1f;
-    vi->colormap_size = 16;
-    vi->bits_per_rgb = log2(16);
-    vi->visual->visualid = 0x21;
-    vi->visual->bits_per_rgb = log2(16);
-    vi->visual->red_mask = 0x1f << 11;
-    vi->visual->green_mask = 0x3f << 5;
-    vi->visual->blue_mask = 0x1f;
-    vi->visual->c_class = TrueColor;
-    vi->visual->map_entries = 0x20;
-    return vi;
+    return guard.chooseVisual(dpy, screen);
 }
 
 GLAPI GLXContext APIENTRY glXCreateContext(
@@ -120,23 +318,25 @@ GLAPI GLXContext APIENTRY glXCreateContext(
     spdlog::set_level(spdlog::level::critical);
 #endif
 
-    guard.getInst().setRenderResolution(RESOLUTION_W, RESOLUTION_H);
+    guard.init();
     return reinterpret_cast<GLXContext>(&guard.getInst());
 }
 
-GLAPI void APIENTRY glXDestroyContext([[maybe_unused]] Display* dpy, [[maybe_unused]] GLXContext ctx)
+GLAPI void APIENTRY glXDestroyContext(Display* dpy, [[maybe_unused]] GLXContext ctx)
 {
-    SPDLOG_WARN("glXDestroyContext not implemented");
+    SPDLOG_DEBUG("glXDestroyContext called");
+    // Releases the drawable. The context itself lives as long as the library.
+    guard.makeCurrent(dpy, 0);
 }
 
 GLAPI Bool APIENTRY glXMakeCurrent(
-    [[maybe_unused]] Display* dpy,
-    [[maybe_unused]] GLXDrawable drawable,
+    Display* dpy,
+    GLXDrawable drawable,
     [[maybe_unused]] GLXContext ctx)
 {
     SPDLOG_DEBUG("glXMakeCurrent called");
-    // Nothing todo. Only one context exists
-    return 1;
+    // Only one context exists
+    return guard.makeCurrent(dpy, drawable);
 }
 
 GLAPI void APIENTRY glXCopyContext(
@@ -206,8 +406,8 @@ GLAPI GLXContext APIENTRY glXGetCurrentContext(void)
 
 GLAPI GLXDrawable APIENTRY glXGetCurrentDrawable(void)
 {
-    SPDLOG_WARN("glXGetCurrentDrawable not implemented");
-    return 1;
+    SPDLOG_DEBUG("glXGetCurrentDrawable called");
+    return guard.getCurrentDrawable();
 }
 
 GLAPI void APIENTRY glXWaitGL(void)
@@ -0,0 +1,182 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// Opens the GL library like a GLX application, renders into windows of an X server and reads the presented pixels back.
+// The test requires an X server with a 24 bit and a 16 bit screen, add_glx_test() runs it in Xvfb.
+
+#define CATCH_CONFIG_MAIN
+#include "../3rdParty/catch.hpp"
+#include "glx.h"
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <chrono>
+#include <dlfcn.h>
+#include <optional>
+#include <thread>
+
+namespace
+{
+
+struct GlxLibrary
+{
+    GlxLibrary()
+    {
+        // Loaded like a GLX application loads its libGL
+        m_handle = dlopen(RIX_GLX_LIBRARY, RTLD_NOW | RTLD_LOCAL);
+        if (m_handle)
+        {
+            chooseVisual = reinterpret_cast<decltype(chooseVisual)>(dlsym(m_handle, "glXChooseVisual"));
+            createContext = reinterpret_cast<decltype(createContext)>(dlsym(m_handle, "glXCreateContext"));
+            destroyContext = reinterpret_cast<decltype(destroyContext)>(dlsym(m_handle, "glXDestroyContext"));
+            makeCurrent = reinterpret_cast<decltype(makeCurrent)>(dlsym(m_handle, "glXMakeCurrent"));
+            swapBuffers = reinterpret_cast<decltype(swapBuffers)>(dlsym(m_handle, "glXSwapBuffers"));
+            clearColor = reinterpret_cast<decltype(clearColor)>(dlsym(m_handle, "glClearColor"));
+            clear = reinterpret_cast<decltype(clear)>(dlsym(m_handle, "glClear"));
+        }
+    }
+
+    bool isLoaded() const
+    {
+        return m_handle && chooseVisual && createContext && destroyContext && makeCurrent && swapBuffers && clearColor && clear;
+    }
+
+    decltype(&glXChooseVisual) chooseVisual { nullptr };
+    decltype(&glXCreateContext) createContext { nullptr };
+    decltype(&glXDestroyContext) destroyContext { nullptr };
+    decltype(&glXMakeCurrent) makeCurrent { nullptr };
+    decltype(&glXSwapBuffers) swapBuffers { nullptr };
+    decltype(&glClearColor) clearColor { nullptr };
+    decltype(&glClear) clear { nullptr };
+
+private:
+    void* m_handle { nullptr };
+};
+
+GlxLibrary& glx()
+{
+    static GlxLibrary library {};
+    return library;
+}
+
+std::optional<int> findScreen(Display* dpy, const int depth)
+{
+    for (int screen = 0; screen < ScreenCount(dpy); screen++)
+    {
+        if (DefaultDepth(dpy, screen) == depth)
+        {
+            return screen;
+        }
+    }
+    return std::nullopt;
+}
+
+void waitForEvent(Display* dpy, const Window window, const int type)
+{
+    XEvent event {};
+    do
+    {
+        XWindowEvent(dpy, window, StructureNotifyMask, &event);
+    } while (event.type != type);
+}
+
+unsigned long readPixel(Display* dpy, const Window window, const int x, const int y)
+{
+    XImage* image = XGetImage(dpy, window, x, y, 1, 1, AllPlanes, ZPixmap);
+    REQUIRE(image != nullptr);
+    const unsigned long pixel = XGetPixel(image, 0, 0);
+    XDestroyImage(image);
+    return pixel;
+}
+
+// Clears the frame and swaps until the presenter shows the color in the corner at x, y or the timeout expires.
+// The rendering and the presentation run in their own threads, therefore the frame shows up with a delay.
+bool presents(Display* dpy, const Window window, const int x, const int y, const GLfloat r, const GLfloat g, const GLfloat b, const unsigned long expected)
+{
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds { 5 };
+    while (std::chrono::steady_clock::now() < timeout)
+    {
+        glx().clearColor(r, g, b, 1.0f);
+        glx().clear(GL_COLOR_BUFFER_BIT);
+        glx().swapBuffers(dpy, window);
+        if (readPixel(dpy, window, 0, 0) == expected && readPixel(dpy, window, x, y) == expected)
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds { 10 });
+    }
+    return false;
+}
+
+void testPresentation(const int depth)
+{
+    REQUIRE(glx().isLoaded());
+    Display* dpy = XOpenDisplay(nullptr);
+    REQUIRE(dpy != nullptr);
+    const std::optional<int> screen = findScreen(dpy, depth);
+    if (!screen)
+    {
+        WARN("The X server has no screen with a depth of " << depth << " bit");
+        XCloseDisplay(dpy);
+        return;
+    }
+
+    // Open
+    int attributes[] = { GLX_RGBA, GLX_DOUBLEBUFFER, None };
+    XVisualInfo* vi = glx().chooseVisual(dpy, *screen, attributes);
+    REQUIRE(vi != nullptr);
+    REQUIRE(vi->depth == depth);
+    const Window root = RootWindow(dpy, vi->screen);
+    XSetWindowAttributes windowAttributes {};
+    windowAttributes.colormap = XCreateColormap(dpy, root, vi->visual, AllocNone);
+    windowAttributes.event_mask = StructureNotifyMask;
+    const Window window = XCreateWindow(dpy, root, 0, 0, 64, 48, 0, vi->depth, InputOutput, vi->visual,
+        CWColormap | CWBorderPixel | CWEventMask, &windowAttributes);
+    XMapWindow(dpy, window);
+    waitForEvent(dpy, window, MapNotify);
+    GLXContext ctx = glx().createContext(dpy, vi, nullptr, True);
+    REQUIRE(glx().makeCurrent(dpy, window, ctx));
+
+    // Present
+    CHECK(presents(dpy, window, 63, 47, 1.0f, 0.0f, 0.0f, vi->red_mask));
+    CHECK(presents(dpy, window, 63, 47, 0.0f, 0.0f, 1.0f, vi->blue_mask));
+
+    // Resize
+    XResizeWindow(dpy, window, 96, 80);
+    waitForEvent(dpy, window, ConfigureNotify);
+    REQUIRE(glx().makeCurrent(dpy, window, ctx));
+    CHECK(presents(dpy, window, 95, 79, 0.0f, 1.0f, 0.0f, vi->green_mask));
+
+    // Close
+    REQUIRE(glx().makeCurrent(dpy, None, nullptr));
+    glx().destroyContext(dpy, ctx);
+    XDestroyWindow(dpy, window);
+    XFreeColormap(dpy, windowAttributes.colormap);
+    XFree(vi);
+    XCloseDisplay(dpy);
+}
+
+} // namespace
+
+TEST_CASE("Present into a 24 bit visual", "[XShmPresenter]")
+{
+    testPresentation(24);
+}
+
+TEST_CASE("Present into a 16 bit visual", "[XShmPresenter]")
+{
+    testPresentation(16);
+}
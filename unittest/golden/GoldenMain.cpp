@@ -0,0 +1,28 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// The main of all golden image tests. The scene is selected by add_golden_test() with the definitions
+// RIX_SCENE_NAME (the name of the golden hashes), RIX_SCENE_HEADER (the header of the scene) and RIX_SCENE_CLASS.
+
+#define CATCH_CONFIG_MAIN
+#include "GoldenRunner.hpp"
+#include RIX_SCENE_HEADER
+
+TEST_CASE(RIX_SCENE_NAME " matches the golden hashes", "[Golden]")
+{
+    rr::golden::runGoldenTest<RIX_SCENE_CLASS>(RIX_SCENE_NAME);
+}
@@ -0,0 +1,305 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef GOLDEN_RUNNER_HPP_
+#define GOLDEN_RUNNER_HPP_
+
+#include "../3rdParty/catch.hpp"
+#include "IBusConnector.hpp"
+#include "MultiThreadRunner.hpp"
+#include "RIXGL.hpp"
+#include "SoftwareRasterizerBusConnector.hpp"
+#include "renderer/devicecapture/DeviceCapture.hpp"
+#include "renderer/devicecapture/DeviceCaptureReplay.hpp"
+#include "renderer/softwarerasterizer/SoftwareRasterizer.hpp"
+#include "renderer/threadedvertextransformer/ThreadedVertexTransformer.hpp"
+#include "vertexpipeline/VertexPipeline.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace rr::golden
+{
+
+static constexpr uint32_t RESOLUTION_W { 320 };
+static constexpr uint32_t RESOLUTION_H { 240 };
+static constexpr std::size_t FRAMES { 4 };
+static constexpr std::size_t TILE_SIZE { 40 };
+static constexpr int DEFAULT_TOLERANCE { 4 };
+
+/// @brief Hashes of the buffers of the last rendered frame
+struct FrameHashes
+{
+    uint64_t color { 0 };
+    uint64_t depth { 0 };
+    uint64_t stencil { 0 };
+    /// Mean of the red, green and blue channel (8 bit), the upper byte of the depth and the stencil value per
+    /// TILE_SIZE x TILE_SIZE tile. Used to compare frames with a tolerance.
+    std::vector<uint8_t> signature {};
+};
+
+inline uint64_t hashBytes(const tcb::span<const uint8_t> data)
+{
+    // FNV-1a
+    uint64_t hash { 0xcbf29ce484222325ull };
+    for (const uint8_t b : data)
+    {
+        hash = (hash ^ b) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+inline std::vector<uint8_t> computeSignature(
+    const std::vector<uint8_t>& color,
+    const std::vector<uint8_t>& depth,
+    const std::vector<uint8_t>& stencil)
+{
+    const uint16_t* color16 = reinterpret_cast<const uint16_t*>(color.data());
+    const uint16_t* depth16 = reinterpret_cast<const uint16_t*>(depth.data());
+    std::vector<uint8_t> signature {};
+    for (std::size_t ty = 0; ty < (RESOLUTION_H / TILE_SIZE); ty++)
+    {
+        for (std::size_t tx = 0; tx < (RESOLUTION_W / TILE_SIZE); tx++)
+        {
+            std::array<uint32_t, 5> sum {};
+            for (std::size_t y = ty * TILE_SIZE; y < ((ty + 1) * TILE_SIZE); y++)
+            {
+                for (std::size_t x = tx * TILE_SIZE; x < ((tx + 1) * TILE_SIZE); x++)
+                {
+                    const std::size_t i = (y * RESOLUTION_W) + x;
+                    sum[0] += ((color16[i] >> 11) & 0x1f) << 3;
+                    sum[1] += ((color16[i] >> 5) & 0x3f) << 2;
+                    sum[2] += (color16[i] & 0x1f) << 3;
+                    sum[3] += depth16[i] >> 8;
+                    sum[4] += stencil[i];
+                }
+            }
+            for (const uint32_t s : sum)
+            {
+                signature.push_back(static_cast<uint8_t>(s / (TILE_SIZE * TILE_SIZE)));
+            }
+        }
+    }
+    return signature;
+}
+
+inline std::string toHex(const tcb::span<const uint8_t> data)
+{
+    std::string hex {};
+    char digits[3] {};
+    for (const uint8_t b : data)
+    {
+        std::snprintf(digits, sizeof(digits), "%02x", b);
+        hex += digits;
+    }
+    return hex;
+}
+
+inline std::vector<uint8_t> fromHex(const std::string& hex)
+{
+    std::vector<uint8_t> data {};
+    for (std::size_t i = 0; (i + 1) < hex.size(); i += 2)
+    {
+        data.push_back(static_cast<uint8_t>(std::strtoul(hex.substr(i, 2).c_str(), nullptr, 16)));
+    }
+    return data;
+}
+
+/// @brief Reads the golden hashes of a scene
+/// @return false if the file does not exist or is incomplete
+inline bool readGolden(const std::string& fileName, FrameHashes& hashes)
+{
+    std::ifstream file { fileName };
+    std::string key {};
+    std::string value {};
+    std::size_t found { 0 };
+    while (file >> key)
+    {
+        if (key[0] == '#')
+        {
+            std::getline(file, value);
+            continue;
+        }
+        file >> value;
+        if (key == "color")
+        {
+            hashes.color = std::strtoull(value.c_str(), nullptr, 16);
+        }
+        else if (key == "depth")
+        {
+            hashes.depth = std::strtoull(value.c_str(), nullptr, 16);
+        }
+        else if (key == "stencil")
+        {
+            hashes.stencil = std::strtoull(value.c_str(), nullptr, 16);
+        }
+        else if (key == "signature")
+        {
+            hashes.signature = fromHex(value);
+        }
+        else
+        {
+            continue;
+        }
+        found++;
+    }
+    return found == 4;
+}
+
+inline bool writeGolden(const std::string& fileName, const char* name, const FrameHashes& hashes)
+{
+    std::ofstream file { fileName };
+    file << "# Golden hashes of the scene " << name << " rendered with the softwarerasterizer preset\n";
+    file << "# Regenerate with RIX_GOLDEN_UPDATE=1 (see unittest/README.md)\n";
+    char line[64] {};
+    std::snprintf(line, sizeof(line), "color %016llx\n", static_cast<unsigned long long>(hashes.color));
+    file << line;
+    std::snprintf(line, sizeof(line), "depth %016llx\n", static_cast<unsigned long long>(hashes.depth));
+    file << line;
+    std::snprintf(line, sizeof(line), "stencil %016llx\n", static_cast<unsigned long long>(hashes.stencil));
+    file << line;
+    file << "signature " << toHex(hashes.signature) << "\n";
+    return static_cast<bool>(file);
+}
+
+/// @brief The software rasterizer with its memory
+struct SoftwareDevice
+{
+    SoftwareDevice()
+    {
+        // Buffers which are never cleared by a scene must not contain random values
+        const tcb::span<uint8_t> gram = busConnector.requestWriteBuffer(0);
+        std::fill(gram.begin(), gram.end(), 0);
+    }
+
+    std::vector<uint8_t> read(const uint32_t addr, const std::size_t size)
+    {
+        std::vector<uint8_t> data(size);
+        rasterizer.readFromDeviceMemory(data, addr);
+        return data;
+    }
+
+    std::array<uint8_t, RESOLUTION_W * RESOLUTION_H * 2> framebuffer {};
+    SoftwareRasterizerBusConnector<> busConnector { framebuffer };
+    softwarerasterizer::SoftwareRasterizer rasterizer { busConnector };
+};
+
+/// @brief Renders a scene through the GL front end into the software rasterizer and compares the buffers of the
+///     last frame with the golden hashes in hashes/<name>.txt
+/// @details The device traffic is captured and replayed into a second software rasterizer, which must produce the
+///     same device memory. Builds with floating point interpolation and builds with RIX_GOLDEN_TOLERANCE=<n> compare
+///     the tile signature with a tolerance of n instead of the hashes. RIX_GOLDEN_UPDATE=1 writes new golden hashes.
+template <typename Scene>
+void runGoldenTest(const char* name)
+{
+    const std::size_t pixels = RESOLUTION_W * RESOLUTION_H;
+    auto live = std::make_unique<SoftwareDevice>();
+    std::stringstream capture {};
+    FrameHashes hashes {};
+    {
+        devicecapture::DeviceCapture captureDevice { live->rasterizer };
+        MultiThreadRunner workerThread {};
+        MultiThreadRunner uploadThread {};
+        auto device = std::make_unique<threadedvertextransformer::ThreadedVertexTransformer>(captureDevice, uploadThread, workerThread);
+        captureDevice.start(capture);
+        RIXGL::createInstance(*device);
+        RIXGL::getInstance().setRenderResolution(RESOLUTION_W, RESOLUTION_H);
+        {
+            auto scene = std::make_unique<Scene>();
+            scene->init(RESOLUTION_W, RESOLUTION_H);
+            for (std::size_t i = 0; i < FRAMES; i++)
+            {
+                scene->draw();
+                RIXGL::getInstance().swapDisplayList();
+            }
+
+            std::vector<uint8_t> color(pixels * 2);
+            std::vector<uint8_t> depth(pixels * 2);
+            std::vector<uint8_t> stencil(pixels);
+            REQUIRE(RIXGL::getInstance().pipeline().readFrontColorBuffer(color));
+            REQUIRE(device->readFromDeviceMemory(depth, RenderConfig::DEPTH_BUFFER_LOC));
+            REQUIRE(device->readFromDeviceMemory(stencil, RenderConfig::STENCIL_BUFFER_LOC));
+            hashes.color = hashBytes(color);
+            hashes.depth = hashBytes(depth);
+            hashes.stencil = hashBytes(stencil);
+            hashes.signature = computeSignature(color, depth, stencil);
+        }
+        RIXGL::destroy();
+        device->deinit();
+        captureDevice.stop();
+    }
+
+    // Replay the capture and compare the device memory of the buffers
+    {
+        auto replayed = std::make_unique<SoftwareDevice>();
+        devicecapture::DeviceCaptureReplay replay {};
+        REQUIRE(replay.load(capture));
+        REQUIRE(replay.replay(replayed->rasterizer));
+        const std::array<std::pair<uint32_t, std::size_t>, 4> regions { {
+            { RenderConfig::COLOR_BUFFER_LOC_1, pixels * 2 },
+            { RenderConfig::COLOR_BUFFER_LOC_2, pixels * 2 },
+            { RenderConfig::DEPTH_BUFFER_LOC, pixels * 2 },
+            { RenderConfig::STENCIL_BUFFER_LOC, pixels },
+        } };
+        for (const auto& [addr, size] : regions)
+        {
+            INFO("Replayed buffer at 0x" << std::hex << addr);
+            REQUIRE(hashBytes(replayed->read(addr, size)) == hashBytes(live->read(addr, size)));
+        }
+    }
+
+    const std::string fileName { std::string { RIX_GOLDEN_HASH_DIR } + "/" + name + ".txt" };
+    if (std::getenv("RIX_GOLDEN_UPDATE"))
+    {
+        REQUIRE(writeGolden(fileName, name, hashes));
+        WARN("Golden hashes written to " << fileName);
+        return;
+    }
+
+    FrameHashes golden {};
+    INFO("Golden hashes " << fileName);
+    REQUIRE(readGolden(fileName, golden));
+    const char* toleranceEnv = std::getenv("RIX_GOLDEN_TOLERANCE");
+    if (RenderConfig::USE_FLOAT_INTERPOLATION || toleranceEnv)
+    {
+        // The golden hashes are generated with fixed point interpolation
+        const int tolerance = toleranceEnv ? std::atoi(toleranceEnv) : DEFAULT_TOLERANCE;
+        REQUIRE(golden.signature.size() == hashes.signature.size());
+        for (std::size_t i = 0; i < golden.signature.size(); i++)
+        {
+            INFO("Tile " << (i / 5) << " channel " << (i % 5));
+            REQUIRE(std::abs(static_cast<int>(golden.signature[i]) - static_cast<int>(hashes.signature[i])) <= tolerance);
+        }
+    }
+    else
+    {
+        CHECK(hashes.color == golden.color);
+        CHECK(hashes.depth == golden.depth);
+        CHECK(hashes.stencil == golden.stencil);
+        CHECK(hashes.signature == golden.signature);
+    }
+}
+
+} // namespace rr::golden
+
+#endif // GOLDEN_RUNNER_HPP_
@@ -0,0 +1,76 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef MEMORYDEVICE_HPP
+#define MEMORYDEVICE_HPP
+
+#include "renderer/IDevice.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace rr
+{
+
+// A device which only has memory. Streamed display lists are recorded.
+class MemoryDevice : public IDevice
+{
+public:
+    MemoryDevice(const std::size_t displayListCount = 2, const std::size_t displayListSize = 4096)
+        : m_displayLists(displayListCount, std::vector<uint8_t>(displayListSize))
+        , m_memory(1024 * 1024)
+    {
+        for (std::size_t i = 0; i < m_memory.size(); i++)
+        {
+            m_memory[i] = static_cast<uint8_t>((i * 7) ^ (i >> 8));
+        }
+    }
+
+    void streamDisplayList(const uint8_t index, const uint32_t size) override
+    {
+        streamed.emplace_back(m_displayLists[index].begin(), m_displayLists[index].begin() + size);
+        streamedIndices.push_back(index);
+    }
+
+    bool writeToDeviceMemory(tcb::span<const uint8_t> data, const uint32_t addr) override
+    {
+        std::copy(data.begin(), data.end(), m_memory.begin() + addr);
+        return true;
+    }
+
+    bool readFromDeviceMemory(tcb::span<uint8_t> data, const uint32_t addr) override
+    {
+        std::copy_n(m_memory.begin() + addr, data.size(), data.begin());
+        return true;
+    }
+
+    void blockUntilDeviceIsIdle() override { }
+    tcb::span<uint8_t> requestDisplayListBuffer(const uint8_t index) override { return { m_displayLists[index] }; }
+    uint8_t getDisplayListBufferCount() const override { return static_cast<uint8_t>(m_displayLists.size()); }
+
+    const std::vector<uint8_t>& memory() const { return m_memory; }
+
+    std::vector<std::vector<uint8_t>> streamed {};
+    std::vector<uint8_t> streamedIndices {};
+
+private:
+    std::vector<std::vector<uint8_t>> m_displayLists;
+    std::vector<uint8_t> m_memory;
+};
+
+} // namespace rr
+
+#endif // MEMORYDEVICE_HPP
@@ -0,0 +1,316 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#define CATCH_CONFIG_MAIN
+#include "../3rdParty/catch.hpp"
+#include "ImageConverter.hpp"
+#include "RIXGL.hpp"
+#include "RenderConfigs.hpp"
+#include "gl.h"
+#include "opengl/ColorBufferRegion.hpp"
+#include "opengl/Helpers.hpp"
+#include "renderer/IDevice.hpp"
+#include "vertexpipeline/VertexPipeline.hpp"
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+using namespace rr;
+
+namespace
+{
+
+static constexpr GLint CBW { 16 };
+static constexpr GLint CBH { 8 };
+
+uint8_t pattern(const uint32_t addr)
+{
+    return static_cast<uint8_t>((addr * 7) ^ (addr >> 8));
+}
+
+// A device with a sparse memory. Memory which was not written returns pattern(). Reads are recorded.
+class SparseMemoryDevice : public IDevice
+{
+public:
+    void streamDisplayList(const uint8_t, const uint32_t) override { streams++; }
+
+    bool writeToDeviceMemory(tcb::span<const uint8_t> data, const uint32_t addr) override
+    {
+        for (std::size_t i = 0; i < data.size(); i++)
+        {
+            m_memory[addr + i] = data[i];
+        }
+        return true;
+    }
+
+    bool readFromDeviceMemory(tcb::span<uint8_t> data, const uint32_t addr) override
+    {
+        reads.push_back({ addr, data.size() });
+        for (std::size_t i = 0; i < data.size(); i++)
+        {
+            const auto it = m_memory.find(addr + i);
+            data[i] = (it != m_memory.end()) ? it->second : pattern(addr + i);
+        }
+        return true;
+    }
+
+    void blockUntilDeviceIsIdle() override { }
+    tcb::span<uint8_t> requestDisplayListBuffer(const uint8_t index) override { return { m_displayLists[index] }; }
+    uint8_t getDisplayListBufferCount() const override { return static_cast<uint8_t>(m_displayLists.size()); }
+
+    std::vector<std::pair<uint32_t, std::size_t>> reads {};
+    std::size_t streams { 0 };
+
+private:
+    std::vector<std::vector<uint8_t>> m_displayLists { 2, std::vector<uint8_t>(64 * 1024) };
+    std::map<uint32_t, uint8_t> m_memory {};
+};
+
+struct Context
+{
+    Context()
+    {
+        RIXGL::createInstance(device);
+        RIXGL::getInstance().setRenderResolution(CBW, CBH);
+        device.reads.clear();
+        device.streams = 0;
+    }
+
+    ~Context()
+    {
+        RIXGL::destroy();
+    }
+
+    SparseMemoryDevice device {};
+};
+
+// The pixel of the color buffer (by default the back buffer) which a region (x, y) reads at the row and column in OpenGL order
+uint16_t expectedPixel(const GLint x, const GLint y, const GLint row, const GLint column, const uint32_t colorBufferLoc = RenderConfig::COLOR_BUFFER_LOC_2)
+{
+    const GLint index = std::clamp(((CBH - row - y - 1) * CBW) + column + x, 0, (CBW * CBH) - 1);
+    const uint32_t addr = static_cast<uint32_t>(colorBufferLoc + (index * sizeof(uint16_t)));
+    return static_cast<uint16_t>(pattern(addr) | (pattern(addr + 1) << 8));
+}
+
+// The texel which the pixel of the back buffer is converted to
+uint16_t expectedTexel(const InternalPixelFormat ipf, const uint16_t pixel)
+{
+    std::shared_ptr<uint16_t> texel { new uint16_t[1], std::default_delete<uint16_t[]>() };
+    RIXGL::getInstance().imageConverter().convertUnpack(texel, ipf, 1, 0, 0, 1, 1, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, reinterpret_cast<const uint8_t*>(&pixel));
+    return texel.get()[0];
+}
+
+TextureObject boundTexture()
+{
+    Texture& texture = RIXGL::getInstance().pipeline().texture();
+    return texture.hasPendingTextureUpdate() ? texture.getTexture() : texture.getBoundTextureObject();
+}
+
+void createTexture()
+{
+    GLuint texture {};
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    const std::vector<uint16_t> pixels(8 * 8, 0);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 8, 8, 0, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, pixels.data());
+    REQUIRE(glGetError() == GL_NO_ERROR);
+}
+
+void checkCopiedRegion(const GLint xoffset, const GLint yoffset, const GLint x, const GLint y, const GLsizei width, const GLsizei height)
+{
+    TextureObject texObj = boundTexture();
+    const InternalPixelFormat ipf = texObj.getInternalPixelFormat(0);
+    const uint16_t clearTexel = expectedTexel(ipf, 0);
+    for (GLint row = 0; row < static_cast<GLint>(texObj.getHeight(0)); row++)
+    {
+        for (GLint column = 0; column < static_cast<GLint>(texObj.getWidth(0)); column++)
+        {
+            const bool inside = (column >= xoffset) && (column < (xoffset + width)) && (row >= yoffset) && (row < (yoffset + height));
+            const uint16_t expected = inside ? expectedTexel(ipf, expectedPixel(x, y, row - yoffset, column - xoffset)) : clearTexel;
+            REQUIRE(texObj.getPixels(0).get()[(row * texObj.getWidth(0)) + column] == expected);
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("A region inside of the color buffer reads its rows directly into the destination", "[ColorBufferRegion]")
+{
+    Context context {};
+    const std::vector<uint16_t> pixels = readFromColorBuffer(3, 2, 5, 4, true);
+    REQUIRE(pixels.size() == (5 * 4));
+    // One read per row, no read of the span between the rows
+    REQUIRE(context.device.reads.size() == 4);
+    for (const auto& read : context.device.reads)
+    {
+        REQUIRE(read.second == (5 * sizeof(uint16_t)));
+    }
+    for (GLint row = 0; row < 4; row++)
+    {
+        for (GLint column = 0; column < 5; column++)
+        {
+            REQUIRE(pixels[(row * 5) + column] == expectedPixel(3, 2, row, column));
+        }
+    }
+}
+
+TEST_CASE("The rows of a region inside of the color buffer are read one by one into a scratch row", "[ColorBufferRegion]")
+{
+    Context context {};
+    ColorBufferRegion region { 3, 2, 5, 4, true };
+    REQUIRE(region.isValid());
+    REQUIRE(context.device.reads.empty());
+    for (GLint row = 0; row < 4; row++)
+    {
+        const uint16_t* pixels = region.getRow(row);
+        REQUIRE(context.device.reads.size() == static_cast<std::size_t>(row + 1));
+        REQUIRE(context.device.reads.back().second == (5 * sizeof(uint16_t)));
+        for (GLint column = 0; column < 5; column++)
+        {
+            REQUIRE(pixels[column] == expectedPixel(3, 2, row, column));
+        }
+    }
+    // The back buffer is only committed before the first row
+    REQUIRE(context.device.streams == 1);
+}
+
+TEST_CASE("The back buffer is only committed again when something was added to the frame", "[ColorBufferRegion]")
+{
+    Context context {};
+    REQUIRE(readFromColorBuffer(0, 0, 4, 4, true).size() == 16);
+    REQUIRE(readFromColorBuffer(0, 0, 4, 4, true).size() == 16);
+    REQUIRE(context.device.streams == 1);
+
+    glClear(GL_COLOR_BUFFER_BIT);
+    REQUIRE(readFromColorBuffer(0, 0, 4, 4, true).size() == 16);
+    REQUIRE(context.device.streams == 2);
+}
+
+TEST_CASE("Read pixels in the color buffer format directly into the client buffer", "[ColorBufferRegion]")
+{
+    Context context {};
+    std::vector<uint16_t> pixels(4 * 3);
+    glReadPixels(2, 1, 4, 3, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, pixels.data());
+    REQUIRE(glGetError() == GL_NO_ERROR);
+    REQUIRE(context.device.reads.size() == 3);
+    for (GLint row = 0; row < 3; row++)
+    {
+        for (GLint column = 0; column < 4; column++)
+        {
+            REQUIRE(pixels[(row * 4) + column] == expectedPixel(2, 1, row, column, RenderConfig::COLOR_BUFFER_LOC_1));
+        }
+    }
+}
+
+TEST_CASE("Read pixels in another format are converted row by row", "[ColorBufferRegion]")
+{
+    Context context {};
+    std::vector<uint8_t> pixels(4 * 3 * 4);
+    glReadPixels(2, 1, 4, 3, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    REQUIRE(glGetError() == GL_NO_ERROR);
+    REQUIRE(context.device.reads.size() == 3);
+
+    std::vector<uint16_t> expected(4 * 3);
+    for (GLint row = 0; row < 3; row++)
+    {
+        for (GLint column = 0; column < 4; column++)
+        {
+            expected[(row * 4) + column] = expectedPixel(2, 1, row, column, RenderConfig::COLOR_BUFFER_LOC_1);
+        }
+    }
+    std::vector<uint8_t> converted(pixels.size());
+    RIXGL::getInstance().imageConverter().convertPack(converted.data(), 4, 3, GL_RGBA, GL_UNSIGNED_BYTE, [&expected](const GLint row)
+        { return expected.data() + (row * 4); });
+    REQUIRE(pixels == converted);
+}
+
+TEST_CASE("A region partly outside of the color buffer is clamped to the color buffer", "[ColorBufferRegion]")
+{
+    Context context {};
+    const std::vector<uint16_t> pixels = readFromColorBuffer(-2, 5, 6, 5, true);
+    REQUIRE(pixels.size() == (6 * 5));
+    for (GLint row = 0; row < 5; row++)
+    {
+        for (GLint column = 0; column < 6; column++)
+        {
+            REQUIRE(pixels[(row * 6) + column] == expectedPixel(-2, 5, row, column));
+        }
+    }
+}
+
+TEST_CASE("Copy the color buffer into a texture which is not uploaded", "[ColorBufferRegion]")
+{
+    Context context {};
+    createTexture();
+    REQUIRE(RIXGL::getInstance().pipeline().texture().hasPendingTextureUpdate());
+
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 1, 2, 3, 1, 4, 3);
+    REQUIRE(glGetError() == GL_NO_ERROR);
+    checkCopiedRegion(1, 2, 3, 1, 4, 3);
+}
+
+TEST_CASE("Copy the color buffer into a texture which is already uploaded", "[ColorBufferRegion]")
+{
+    Context context {};
+    createTexture();
+    REQUIRE(RIXGL::getInstance().pipeline().texture().updateTexture());
+    // Ends the frame, which uploads the texture
+    RIXGL::getInstance().setRenderResolution(CBW, CBH);
+    REQUIRE(!RIXGL::getInstance().pipeline().texture().hasPendingTextureUpdate());
+
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 4, 0, -1, 6, 4, 3);
+    REQUIRE(glGetError() == GL_NO_ERROR);
+    // The region is written in place, the texture is not uploaded again as a whole
+    REQUIRE(!RIXGL::getInstance().pipeline().texture().hasPendingTextureUpdate());
+    checkCopiedRegion(4, 0, -1, 6, 4, 3);
+}
+
+TEST_CASE("Copies outside of the texture or to other targets are rejected", "[ColorBufferRegion]")
+{
+    Context context {};
+    createTexture();
+
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 6, 0, 0, 0, 4, 3);
+    REQUIRE(glGetError() == GL_INVALID_VALUE);
+
+    glCopyTexSubImage2D(GL_TEXTURE_1D, 0, 0, 0, 0, 0, 4, 3);
+    REQUIRE(glGetError() == GL_INVALID_ENUM);
+}
+
+TEST_CASE("Write a region of a texture", "[ColorBufferRegion]")
+{
+    Context context {};
+    createTexture();
+    REQUIRE(RIXGL::getInstance().pipeline().texture().updateTexture());
+    // Ends the frame, which uploads the texture
+    RIXGL::getInstance().setRenderResolution(CBW, CBH);
+
+    std::size_t writes { 0 };
+    const GLenum error = writeTextureRegion(0, 2, 3, 2, 2, true,
+        [&](const TextureObject::PixelsType& texels, const InternalPixelFormat, const std::size_t rowLength)
+        {
+            writes++;
+            REQUIRE(rowLength == 8);
+            texels.get()[(3 * rowLength) + 2] = 0x1234;
+        });
+    REQUIRE(error == GL_NO_ERROR);
+    REQUIRE(writes == 1);
+    REQUIRE(boundTexture().getPixels(0).get()[(3 * 8) + 2] == 0x1234);
+
+    REQUIRE(writeTextureRegion(0, 7, 7, 2, 2, true, [](const TextureObject::PixelsType&, const InternalPixelFormat, const std::size_t) { }) == GL_INVALID_VALUE);
+}
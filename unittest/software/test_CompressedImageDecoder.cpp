@@ -0,0 +1,238 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#define CATCH_CONFIG_MAIN
+#include "../3rdParty/catch.hpp"
+#include "CompressedImageDecoder.hpp"
+#include <vector>
+
+using namespace rr;
+
+namespace
+{
+std::shared_ptr<uint16_t> createTexture(const std::size_t size, const uint16_t clearColor)
+{
+    std::shared_ptr<uint16_t> texture { new uint16_t[size], std::default_delete<uint16_t[]>() };
+    std::fill_n(texture.get(), size, clearColor);
+    return texture;
+}
+
+std::shared_ptr<uint16_t> decodeBlock(const GLenum format, const InternalPixelFormat ipf, const std::vector<uint8_t>& block)
+{
+    std::shared_ptr<uint16_t> texture = createTexture(16, 0x1234);
+    REQUIRE(CompressedImageDecoder::decode(texture, ipf, 4, 0, 0, 4, 4, format, block.data()));
+    return texture;
+}
+} // namespace
+
+TEST_CASE("Compressed image sizes", "[CompressedImageDecoder]")
+{
+    REQUIRE(CompressedImageDecoder::getImageSize(GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 4, 4) == 8);
+    REQUIRE(CompressedImageDecoder::getImageSize(GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, 5, 5) == 32);
+    REQUIRE(CompressedImageDecoder::getImageSize(GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, 8, 4) == 32);
+    REQUIRE(CompressedImageDecoder::getImageSize(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 1, 1) == 16);
+    REQUIRE(CompressedImageDecoder::getImageSize(GL_ETC1_RGB8_OES, 2, 16) == 32);
+    REQUIRE(CompressedImageDecoder::getImageSize(GL_RGBA, 4, 4) == 0);
+}
+
+TEST_CASE("Compressed formats select the internal pixel format", "[CompressedImageDecoder]")
+{
+    InternalPixelFormat ipf {};
+    REQUIRE(CompressedImageDecoder::convertInternalPixelFormat(ipf, GL_COMPRESSED_RGB_S3TC_DXT1_EXT) == GL_NO_ERROR);
+    REQUIRE(ipf == InternalPixelFormat::RGB);
+    REQUIRE(CompressedImageDecoder::convertInternalPixelFormat(ipf, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT) == GL_NO_ERROR);
+    REQUIRE(ipf == InternalPixelFormat::RGBA1);
+    REQUIRE(CompressedImageDecoder::convertInternalPixelFormat(ipf, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT) == GL_NO_ERROR);
+    REQUIRE(ipf == InternalPixelFormat::RGBA);
+    REQUIRE(CompressedImageDecoder::convertInternalPixelFormat(ipf, GL_ETC1_RGB8_OES) == GL_NO_ERROR);
+    REQUIRE(ipf == InternalPixelFormat::RGB);
+    REQUIRE(CompressedImageDecoder::convertInternalPixelFormat(ipf, GL_RGB) == GL_INVALID_ENUM);
+
+    std::shared_ptr<uint16_t> texture = createTexture(16, 0);
+    const std::vector<uint8_t> block(16);
+    REQUIRE_FALSE(CompressedImageDecoder::decode(texture, InternalPixelFormat::RGB, 4, 0, 0, 4, 4, GL_RGB, block.data()));
+}
+
+TEST_CASE("Decode DXT1 four color block", "[CompressedImageDecoder]")
+{
+    // c0 red, c1 blue, first row uses the indices 0, 1, 2 and 3
+    const std::shared_ptr<uint16_t> texture = decodeBlock(GL_COMPRESSED_RGB_S3TC_DXT1_EXT, InternalPixelFormat::RGB,
+        { 0x00, 0xf8, 0x1f, 0x00, 0xe4, 0x00, 0x00, 0x00 });
+    REQUIRE(texture.get()[0] == 0xf800);
+    REQUIRE(texture.get()[1] == 0x001f);
+    REQUIRE(texture.get()[2] == 0xa80a); // 2/3 red, 1/3 blue
+    REQUIRE(texture.get()[3] == 0x5015); // 1/3 red, 2/3 blue
+    for (std::size_t i = 4; i < 16; i++)
+    {
+        REQUIRE(texture.get()[i] == 0xf800);
+    }
+}
+
+TEST_CASE("Decode DXT1 three color block", "[CompressedImageDecoder]")
+{
+    // c0 blue, c1 red, first row uses the indices 0, 3, 2 and 1
+    const std::vector<uint8_t> block { 0x1f, 0x00, 0x00, 0xf8, 0x6c, 0x00, 0x00, 0x00 };
+
+    const std::shared_ptr<uint16_t> rgba = decodeBlock(GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, InternalPixelFormat::RGBA1, block);
+    REQUIRE(rgba.get()[0] == 0x003f);
+    REQUIRE(rgba.get()[1] == 0x0000); // Transparent black
+    REQUIRE(rgba.get()[2] == 0x781f); // Half red, half blue
+    REQUIRE(rgba.get()[3] == 0xf801);
+
+    const std::shared_ptr<uint16_t> rgb = decodeBlock(GL_COMPRESSED_RGB_S3TC_DXT1_EXT, InternalPixelFormat::RGB, block);
+    REQUIRE(rgb.get()[0] == 0x001f);
+    REQUIRE(rgb.get()[1] == 0x0000); // Opaque black
+    REQUIRE(rgb.get()[2] == 0x780f);
+    REQUIRE(rgb.get()[3] == 0xf800);
+}
+
+TEST_CASE("Decode DXT3 block", "[CompressedImageDecoder]")
+{
+    // White, the first pixel is transparent and the second pixel is opaque
+    const std::shared_ptr<uint16_t> texture = decodeBlock(GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, InternalPixelFormat::RGBA,
+        { 0xf0, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00 });
+    REQUIRE(texture.get()[0] == 0xfff0);
+    REQUIRE(texture.get()[1] == 0xffff);
+    REQUIRE(texture.get()[2] == 0xfff0);
+    REQUIRE(texture.get()[3] == 0xfff8);
+}
+
+TEST_CASE("Decode DXT5 block", "[CompressedImageDecoder]")
+{
+    SECTION("Eight alpha values")
+    {
+        // a0 255, a1 0, the first pixels use the alpha indices 0, 1 and 2
+        const std::shared_ptr<uint16_t> texture = decodeBlock(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, InternalPixelFormat::RGBA,
+            { 0xff, 0x00, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00 });
+        REQUIRE(texture.get()[0] == 0xffff);
+        REQUIRE(texture.get()[1] == 0xfff0);
+        REQUIRE(texture.get()[2] == 0xfffd); // 6/7 of 255
+        REQUIRE(texture.get()[15] == 0xffff);
+    }
+
+    SECTION("Six alpha values")
+    {
+        // a0 0, a1 255, the first pixels use the alpha indices 6, 7 and 2
+        const std::shared_ptr<uint16_t> texture = decodeBlock(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, InternalPixelFormat::RGBA,
+            { 0x00, 0xff, 0xbe, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00 });
+        REQUIRE(texture.get()[0] == 0xfff0);
+        REQUIRE(texture.get()[1] == 0xffff);
+        REQUIRE(texture.get()[2] == 0xfff3); // 1/5 of 255
+        REQUIRE(texture.get()[15] == 0xfff0);
+    }
+}
+
+TEST_CASE("Decode ETC1 block", "[CompressedImageDecoder]")
+{
+    SECTION("Individual mode with vertical sub blocks")
+    {
+        // Left sub block red, right sub block black, table 0. Pixel (3, 0) uses the modifier 8, all others 2.
+        const std::shared_ptr<uint16_t> texture = decodeBlock(GL_ETC1_RGB8_OES, InternalPixelFormat::RGB,
+            { 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00 });
+        REQUIRE(texture.get()[0] == 0xf800);
+        REQUIRE(texture.get()[1] == 0xf800);
+        REQUIRE(texture.get()[2] == 0x0000);
+        REQUIRE(texture.get()[3] == 0x0841);
+        REQUIRE(texture.get()[12] == 0xf800);
+        REQUIRE(texture.get()[15] == 0x0000);
+    }
+
+    SECTION("Individual mode with horizontal sub blocks")
+    {
+        // Same as above but the flip bit is set
+        const std::shared_ptr<uint16_t> texture = decodeBlock(GL_ETC1_RGB8_OES, InternalPixelFormat::RGB,
+            { 0xf0, 0x00, 0x00, 0x01, 0x00, 0x00, 0x10, 0x00 });
+        REQUIRE(texture.get()[0] == 0xf800);
+        REQUIRE(texture.get()[3] == 0xf841);
+        REQUIRE(texture.get()[4] == 0xf800);
+        REQUIRE(texture.get()[8] == 0x0000);
+        REQUIRE(texture.get()[15] == 0x0000);
+    }
+
+    SECTION("Differential mode")
+    {
+        // Base red 31, delta -1, all pixels use the modifier -8
+        const std::shared_ptr<uint16_t> texture = decodeBlock(GL_ETC1_RGB8_OES, InternalPixelFormat::RGB,
+            { 0xff, 0x00, 0x00, 0x02, 0xff, 0xff, 0xff, 0xff });
+        REQUIRE(texture.get()[0] == 0xf000);
+        REQUIRE(texture.get()[1] == 0xf000);
+        REQUIRE(texture.get()[2] == 0xe800);
+        REQUIRE(texture.get()[15] == 0xe800);
+    }
+}
+
+TEST_CASE("Decode clips the blocks to the region", "[CompressedImageDecoder]")
+{
+    // 2x2 blocks with the colors red, green, blue and white decoded into a 6x5 region at (1, 2) of an 8x8 texture
+    const std::vector<uint8_t> blocks {
+        0x00, 0xf8, 0x00, 0xf8, 0x00, 0x00, 0x00, 0x00,
+        0xe0, 0x07, 0xe0, 0x07, 0x00, 0x00, 0x00, 0x00,
+        0x1f, 0x00, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00
+    };
+    std::shared_ptr<uint16_t> texture = createTexture(64, 0x1234);
+    REQUIRE(CompressedImageDecoder::decode(texture, InternalPixelFormat::RGB, 8, 1, 2, 6, 5, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, blocks.data()));
+
+    for (std::size_t y = 0; y < 8; y++)
+    {
+        for (std::size_t x = 0; x < 8; x++)
+        {
+            const uint16_t texel = texture.get()[(y * 8) + x];
+            if ((x < 1) || (x >= 7) || (y < 2) || (y >= 7))
+            {
+                REQUIRE(texel == 0x1234);
+                continue;
+            }
+            const bool right = x >= 5;
+            const bool bottom = y >= 6;
+            const uint16_t expected = bottom ? (right ? 0xffff : 0x001f) : (right ? 0x07e0 : 0xf800);
+            REQUIRE(texel == expected);
+        }
+    }
+}
+
+TEST_CASE("Decode rescaled resamples a not power of two image", "[CompressedImageDecoder]")
+{
+    // A red 6x6 image (2x2 blocks) resampled into an 8x8 texture
+    const std::vector<uint8_t> red { 0x00, 0xf8, 0x00, 0xf8, 0x00, 0x00, 0x00, 0x00 };
+    std::vector<uint8_t> blocks {};
+    for (std::size_t i = 0; i < 4; i++)
+    {
+        blocks.insert(blocks.end(), red.begin(), red.end());
+    }
+    const ImageConverter converter {};
+    std::shared_ptr<uint16_t> texture = createTexture(64, 0x1234);
+    REQUIRE(CompressedImageDecoder::decodeRescaled(converter, texture, InternalPixelFormat::RGB, 8, 0, 0, 8, 8, 6, 6, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, blocks.data()));
+    for (std::size_t i = 0; i < 64; i++)
+    {
+        REQUIRE(texture.get()[i] == 0xf800);
+    }
+    REQUIRE_FALSE(CompressedImageDecoder::decodeRescaled(converter, texture, InternalPixelFormat::RGB, 8, 0, 0, 8, 8, 6, 6, GL_RGB, blocks.data()));
+}
+
+TEST_CASE("Copy blocks patches a region of a compressed image", "[CompressedImageDecoder]")
+{
+    // A 12x8 DXT1 image has 3x2 blocks. The region covers the last two blocks of the second row.
+    std::vector<uint8_t> image(48, 0);
+    const std::vector<uint8_t> region { 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2 };
+    CompressedImageDecoder::copyBlocks(image, 12, 4, 4, 8, 4, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, region.data());
+    for (std::size_t i = 0; i < image.size(); i++)
+    {
+        const uint8_t expected = (i < 32) ? 0 : ((i < 40) ? 1 : 2);
+        REQUIRE(image[i] == expected);
+    }
+}
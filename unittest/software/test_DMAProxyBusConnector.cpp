@@ -0,0 +1,264 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#define CATCH_CONFIG_MAIN
+#include "../3rdParty/catch.hpp"
+#include "DMAProxyBusConnector.hpp"
+#include "IDMAProxyDevice.hpp"
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <string>
+#include <sys/ioctl.h>
+#include <vector>
+
+#include "kernel/dma-proxy/files/include/dma-proxy.h"
+
+using namespace rr;
+
+namespace
+{
+
+// Mocks the char devices of the dma-proxy. A transfer snapshots the buffer when it is started and checks on
+// completion that the buffer was not changed while the DMA was reading it.
+class MockDMAProxyDevice : public IDMAProxyDevice
+{
+public:
+    static constexpr int TX_FD { 3 };
+    static constexpr int RX_FD { 4 };
+
+    struct Transfer
+    {
+        int32_t bufferId;
+        std::vector<uint8_t> data;
+    };
+
+    virtual int open(const char* path) override
+    {
+        return (std::string { path } == "/dev/dma_proxy_tx") ? TX_FD : RX_FD;
+    }
+
+    virtual void close(const int fd) override
+    {
+        closed.push_back(fd);
+    }
+
+    virtual channel_buffer* map(const int fd, const std::size_t count) override
+    {
+        std::unique_ptr<channel_buffer[]>& buffers = (fd == TX_FD) ? txBuffers : rxBuffers;
+        buffers.reset(new channel_buffer[count]);
+        return buffers.get();
+    }
+
+    virtual void unmap(channel_buffer*, const std::size_t) override
+    {
+    }
+
+    virtual int ioctl(const int fd, const unsigned long request, int32_t bufferId) override
+    {
+        channel_buffer& buffer = (fd == TX_FD) ? txBuffers[bufferId] : rxBuffers[bufferId];
+        std::deque<Transfer>& pending = (fd == TX_FD) ? txPending : rxPending;
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(&buffer.buffer[0]);
+        if (request == START_XFER)
+        {
+            for (const Transfer& t : pending)
+            {
+                REQUIRE(t.bufferId != bufferId); // A buffer must not be submitted twice
+            }
+            if (fd == RX_FD)
+            {
+                for (std::size_t i = 0; i < buffer.length; i++)
+                {
+                    reinterpret_cast<uint8_t*>(&buffer.buffer[0])[i] = static_cast<uint8_t>(i + 1);
+                }
+            }
+            pending.push_back({ bufferId, { data, data + buffer.length } });
+            buffer.status = channel_buffer::proxy_status::PROXY_BUSY;
+            startCount++;
+        }
+        if (request == FINISH_XFER)
+        {
+            REQUIRE(!pending.empty());
+            REQUIRE(pending.front().bufferId == bufferId); // The DMA completes in submission order
+            if (fd == TX_FD)
+            {
+                REQUIRE(std::memcmp(pending.front().data.data(), data, pending.front().data.size()) == 0);
+                txCompleted.push_back(pending.front());
+            }
+            pending.pop_front();
+            buffer.status = channel_buffer::proxy_status::PROXY_NO_ERROR;
+            finishCount++;
+        }
+        return 0;
+    }
+
+    std::unique_ptr<channel_buffer[]> txBuffers {};
+    std::unique_ptr<channel_buffer[]> rxBuffers {};
+    std::deque<Transfer> txPending {};
+    std::deque<Transfer> rxPending {};
+    std::vector<Transfer> txCompleted {};
+    std::vector<int> closed {};
+    std::size_t startCount { 0 };
+    std::size_t finishCount { 0 };
+};
+
+void fill(tcb::span<uint8_t> buffer, const std::size_t size, const uint8_t value)
+{
+    for (std::size_t i = 0; i < size; i++)
+    {
+        buffer[i] = static_cast<uint8_t>(value + i);
+    }
+}
+
+} // namespace
+
+TEST_CASE("Writes are submitted without waiting for the DMA", "[DMAProxyBusConnector]")
+{
+    MockDMAProxyDevice device {};
+    DMAProxyBusConnector connector { device };
+
+    fill(connector.requestWriteBuffer(0), 64, 0);
+    connector.writeData(0, 64, 0);
+    fill(connector.requestWriteBuffer(1), 32, 100);
+    connector.writeData(1, 32, 0);
+
+    REQUIRE(connector.getTransfersInFlight() == 2);
+    REQUIRE(device.startCount == 2);
+    REQUIRE(device.finishCount == 0);
+
+    connector.blockUntilTransferIsComplete();
+    REQUIRE(connector.getTransfersInFlight() == 0);
+    REQUIRE(device.txCompleted.size() == 2);
+    REQUIRE(device.txCompleted[0].bufferId == 0);
+    REQUIRE(device.txCompleted[0].data.size() == 64);
+    REQUIRE(device.txCompleted[1].bufferId == 1);
+    REQUIRE(device.txCompleted[1].data.size() == 32);
+    REQUIRE(device.txCompleted[1].data[0] == 100);
+}
+
+TEST_CASE("Requesting a buffer in flight completes its transfer", "[DMAProxyBusConnector]")
+{
+    MockDMAProxyDevice device {};
+    DMAProxyBusConnector connector { device };
+
+    fill(connector.requestWriteBuffer(0), 16, 0);
+    connector.writeData(0, 16, 0);
+    fill(connector.requestWriteBuffer(1), 16, 0);
+    connector.writeData(1, 16, 0);
+    fill(connector.requestWriteBuffer(2), 16, 0);
+    connector.writeData(2, 16, 0);
+
+    // Buffer 1 is still in flight. The transfers are completed in submission order up to buffer 1.
+    fill(connector.requestWriteBuffer(1), 16, 50);
+    REQUIRE(device.txCompleted.size() == 2);
+    REQUIRE(connector.getTransfersInFlight() == 1);
+
+    connector.writeData(1, 16, 0);
+    connector.blockUntilTransferIsComplete();
+    REQUIRE(device.txCompleted.size() == 4);
+    REQUIRE(device.txCompleted[3].bufferId == 1);
+    REQUIRE(device.txCompleted[3].data[0] == 50);
+}
+
+TEST_CASE("Writes with an offset are transferred from staging buffers", "[DMAProxyBusConnector]")
+{
+    MockDMAProxyDevice device {};
+    DMAProxyBusConnector connector { device };
+
+    fill(connector.requestWriteBuffer(0), 64, 0);
+    // More transfers than staging buffers are available
+    for (uint32_t offset = 1; offset <= 10; offset++)
+    {
+        connector.writeData(0, 16, offset);
+    }
+    connector.blockUntilTransferIsComplete();
+
+    REQUIRE(device.txCompleted.size() == 10);
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        REQUIRE(device.txCompleted[i].bufferId >= connector.getWriteBufferCount());
+        REQUIRE(device.txCompleted[i].bufferId < TX_BUFFER_COUNT);
+        REQUIRE(device.txCompleted[i].data.size() == 16);
+        REQUIRE(device.txCompleted[i].data[0] == i + 1);
+        REQUIRE(device.txCompleted[i].data[15] == i + 16);
+    }
+}
+
+TEST_CASE("Write buffers larger than a channel buffer are scattered across channel buffers", "[DMAProxyBusConnector]")
+{
+    MockDMAProxyDevice device {};
+    DMAProxyBusConnector connector { device, (3 * BUFFER_SIZE) - 100 };
+    REQUIRE(connector.queuesTransfers());
+    REQUIRE(connector.getWriteBufferCount() == (TX_BUFFER_COUNT - 4) / 3);
+    REQUIRE(connector.requestWriteBuffer(0).size() == (3 * BUFFER_SIZE) - 100);
+
+    const uint32_t size = (2 * BUFFER_SIZE) + 10;
+    tcb::span<uint8_t> buffer = connector.requestWriteBuffer(1);
+    fill(buffer, size + 2, 7);
+    connector.writeData(1, size, 2);
+    // The data is copied. The buffer can be changed while the transfer is in flight.
+    fill(connector.requestWriteBuffer(1), 16, 0);
+    connector.blockUntilTransferIsComplete();
+
+    REQUIRE(device.txCompleted.size() == 3);
+    REQUIRE(device.txCompleted[0].data.size() == BUFFER_SIZE);
+    REQUIRE(device.txCompleted[1].data.size() == BUFFER_SIZE);
+    REQUIRE(device.txCompleted[2].data.size() == 10);
+    for (std::size_t i = 0; i < device.txCompleted.size(); i++)
+    {
+        REQUIRE(device.txCompleted[i].data[0] == static_cast<uint8_t>(7 + 2 + (i * BUFFER_SIZE)));
+    }
+    REQUIRE(device.txCompleted[2].data[9] == static_cast<uint8_t>(7 + 2 + size - 1));
+}
+
+TEST_CASE("Read data is available when the read buffer is requested", "[DMAProxyBusConnector]")
+{
+    MockDMAProxyDevice device {};
+    DMAProxyBusConnector connector { device };
+
+    fill(connector.requestWriteBuffer(0), 16, 0);
+    connector.writeData(0, 16, 0);
+    connector.readData(0, 8);
+    connector.readData(1, 8);
+    REQUIRE(connector.getTransfersInFlight() == 3);
+
+    // The previously submitted write is completed before the read
+    tcb::span<uint8_t> data = connector.requestReadBuffer(0);
+    REQUIRE(device.txCompleted.size() == 1);
+    REQUIRE(connector.getTransfersInFlight() == 1);
+    REQUIRE(data[0] == 1);
+    REQUIRE(data[7] == 8);
+}
+
+TEST_CASE("Invalid transfers are rejected", "[DMAProxyBusConnector]")
+{
+    MockDMAProxyDevice device {};
+    {
+        DMAProxyBusConnector connector { device };
+
+        connector.writeData(connector.getWriteBufferCount(), 16, 0);
+        connector.writeData(0, 16, BUFFER_SIZE - 8);
+        connector.readData(connector.getReadBufferCount(), 16);
+        REQUIRE(connector.requestWriteBuffer(connector.getWriteBufferCount()).empty());
+        REQUIRE(device.startCount == 0);
+
+        connector.writeData(0, 16, 0);
+    }
+    // The destructor completes the transfers and closes the channels
+    REQUIRE(device.finishCount == 1);
+    REQUIRE(device.closed.size() == 2);
+}
@@ -0,0 +1,215 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#define CATCH_CONFIG_MAIN
+#include "../3rdParty/catch.hpp"
+#include "renderer/devicecapture/DeviceCapture.hpp"
+#include "renderer/devicecapture/DeviceCaptureReplay.hpp"
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace rr;
+using namespace rr::devicecapture;
+
+namespace
+{
+
+// Logs all calls with their data
+class MockDevice : public IDevice
+{
+public:
+    MockDevice(const std::size_t bufferCount, const std::size_t bufferSize)
+        : m_buffers(bufferCount, std::vector<uint8_t>(bufferSize))
+    {
+    }
+
+    void streamDisplayList(const uint8_t index, const uint32_t size) override
+    {
+        log.push_back("stream " + std::to_string(index) + " " + toString({ m_buffers[index].data(), size }));
+    }
+
+    bool writeToDeviceMemory(tcb::span<const uint8_t> data, const uint32_t addr) override
+    {
+        log.push_back("write " + std::to_string(addr) + " " + toString(data));
+        return true;
+    }
+
+    bool readFromDeviceMemory(tcb::span<uint8_t> data, const uint32_t addr) override
+    {
+        std::fill(data.begin(), data.end(), 0x5a);
+        log.push_back("read " + std::to_string(addr) + " " + std::to_string(data.size()));
+        return true;
+    }
+
+    void blockUntilDeviceIsIdle() override
+    {
+        log.push_back("idle");
+    }
+
+    tcb::span<uint8_t> requestDisplayListBuffer(const uint8_t index) override
+    {
+        return { m_buffers[index] };
+    }
+
+    uint8_t getDisplayListBufferCount() const override
+    {
+        return static_cast<uint8_t>(m_buffers.size());
+    }
+
+    std::vector<std::string> log {};
+
+private:
+    static std::string toString(const tcb::span<const uint8_t> data)
+    {
+        std::string str {};
+        for (const uint8_t d : data)
+        {
+            str += std::to_string(d) + ",";
+        }
+        return str;
+    }
+
+    std::vector<std::vector<uint8_t>> m_buffers;
+};
+
+void stream(IDevice& device, const uint8_t index, const std::vector<uint8_t>& displayList)
+{
+    std::copy(displayList.begin(), displayList.end(), device.requestDisplayListBuffer(index).begin());
+    device.streamDisplayList(index, displayList.size());
+}
+
+void capture(IDevice& device)
+{
+    const std::vector<uint8_t> page { 9, 8, 7, 6, 5 };
+    std::vector<uint8_t> readBuffer(12);
+    device.writeToDeviceMemory(page, 0x1000);
+    stream(device, 0, { 1, 2, 3, 4 });
+    stream(device, 1, { 5, 6, 7, 8, 9, 10, 11, 12 });
+    device.blockUntilDeviceIsIdle();
+    device.readFromDeviceMemory(readBuffer, 0x2000);
+    stream(device, 0, { 13, 14 });
+}
+
+} // namespace
+
+TEST_CASE("Forward and capture all calls", "[DeviceCapture]")
+{
+    MockDevice device { 2, 16 };
+    DeviceCapture deviceCapture { device };
+    std::stringstream file {};
+    REQUIRE(deviceCapture.start(file));
+    REQUIRE(deviceCapture.isCapturing());
+    REQUIRE(deviceCapture.getDisplayListBufferCount() == 2);
+    capture(deviceCapture);
+    deviceCapture.stop();
+    REQUIRE(!deviceCapture.isCapturing());
+
+    const std::vector<std::string> expected {
+        "write 4096 9,8,7,6,5,",
+        "stream 0 1,2,3,4,",
+        "stream 1 5,6,7,8,9,10,11,12,",
+        "idle",
+        "read 8192 12",
+        "stream 0 13,14,",
+    };
+    REQUIRE(device.log == expected);
+    REQUIRE(deviceCapture.getCapturedBytes() == file.str().size());
+
+    DeviceCaptureReplay replay {};
+    REQUIRE(replay.load(file));
+    REQUIRE(replay.getHeader().displayListBufferCount == 2);
+    REQUIRE(replay.getHeader().displayListBufferSize == 16);
+    REQUIRE(replay.getRecordCount() == 6);
+    const DeviceCaptureReplay::Statistics statistics = replay.getStatistics();
+    REQUIRE(statistics.displayLists == 3);
+    REQUIRE(statistics.displayListBytes == 14);
+    REQUIRE(statistics.uploads == 1);
+    REQUIRE(statistics.uploadBytes == 5);
+    REQUIRE(statistics.reads == 1);
+    REQUIRE(statistics.readBytes == 12);
+    REQUIRE(statistics.waits == 1);
+
+    MockDevice replayDevice { 2, 16 };
+    REQUIRE(replay.replay(replayDevice));
+    std::vector<std::string> expectedReplay { expected };
+    expectedReplay.push_back("idle");
+    REQUIRE(replayDevice.log == expectedReplay);
+}
+
+TEST_CASE("Calls are not captured when the capture is stopped", "[DeviceCapture]")
+{
+    MockDevice device { 2, 16 };
+    DeviceCapture deviceCapture { device };
+    std::stringstream file {};
+    capture(deviceCapture);
+    REQUIRE(device.log.size() == 6);
+    REQUIRE(file.str().empty());
+
+    REQUIRE(deviceCapture.start(file));
+    deviceCapture.blockUntilDeviceIsIdle();
+    deviceCapture.stop();
+    capture(deviceCapture);
+
+    DeviceCaptureReplay replay {};
+    REQUIRE(replay.load(file));
+    REQUIRE(replay.getRecordCount() == 1);
+    REQUIRE(replay.getStatistics().waits == 1);
+}
+
+TEST_CASE("Replay into a device with less display list buffers", "[DeviceCapture]")
+{
+    MockDevice device { 2, 16 };
+    DeviceCapture deviceCapture { device };
+    std::stringstream file {};
+    REQUIRE(deviceCapture.start(file));
+    capture(deviceCapture);
+    deviceCapture.stop();
+
+    DeviceCaptureReplay replay {};
+    REQUIRE(replay.load(file));
+    MockDevice replayDevice { 1, 16 };
+    REQUIRE(replay.replay(replayDevice));
+    REQUIRE(replayDevice.log[2] == "stream 0 5,6,7,8,9,10,11,12,");
+
+    // The display list does not fit into the buffer
+    MockDevice smallDevice { 2, 4 };
+    REQUIRE(!replay.replay(smallDevice));
+}
+
+TEST_CASE("Reject invalid captures", "[DeviceCapture]")
+{
+    MockDevice device { 2, 16 };
+    DeviceCapture deviceCapture { device };
+    std::stringstream file {};
+    REQUIRE(deviceCapture.start(file));
+    capture(deviceCapture);
+    deviceCapture.stop();
+    const std::string data = file.str();
+
+    DeviceCaptureReplay replay {};
+    std::stringstream truncated { data.substr(0, data.size() - 1) };
+    REQUIRE(!replay.load(truncated));
+
+    std::string wrongMagic { data };
+    wrongMagic[0] = 'X';
+    std::stringstream wrongMagicFile { wrongMagic };
+    REQUIRE(!replay.load(wrongMagicFile));
+
+    std::stringstream empty {};
+    REQUIRE(!replay.load(empty));
+}
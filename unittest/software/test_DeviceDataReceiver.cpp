@@ -0,0 +1,100 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#define CATCH_CONFIG_MAIN
+#include "../3rdParty/catch.hpp"
+#include "MemoryDevice.hpp"
+#include "renderer/devicedatauploader/DeviceDataReceiver.hpp"
+#include "renderer/devicedatauploader/DeviceDataUploader.hpp"
+#include <numeric>
+#include <vector>
+
+using namespace rr;
+using namespace rr::devicedatauploader;
+
+TEST_CASE("The receiver provides a write buffer for each display list plus one for memory transfers", "[DeviceDataReceiver]")
+{
+    MemoryDevice device { 3, 1000 };
+    DeviceDataReceiver receiver { device, 2, 256 };
+    CHECK(receiver.getWriteBufferCount() == 4);
+    CHECK(receiver.requestWriteBuffer(0).size() == 1000 + sizeof(Command));
+    CHECK(receiver.getReadBufferCount() == 2);
+    CHECK(receiver.requestReadBuffer(1).size() == 256);
+    CHECK(receiver.requestWriteBuffer(4).empty());
+
+    DeviceDataUploader uploader { receiver };
+    CHECK(uploader.getDisplayListBufferCount() == 3);
+    CHECK(uploader.requestDisplayListBuffer(0).size() == 1000);
+}
+
+TEST_CASE("Display lists are streamed into the display list buffer of the device", "[DeviceDataReceiver]")
+{
+    MemoryDevice device {};
+    DeviceDataReceiver receiver { device };
+    DeviceDataUploader uploader { receiver };
+
+    for (uint8_t index = 0; index < 2; index++)
+    {
+        tcb::span<uint8_t> displayList = uploader.requestDisplayListBuffer(index);
+        std::iota(displayList.begin(), displayList.begin() + 128, static_cast<uint8_t>(index * 10));
+        uploader.streamDisplayList(index, 128);
+    }
+
+    REQUIRE(device.streamed.size() == 2);
+    for (uint8_t index = 0; index < 2; index++)
+    {
+        std::vector<uint8_t> expected(128);
+        std::iota(expected.begin(), expected.end(), static_cast<uint8_t>(index * 10));
+        CHECK(device.streamedIndices[index] == index);
+        CHECK(device.streamed[index] == expected);
+    }
+}
+
+TEST_CASE("Short display lists are padded to the minimum transfer size", "[DeviceDataReceiver]")
+{
+    MemoryDevice device {};
+    DeviceDataReceiver receiver { device };
+    DeviceDataUploader uploader { receiver };
+
+    uploader.requestDisplayListBuffer(0)[0] = 0x42;
+    uploader.streamDisplayList(0, 1);
+
+    REQUIRE(device.streamed.size() == 1);
+    REQUIRE(device.streamed[0].size() == DEVICE_MIN_TRANSFER_SIZE);
+    CHECK(device.streamed[0][0] == 0x42);
+    CHECK(device.streamed[0][1] == 0);
+}
+
+TEST_CASE("Stored data can be loaded again", "[DeviceDataReceiver]")
+{
+    MemoryDevice device {};
+    DeviceDataReceiver receiver { device, 2, 256 };
+    DeviceDataUploader uploader { receiver };
+
+    // Smaller than the minimum transfer size and larger than a read buffer
+    for (const std::size_t size : { std::size_t { 5 }, std::size_t { 1000 } })
+    {
+        std::vector<uint8_t> data(size);
+        std::iota(data.begin(), data.end(), static_cast<uint8_t>(size));
+        CHECK(uploader.writeToDeviceMemory(data, 4096 + 3));
+        CHECK(std::equal(data.begin(), data.end(), device.memory().begin() + 4096 + 3));
+
+        std::vector<uint8_t> loaded(size);
+        CHECK(uploader.readFromDeviceMemory(loaded, 4096 + 3));
+        CHECK(loaded == data);
+    }
+}
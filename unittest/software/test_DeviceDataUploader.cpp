@@ -0,0 +1,333 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#define CATCH_CONFIG_MAIN
+#include "../3rdParty/catch.hpp"
+#include "RenderConfigs.hpp"
+#include "renderer/Renderer.hpp"
+#include "renderer/devicedatauploader/DeviceDataUploader.hpp"
+#include <array>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <vector>
+
+using namespace rr;
+using namespace rr::devicedatauploader;
+
+namespace
+{
+
+// Emulates the FrameStreamingCore behind a bus. LOAD commands queue the requested device memory, which is
+// returned by the next reads. Like a DMA queue, the read data is only delivered when the read buffer is requested.
+// Without a queue, a transfer is ongoing until blockUntilTransferIsComplete() is called.
+class MockBusConnector : public IBusConnector
+{
+public:
+    MockBusConnector(const std::size_t readBufferCount, const std::size_t readBufferSize)
+        : m_readBuffers(readBufferCount, std::vector<uint8_t>(readBufferSize))
+        , m_pendingReads(readBufferCount, 0)
+        , m_memory(1024 * 1024)
+    {
+        for (std::vector<uint8_t>& writeBuffer : m_writeBuffers)
+        {
+            writeBuffer.resize(64 * 1024);
+        }
+        for (std::size_t i = 0; i < m_memory.size(); i++)
+        {
+            m_memory[i] = static_cast<uint8_t>((i * 7) ^ (i >> 8));
+        }
+    }
+
+    virtual void writeData(const uint8_t index, const uint32_t size, const uint32_t offset) override
+    {
+        Command cmd;
+        std::memcpy(&cmd, m_writeBuffers[index].data() + offset, sizeof(cmd));
+        if ((cmd.op & OP_MASK) == OP_LOAD)
+        {
+            const uint32_t addr = cmd.addr - RenderConfig::GRAM_MEMORY_LOC;
+            const uint32_t loadSize = cmd.op & IMM_MASK;
+            REQUIRE((loadSize % DEVICE_MIN_TRANSFER_SIZE) == 0);
+            m_response.insert(m_response.end(), m_memory.begin() + addr, m_memory.begin() + addr + loadSize);
+            loads++;
+        }
+        if ((cmd.op & OP_MASK) == OP_STREAM)
+        {
+            streams++;
+        }
+        REQUIRE(size >= sizeof(Command));
+        m_busy = !queued;
+    }
+
+    virtual void readData(const uint8_t index, const uint32_t size) override
+    {
+        REQUIRE(m_pendingReads[index] == 0);
+        REQUIRE(size <= m_response.size());
+        m_pendingReads[index] = size;
+        m_readOrder.push_back(index);
+        maxReadsInFlight = (std::max)(maxReadsInFlight, readsInFlight());
+        m_busy = !queued;
+    }
+
+    virtual void blockUntilTransferIsComplete() override
+    {
+        idleWaits++;
+        for (std::size_t i = 0; i < m_pendingReads.size(); i++)
+        {
+            completeRead(i);
+        }
+        m_busy = false;
+    }
+
+    virtual tcb::span<uint8_t> requestWriteBuffer(const uint8_t index) override
+    {
+        // Without a queue, the buffers are handed out without waiting for the ongoing transfer
+        REQUIRE(!m_busy);
+        return { m_writeBuffers[index] };
+    }
+
+    virtual tcb::span<uint8_t> requestReadBuffer(const uint8_t index) override
+    {
+        REQUIRE(!m_busy);
+        completeRead(index);
+        return { m_readBuffers[index] };
+    }
+
+    virtual uint8_t getWriteBufferCount() const override { return m_writeBuffers.size(); }
+    virtual uint8_t getReadBufferCount() const override { return m_readBuffers.size(); }
+    virtual bool queuesTransfers() const override { return queued; }
+
+    const std::vector<uint8_t>& memory() const { return m_memory; }
+
+    std::size_t loads { 0 };
+    std::size_t streams { 0 };
+    std::size_t maxReadsInFlight { 0 };
+    std::size_t idleWaits { 0 };
+    bool queued { true };
+
+private:
+    std::size_t readsInFlight() const
+    {
+        std::size_t count = 0;
+        for (const std::size_t size : m_pendingReads)
+        {
+            count += (size != 0) ? 1 : 0;
+        }
+        return count;
+    }
+
+    void completeRead(const std::size_t index)
+    {
+        // The responses are delivered in the order of the reads. Complete older reads first.
+        if (m_pendingReads[index] == 0)
+        {
+            return;
+        }
+        while (m_pendingReads[index] != 0)
+        {
+            const std::size_t oldest = m_readOrder.front();
+            const std::size_t size = m_pendingReads[oldest];
+            std::copy(m_response.begin(), m_response.begin() + size, m_readBuffers[oldest].begin());
+            m_response.erase(m_response.begin(), m_response.begin() + size);
+            m_pendingReads[oldest] = 0;
+            m_readOrder.pop_front();
+        }
+    }
+
+    std::array<std::vector<uint8_t>, 4> m_writeBuffers {};
+    std::vector<std::vector<uint8_t>> m_readBuffers;
+    std::vector<std::size_t> m_pendingReads;
+    std::deque<std::size_t> m_readOrder {};
+    std::deque<uint8_t> m_response {};
+    std::vector<uint8_t> m_memory;
+    bool m_busy { false };
+};
+
+} // namespace
+
+TEST_CASE("Read data which spans several chunks", "[DeviceDataUploader]")
+{
+    for (const std::size_t readBufferCount : { 1, 2, 3 })
+    {
+        MockBusConnector bus { readBufferCount, 128 };
+        DeviceDataUploader ddu { bus };
+        std::vector<uint8_t> data(1000);
+        REQUIRE(ddu.readFromDeviceMemory(data, 4096));
+        REQUIRE(std::equal(data.begin(), data.end(), bus.memory().begin() + 4096));
+        REQUIRE(bus.loads == 8); // 1000 bytes aligned to 1024 bytes are loaded in 128 byte chunks
+        REQUIRE(bus.maxReadsInFlight == (std::min)(readBufferCount, std::size_t { 2 }));
+    }
+}
+
+TEST_CASE("Read does not write behind the end of the data", "[DeviceDataUploader]")
+{
+    MockBusConnector bus { 2, 128 };
+    DeviceDataUploader ddu { bus };
+    std::vector<uint8_t> data(200, 0xaa);
+    REQUIRE(ddu.readFromDeviceMemory({ data.data(), 130 }, 64));
+    REQUIRE(std::equal(data.begin(), data.begin() + 130, bus.memory().begin() + 64));
+    REQUIRE(std::all_of(data.begin() + 130, data.end(), [](const uint8_t v)
+        { return v == 0xaa; }));
+}
+
+TEST_CASE("Read from an address which is not aligned to the transfer size", "[DeviceDataUploader]")
+{
+    for (const uint32_t addr : { 1u, 63u, 100u, 130u })
+    {
+        MockBusConnector bus { 2, 128 };
+        DeviceDataUploader ddu { bus };
+        std::vector<uint8_t> data(300, 0xaa);
+        REQUIRE(ddu.readFromDeviceMemory({ data.data(), 250 }, addr));
+        REQUIRE(std::equal(data.begin(), data.begin() + 250, bus.memory().begin() + addr));
+        REQUIRE(std::all_of(data.begin() + 250, data.end(), [](const uint8_t v)
+            { return v == 0xaa; }));
+    }
+}
+
+TEST_CASE("Asynchronous reads are progressed by streamed display lists", "[DeviceDataUploader]")
+{
+    MockBusConnector bus { 2, 128 };
+    DeviceDataUploader ddu { bus };
+    std::vector<uint8_t> data0(256);
+    std::vector<uint8_t> data1(128);
+    const DeviceDataUploader::ReadHandle handle0 = ddu.readFromDeviceMemoryAsync(data0, 0);
+    const DeviceDataUploader::ReadHandle handle1 = ddu.readFromDeviceMemoryAsync(data1, 1024);
+    REQUIRE_FALSE(ddu.isReadComplete(handle0));
+    REQUIRE_FALSE(ddu.isReadComplete(handle1));
+    REQUIRE(bus.loads == 0);
+
+    // Every display list requests one chunk and copies the previous one
+    ddu.streamDisplayList(0, 64);
+    ddu.streamDisplayList(1, 64);
+    REQUIRE(bus.loads == 2);
+    REQUIRE_FALSE(ddu.isReadComplete(handle0));
+    ddu.streamDisplayList(0, 64);
+    REQUIRE(ddu.isReadComplete(handle0));
+    REQUIRE_FALSE(ddu.isReadComplete(handle1));
+    REQUIRE(std::equal(data0.begin(), data0.end(), bus.memory().begin()));
+
+    ddu.waitForRead(handle1);
+    REQUIRE(ddu.isReadComplete(handle1));
+    REQUIRE(std::equal(data1.begin(), data1.end(), bus.memory().begin() + 1024));
+    REQUIRE(bus.streams == 3);
+    REQUIRE(bus.loads == 3);
+    REQUIRE(bus.idleWaits == 0);
+}
+
+TEST_CASE("A readback through the renderer overlaps with the rendering of the next frames", "[DeviceDataUploader]")
+{
+    MockBusConnector bus { 2, 128 };
+    DeviceDataUploader ddu { bus };
+    std::unique_ptr<Renderer> renderer = std::make_unique<Renderer>(ddu);
+    std::vector<uint8_t> data(1000);
+    const IDevice::ReadHandle handle = renderer->readFromDeviceMemoryAsync(data, 4096);
+    REQUIRE_FALSE(renderer->isReadComplete(handle));
+
+    std::size_t frames = 0;
+    while (!renderer->isReadComplete(handle) && (frames < 20))
+    {
+        renderer->swapDisplayList();
+        frames++;
+    }
+    // 1000 bytes aligned to 1024 bytes are loaded in 8 chunks of 128 bytes, one per frame. The last chunk is copied in the next frame.
+    REQUIRE(frames == 9);
+    REQUIRE(std::equal(data.begin(), data.end(), bus.memory().begin() + 4096));
+    REQUIRE(bus.loads == 8);
+    REQUIRE(bus.idleWaits == 0);
+}
+
+TEST_CASE("Reads without load buffers or data complete immediately", "[DeviceDataUploader]")
+{
+    MockBusConnector bus { 0, 128 };
+    DeviceDataUploader ddu { bus };
+    std::vector<uint8_t> data(64);
+    REQUIRE(ddu.isReadComplete(ddu.readFromDeviceMemoryAsync(data, 0)));
+    REQUIRE(ddu.readFromDeviceMemory(data, 0));
+    REQUIRE(bus.loads == 0);
+
+    MockBusConnector bus2 { 2, 128 };
+    DeviceDataUploader ddu2 { bus2 };
+    REQUIRE(ddu2.isReadComplete(ddu2.readFromDeviceMemoryAsync({}, 0)));
+    REQUIRE(ddu2.readFromDeviceMemory({}, 0));
+    REQUIRE(bus2.loads == 0);
+}
+
+TEST_CASE("More reads than the queue holds are completed in order", "[DeviceDataUploader]")
+{
+    MockBusConnector bus { 2, 128 };
+    DeviceDataUploader ddu { bus };
+    std::array<std::vector<uint8_t>, 6> data {};
+    std::array<DeviceDataUploader::ReadHandle, 6> handles {};
+    for (std::size_t i = 0; i < data.size(); i++)
+    {
+        data[i].resize(192);
+        handles[i] = ddu.readFromDeviceMemoryAsync(data[i], i * 256);
+    }
+    ddu.waitForRead(handles.back());
+    for (std::size_t i = 0; i < data.size(); i++)
+    {
+        REQUIRE(ddu.isReadComplete(handles[i]));
+        REQUIRE(std::equal(data[i].begin(), data[i].end(), bus.memory().begin() + i * 256));
+    }
+}
+
+TEST_CASE("Reads wait for the bus on bus connectors which do not queue transfers", "[DeviceDataUploader]")
+{
+    for (const std::size_t readBufferCount : { 1, 2 })
+    {
+        MockBusConnector bus { readBufferCount, 128 };
+        bus.queued = false;
+        DeviceDataUploader ddu { bus };
+        ddu.streamDisplayList(0, 64);
+        std::vector<uint8_t> data(1000);
+        // The mock checks that no buffer is requested while a transfer is ongoing
+        REQUIRE(ddu.readFromDeviceMemory(data, 4096 + 5));
+        REQUIRE(std::equal(data.begin(), data.end(), bus.memory().begin() + 4096 + 5));
+        REQUIRE(bus.maxReadsInFlight == 1);
+    }
+}
+
+TEST_CASE("Asynchronous reads are not progressed by display lists on bus connectors which do not queue transfers", "[DeviceDataUploader]")
+{
+    MockBusConnector bus { 2, 128 };
+    bus.queued = false;
+    DeviceDataUploader ddu { bus };
+    std::vector<uint8_t> data(256);
+    const DeviceDataUploader::ReadHandle handle = ddu.readFromDeviceMemoryAsync(data, 0);
+    ddu.streamDisplayList(0, 64);
+    ddu.streamDisplayList(1, 64);
+    REQUIRE(bus.loads == 0);
+
+    ddu.waitForRead(handle);
+    REQUIRE(ddu.isReadComplete(handle));
+    REQUIRE(std::equal(data.begin(), data.end(), bus.memory().begin()));
+}
+
+TEST_CASE("Display lists are only streamed back to back on bus connectors which queue transfers", "[DeviceDataUploader]")
+{
+    MockBusConnector bus { 2, 128 };
+    DeviceDataUploader ddu { bus };
+    ddu.streamDisplayList(0, 64);
+    ddu.streamDisplayList(1, 64);
+    REQUIRE(bus.idleWaits == 0);
+
+    bus.queued = false;
+    ddu.streamDisplayList(0, 64);
+    ddu.streamDisplayList(1, 64);
+    REQUIRE(bus.idleWaits == 2);
+    REQUIRE(bus.streams == 4);
+}
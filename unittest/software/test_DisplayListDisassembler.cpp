@@ -0,0 +1,170 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#define CATCH_CONFIG_MAIN
+#include "../3rdParty/catch.hpp"
+#include "renderer/commands/CommandVariant.hpp"
+#include "renderer/displaylist/DisplayList.hpp"
+#include "renderer/displaylist/DisplayListDisassembler.hpp"
+#include "renderer/displaylist/RIXDisplayListAssembler.hpp"
+#include <vector>
+
+using namespace rr;
+using namespace rr::displaylist;
+
+// Helper to build a display list with a mix of commands
+class TestDisplayList
+{
+public:
+    TestDisplayList()
+        : m_buffer(4096)
+    {
+        m_displayList.setBuffer({ m_buffer.data(), m_buffer.size() });
+    }
+
+    template <typename TCmd>
+    void add(const TCmd& cmd)
+    {
+        REQUIRE(m_assembler.addCommand(cmd));
+    }
+
+    DisplayList& get()
+    {
+        m_displayList.resetGet();
+        return m_displayList;
+    }
+
+    bool isInBuffer(const void* ptr) const
+    {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(ptr);
+        return (p >= m_buffer.data()) && (p < (m_buffer.data() + m_buffer.size()));
+    }
+
+private:
+    std::vector<uint8_t> m_buffer;
+    DisplayList m_displayList {};
+    RIXDisplayListAssembler<DisplayList> m_assembler { m_displayList };
+};
+
+TEST_CASE("Visit decodes all commands in order", "[DisplayListDisassembler]")
+{
+    TestDisplayList dl;
+    const std::array<std::size_t, 3> pages { 1, 2, 3 };
+    dl.add(NopCmd {});
+    dl.add(WriteRegisterCmd { ColorBufferAddrReg { 0x1000 } });
+    dl.add(TextureStreamCmd { 1, pages });
+    dl.add(DrawNewElementCmd {});
+
+    DisplayListDisassembler disassembler { dl.get() };
+    std::vector<std::size_t> indices;
+    while (disassembler.hasNextCommand())
+    {
+        const bool ret = disassembler.visitNextCommand([&indices](const auto& cmd)
+            {
+                indices.push_back(CommandVariant { cmd }.index());
+                return true; });
+        REQUIRE(ret);
+    }
+
+    REQUIRE(indices.size() == 4);
+    REQUIRE(indices[0] == CommandVariant { NopCmd {} }.index());
+    REQUIRE(indices[1] == CommandVariant { WriteRegisterCmd {} }.index());
+    REQUIRE(indices[2] == CommandVariant { TextureStreamCmd {} }.index());
+    REQUIRE(indices[3] == CommandVariant { DrawNewElementCmd {} }.index());
+}
+
+TEST_CASE("Visit and getNextCommand decode the same commands", "[DisplayListDisassembler]")
+{
+    TestDisplayList dl;
+    const std::array<std::size_t, 2> pages { 5, 7 };
+    dl.add(WriteRegisterCmd { DepthBufferAddrReg { 0x2000 } });
+    dl.add(TextureStreamCmd { 0, pages });
+    dl.add(NopCmd {});
+
+    DisplayListDisassembler variantDisassembler { dl.get() };
+    std::vector<CommandVariant> expected;
+    while (variantDisassembler.hasNextCommand())
+    {
+        expected.push_back(variantDisassembler.getNextCommand());
+    }
+
+    DisplayListDisassembler visitDisassembler { dl.get() };
+    std::size_t i = 0;
+    while (visitDisassembler.hasNextCommand())
+    {
+        visitDisassembler.visitNextCommand([&](const auto& cmd)
+            {
+                using T = std::decay_t<decltype(cmd)>;
+                REQUIRE(std::holds_alternative<T>(expected[i]));
+                REQUIRE(std::get<T>(expected[i]).command() == cmd.command());
+                REQUIRE(std::get<T>(expected[i]).payload().size() == cmd.payload().size());
+                i++;
+                return true; });
+    }
+    REQUIRE(i == expected.size());
+}
+
+TEST_CASE("Visit passes payloads which point into the display list", "[DisplayListDisassembler]")
+{
+    TestDisplayList dl;
+    const std::array<std::size_t, 3> pages { 1, 2, 3 };
+    dl.add(TextureStreamCmd { 1, pages });
+    dl.add(WriteRegisterCmd { ColorBufferAddrReg { 0x1000 } });
+
+    DisplayListDisassembler disassembler { dl.get() };
+    while (disassembler.hasNextCommand())
+    {
+        disassembler.visitNextCommand([&dl](const auto& cmd)
+            {
+                using T = std::decay_t<decltype(cmd)>;
+                if constexpr (std::is_same_v<T, TextureStreamCmd>)
+                {
+                    REQUIRE(cmd.getTmu() == 1);
+                    REQUIRE(cmd.payload().size() == 3);
+                    REQUIRE(dl.isInBuffer(cmd.payload().data()));
+                    REQUIRE(cmd.payload()[2] == RenderConfig::GRAM_MEMORY_LOC + 3 * RenderConfig::TEXTURE_PAGE_SIZE);
+                }
+                if constexpr (std::is_same_v<T, WriteRegisterCmd>)
+                {
+                    REQUIRE(dl.isInBuffer(cmd.payload().data()));
+                    REQUIRE(std::get<ColorBufferAddrReg>(cmd.getRegister()).getValue() == 0x1000);
+                }
+                return true; });
+    }
+}
+
+TEST_CASE("Visit skips unknown commands", "[DisplayListDisassembler]")
+{
+    std::array<uint8_t, 8> buffer {};
+    const uint32_t unknownOp = 0x7000'0000;
+    std::memcpy(buffer.data(), &unknownOp, sizeof(unknownOp));
+    DisplayList displayList {};
+    displayList.setBuffer(buffer);
+    displayList.setCurrentSize(buffer.size());
+
+    DisplayListDisassembler disassembler { displayList };
+    std::size_t visited = 0;
+    const auto visitor = [&visited](const auto&)
+    {
+        visited++;
+        return true;
+    };
+    REQUIRE_FALSE(disassembler.visitNextCommand(visitor));
+    REQUIRE(disassembler.visitNextCommand(visitor)); // Second word is a NOP
+    REQUIRE_FALSE(disassembler.hasNextCommand());
+    REQUIRE(visited == 1);
+}
@@ -0,0 +1,115 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#define CATCH_CONFIG_MAIN
+#include "../3rdParty/catch.hpp"
+#include "renderer/displaylist/DisplayListRingBuffer.hpp"
+
+using namespace rr::displaylist;
+
+TEST_CASE("Ring with depth two behaves like a double buffer", "[DisplayListRingBuffer]")
+{
+    std::array<int, 2> lists { 0, 1 };
+    DisplayListRingBuffer<int, 2> ring { lists };
+    ring.setDepth(2, 1);
+
+    REQUIRE(ring.empty());
+    REQUIRE_FALSE(ring.full());
+    REQUIRE(ring.getBack() == 0);
+
+    ring.commit();
+    REQUIRE(ring.full());
+    REQUIRE(ring.getFront() == 0);
+    REQUIRE(ring.getBack() == 1);
+
+    ring.release();
+    REQUIRE(ring.empty());
+    ring.commit();
+    REQUIRE(ring.getFront() == 1);
+    REQUIRE(ring.getBack() == 0);
+}
+
+TEST_CASE("Ring keeps the commit order of the lists in flight", "[DisplayListRingBuffer]")
+{
+    std::array<int, 4> lists { 0, 1, 2, 3 };
+    DisplayListRingBuffer<int, 4> ring { lists };
+    ring.setDepth(4, 3);
+
+    for (int i = 0; i < 10; i++)
+    {
+        REQUIRE(ring.getBack() == (i % 4));
+        ring.commit();
+        if (ring.full())
+        {
+            REQUIRE(ring.getInFlight() == 3);
+            REQUIRE(ring.getFront() == ((i - 2) % 4));
+            ring.release();
+        }
+    }
+    REQUIRE(ring.getPeakInFlight() == 3);
+}
+
+TEST_CASE("Ring bounds the frames in flight", "[DisplayListRingBuffer]")
+{
+    std::array<int, 4> lists { 0, 1, 2, 3 };
+    DisplayListRingBuffer<int, 4> ring { lists };
+
+    ring.setDepth(4, 2);
+    REQUIRE(ring.getMaxInFlight() == 2);
+    ring.commit();
+    REQUIRE_FALSE(ring.full());
+    ring.commit();
+    REQUIRE(ring.full());
+    REQUIRE(ring.getFrontIndex() == 0);
+    REQUIRE(ring.getBackIndex() == 2);
+
+    // The maximum is clamped to keep one list free for the assembly
+    ring.setDepth(3, 5);
+    REQUIRE(ring.getDepth() == 3);
+    REQUIRE(ring.getMaxInFlight() == 2);
+
+    // The depth is clamped to the available lists
+    ring.setDepth(8, 1);
+    REQUIRE(ring.getDepth() == 4);
+    REQUIRE(ring.getMaxInFlight() == 1);
+}
+
+TEST_CASE("Ring with a single list keeps the back in flight until it is released", "[DisplayListRingBuffer]")
+{
+    std::array<int, 4> lists { 0, 1, 2, 3 };
+    DisplayListRingBuffer<int, 4> ring { lists };
+    ring.setDepth(1, 3);
+    REQUIRE(ring.getDepth() == 1);
+    REQUIRE(ring.getMaxInFlight() == 1);
+
+    REQUIRE_FALSE(ring.backInFlight());
+    ring.commit();
+    REQUIRE(ring.full());
+    REQUIRE(ring.backInFlight());
+    REQUIRE(ring.getFront() == 0);
+    REQUIRE(ring.getBack() == 0);
+
+    ring.release();
+    REQUIRE(ring.empty());
+    REQUIRE_FALSE(ring.backInFlight());
+    REQUIRE(ring.getBack() == 0);
+
+    // Two lists never keep the back in flight
+    ring.setDepth(2, 1);
+    ring.commit();
+    REQUIRE_FALSE(ring.backInFlight());
+}
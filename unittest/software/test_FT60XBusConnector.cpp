@@ -0,0 +1,287 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#define CATCH_CONFIG_MAIN
+#include "../3rdParty/catch.hpp"
+#include "FT60XBusConnector.hpp"
+#include "IFT60XDevice.hpp"
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <vector>
+
+using namespace rr;
+
+namespace
+{
+
+// Mocks the FTD3XX library. A write snapshots the data when it is queued and checks on completion that the
+// buffer was not changed while the USB was reading it. A read fills the buffer when it is completed.
+class MockFT60XDevice : public IFT60XDevice
+{
+public:
+    struct Transfer
+    {
+        bool read;
+        std::size_t slot;
+        uint8_t* data;
+        std::vector<uint8_t> snapshot;
+    };
+
+    virtual bool open() override
+    {
+        openCount++;
+        return openResult;
+    }
+
+    virtual void close() override
+    {
+        REQUIRE(pending.empty()); // Transfers are completed before the device is closed
+        closeCount++;
+    }
+
+    virtual bool writePipeAsync(const std::size_t slot, const uint8_t* data, const uint32_t size) override
+    {
+        return queue(false, slot, const_cast<uint8_t*>(data), size);
+    }
+
+    virtual bool readPipeAsync(const std::size_t slot, uint8_t* data, const uint32_t size) override
+    {
+        return queue(true, slot, data, size);
+    }
+
+    virtual int64_t waitForTransfer(const std::size_t slot) override
+    {
+        REQUIRE(!pending.empty());
+        REQUIRE(pending.front().slot == slot); // The transfers are completed in submission order
+        Transfer& transfer = pending.front();
+        if (transfer.read)
+        {
+            for (std::size_t i = 0; i < transfer.snapshot.size(); i++)
+            {
+                transfer.data[i] = static_cast<uint8_t>(i + 1);
+            }
+        }
+        else
+        {
+            REQUIRE(std::memcmp(transfer.snapshot.data(), transfer.data, transfer.snapshot.size()) == 0);
+        }
+        const int64_t size = transferredSize.value_or(transfer.snapshot.size());
+        completed.push_back(std::move(transfer));
+        pending.pop_front();
+        return size;
+    }
+
+    bool openResult { true };
+    bool submitResult { true };
+    std::optional<int64_t> transferredSize {};
+    std::deque<Transfer> pending {};
+    std::vector<Transfer> completed {};
+    std::size_t openCount { 0 };
+    std::size_t closeCount { 0 };
+
+private:
+    bool queue(const bool read, const std::size_t slot, uint8_t* data, const uint32_t size)
+    {
+        if (!submitResult)
+        {
+            return false;
+        }
+        REQUIRE(slot < MAX_TRANSFERS_IN_FLIGHT);
+        REQUIRE(pending.size() < MAX_TRANSFERS_IN_FLIGHT);
+        for (const Transfer& t : pending)
+        {
+            REQUIRE(t.slot != slot); // A slot must not be used twice
+        }
+        pending.push_back({ read, slot, data, { data, data + size } });
+        return true;
+    }
+};
+
+void fill(tcb::span<uint8_t> buffer, const std::size_t size, const uint8_t value)
+{
+    for (std::size_t i = 0; i < size; i++)
+    {
+        buffer[i] = static_cast<uint8_t>(value + i);
+    }
+}
+
+} // namespace
+
+TEST_CASE("Writes are queued without waiting for the USB", "[FT60XBusConnector]")
+{
+    MockFT60XDevice device {};
+    auto busConnector = std::make_unique<FT60XBusConnector>(device);
+    FT60XBusConnector& connector = *busConnector;
+    CHECK(device.openCount == 1);
+
+    fill(connector.requestWriteBuffer(0), 64, 0);
+    connector.writeData(0, 64, 0);
+    fill(connector.requestWriteBuffer(1), 32, 100);
+    connector.writeData(1, 32, 0);
+
+    CHECK(device.pending.size() == 2);
+    CHECK(device.completed.empty());
+    CHECK(connector.getTransfersInFlight() == 2);
+    CHECK(!device.pending[0].read);
+    CHECK(device.pending[0].snapshot.size() == 64);
+    CHECK(device.pending[0].snapshot[1] == 1);
+    CHECK(device.pending[1].snapshot.size() == 32);
+    CHECK(device.pending[1].snapshot[1] == 101);
+
+    connector.blockUntilTransferIsComplete();
+    CHECK(device.pending.empty());
+    CHECK(device.completed.size() == 2);
+    CHECK(connector.getTransfersInFlight() == 0);
+}
+
+TEST_CASE("Writes with an offset start at the offset", "[FT60XBusConnector]")
+{
+    MockFT60XDevice device {};
+    auto busConnector = std::make_unique<FT60XBusConnector>(device);
+    FT60XBusConnector& connector = *busConnector;
+
+    const tcb::span<uint8_t> buffer = connector.requestWriteBuffer(0);
+    fill(buffer, 64, 0);
+    connector.writeData(0, 16, 32);
+
+    REQUIRE(device.pending.size() == 1);
+    CHECK(device.pending[0].data == buffer.data() + 32);
+    CHECK(device.pending[0].snapshot[0] == 32);
+}
+
+TEST_CASE("The oldest transfer is completed when all slots are in use", "[FT60XBusConnector]")
+{
+    MockFT60XDevice device {};
+    auto busConnector = std::make_unique<FT60XBusConnector>(device);
+    FT60XBusConnector& connector = *busConnector;
+
+    for (uint8_t i = 0; i < IFT60XDevice::MAX_TRANSFERS_IN_FLIGHT + 2; i++)
+    {
+        fill(connector.requestWriteBuffer(i), 16, i);
+        connector.writeData(i, 16, 0);
+        CHECK(connector.getTransfersInFlight() <= IFT60XDevice::MAX_TRANSFERS_IN_FLIGHT);
+    }
+
+    CHECK(device.pending.size() == IFT60XDevice::MAX_TRANSFERS_IN_FLIGHT);
+    REQUIRE(device.completed.size() == 2);
+    CHECK(device.completed[0].snapshot[0] == 0);
+    CHECK(device.completed[1].snapshot[0] == 1);
+}
+
+TEST_CASE("Requesting a buffer in flight completes its transfer", "[FT60XBusConnector]")
+{
+    MockFT60XDevice device {};
+    auto busConnector = std::make_unique<FT60XBusConnector>(device);
+    FT60XBusConnector& connector = *busConnector;
+
+    fill(connector.requestWriteBuffer(0), 64, 0);
+    connector.writeData(0, 64, 0);
+    fill(connector.requestWriteBuffer(1), 64, 10);
+    connector.writeData(1, 64, 0);
+    fill(connector.requestWriteBuffer(2), 64, 20);
+    connector.writeData(2, 64, 0);
+
+    // The mock checks that the buffer is not changed before its transfer is complete
+    fill(connector.requestWriteBuffer(1), 64, 50);
+    CHECK(device.completed.size() == 2);
+    CHECK(device.pending.size() == 1);
+}
+
+TEST_CASE("Read data is available when the read buffer is requested", "[FT60XBusConnector]")
+{
+    MockFT60XDevice device {};
+    auto busConnector = std::make_unique<FT60XBusConnector>(device);
+    FT60XBusConnector& connector = *busConnector;
+
+    fill(connector.requestWriteBuffer(0), 64, 0);
+    connector.writeData(0, 64, 0);
+    connector.readData(0, 16);
+    REQUIRE(device.pending.size() == 2);
+    CHECK(device.pending[1].read);
+
+    const tcb::span<uint8_t> data = connector.requestReadBuffer(0);
+    CHECK(device.pending.empty());
+    REQUIRE(device.completed.size() == 2);
+    for (std::size_t i = 0; i < 16; i++)
+    {
+        CHECK(data[i] == i + 1);
+    }
+}
+
+TEST_CASE("Invalid transfers are rejected", "[FT60XBusConnector]")
+{
+    MockFT60XDevice device {};
+    auto busConnector = std::make_unique<FT60XBusConnector>(device);
+    FT60XBusConnector& connector = *busConnector;
+
+    connector.writeData(connector.getWriteBufferCount(), 16, 0);
+    connector.writeData(0, connector.requestWriteBuffer(0).size(), 1);
+    connector.readData(connector.getReadBufferCount(), 16);
+    connector.readData(0, connector.requestReadBuffer(0).size() + 1);
+    CHECK(connector.requestWriteBuffer(connector.getWriteBufferCount()).empty());
+    CHECK(connector.requestReadBuffer(connector.getReadBufferCount()).empty());
+
+    CHECK(device.pending.empty());
+    CHECK(connector.getTransfersInFlight() == 0);
+}
+
+TEST_CASE("Failed transfers are not tracked", "[FT60XBusConnector]")
+{
+    MockFT60XDevice device {};
+    device.submitResult = false;
+    auto busConnector = std::make_unique<FT60XBusConnector>(device);
+    FT60XBusConnector& connector = *busConnector;
+
+    connector.writeData(0, 16, 0);
+    CHECK(connector.getTransfersInFlight() == 0);
+
+    device.submitResult = true;
+    connector.writeData(0, 16, 0);
+    CHECK(connector.getTransfersInFlight() == 1);
+    CHECK(device.pending[0].slot == 0);
+}
+
+TEST_CASE("Transfers are ignored when the device can't be opened", "[FT60XBusConnector]")
+{
+    MockFT60XDevice device {};
+    device.openResult = false;
+    auto busConnector = std::make_unique<FT60XBusConnector>(device);
+    FT60XBusConnector& connector = *busConnector;
+
+    connector.writeData(0, 16, 0);
+    connector.readData(0, 16);
+    CHECK(device.pending.empty());
+    CHECK(connector.getTransfersInFlight() == 0);
+}
+
+TEST_CASE("Transfers in flight are completed before the device is closed", "[FT60XBusConnector]")
+{
+    MockFT60XDevice device {};
+    {
+        auto busConnector = std::make_unique<FT60XBusConnector>(device);
+    FT60XBusConnector& connector = *busConnector;
+        connector.writeData(0, 16, 0);
+        connector.writeData(1, 16, 0);
+        // A short transfer is reported as error but still completes the slot
+        device.transferredSize = 8;
+    }
+    CHECK(device.pending.empty());
+    CHECK(device.completed.size() == 2);
+    CHECK(device.closeCount == 1);
+}
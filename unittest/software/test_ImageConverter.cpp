@@ -0,0 +1,265 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#define CATCH_CONFIG_MAIN
+#include "../3rdParty/catch.hpp"
+#include "ImageConverter.hpp"
+#include <random>
+#include <vector>
+
+using namespace rr;
+
+namespace
+{
+static constexpr std::size_t TEXTURE_SIZE { 32 };
+static constexpr uint16_t CLEAR_COLOR { 0x1234 };
+
+struct Rgba
+{
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t a;
+};
+
+uint16_t toDevice(const InternalPixelFormat ipf, const Rgba& c)
+{
+    switch (ipf)
+    {
+    case InternalPixelFormat::RGB:
+        return ((c.r >> 3) << 11) | ((c.g >> 2) << 5) | (c.b >> 3);
+    case InternalPixelFormat::RGBA:
+        return ((c.r >> 4) << 12) | ((c.g >> 4) << 8) | ((c.b >> 4) << 4) | (c.a >> 4);
+    case InternalPixelFormat::RGBA1:
+        return ((c.r >> 3) << 11) | ((c.g >> 3) << 6) | ((c.b >> 3) << 1) | (c.a >> 7);
+    case InternalPixelFormat::LUMINANCE:
+        return ((c.r >> 3) << 11) | ((c.r >> 2) << 5) | (c.r >> 3);
+    default:
+        return 0;
+    }
+}
+
+// Reads a client pixel with 8 bit components
+Rgba readClientPixel(const GLenum format, const uint8_t* p)
+{
+    switch (format)
+    {
+    case GL_RGBA:
+        return { p[0], p[1], p[2], p[3] };
+    case GL_BGRA:
+        return { p[2], p[1], p[0], p[3] };
+    case GL_RGB:
+        return { p[0], p[1], p[2], 0xff };
+    case GL_BGR:
+        return { p[2], p[1], p[0], 0xff };
+    default:
+        return { p[0], p[0], p[0], 0xff };
+    }
+}
+
+std::size_t getPixelSize(const GLenum format)
+{
+    switch (format)
+    {
+    case GL_RGBA:
+    case GL_BGRA:
+        return 4;
+    case GL_RGB:
+    case GL_BGR:
+        return 3;
+    default:
+        return 1;
+    }
+}
+
+void checkUnpack(
+    const InternalPixelFormat ipf,
+    const GLenum format,
+    const std::size_t alignment,
+    const std::size_t x,
+    const std::size_t y,
+    const std::size_t width,
+    const std::size_t height)
+{
+    std::mt19937 rng { 1234 };
+    const std::size_t pixelSize = getPixelSize(format);
+    const std::size_t rowSize = ((pixelSize * width) + alignment - 1) / alignment * alignment;
+    std::vector<uint8_t> client(rowSize * height);
+    for (uint8_t& c : client)
+    {
+        c = static_cast<uint8_t>(rng());
+    }
+
+    std::shared_ptr<uint16_t> texture { new uint16_t[TEXTURE_SIZE * TEXTURE_SIZE], std::default_delete<uint16_t[]>() };
+    std::fill_n(texture.get(), TEXTURE_SIZE * TEXTURE_SIZE, CLEAR_COLOR);
+
+    ImageConverter imageConverter {};
+    imageConverter.setUnpackAlignment(alignment);
+    imageConverter.convertUnpack(texture, ipf, TEXTURE_SIZE, x, y, width, height, format, GL_UNSIGNED_BYTE, client.data());
+
+    for (std::size_t row = 0; row < TEXTURE_SIZE; row++)
+    {
+        for (std::size_t column = 0; column < TEXTURE_SIZE; column++)
+        {
+            const uint16_t texel = texture.get()[(row * TEXTURE_SIZE) + column];
+            if ((column < x) || (column >= (x + width)) || (row < y) || (row >= (y + height)))
+            {
+                REQUIRE(texel == CLEAR_COLOR);
+                continue;
+            }
+            const uint8_t* clientPixel = client.data() + ((row - y) * rowSize) + ((column - x) * pixelSize);
+            REQUIRE(texel == toDevice(ipf, readClientPixel(format, clientPixel)));
+        }
+    }
+}
+} // namespace
+
+TEST_CASE("Unpack 8 bit components into the device formats", "[ImageConverter]")
+{
+    const std::array<GLenum, 4> formats { GL_RGBA, GL_BGRA, GL_RGB, GL_BGR };
+    const std::array<InternalPixelFormat, 3> ipfs { InternalPixelFormat::RGB, InternalPixelFormat::RGBA, InternalPixelFormat::RGBA1 };
+    for (const GLenum format : formats)
+    {
+        for (const InternalPixelFormat ipf : ipfs)
+        {
+            // Full rows and rows with a remainder which is not handled by the vector loop
+            checkUnpack(ipf, format, 4, 0, 0, TEXTURE_SIZE, TEXTURE_SIZE);
+            checkUnpack(ipf, format, 4, 3, 5, 13, 7);
+            checkUnpack(ipf, format, 1, 1, 2, 27, 3);
+        }
+    }
+}
+
+TEST_CASE("Unpack formats without a specialized kernel", "[ImageConverter]")
+{
+    checkUnpack(InternalPixelFormat::LUMINANCE, GL_LUMINANCE, 4, 2, 1, 13, 5);
+}
+
+TEST_CASE("Unpack device formats by copying", "[ImageConverter]")
+{
+    const std::vector<uint16_t> client { 0x0123, 0x4567, 0x89ab, 0xcdef, 0xfedc, 0xba98, 0x7654, 0x3210 };
+    const std::array<std::pair<GLenum, InternalPixelFormat>, 3> types { {
+        { GL_UNSIGNED_SHORT_5_6_5, InternalPixelFormat::RGB },
+        { GL_UNSIGNED_SHORT_4_4_4_4, InternalPixelFormat::RGBA },
+        { GL_UNSIGNED_SHORT_5_5_5_1, InternalPixelFormat::RGBA1 },
+    } };
+    for (const auto& [type, ipf] : types)
+    {
+        std::shared_ptr<uint16_t> texture { new uint16_t[16], std::default_delete<uint16_t[]>() };
+        std::fill_n(texture.get(), 16, CLEAR_COLOR);
+        ImageConverter imageConverter {};
+        const GLenum format = (type == GL_UNSIGNED_SHORT_5_6_5) ? GL_RGB : GL_RGBA;
+        // Three pixels per row are 6 bytes which are padded to 8 bytes
+        imageConverter.convertUnpack(texture, ipf, 4, 1, 1, 3, 2, format, type, reinterpret_cast<const uint8_t*>(client.data()));
+        REQUIRE(texture.get()[4] == CLEAR_COLOR);
+        REQUIRE(texture.get()[5] == 0x0123);
+        REQUIRE(texture.get()[6] == 0x4567);
+        REQUIRE(texture.get()[7] == 0x89ab);
+        REQUIRE(texture.get()[9] == 0xfedc);
+        REQUIRE(texture.get()[10] == 0xba98);
+        REQUIRE(texture.get()[11] == 0x7654);
+        REQUIRE(texture.get()[12] == CLEAR_COLOR);
+    }
+}
+
+TEST_CASE("Round not power of two sizes", "[ImageConverter]")
+{
+    ImageConverter imageConverter {};
+    REQUIRE(imageConverter.getNpotRounding() == ImageConverter::NpotRounding::NEXT);
+    REQUIRE(imageConverter.getPowerOfTwoSize(0) == 0);
+    REQUIRE(imageConverter.getPowerOfTwoSize(1) == 1);
+    REQUIRE(imageConverter.getPowerOfTwoSize(48) == 64);
+    REQUIRE(imageConverter.getPowerOfTwoSize(64) == 64);
+
+    imageConverter.setNpotRounding(ImageConverter::NpotRounding::NEAREST);
+    REQUIRE(imageConverter.getPowerOfTwoSize(3) == 4);
+    REQUIRE(imageConverter.getPowerOfTwoSize(5) == 4);
+    REQUIRE(imageConverter.getPowerOfTwoSize(40) == 32);
+    REQUIRE(imageConverter.getPowerOfTwoSize(48) == 64);
+
+    imageConverter.setNpotRounding(ImageConverter::NpotRounding::DOWN);
+    REQUIRE(imageConverter.getPowerOfTwoSize(33) == 32);
+    REQUIRE(imageConverter.getPowerOfTwoSize(48) == 32);
+    REQUIRE(imageConverter.getPowerOfTwoSize(64) == 64);
+}
+
+TEST_CASE("Resample not power of two images", "[ImageConverter]")
+{
+    SECTION("Box filter weights the covered area")
+    {
+        const std::vector<uint8_t> src { 0, 0, 0, 0, 90, 90, 90, 90, 180, 180, 180, 180 };
+        std::vector<uint8_t> dst(2 * ImageResampler::CHANNELS);
+        ImageResampler::resample(dst.data(), 2, 1, src.data(), 3, 1, ImageResampler::Filter::BOX);
+        REQUIRE(dst == std::vector<uint8_t> { 30, 30, 30, 30, 150, 150, 150, 150 });
+    }
+
+    SECTION("Bilinear filter interpolates at the pixel centers")
+    {
+        const std::vector<uint8_t> src { 0, 0, 0, 0, 100, 100, 100, 100 };
+        std::vector<uint8_t> dst(4 * ImageResampler::CHANNELS);
+        ImageResampler::resample(dst.data(), 4, 1, src.data(), 2, 1, ImageResampler::Filter::BILINEAR);
+        REQUIRE(dst == std::vector<uint8_t> { 0, 0, 0, 0, 25, 25, 25, 25, 75, 75, 75, 75, 100, 100, 100, 100 });
+    }
+
+    SECTION("Constant images are unchanged")
+    {
+        const std::array<ImageResampler::Filter, 2> filters { ImageResampler::Filter::BOX, ImageResampler::Filter::BILINEAR };
+        for (const ImageResampler::Filter filter : filters)
+        {
+            // 5x3 RGB pixels with rows padded to 16 bytes
+            const std::array<uint8_t, 3> color { 0x80, 0x40, 0x20 };
+            std::vector<uint8_t> client(16 * 3, 0xff);
+            for (std::size_t i = 0; i < client.size(); i++)
+            {
+                if ((i % 16) < 15)
+                {
+                    client[i] = color[(i % 16) % 3];
+                }
+            }
+            std::shared_ptr<uint16_t> texture { new uint16_t[TEXTURE_SIZE * TEXTURE_SIZE], std::default_delete<uint16_t[]>() };
+            std::fill_n(texture.get(), TEXTURE_SIZE * TEXTURE_SIZE, CLEAR_COLOR);
+            ImageConverter imageConverter {};
+            imageConverter.setNpotFilter(filter);
+            imageConverter.convertUnpackRescaled(texture, InternalPixelFormat::RGB, TEXTURE_SIZE, 0, 0, 8, 2, 5, 3, GL_RGB, GL_UNSIGNED_BYTE, client.data());
+            for (std::size_t row = 0; row < 3; row++)
+            {
+                for (std::size_t column = 0; column < TEXTURE_SIZE; column++)
+                {
+                    const uint16_t expected = ((row < 2) && (column < 8)) ? toDevice(InternalPixelFormat::RGB, { 0x80, 0x40, 0x20, 0xff }) : CLEAR_COLOR;
+                    REQUIRE(texture.get()[(row * TEXTURE_SIZE) + column] == expected);
+                }
+            }
+        }
+    }
+    SECTION("Resampled images are written at the offset")
+    {
+        const std::vector<uint8_t> client(3 * 3 * 4, 0x40);
+        std::shared_ptr<uint16_t> texture { new uint16_t[TEXTURE_SIZE * TEXTURE_SIZE], std::default_delete<uint16_t[]>() };
+        std::fill_n(texture.get(), TEXTURE_SIZE * TEXTURE_SIZE, CLEAR_COLOR);
+        ImageConverter imageConverter {};
+        imageConverter.convertUnpackRescaled(texture, InternalPixelFormat::RGBA, TEXTURE_SIZE, 3, 1, 2, 2, 3, 3, GL_RGBA, GL_UNSIGNED_BYTE, client.data());
+        for (std::size_t row = 0; row < TEXTURE_SIZE; row++)
+        {
+            for (std::size_t column = 0; column < TEXTURE_SIZE; column++)
+            {
+                const bool inside = (row >= 1) && (row < 3) && (column >= 3) && (column < 5);
+                const uint16_t expected = inside ? toDevice(InternalPixelFormat::RGBA, { 0x40, 0x40, 0x40, 0x40 }) : CLEAR_COLOR;
+                REQUIRE(texture.get()[(row * TEXTURE_SIZE) + column] == expected);
+            }
+        }
+    }
+}
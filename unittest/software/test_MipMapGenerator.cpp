@@ -0,0 +1,215 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#define CATCH_CONFIG_MAIN
+#include "../3rdParty/catch.hpp"
+#include "MipMapGenerator.hpp"
+#include <random>
+
+using namespace rr;
+
+namespace
+{
+static constexpr std::size_t BASE_WIDTH { 38 };
+static constexpr std::size_t BASE_HEIGHT { 6 };
+static constexpr uint16_t CLEAR_COLOR { 0x1234 };
+
+static constexpr std::array<InternalPixelFormat, 7> IPFS {
+    InternalPixelFormat::ALPHA,
+    InternalPixelFormat::LUMINANCE,
+    InternalPixelFormat::INTENSITY,
+    InternalPixelFormat::LUMINANCE_ALPHA,
+    InternalPixelFormat::RGB,
+    InternalPixelFormat::RGBA,
+    InternalPixelFormat::RGBA1,
+};
+
+uint32_t expand(const uint16_t color, const std::size_t pos, const std::size_t bits)
+{
+    const uint32_t c = (color >> pos) & ((1u << bits) - 1);
+    return (c << (8 - bits)) | (c >> (bits - (8 - bits)));
+}
+
+// Reference: Expand the four pixels to 8 bit components, average them and convert them back
+uint16_t referenceFilter(const InternalPixelFormat ipf, const std::array<uint16_t, 4>& p)
+{
+    const auto average = [&](const std::size_t pos, const std::size_t bits)
+    {
+        uint32_t sum = 0;
+        for (const uint16_t c : p)
+        {
+            sum += (bits == 1) ? (((c >> pos) & 1) * 0xff) : expand(c, pos, bits);
+        }
+        return sum / 4;
+    };
+    switch (ipf)
+    {
+    case InternalPixelFormat::ALPHA:
+        return average(0, 4) >> 4;
+    case InternalPixelFormat::LUMINANCE:
+    {
+        const uint32_t r = average(11, 5);
+        return ((r >> 3) << 11) | ((r >> 2) << 5) | (r >> 3);
+    }
+    case InternalPixelFormat::INTENSITY:
+        return (average(12, 4) >> 4) * 0x1111;
+    case InternalPixelFormat::LUMINANCE_ALPHA:
+        return ((average(12, 4) >> 4) * 0x1110) | (average(0, 4) >> 4);
+    case InternalPixelFormat::RGB:
+        return ((average(11, 5) >> 3) << 11) | ((average(5, 6) >> 2) << 5) | (average(0, 5) >> 3);
+    case InternalPixelFormat::RGBA:
+        return ((average(12, 4) >> 4) << 12) | ((average(8, 4) >> 4) << 8) | ((average(4, 4) >> 4) << 4) | (average(0, 4) >> 4);
+    case InternalPixelFormat::RGBA1:
+        return ((average(11, 5) >> 3) << 11) | ((average(6, 5) >> 3) << 6) | ((average(1, 5) >> 3) << 1) | (average(0, 1) >> 7);
+    default:
+        return 0;
+    }
+}
+
+std::shared_ptr<uint16_t> createImage(const std::size_t size, const uint32_t seed)
+{
+    std::mt19937 rng { seed };
+    std::shared_ptr<uint16_t> image { new uint16_t[size], std::default_delete<uint16_t[]>() };
+    for (std::size_t i = 0; i < size; i++)
+    {
+        image.get()[i] = static_cast<uint16_t>(rng());
+    }
+    return image;
+}
+
+uint16_t referencePixel(
+    const InternalPixelFormat ipf,
+    const uint16_t* base,
+    const std::size_t baseWidth,
+    const std::size_t x,
+    const std::size_t y)
+{
+    const uint16_t* top = base + (y * 2 * baseWidth) + (x * 2);
+    return referenceFilter(ipf, { top[0], top[1], top[baseWidth], top[baseWidth + 1] });
+}
+
+TextureObject createTextureObject(const InternalPixelFormat ipf, const std::size_t width, const std::size_t height)
+{
+    TextureObject obj {};
+    obj.setWidth(0, width);
+    obj.setHeight(0, height);
+    obj.setInternalPixelFormat(0, ipf);
+    obj.setPixels(0, createImage(width * height, 42));
+    return obj;
+}
+
+void checkLevels(TextureObject& obj, const std::size_t levels)
+{
+    for (std::size_t level = 1; level <= levels; level++)
+    {
+        const uint16_t* base = obj.getPixels(level - 1).get();
+        const uint16_t* pixels = obj.getPixels(level).get();
+        REQUIRE(pixels != nullptr);
+        for (std::size_t y = 0; y < obj.getHeight(level); y++)
+        {
+            for (std::size_t x = 0; x < obj.getWidth(level); x++)
+            {
+                REQUIRE(pixels[(y * obj.getWidth(level)) + x] == referencePixel(obj.getInternalPixelFormat(0), base, obj.getWidth(level - 1), x, y));
+            }
+        }
+    }
+}
+} // namespace
+
+TEST_CASE("Box filter matches the average of the expanded components", "[MipMapGenerator]")
+{
+    // The width of 19 pixels in the new level uses the vector loop and the scalar remainder
+    const std::shared_ptr<uint16_t> base = createImage(BASE_WIDTH * BASE_HEIGHT, 1234);
+    for (const InternalPixelFormat ipf : IPFS)
+    {
+        std::shared_ptr<uint16_t> level { new uint16_t[(BASE_WIDTH / 2) * (BASE_HEIGHT / 2)], std::default_delete<uint16_t[]>() };
+        REQUIRE(ImageConverter::computeMipMapLevel(level, ipf, BASE_WIDTH, BASE_HEIGHT, base));
+        for (std::size_t y = 0; y < (BASE_HEIGHT / 2); y++)
+        {
+            for (std::size_t x = 0; x < (BASE_WIDTH / 2); x++)
+            {
+                REQUIRE(level.get()[(y * (BASE_WIDTH / 2)) + x] == referencePixel(ipf, base.get(), BASE_WIDTH, x, y));
+            }
+        }
+    }
+}
+
+TEST_CASE("Box filter of all component values", "[MipMapGenerator]")
+{
+    // Every 16 bit value together with three values derived from it
+    for (const InternalPixelFormat ipf : IPFS)
+    {
+        for (uint32_t c = 0; c <= 0xffff; c++)
+        {
+            const uint16_t v = static_cast<uint16_t>(c);
+            const std::array<uint16_t, 4> pixels { v, static_cast<uint16_t>(v + 1), static_cast<uint16_t>(v ^ 0x0841), static_cast<uint16_t>(~v) };
+            std::shared_ptr<uint16_t> base { new uint16_t[4] { pixels[0], pixels[1], pixels[2], pixels[3] }, std::default_delete<uint16_t[]>() };
+            std::shared_ptr<uint16_t> level { new uint16_t[1], std::default_delete<uint16_t[]>() };
+            REQUIRE(ImageConverter::computeMipMapLevel(level, ipf, 2, 2, base));
+            REQUIRE(level.get()[0] == referenceFilter(ipf, pixels));
+        }
+    }
+}
+
+TEST_CASE("Compute a region of a mip map level", "[MipMapGenerator]")
+{
+    const std::shared_ptr<uint16_t> base = createImage(BASE_WIDTH * BASE_HEIGHT, 99);
+    std::shared_ptr<uint16_t> level { new uint16_t[(BASE_WIDTH / 2) * (BASE_HEIGHT / 2)], std::default_delete<uint16_t[]>() };
+    std::fill_n(level.get(), (BASE_WIDTH / 2) * (BASE_HEIGHT / 2), CLEAR_COLOR);
+    REQUIRE(ImageConverter::computeMipMapLevel(level, InternalPixelFormat::RGB, BASE_WIDTH, BASE_HEIGHT, base, 3, 1, 11, 1));
+    for (std::size_t y = 0; y < (BASE_HEIGHT / 2); y++)
+    {
+        for (std::size_t x = 0; x < (BASE_WIDTH / 2); x++)
+        {
+            const uint16_t pixel = level.get()[(y * (BASE_WIDTH / 2)) + x];
+            if ((y == 1) && (x >= 3) && (x < 14))
+            {
+                REQUIRE(pixel == referencePixel(InternalPixelFormat::RGB, base.get(), BASE_WIDTH, x, y));
+            }
+            else
+            {
+                REQUIRE(pixel == CLEAR_COLOR);
+            }
+        }
+    }
+    REQUIRE(!ImageConverter::computeMipMapLevel(level, InternalPixelFormat::RGB, BASE_WIDTH, BASE_HEIGHT, base, 3, 1, 11, 3));
+}
+
+TEST_CASE("Generate all mip map levels", "[MipMapGenerator]")
+{
+    TexturePixelAllocator allocator {};
+    MipMapGenerator generator { allocator };
+    generator.setEnableMipMapGeneration(true);
+    TextureObject obj = createTextureObject(InternalPixelFormat::RGBA, 64, 32);
+    generator.generateMipMap(obj, 0);
+    // The levels are generated down to the 2x1 level (getLevels() - 1)
+    checkLevels(obj, 5);
+    REQUIRE(!obj.getPixels(6));
+}
+
+TEST_CASE("Generate mip map levels of every format", "[MipMapGenerator]")
+{
+    for (const InternalPixelFormat ipf : IPFS)
+    {
+        TexturePixelAllocator allocator {};
+        MipMapGenerator generator { allocator };
+        generator.setEnableMipMapGeneration(true);
+        TextureObject obj = createTextureObject(ipf, 256, 256);
+        generator.generateMipMap(obj, 0);
+        checkLevels(obj, 7);
+    }
+}
@@ -0,0 +1,155 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#define CATCH_CONFIG_MAIN
+#include "../3rdParty/catch.hpp"
+// The profiler is tested independently of the configuration of the library
+#undef RIX_CORE_ENABLE_PROFILING
+#define RIX_CORE_ENABLE_PROFILING true
+#include "Profiler.hpp"
+#include <sstream>
+#include <thread>
+
+using namespace rr;
+using namespace rr::profiler;
+
+namespace
+{
+uint64_t getCounter(const Profiler::FrameSummary& frame, const Counter counter)
+{
+    return frame.counters[static_cast<std::size_t>(counter)];
+}
+
+bool contains(const std::string& str, const std::string& pattern)
+{
+    return str.find(pattern) != std::string::npos;
+}
+} // namespace
+
+TEST_CASE("Counters are stored per frame", "[Profiler]")
+{
+    Profiler& profiler = Profiler::getInstance();
+    profiler.clear();
+
+    profiler.count(Counter::TEXTURE_UPLOAD_BYTES, 10);
+    profiler.count(Counter::RING_STALL_TIME_US, 4);
+    profiler.count(Counter::TEXTURE_UPLOAD_BYTES, 2);
+    profiler.endFrame({});
+    profiler.count(Counter::UPLOAD_WAIT_TIME_US, 7);
+    profiler.endFrame({});
+
+    const std::vector<Profiler::FrameSummary> frames = profiler.getFrameSummaries();
+    REQUIRE(frames.size() == 2);
+    REQUIRE(getCounter(frames[0], Counter::TEXTURE_UPLOAD_BYTES) == 12);
+    REQUIRE(getCounter(frames[0], Counter::RING_STALL_TIME_US) == 4);
+    REQUIRE(getCounter(frames[0], Counter::UPLOAD_WAIT_TIME_US) == 0);
+    REQUIRE(getCounter(frames[1], Counter::TEXTURE_UPLOAD_BYTES) == 0);
+    REQUIRE(getCounter(frames[1], Counter::UPLOAD_WAIT_TIME_US) == 7);
+    REQUIRE(frames[1].startUs >= frames[0].startUs + frames[0].durationUs);
+}
+
+TEST_CASE("Frame summaries take the triangles from the frame statistics", "[Profiler]")
+{
+    Profiler& profiler = Profiler::getInstance();
+    profiler.clear();
+
+    FrameStatistics statistics {};
+    statistics.trianglesSubmitted = 12;
+    statistics.trianglesCulled = 4;
+    statistics.trianglesClipped = 1;
+    statistics.trianglesRasterized = 8;
+    profiler.endFrame(statistics);
+
+    const std::vector<Profiler::FrameSummary> frames = profiler.getFrameSummaries();
+    REQUIRE(frames.size() == 1);
+    REQUIRE(frames[0].statistics.trianglesSubmitted == 12);
+    REQUIRE(frames[0].statistics.trianglesRasterized == 8);
+
+    std::stringstream summaries {};
+    profiler.writeFrameSummaries(summaries);
+    REQUIRE(contains(summaries.str(), "\"trianglesSubmitted\":12,\"trianglesCulled\":4,\"trianglesClipped\":1,\"trianglesRasterized\":8"));
+}
+
+TEST_CASE("Command bytes are accumulated per op", "[Profiler]")
+{
+    Profiler& profiler = Profiler::getInstance();
+    profiler.clear();
+
+    profiler.countCommandBytes(op::TRIANGLE_STREAM | 0x40, 68);
+    profiler.countCommandBytes(op::TRIANGLE_STREAM | 0x40, 68);
+    profiler.countCommandBytes(op::TEXTURE_STREAM | 0x1, 12);
+    profiler.endFrame({});
+
+    const std::vector<Profiler::FrameSummary> frames = profiler.getFrameSummaries();
+    REQUIRE(frames.size() == 1);
+    REQUIRE(frames[0].commandBytes[op::TRIANGLE_STREAM >> 28] == 136);
+    REQUIRE(frames[0].commandBytes[op::TEXTURE_STREAM >> 28] == 12);
+    REQUIRE(frames[0].commandBytes[op::NOP >> 28] == 0);
+
+    std::stringstream summaries {};
+    profiler.writeFrameSummaries(summaries);
+    REQUIRE(contains(summaries.str(), "\"commandBytes\":{\"triangleStream\":136,\"textureStream\":12}"));
+}
+
+TEST_CASE("Scoped events are exported with the name of their thread", "[Profiler]")
+{
+    Profiler& profiler = Profiler::getInstance();
+    profiler.clear();
+
+    std::thread worker { []()
+        {
+            Profiler::getInstance().setThreadName("worker");
+            ScopedEvent event { "transform" };
+        } };
+    worker.join();
+    {
+        ScopedTimeCounter time { Counter::UPLOAD_WAIT_TIME_US };
+        ScopedEvent event { "upload" };
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    profiler.endFrame({});
+
+    REQUIRE(getCounter(profiler.getFrameSummaries()[0], Counter::UPLOAD_WAIT_TIME_US) >= 2000);
+
+    std::stringstream trace {};
+    profiler.writeChromeTrace(trace);
+    const std::string json = trace.str();
+    REQUIRE(contains(json, "\"traceEvents\":["));
+    REQUIRE(contains(json, "\"args\":{\"name\":\"worker\"}"));
+    REQUIRE(contains(json, "{\"name\":\"transform\",\"ph\":\"X\""));
+    REQUIRE(contains(json, "{\"name\":\"upload\",\"ph\":\"X\""));
+    REQUIRE(contains(json, "{\"name\":\"triangles\",\"ph\":\"C\""));
+}
+
+TEST_CASE("Clear removes events, frames and counters", "[Profiler]")
+{
+    Profiler& profiler = Profiler::getInstance();
+    profiler.count(Counter::TEXTURE_UPLOAD_BYTES, 3);
+    {
+        ScopedEvent event { "scope" };
+    }
+    profiler.clear();
+    profiler.endFrame({});
+
+    const std::vector<Profiler::FrameSummary> frames = profiler.getFrameSummaries();
+    REQUIRE(frames.size() == 1);
+    REQUIRE(getCounter(frames[0], Counter::TEXTURE_UPLOAD_BYTES) == 0);
+
+    std::stringstream trace {};
+    profiler.writeChromeTrace(trace);
+    REQUIRE(!contains(trace.str(), "\"ph\":\"X\""));
+}
@@ -0,0 +1,148 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#define CATCH_CONFIG_MAIN
+#include "../3rdParty/catch.hpp"
+#include "MemoryDevice.hpp"
+#include "SharedMemoryBusConnector.hpp"
+#include "SharedMemoryBusServer.hpp"
+#include "renderer/devicedatauploader/DeviceDataReceiver.hpp"
+#include "renderer/devicedatauploader/DeviceDataUploader.hpp"
+#include <numeric>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace rr;
+using namespace rr::devicedatauploader;
+
+namespace
+{
+
+// Runs the server on its own thread. The client runs on the test thread like in another process.
+class ServerThread
+{
+public:
+    ServerThread(IBusConnector& device)
+        : m_server { device }
+    {
+        REQUIRE(m_server.open(NAME.c_str()));
+        m_thread = std::thread { [this]()
+            { m_server.serve(); } };
+    }
+
+    ~ServerThread()
+    {
+        m_server.stop();
+        m_thread.join();
+    }
+
+    SharedMemoryBusServer& server() { return m_server; }
+
+    static inline const std::string NAME { "/rixbus_test_" + std::to_string(getpid()) };
+
+private:
+    SharedMemoryBusServer m_server;
+    std::thread m_thread {};
+};
+
+} // namespace
+
+TEST_CASE("The client gets the buffer layout of the device", "[SharedMemoryBusConnector]")
+{
+    MemoryDevice device { 3, 1000 };
+    DeviceDataReceiver receiver { device, 2, 256 };
+    ServerThread server { receiver };
+
+    SharedMemoryBusConnector busConnector {};
+    REQUIRE(busConnector.connect(ServerThread::NAME.c_str()));
+    CHECK(busConnector.isConnected());
+    CHECK(busConnector.getWriteBufferCount() == receiver.getWriteBufferCount());
+    CHECK(busConnector.getReadBufferCount() == receiver.getReadBufferCount());
+    CHECK(busConnector.requestWriteBuffer(0).size() >= receiver.requestWriteBuffer(0).size());
+    CHECK(busConnector.requestReadBuffer(0).size() == 256);
+    CHECK(busConnector.requestWriteBuffer(4).empty());
+}
+
+TEST_CASE("Only one client can be connected", "[SharedMemoryBusConnector]")
+{
+    MemoryDevice device {};
+    DeviceDataReceiver receiver { device };
+    ServerThread server { receiver };
+
+    SharedMemoryBusConnector first {};
+    SharedMemoryBusConnector second {};
+    REQUIRE(first.connect(ServerThread::NAME.c_str()));
+    CHECK_FALSE(second.connect(ServerThread::NAME.c_str()));
+    first.disconnect();
+    CHECK(second.connect(ServerThread::NAME.c_str()));
+}
+
+TEST_CASE("Connecting without a server fails", "[SharedMemoryBusConnector]")
+{
+    SharedMemoryBusConnector busConnector {};
+    CHECK_FALSE(busConnector.connect("/rixbus_test_does_not_exist"));
+    CHECK_FALSE(busConnector.isConnected());
+    CHECK(busConnector.getWriteBufferCount() == 0);
+}
+
+TEST_CASE("The DeviceDataUploader drives a device in the server", "[SharedMemoryBusConnector]")
+{
+    MemoryDevice device { 2, 64 * 1024 };
+    DeviceDataReceiver receiver { device, 2, 1024 };
+    ServerThread server { receiver };
+    SharedMemoryBusConnector busConnector {};
+    REQUIRE(busConnector.connect(ServerThread::NAME.c_str()));
+    DeviceDataUploader uploader { busConnector };
+
+    SECTION("Display lists")
+    {
+        static constexpr std::size_t FRAMES { 200 };
+        for (std::size_t i = 0; i < FRAMES; i++)
+        {
+            const uint8_t index = i % 2;
+            tcb::span<uint8_t> displayList = uploader.requestDisplayListBuffer(index);
+            std::iota(displayList.begin(), displayList.begin() + 4096, static_cast<uint8_t>(i));
+            uploader.streamDisplayList(index, 4096);
+        }
+        uploader.blockUntilDeviceIsIdle();
+
+        REQUIRE(device.streamed.size() == FRAMES);
+        for (std::size_t i = 0; i < FRAMES; i++)
+        {
+            std::vector<uint8_t> expected(4096);
+            std::iota(expected.begin(), expected.end(), static_cast<uint8_t>(i));
+            CHECK(device.streamed[i] == expected);
+        }
+    }
+
+    SECTION("Device memory")
+    {
+        std::vector<uint8_t> data(5000);
+        std::iota(data.begin(), data.end(), static_cast<uint8_t>(3));
+        CHECK(uploader.writeToDeviceMemory(data, 8192));
+
+        std::vector<uint8_t> loaded(data.size());
+        CHECK(uploader.readFromDeviceMemory(loaded, 8192));
+        CHECK(loaded == data);
+    }
+
+    busConnector.disconnect();
+    uploader.blockUntilDeviceIsIdle();
+    CHECK_FALSE(busConnector.isConnected());
+}
@@ -0,0 +1,184 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#define CATCH_CONFIG_MAIN
+#include "../3rdParty/catch.hpp"
+#include "SoftwareRasterizerBusConnector.hpp"
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace rr;
+
+namespace
+{
+static constexpr uint32_t GRAM_SIZE { 64 * 1024 };
+static constexpr uint32_t COLOR_BUFFER_OFFSET { 256 };
+// Not a multiple of the vector width to cover the scalar remainder
+static constexpr std::size_t PIXEL_COUNT { 3 * 1024 + 7 };
+static constexpr uint8_t GUARD { 0xa5 };
+
+template <SoftwareRasterizerBusConnectorColorFormat Format>
+using BusConnector = SoftwareRasterizerBusConnector<GRAM_SIZE, Format>;
+
+uint8_t expand5(const uint16_t c)
+{
+    return static_cast<uint8_t>((c << 3) | (c >> 2));
+}
+
+uint8_t expand6(const uint16_t c)
+{
+    return static_cast<uint8_t>((c << 2) | (c >> 4));
+}
+
+// Fills the color buffer in the device memory with random pixels and returns the pixels
+std::vector<uint16_t> fillColorBuffer(IBusConnector& busConnector, const uint32_t seed)
+{
+    std::mt19937 rng { seed };
+    std::vector<uint16_t> pixels(PIXEL_COUNT);
+    for (uint16_t& p : pixels)
+    {
+        p = static_cast<uint16_t>(rng());
+    }
+    std::memcpy(busConnector.requestWriteBuffer(0).data() + COLOR_BUFFER_OFFSET, pixels.data(), pixels.size() * sizeof(uint16_t));
+    return pixels;
+}
+
+void commit(IBusConnector& busConnector)
+{
+    busConnector.writeData(0, PIXEL_COUNT * sizeof(uint16_t), COLOR_BUFFER_OFFSET);
+}
+
+void checkBgr888(const std::vector<uint8_t>& framebuffer, const std::vector<uint16_t>& pixels)
+{
+    for (std::size_t i = 0; i < pixels.size(); i++)
+    {
+        INFO("Pixel " << i);
+        CHECK(framebuffer[(i * 3) + 0] == expand5(pixels[i] & 0x1f));
+        CHECK(framebuffer[(i * 3) + 1] == expand6((pixels[i] >> 5) & 0x3f));
+        CHECK(framebuffer[(i * 3) + 2] == expand5(pixels[i] >> 11));
+    }
+}
+} // namespace
+
+TEST_CASE("RGB565 is copied unchanged", "[SoftwareRasterizerBusConnector]")
+{
+    std::vector<uint8_t> framebuffer(PIXEL_COUNT * 2 + 1, GUARD);
+    auto busConnector = std::make_unique<BusConnector<SoftwareRasterizerBusConnectorColorFormat::RGB565>>(framebuffer);
+    const std::vector<uint16_t> pixels = fillColorBuffer(*busConnector, 1);
+    commit(*busConnector);
+
+    CHECK(std::memcmp(framebuffer.data(), pixels.data(), pixels.size() * sizeof(uint16_t)) == 0);
+    CHECK(framebuffer.back() == GUARD);
+}
+
+TEST_CASE("RGB565 is converted into BGR888", "[SoftwareRasterizerBusConnector]")
+{
+    std::vector<uint8_t> framebuffer(PIXEL_COUNT * 3 + 1, GUARD);
+    auto busConnector = std::make_unique<BusConnector<SoftwareRasterizerBusConnectorColorFormat::BGR888>>(framebuffer);
+    const std::vector<uint16_t> pixels = fillColorBuffer(*busConnector, 2);
+    commit(*busConnector);
+
+    checkBgr888(framebuffer, pixels);
+    CHECK(framebuffer.back() == GUARD);
+}
+
+TEST_CASE("RGB565 is converted into RGBA8888", "[SoftwareRasterizerBusConnector]")
+{
+    std::vector<uint8_t> framebuffer(PIXEL_COUNT * 4 + 1, GUARD);
+    auto busConnector = std::make_unique<BusConnector<SoftwareRasterizerBusConnectorColorFormat::RGBA8888>>(framebuffer);
+    const std::vector<uint16_t> pixels = fillColorBuffer(*busConnector, 3);
+    commit(*busConnector);
+
+    for (std::size_t i = 0; i < pixels.size(); i++)
+    {
+        INFO("Pixel " << i);
+        CHECK(framebuffer[(i * 4) + 0] == expand5(pixels[i] >> 11));
+        CHECK(framebuffer[(i * 4) + 1] == expand6((pixels[i] >> 5) & 0x3f));
+        CHECK(framebuffer[(i * 4) + 2] == expand5(pixels[i] & 0x1f));
+        CHECK(framebuffer[(i * 4) + 3] == 0xff);
+    }
+    CHECK(framebuffer.back() == GUARD);
+}
+
+TEST_CASE("RGB565 is converted into BGRA8888", "[SoftwareRasterizerBusConnector]")
+{
+    std::vector<uint8_t> framebuffer(PIXEL_COUNT * 4 + 1, GUARD);
+    auto busConnector = std::make_unique<BusConnector<SoftwareRasterizerBusConnectorColorFormat::BGRA8888>>(framebuffer);
+    const std::vector<uint16_t> pixels = fillColorBuffer(*busConnector, 7);
+    commit(*busConnector);
+
+    for (std::size_t i = 0; i < pixels.size(); i++)
+    {
+        INFO("Pixel " << i);
+        CHECK(framebuffer[(i * 4) + 0] == expand5(pixels[i] & 0x1f));
+        CHECK(framebuffer[(i * 4) + 1] == expand6((pixels[i] >> 5) & 0x3f));
+        CHECK(framebuffer[(i * 4) + 2] == expand5(pixels[i] >> 11));
+        CHECK(framebuffer[(i * 4) + 3] == 0xff);
+    }
+    CHECK(framebuffer.back() == GUARD);
+}
+
+TEST_CASE("The conversion stops at the end of a smaller framebuffer", "[SoftwareRasterizerBusConnector]")
+{
+    std::vector<uint8_t> framebuffer(PIXEL_COUNT * 3 + 1, GUARD);
+    auto busConnector = std::make_unique<BusConnector<SoftwareRasterizerBusConnectorColorFormat::BGR888>>(tcb::span<uint8_t> { framebuffer.data(), 100 * 3 });
+    const std::vector<uint16_t> pixels = fillColorBuffer(*busConnector, 4);
+    commit(*busConnector);
+
+    checkBgr888(framebuffer, { pixels.begin(), pixels.begin() + 100 });
+    CHECK(framebuffer[100 * 3] == GUARD);
+}
+
+TEST_CASE("Only dirty bands are converted", "[SoftwareRasterizerBusConnector]")
+{
+    using Connector = BusConnector<SoftwareRasterizerBusConnectorColorFormat::BGR888>;
+    std::vector<uint8_t> framebuffer(PIXEL_COUNT * 3, GUARD);
+    auto busConnector = std::make_unique<Connector>(framebuffer);
+    busConnector->setConvertDirtyBandsOnly(true);
+    std::vector<uint16_t> pixels = fillColorBuffer(*busConnector, 5);
+    commit(*busConnector);
+    checkBgr888(framebuffer, pixels);
+
+    // Mark the framebuffer to see which bands are converted again
+    std::fill(framebuffer.begin(), framebuffer.end(), GUARD);
+    const std::size_t changedPixel = Connector::BAND_SIZE + 3;
+    uint16_t* colorBuffer = reinterpret_cast<uint16_t*>(busConnector->requestWriteBuffer(0).data() + COLOR_BUFFER_OFFSET);
+    colorBuffer[changedPixel] = ~colorBuffer[changedPixel];
+    pixels[changedPixel] = colorBuffer[changedPixel];
+    commit(*busConnector);
+
+    CHECK(framebuffer[0] == GUARD);
+    CHECK(framebuffer[((Connector::BAND_SIZE - 1) * 3) + 2] == GUARD);
+    CHECK(framebuffer[(2 * Connector::BAND_SIZE) * 3] == GUARD);
+    const std::vector<uint8_t> band { framebuffer.begin() + (Connector::BAND_SIZE * 3), framebuffer.begin() + (2 * Connector::BAND_SIZE * 3) };
+    std::vector<uint8_t> expected(Connector::BAND_SIZE * 3);
+    FramebufferConverter::convertRgb565ToBgr888(expected.data(), pixels.data() + Connector::BAND_SIZE, Connector::BAND_SIZE);
+    CHECK(band == expected);
+}
+
+TEST_CASE("Without a framebuffer the front buffer is read from the device memory", "[SoftwareRasterizerBusConnector]")
+{
+    auto busConnector = std::make_unique<BusConnector<SoftwareRasterizerBusConnectorColorFormat::RGB565>>();
+    CHECK(busConnector->getFrontBuffer().empty());
+    fillColorBuffer(*busConnector, 6);
+    commit(*busConnector);
+
+    const tcb::span<const uint8_t> frontBuffer = busConnector->getFrontBuffer();
+    CHECK(frontBuffer.data() == busConnector->requestWriteBuffer(0).data() + COLOR_BUFFER_OFFSET);
+    CHECK(frontBuffer.size() == PIXEL_COUNT * sizeof(uint16_t));
+}
@@ -0,0 +1,179 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#define CATCH_CONFIG_MAIN
+#include "../3rdParty/catch.hpp"
+#include "ImageConverter.hpp"
+#include "MemoryDevice.hpp"
+#include "RIXGL.hpp"
+#include "RenderConfigs.hpp"
+#include "gl.h"
+#include "renderer/displaylist/DisplayList.hpp"
+#include "renderer/displaylist/DisplayListDisassembler.hpp"
+#include "vertexpipeline/VertexPipeline.hpp"
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+using namespace rr;
+
+namespace
+{
+
+static constexpr GLsizei SIZE { 8 };
+static constexpr uint16_t RED { 0xf800 };
+static constexpr uint16_t GREEN { 0x07e0 };
+
+struct Context
+{
+    Context()
+    {
+        RIXGL::createInstance(device);
+        RIXGL::getInstance().setRenderResolution(16, 8);
+        glViewport(0, 0, 16, 8);
+        glEnable(GL_TEXTURE_2D);
+    }
+
+    ~Context()
+    {
+        RIXGL::destroy();
+    }
+
+    MemoryDevice device { 2, 64 * 1024 };
+};
+
+void uploadTexture(const uint16_t color)
+{
+    GLuint texture {};
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    const std::vector<uint16_t> pixels(SIZE * SIZE, color);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, SIZE, SIZE, 0, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, pixels.data());
+    REQUIRE(glGetError() == GL_NO_ERROR);
+    RIXGL::getInstance().swapDisplayList();
+}
+
+void subImage(const uint16_t color)
+{
+    const std::vector<uint16_t> pixels(SIZE * SIZE, color);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, SIZE, SIZE, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, pixels.data());
+    REQUIRE(glGetError() == GL_NO_ERROR);
+}
+
+void draw()
+{
+    glBegin(GL_TRIANGLES);
+    glTexCoord2f(0.0f, 0.0f);
+    glVertex2f(-1.0f, -1.0f);
+    glTexCoord2f(1.0f, 0.0f);
+    glVertex2f(1.0f, -1.0f);
+    glTexCoord2f(0.0f, 1.0f);
+    glVertex2f(-1.0f, 1.0f);
+    glEnd();
+}
+
+// The texel which a RGB565 pixel is stored as in the texture memory
+uint16_t texel(const uint16_t color)
+{
+    std::shared_ptr<uint16_t> texel { new uint16_t[1], std::default_delete<uint16_t[]>() };
+    RIXGL::getInstance().imageConverter().convertUnpack(texel, InternalPixelFormat::RGB, 1, 0, 0, 1, 1, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, reinterpret_cast<const uint8_t*>(&color));
+    return texel.get()[0];
+}
+
+// Collects the first page of every texture stream of a display list in the order of the draws
+std::vector<uint32_t> streamedTexturePages(std::vector<uint8_t>& displayListData)
+{
+    displaylist::DisplayList displayList {};
+    displayList.setBuffer({ displayListData.data(), displayListData.size() });
+    displayList.setCurrentSize(displayListData.size());
+    displaylist::DisplayListDisassembler disassembler { displayList };
+    std::vector<uint32_t> pages {};
+    while (disassembler.visitNextCommand([&pages](const auto& cmd)
+        {
+            using CmdType = std::decay_t<decltype(cmd)>;
+            if constexpr (std::is_same_v<CmdType, TextureStreamCmd>)
+            {
+                pages.push_back(cmd.payload()[0]);
+            }
+            return true; }))
+    {
+    }
+    return pages;
+}
+
+// The first texel of the page in the memory of the device
+uint16_t texelAt(const MemoryDevice& device, const uint32_t page)
+{
+    uint16_t t {};
+    std::memcpy(&t, device.memory().data() + (page - RenderConfig::GRAM_MEMORY_LOC), sizeof(t));
+    return t;
+}
+
+} // namespace
+
+TEST_CASE("A draw before a sub image update in the same frame samples the old texels", "[TexSubImage]")
+{
+    Context context {};
+    uploadTexture(RED);
+
+    glBindTexture(GL_TEXTURE_2D, 1);
+    draw();
+    subImage(GREEN);
+    draw();
+    RIXGL::getInstance().swapDisplayList();
+
+    const std::vector<uint32_t> pages = streamedTexturePages(context.device.streamed.back());
+    REQUIRE(pages.size() >= 2);
+    REQUIRE(pages.front() != pages.back());
+    REQUIRE(texelAt(context.device, pages.front()) == texel(RED));
+    REQUIRE(texelAt(context.device, pages.back()) == texel(GREEN));
+}
+
+TEST_CASE("A sub image update before the first draw of a frame is written in place", "[TexSubImage]")
+{
+    Context context {};
+    uploadTexture(RED);
+    glBindTexture(GL_TEXTURE_2D, 1);
+    RIXGL::getInstance().swapDisplayList();
+    const std::vector<uint32_t> boundPages = streamedTexturePages(context.device.streamed.back());
+
+    subImage(GREEN);
+    draw();
+    RIXGL::getInstance().swapDisplayList();
+
+    // The texture keeps its pages, only their content changes
+    REQUIRE(streamedTexturePages(context.device.streamed.back()).empty());
+    REQUIRE(texelAt(context.device, boundPages.back()) == texel(GREEN));
+}
+
+TEST_CASE("The NPOT rounding hint accepts only hint modes", "[TexSubImage]")
+{
+    Context context {};
+    const ImageConverter& imageConverter = RIXGL::getInstance().imageConverter();
+
+    glHint(GL_TEXTURE_NPOT_ROUNDING_HINT_RIX, GL_FASTEST);
+    REQUIRE(imageConverter.getNpotRounding() == ImageConverter::NpotRounding::DOWN);
+    glHint(GL_TEXTURE_NPOT_ROUNDING_HINT_RIX, GL_DONT_CARE);
+    REQUIRE(imageConverter.getNpotRounding() == ImageConverter::NpotRounding::NEAREST);
+    glHint(GL_TEXTURE_NPOT_ROUNDING_HINT_RIX, GL_NICEST);
+    REQUIRE(imageConverter.getNpotRounding() == ImageConverter::NpotRounding::NEXT);
+    REQUIRE(glGetError() == GL_NO_ERROR);
+
+    glHint(GL_TEXTURE_NPOT_ROUNDING_HINT_RIX, GL_NEAREST);
+    REQUIRE(glGetError() == GL_INVALID_ENUM);
+    REQUIRE(imageConverter.getNpotRounding() == ImageConverter::NpotRounding::NEXT);
+}
@@ -0,0 +1,545 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#define CATCH_CONFIG_MAIN
+#include "../3rdParty/catch.hpp"
+#include "renderer/FreeIndexList.hpp"
+#include "renderer/TextureMemoryManager.hpp"
+#include <algorithm>
+#include <vector>
+
+using namespace rr;
+
+namespace
+{
+
+struct TestRenderConfig
+{
+    static constexpr std::size_t MAX_TEXTURE_SIZE { 16 };
+    static constexpr std::size_t TEXTURE_PAGE_SIZE { 64 };
+    static constexpr std::size_t NUMBER_OF_TEXTURE_PAGES { 32 };
+    static constexpr std::size_t NUMBER_OF_TEXTURES { 8 };
+    static constexpr std::size_t TMU_COUNT { 2 };
+};
+
+using TestTextureMemoryManager = TextureMemoryManager<TestRenderConfig>;
+
+TextureObject createTextureObject(const std::size_t width, const std::size_t height)
+{
+    TextureObject obj {};
+    obj.setWidth(0, width);
+    obj.setHeight(0, height);
+    obj.setInternalPixelFormat(0, InternalPixelFormat::RGB);
+    obj.setPixels(0, TextureObject::PixelsType { new uint16_t[width * height], std::default_delete<uint16_t[]>() });
+    return obj;
+}
+
+std::size_t upload(TestTextureMemoryManager& manager)
+{
+    std::size_t pages = 0;
+    manager.uploadTextures([&pages](uint32_t, const tcb::span<const uint8_t>)
+        {
+            pages++;
+            return true; });
+    return pages;
+}
+
+} // namespace
+
+TEST_CASE("Free index list returns the indices in ascending order after a reset", "[FreeIndexList]")
+{
+    FreeIndexList<5> list {};
+    list.reset(1);
+    REQUIRE(list.size() == 4);
+    REQUIRE_FALSE(list.contains(0));
+    REQUIRE(list.pop() == 1);
+    REQUIRE(list.pop() == 2);
+    REQUIRE(list.pop() == 3);
+    REQUIRE(list.pop() == 4);
+    REQUIRE(list.empty());
+}
+
+TEST_CASE("Free index list reuses the last freed index first", "[FreeIndexList]")
+{
+    FreeIndexList<5> list {};
+    list.reset();
+    REQUIRE(list.pop() == 0);
+    REQUIRE(list.pop() == 1);
+    list.push(0);
+    list.push(1);
+    list.push(1); // Already free
+    REQUIRE(list.size() == 5);
+    REQUIRE(list.pop() == 1);
+    REQUIRE(list.pop() == 0);
+}
+
+TEST_CASE("Free index list removes indices from the middle", "[FreeIndexList]")
+{
+    FreeIndexList<5> list {};
+    list.reset();
+    list.remove(2);
+    list.remove(0);
+    list.remove(0); // Already used
+    REQUIRE(list.size() == 3);
+    REQUIRE_FALSE(list.contains(2));
+    REQUIRE(list.pop() == 1);
+    REQUIRE(list.pop() == 3);
+    REQUIRE(list.pop() == 4);
+    REQUIRE(list.empty());
+}
+
+TEST_CASE("Texture names are reused after deletion", "[TextureMemoryManager]")
+{
+    TestTextureMemoryManager manager {};
+    REQUIRE(manager.createTexture() == std::pair<bool, uint16_t> { true, 1 });
+    REQUIRE(manager.createTextureWithName(3));
+    REQUIRE(manager.createTexture() == std::pair<bool, uint16_t> { true, 2 });
+    REQUIRE(manager.createTexture() == std::pair<bool, uint16_t> { true, 4 });
+    REQUIRE(manager.deleteTexture(2));
+    upload(manager);
+    REQUIRE(manager.createTexture() == std::pair<bool, uint16_t> { true, 2 });
+}
+
+TEST_CASE("Texture creation fails when all texture slots are used", "[TextureMemoryManager]")
+{
+    TestTextureMemoryManager manager {};
+    for (std::size_t i = 1; i < TestRenderConfig::NUMBER_OF_TEXTURES; i++)
+    {
+        REQUIRE(manager.createTexture().first);
+    }
+    REQUIRE_FALSE(manager.createTexture().first);
+    REQUIRE_FALSE(manager.createTextureWithName(TestRenderConfig::NUMBER_OF_TEXTURES));
+    REQUIRE(manager.getStatistics().freeTextureSlots == 0);
+
+    // The slot is freed with the next upload
+    REQUIRE(manager.deleteTexture(5));
+    REQUIRE_FALSE(manager.createTexture().first);
+    upload(manager);
+    REQUIRE(manager.createTexture() == std::pair<bool, uint16_t> { true, 5 });
+}
+
+TEST_CASE("Pages are allocated and freed", "[TextureMemoryManager]")
+{
+    TestTextureMemoryManager manager {};
+    const uint16_t tex0 = manager.createTexture().second;
+    const uint16_t tex1 = manager.createTexture().second;
+    REQUIRE(manager.updateTexture(tex0, createTextureObject(8, 8))); // 2 pages
+    REQUIRE(manager.updateTexture(tex1, createTextureObject(16, 10))); // 5 pages
+    REQUIRE(upload(manager) == 7);
+
+    const tcb::span<const std::size_t> pages0 = manager.getPages(tex0);
+    const tcb::span<const std::size_t> pages1 = manager.getPages(tex1);
+    REQUIRE(std::vector<std::size_t>(pages0.begin(), pages0.end()) == std::vector<std::size_t> { 0, 1 });
+    REQUIRE(std::vector<std::size_t>(pages1.begin(), pages1.end()) == std::vector<std::size_t> { 2, 3, 4, 5, 6 });
+
+    TestTextureMemoryManager::Statistics stats = manager.getStatistics();
+    REQUIRE(stats.usedPages == 7);
+    REQUIRE(stats.freePages == 25);
+    REQUIRE(stats.peakUsedPages == 7);
+    REQUIRE(stats.usedTextureSlots == 2);
+    REQUIRE(stats.unusedBytesInPages == 0);
+    REQUIRE(stats.freePageRuns == 1);
+    REQUIRE(stats.largestFreePageRun == 25);
+
+    REQUIRE(manager.deleteTexture(tex0));
+    upload(manager);
+    stats = manager.getStatistics();
+    REQUIRE(stats.usedPages == 5);
+    REQUIRE(stats.peakUsedPages == 7);
+    REQUIRE(stats.usedTextureSlots == 1);
+    REQUIRE(stats.freePageRuns == 2);
+    REQUIRE(stats.largestFreePageRun == 25);
+
+    // The freed pages are reused first. Pages of a texture do not have to be continuous.
+    const uint16_t tex2 = manager.createTexture().second;
+    REQUIRE(manager.updateTexture(tex2, createTextureObject(4, 12))); // 96 bytes, 2 pages
+    upload(manager);
+    const tcb::span<const std::size_t> pages2 = manager.getPages(tex2);
+    REQUIRE(std::vector<std::size_t>(pages2.begin(), pages2.end()) == std::vector<std::size_t> { 0, 1 });
+    REQUIRE(manager.getStatistics().unusedBytesInPages == 32);
+}
+
+TEST_CASE("Texture update fails when the pages are exhausted", "[TextureMemoryManager]")
+{
+    TestTextureMemoryManager manager {};
+    std::vector<uint16_t> textures;
+    for (std::size_t i = 0; i < 4; i++)
+    {
+        textures.push_back(manager.createTexture().second);
+        REQUIRE(manager.updateTexture(textures.back(), createTextureObject(16, 16))); // 8 pages
+    }
+    upload(manager);
+    REQUIRE(manager.getStatistics().freePages == 0);
+
+    // Textures which are used in the current frame can't be evicted
+    for (const uint16_t t : textures)
+    {
+        REQUIRE(manager.useTexture(0, t));
+    }
+    const uint16_t tex = manager.createTexture().second;
+    REQUIRE_FALSE(manager.updateTexture(tex, createTextureObject(2, 2)));
+
+    // An uploaded texture frees its pages immediately when it is updated
+    REQUIRE(manager.updateTexture(textures[0], createTextureObject(8, 8)));
+    REQUIRE(manager.getStatistics().usedPages == 26);
+}
+
+TEST_CASE("Updating a texture which is not uploaded keeps the old pages until the upload", "[TextureMemoryManager]")
+{
+    TestTextureMemoryManager manager {};
+    const uint16_t tex = manager.createTexture().second;
+    REQUIRE(manager.updateTexture(tex, createTextureObject(8, 8)));
+    REQUIRE(manager.updateTexture(tex, createTextureObject(8, 8)));
+    REQUIRE(manager.getStatistics().usedPages == 4);
+    REQUIRE(manager.getStatistics().usedTextureSlots == 2);
+    upload(manager);
+    REQUIRE(manager.getStatistics().usedPages == 2);
+    REQUIRE(manager.getStatistics().usedTextureSlots == 1);
+}
+
+TEST_CASE("Only changed textures are uploaded", "[TextureMemoryManager]")
+{
+    TestTextureMemoryManager manager {};
+    const uint16_t tex0 = manager.createTexture().second;
+    const uint16_t tex1 = manager.createTexture().second;
+    REQUIRE(manager.updateTexture(tex0, createTextureObject(8, 8)));
+    REQUIRE(manager.updateTexture(tex1, createTextureObject(16, 8)));
+    REQUIRE(upload(manager) == 6);
+    REQUIRE(upload(manager) == 0);
+    REQUIRE(manager.updateTexture(tex1, createTextureObject(8, 4)));
+    REQUIRE(upload(manager) == 1);
+}
+
+TEST_CASE("Failed uploads are retried", "[TextureMemoryManager]")
+{
+    TestTextureMemoryManager manager {};
+    const uint16_t tex = manager.createTexture().second;
+    REQUIRE(manager.updateTexture(tex, createTextureObject(8, 8)));
+    std::size_t calls = 0;
+    manager.uploadTextures([&calls](uint32_t, const tcb::span<const uint8_t>)
+        {
+            calls++;
+            return false; });
+    REQUIRE(calls == 1); // The upload stops at the first failed page
+    REQUIRE(upload(manager) == 2);
+    REQUIRE(upload(manager) == 0);
+}
+
+TEST_CASE("Pages point into the pixels of a mip level when possible", "[TextureMemoryManager]")
+{
+    TestTextureMemoryManager manager {};
+    const uint16_t tex = manager.createTexture().second;
+
+    // The levels are 512, 128, 32 and 8 bytes big
+    TextureObject obj = createTextureObject(16, 16);
+    std::vector<uint8_t> expected;
+    for (std::size_t level = 0; level < obj.getLevels(); level++)
+    {
+        const std::size_t pixels = obj.getWidth(level) * obj.getHeight(level);
+        if (level != 0)
+        {
+            obj.setPixels(level, TextureObject::PixelsType { new uint16_t[pixels], std::default_delete<uint16_t[]>() });
+        }
+        for (std::size_t i = 0; i < pixels; i++)
+        {
+            obj.getPixels(level).get()[i] = static_cast<uint16_t>((level << 12) | i);
+        }
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(obj.getPixels(level).get());
+        expected.insert(expected.end(), bytes, bytes + obj.getSizeInBytes(level));
+    }
+    REQUIRE(expected.size() == 680);
+    REQUIRE(manager.updateTexture(tex, obj));
+
+    std::vector<uint8_t> memory(TestRenderConfig::NUMBER_OF_TEXTURE_PAGES * TestRenderConfig::TEXTURE_PAGE_SIZE);
+    std::vector<const uint8_t*> pageData;
+    manager.uploadTextures([&](uint32_t addr, const tcb::span<const uint8_t> data)
+        {
+            std::copy(data.begin(), data.end(), memory.begin() + addr);
+            pageData.push_back(data.data());
+            return true; });
+
+    const tcb::span<const std::size_t> pages = manager.getPages(tex);
+    REQUIRE(pages.size() == 11);
+    REQUIRE(pageData.size() == 11);
+    for (std::size_t i = 0; i < pages.size(); i++)
+    {
+        const std::size_t size = (std::min)(expected.size() - (i * 64), std::size_t { 64 });
+        REQUIRE(std::equal(expected.begin() + (i * 64), expected.begin() + (i * 64) + size, memory.begin() + (pages[i] * 64)));
+    }
+    const uint8_t* level0 = reinterpret_cast<const uint8_t*>(obj.getPixels(0).get());
+    const uint8_t* level1 = reinterpret_cast<const uint8_t*>(obj.getPixels(1).get());
+    for (std::size_t i = 0; i < 8; i++)
+    {
+        REQUIRE(pageData[i] == level0 + (i * 64));
+    }
+    REQUIRE(pageData[8] == level1);
+    REQUIRE(pageData[9] == level1 + 64);
+    REQUIRE(pageData[10] != reinterpret_cast<const uint8_t*>(obj.getPixels(2).get())); // Level 2 and 3 share a page
+}
+
+TEST_CASE("Region updates upload only the touched pages", "[TextureMemoryManager]")
+{
+    TestTextureMemoryManager manager {};
+    const uint16_t tex = manager.createTexture().second;
+    TextureObject obj = createTextureObject(16, 16); // One row is 32 bytes, two rows per page
+    REQUIRE(manager.updateTexture(tex, obj));
+    REQUIRE(upload(manager) == 8);
+    const tcb::span<const std::size_t> pages = manager.getPages(tex);
+
+    std::vector<uint32_t> addrs;
+    const auto collect = [&addrs](uint32_t addr, const tcb::span<const uint8_t> data)
+    {
+        REQUIRE(data.size() == 64);
+        addrs.push_back(addr);
+        return true;
+    };
+
+    REQUIRE(manager.updateTextureRegion(tex, obj, 0, 2, 4, 4, 2));
+    manager.uploadTextures(collect);
+    REQUIRE(addrs == std::vector<uint32_t> { static_cast<uint32_t>(pages[2] * 64) });
+
+    addrs.clear();
+    REQUIRE(manager.updateTextureRegion(tex, obj, 0, 0, 1, 16, 2));
+    manager.uploadTextures(collect);
+    REQUIRE(addrs == std::vector<uint32_t> { static_cast<uint32_t>(pages[0] * 64), static_cast<uint32_t>(pages[1] * 64) });
+
+    REQUIRE(upload(manager) == 0);
+    REQUIRE(manager.getPages(tex).size() == 8);
+    REQUIRE(manager.getPages(tex)[0] == pages[0]);
+}
+
+TEST_CASE("Region updates of a texture which is not uploaded upload the whole texture", "[TextureMemoryManager]")
+{
+    TestTextureMemoryManager manager {};
+    const uint16_t tex = manager.createTexture().second;
+    TextureObject obj = createTextureObject(16, 16);
+    REQUIRE(manager.updateTexture(tex, obj));
+    REQUIRE(manager.updateTextureRegion(tex, obj, 0, 0, 0, 1, 1));
+    REQUIRE(upload(manager) == 8);
+    REQUIRE(upload(manager) == 0);
+}
+
+TEST_CASE("Region updates require the same texture layout", "[TextureMemoryManager]")
+{
+    TestTextureMemoryManager manager {};
+    const uint16_t tex = manager.createTexture().second;
+    REQUIRE(manager.updateTexture(tex, createTextureObject(16, 16)));
+    REQUIRE(upload(manager) == 8);
+    REQUIRE_FALSE(manager.updateTextureRegion(tex, createTextureObject(8, 8), 0, 0, 0, 1, 1));
+    REQUIRE_FALSE(manager.updateTextureRegion(tex, createTextureObject(16, 16), 0, 8, 8, 9, 1));
+    REQUIRE(upload(manager) == 0);
+}
+
+TEST_CASE("A texture which was drawn in the current frame is updated into a new slot", "[TextureMemoryManager]")
+{
+    TestTextureMemoryManager manager {};
+    const uint16_t tex = manager.createTexture().second;
+    TextureObject obj = createTextureObject(16, 16);
+    REQUIRE(manager.updateTexture(tex, obj));
+    REQUIRE(upload(manager) == 8);
+    const std::vector<std::size_t> drawnPages { manager.getPages(tex).begin(), manager.getPages(tex).end() };
+
+    REQUIRE(manager.useTexture(0, tex));
+    REQUIRE_FALSE(manager.textureDrawnInCurrentFrame(tex));
+    manager.markBoundTexturesDrawn();
+    REQUIRE(manager.textureDrawnInCurrentFrame(tex));
+
+    // The pages sampled by the draw must not be changed in this frame
+    REQUIRE_FALSE(manager.updateTextureRegion(tex, obj, 0, 0, 0, 1, 1));
+    REQUIRE(manager.updateTexture(tex, createTextureObject(16, 16)));
+    REQUIRE(manager.getStatistics().usedTextureSlots == 2);
+    const tcb::span<const std::size_t> newPages = manager.getPages(tex);
+    for (const std::size_t page : drawnPages)
+    {
+        REQUIRE(std::find(newPages.begin(), newPages.end(), page) == newPages.end());
+    }
+    REQUIRE(upload(manager) == 8);
+    REQUIRE(manager.getStatistics().usedTextureSlots == 1);
+
+    // In the next frame, the texture is updated in place again
+    REQUIRE_FALSE(manager.textureDrawnInCurrentFrame(tex));
+    REQUIRE(manager.updateTextureRegion(tex, manager.getTexture(tex), 0, 0, 0, 1, 1));
+    REQUIRE(upload(manager) == 1);
+}
+
+TEST_CASE("Least recently used textures are evicted when the pages are exhausted", "[TextureMemoryManager]")
+{
+    TestTextureMemoryManager manager {};
+    std::array<uint16_t, 4> tex {};
+    for (uint16_t& t : tex)
+    {
+        t = manager.createTexture().second;
+        REQUIRE(manager.updateTexture(t, createTextureObject(16, 16))); // 8 pages each
+    }
+    REQUIRE(upload(manager) == 32);
+
+    REQUIRE(manager.useTexture(0, tex[0]));
+    REQUIRE(manager.useTexture(0, tex[1]));
+    REQUIRE(manager.useTexture(1, tex[3]));
+    REQUIRE(upload(manager) == 0);
+    REQUIRE(manager.useTexture(1, tex[0]));
+    REQUIRE(upload(manager) == 0);
+
+    // tex[2] is the least recently used. tex[0] and tex[1] are bound.
+    const uint16_t newTex = manager.createTexture().second;
+    REQUIRE(manager.updateTexture(newTex, createTextureObject(16, 16)));
+    REQUIRE_FALSE(manager.textureResident(tex[2]));
+    REQUIRE(manager.textureResident(tex[0]));
+    REQUIRE(manager.textureResident(tex[1]));
+    REQUIRE(manager.textureResident(tex[3]));
+    REQUIRE(manager.getStatistics().evictions == 1);
+    REQUIRE(upload(manager) == 8);
+
+    // Using the evicted texture evicts the next least recently used texture and uploads it again
+    REQUIRE(manager.useTexture(0, tex[2]));
+    REQUIRE(manager.textureResident(tex[2]));
+    REQUIRE_FALSE(manager.textureResident(tex[1]));
+    REQUIRE(manager.textureResident(tex[3]));
+    REQUIRE(manager.textureResident(newTex));
+    REQUIRE(manager.getPages(tex[2]).size() == 8);
+    REQUIRE(upload(manager) == 8);
+    REQUIRE(manager.getStatistics().evictions == 2);
+    REQUIRE(manager.getStatistics().reuploadedBytes == 512);
+}
+
+TEST_CASE("Textures with a lower priority are evicted first", "[TextureMemoryManager]")
+{
+    TestTextureMemoryManager manager {};
+    std::array<uint16_t, 4> tex {};
+    for (uint16_t& t : tex)
+    {
+        t = manager.createTexture().second;
+        REQUIRE(manager.updateTexture(t, createTextureObject(16, 16)));
+    }
+    manager.setTexturePriority(tex[3], 0.5f);
+    REQUIRE(manager.getTexturePriority(tex[3]) == 0.5f);
+    REQUIRE(upload(manager) == 32);
+
+    const uint16_t newTex = manager.createTexture().second;
+    REQUIRE(manager.updateTexture(newTex, createTextureObject(16, 16)));
+    REQUIRE_FALSE(manager.textureResident(tex[3]));
+    REQUIRE(manager.textureResident(tex[0]));
+}
+
+TEST_CASE("Several textures are evicted in the order of their priority and last use", "[TextureMemoryManager]")
+{
+    TestTextureMemoryManager manager {};
+    std::array<uint16_t, 4> tex {};
+    for (uint16_t& t : tex)
+    {
+        t = manager.createTexture().second;
+        REQUIRE(manager.updateTexture(t, createTextureObject(16, 8))); // 4 pages each
+    }
+    std::array<uint16_t, 2> bound {};
+    for (uint16_t& t : bound)
+    {
+        t = manager.createTexture().second;
+        REQUIRE(manager.updateTexture(t, createTextureObject(16, 16))); // 8 pages each
+    }
+    manager.setTexturePriority(tex[2], 0.5f);
+    REQUIRE(upload(manager) == 32);
+    REQUIRE(manager.useTexture(0, tex[0]));
+    REQUIRE(upload(manager) == 0);
+    REQUIRE(manager.useTexture(0, tex[3]));
+    REQUIRE(upload(manager) == 0);
+    REQUIRE(manager.useTexture(0, bound[0]));
+    REQUIRE(manager.useTexture(1, bound[1]));
+    REQUIRE(upload(manager) == 0);
+
+    // Requires two textures: tex[2] has the lowest priority, tex[1] is the least recently used of the others
+    const uint16_t newTex = manager.createTexture().second;
+    REQUIRE(manager.updateTexture(newTex, createTextureObject(16, 16)));
+    REQUIRE_FALSE(manager.textureResident(tex[2]));
+    REQUIRE_FALSE(manager.textureResident(tex[1]));
+    REQUIRE(manager.textureResident(tex[0]));
+    REQUIRE(manager.textureResident(tex[3]));
+    REQUIRE(manager.textureResident(bound[0]));
+    REQUIRE(manager.textureResident(bound[1]));
+    REQUIRE(manager.getStatistics().evictions == 2);
+}
+
+TEST_CASE("A texture keeps its slot when no slot is available for the update", "[TextureMemoryManager]")
+{
+    TestTextureMemoryManager manager {};
+    std::array<uint16_t, TestRenderConfig::NUMBER_OF_TEXTURES - 1> tex {};
+    for (uint16_t& t : tex)
+    {
+        t = manager.createTexture().second;
+    }
+    REQUIRE(manager.updateTexture(tex[0], createTextureObject(8, 8)));
+
+    // The texture is not uploaded yet. The update requires a new slot, but all slots are used.
+    REQUIRE_FALSE(manager.updateTexture(tex[0], createTextureObject(8, 8)));
+    REQUIRE(manager.getTexture(tex[0]).getWidth(0) == 8);
+    REQUIRE(upload(manager) == 2);
+    REQUIRE(manager.getTexture(tex[0]).getWidth(0) == 8);
+    REQUIRE(manager.textureResident(tex[0]));
+    REQUIRE(manager.getStatistics().freeTextureSlots == 0);
+}
+
+TEST_CASE("Textures used in the current frame are not evicted", "[TextureMemoryManager]")
+{
+    TestTextureMemoryManager manager {};
+    std::array<uint16_t, 4> tex {};
+    for (uint16_t& t : tex)
+    {
+        t = manager.createTexture().second;
+        REQUIRE(manager.updateTexture(t, createTextureObject(16, 16)));
+    }
+    REQUIRE(upload(manager) == 32);
+    for (const uint16_t t : tex)
+    {
+        REQUIRE(manager.useTexture(0, t));
+    }
+
+    const uint16_t newTex = manager.createTexture().second;
+    REQUIRE_FALSE(manager.updateTexture(newTex, createTextureObject(16, 16)));
+    REQUIRE_FALSE(manager.textureResident(newTex));
+    REQUIRE(manager.getStatistics().evictions == 0);
+    REQUIRE(upload(manager) == 0);
+
+    // In the next frame, only the bound texture is protected. The texture which failed to allocate its pages
+    // is uploaded when it is used.
+    REQUIRE(manager.useTexture(1, newTex));
+    REQUIRE(manager.textureResident(newTex));
+    REQUIRE(manager.textureResident(tex[3]));
+    REQUIRE_FALSE(manager.textureResident(tex[0]));
+    REQUIRE(upload(manager) == 8);
+}
+
+TEST_CASE("Region updates of evicted textures are uploaded when the texture is used again", "[TextureMemoryManager]")
+{
+    TestTextureMemoryManager manager {};
+    std::array<uint16_t, 4> tex {};
+    std::array<TextureObject, 4> obj {};
+    for (std::size_t i = 0; i < tex.size(); i++)
+    {
+        tex[i] = manager.createTexture().second;
+        obj[i] = createTextureObject(16, 16);
+        REQUIRE(manager.updateTexture(tex[i], obj[i]));
+    }
+    REQUIRE(upload(manager) == 32);
+    const uint16_t newTex = manager.createTexture().second;
+    REQUIRE(manager.updateTexture(newTex, createTextureObject(16, 16)));
+    REQUIRE_FALSE(manager.textureResident(tex[0]));
+    REQUIRE(upload(manager) == 8);
+
+    REQUIRE(manager.updateTextureRegion(tex[0], obj[0], 0, 0, 0, 1, 1));
+    REQUIRE(upload(manager) == 0);
+    REQUIRE(manager.useTexture(0, tex[0]));
+    REQUIRE(upload(manager) == 8);
+}
@@ -0,0 +1,102 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#define CATCH_CONFIG_MAIN
+#include "../3rdParty/catch.hpp"
+#include "TexturePixelAllocator.hpp"
+#include <thread>
+
+using namespace rr;
+
+TEST_CASE("Reuse released buffers with the same size", "[TexturePixelAllocator]")
+{
+    TexturePixelAllocator allocator {};
+    TextureObject::PixelsType a = allocator.allocate(256);
+    REQUIRE(a);
+    const uint16_t* address = a.get();
+    a.reset();
+
+    TextureObject::PixelsType b = allocator.allocate(128);
+    TextureObject::PixelsType c = allocator.allocate(256);
+    REQUIRE(c.get() == address);
+
+    const TexturePixelAllocator::Statistics statistics = allocator.getStatistics();
+    REQUIRE(statistics.allocations == 2);
+    REQUIRE(statistics.reuses == 1);
+    REQUIRE(statistics.bytesInUse == (384 * sizeof(uint16_t)));
+    REQUIRE(statistics.bytesCached == 0);
+}
+
+TEST_CASE("Report the peak memory", "[TexturePixelAllocator]")
+{
+    TexturePixelAllocator allocator {};
+    {
+        TextureObject::PixelsType a = allocator.allocate(1000);
+        TextureObject::PixelsType b = allocator.allocate(500);
+    }
+    TexturePixelAllocator::Statistics statistics = allocator.getStatistics();
+    REQUIRE(statistics.bytesInUse == 0);
+    REQUIRE(statistics.bytesCached == (1500 * sizeof(uint16_t)));
+    REQUIRE(statistics.peakBytes == (1500 * sizeof(uint16_t)));
+
+    // A new size adds to the cached buffers
+    TextureObject::PixelsType c = allocator.allocate(100);
+    statistics = allocator.getStatistics();
+    REQUIRE(statistics.peakBytes == (1600 * sizeof(uint16_t)));
+
+    allocator.trim();
+    statistics = allocator.getStatistics();
+    REQUIRE(statistics.bytesCached == 0);
+    REQUIRE(statistics.bytesInUse == (100 * sizeof(uint16_t)));
+}
+
+TEST_CASE("Free buffers which exceed the cache limit", "[TexturePixelAllocator]")
+{
+    TexturePixelAllocator allocator {};
+    allocator.setMaxCachedBytes(1000 * sizeof(uint16_t));
+    TextureObject::PixelsType a = allocator.allocate(600);
+    TextureObject::PixelsType b = allocator.allocate(600);
+    a.reset();
+    b.reset();
+    REQUIRE(allocator.getStatistics().bytesCached == (600 * sizeof(uint16_t)));
+
+    TextureObject::PixelsType c = allocator.allocate(600);
+    TextureObject::PixelsType d = allocator.allocate(600);
+    REQUIRE(allocator.getStatistics().reuses == 1);
+    REQUIRE(allocator.getStatistics().allocations == 3);
+}
+
+TEST_CASE("Release buffers from another thread", "[TexturePixelAllocator]")
+{
+    TexturePixelAllocator allocator { true };
+    std::vector<TextureObject::PixelsType> buffers {};
+    for (std::size_t i = 0; i < 100; i++)
+    {
+        buffers.push_back(allocator.allocate(64 * (1 + (i % 4))));
+    }
+    std::thread releaser { [&buffers]()
+        { buffers.clear(); } };
+    for (std::size_t i = 0; i < 100; i++)
+    {
+        TextureObject::PixelsType buffer = allocator.allocate(32);
+    }
+    releaser.join();
+    const TexturePixelAllocator::Statistics statistics = allocator.getStatistics();
+    REQUIRE(statistics.bytesInUse == 0);
+    REQUIRE(statistics.bytesCached == ((100 * 160) + 32) * sizeof(uint16_t));
+}
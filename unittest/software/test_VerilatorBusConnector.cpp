@@ -0,0 +1,89 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#define CATCH_CONFIG_MAIN
+#include "../3rdParty/catch.hpp"
+#include "VerilatorBusConnector.hpp"
+#include <memory>
+#include <vector>
+
+using namespace rr;
+
+namespace
+{
+using TestBusConnector = VerilatorBusConnector<2, 64 * 1024>;
+
+void fill(tcb::span<uint8_t> buffer, const uint32_t seed)
+{
+    uint32_t* data32 = reinterpret_cast<uint32_t*>(buffer.data());
+    for (std::size_t i = 0; i < (buffer.size() / sizeof(uint32_t)); i++)
+    {
+        data32[i] = (seed << 16) | static_cast<uint32_t>(i & 0xffff);
+    }
+}
+} // namespace
+
+TEST_CASE("Back to back writes of the same buffer are streamed unchanged", "[VerilatorBusConnector]")
+{
+    Vtop::commandBeats().clear();
+    std::unique_ptr<TestBusConnector> busConnector = std::make_unique<TestBusConnector>(tcb::span<uint8_t> {});
+    REQUIRE(busConnector->queuesTransfers());
+
+    static constexpr uint32_t WRITES { 8 };
+    static constexpr uint32_t SIZE { 64 * 1024 };
+    for (uint32_t i = 0; i < WRITES; i++)
+    {
+        // Without waiting for the in flight transfer, this overwrites the buffer while it is streamed
+        fill(busConnector->requestWriteBuffer(0), i);
+        busConnector->writeData(0, SIZE, 0);
+    }
+    busConnector->blockUntilTransferIsComplete();
+
+    const std::vector<uint32_t>& beats = Vtop::commandBeats();
+    REQUIRE(beats.size() == (WRITES * SIZE / sizeof(uint32_t)));
+    for (std::size_t i = 0; i < beats.size(); i++)
+    {
+        const uint32_t beat = i % (SIZE / sizeof(uint32_t));
+        REQUIRE(beats[i] == (((i / (SIZE / sizeof(uint32_t))) << 16) | beat));
+    }
+    REQUIRE(busConnector->getStatistics().beatsWritten == beats.size());
+}
+
+TEST_CASE("Writes alternate between buffers and respect the offset", "[VerilatorBusConnector]")
+{
+    Vtop::commandBeats().clear();
+    std::unique_ptr<TestBusConnector> busConnector = std::make_unique<TestBusConnector>(tcb::span<uint8_t> {});
+
+    fill(busConnector->requestWriteBuffer(0), 1);
+    busConnector->writeData(0, 16, 0);
+    fill(busConnector->requestWriteBuffer(1), 2);
+    busConnector->writeData(1, 8, 8);
+    busConnector->blockUntilTransferIsComplete();
+
+    REQUIRE(Vtop::commandBeats() == std::vector<uint32_t> { 0x10000, 0x10001, 0x10002, 0x10003, 0x20002, 0x20003 });
+}
+
+TEST_CASE("Reads are valid when the read buffer is requested", "[VerilatorBusConnector]")
+{
+    std::unique_ptr<TestBusConnector> busConnector = std::make_unique<TestBusConnector>(tcb::span<uint8_t> {});
+    busConnector->readData(0, 16);
+    const tcb::span<uint8_t> buffer = busConnector->requestReadBuffer(0);
+    const uint32_t* data32 = reinterpret_cast<const uint32_t*>(buffer.data());
+    REQUIRE(data32[0] == 0);
+    REQUIRE(data32[3] == 3);
+    REQUIRE(busConnector->getStatistics().beatsRead == 4);
+}
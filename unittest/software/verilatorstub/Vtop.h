@@ -0,0 +1,72 @@
+// RasterIX
+// https://github.com/ToNi3141/RasterIX
+// Copyright (c) 2025 ToNi3141
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef VTOP_STUB_H
+#define VTOP_STUB_H
+
+#include <cstdint>
+#include <vector>
+
+// Stands in for the verilated model of rtl/top/Verilator/top.v, so that the VerilatorBusConnector can be tested
+// without Verilator. Each command beat is accepted and recorded on the rising edge of the clock. The response
+// stream returns a counter.
+class Vtop
+{
+public:
+    void eval()
+    {
+        const bool risingEdge = aclk && !m_lastClk;
+        m_lastClk = aclk;
+        if (!risingEdge || !resetn)
+        {
+            return;
+        }
+        if (s_cmd_axis_tvalid && s_cmd_axis_tready)
+        {
+            commandBeats().push_back(s_cmd_axis_tdata);
+        }
+        if (m_cmd_resp_axis_tvalid && m_cmd_resp_axis_tready)
+        {
+            m_cmd_resp_axis_tdata++;
+        }
+    }
+
+    /// @brief The beats received by all models. Only valid when the simulation thread is idle.
+    static std::vector<uint32_t>& commandBeats()
+    {
+        static std::vector<uint32_t> beats {};
+        return beats;
+    }
+
+    uint8_t aclk { 0 };
+    uint8_t resetn { 0 };
+    uint8_t s_cmd_axis_tvalid { 0 };
+    uint8_t s_cmd_axis_tready { 1 };
+    uint32_t s_cmd_axis_tdata { 0 };
+    uint8_t m_cmd_resp_axis_tvalid { 1 };
+    uint8_t m_cmd_resp_axis_tready { 0 };
+    uint32_t m_cmd_resp_axis_tdata { 0 };
+    uint8_t m_framebuffer_axis_tvalid { 0 };
+    uint8_t m_framebuffer_axis_tready { 0 };
+    uint8_t m_framebuffer_axis_tlast { 0 };
+    uint32_t m_framebuffer_axis_tdata { 0 };
+
+private:
+    uint8_t m_lastClk { 0 };
+};
+
+#endif // VTOP_STUB_H